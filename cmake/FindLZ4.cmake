@@ -0,0 +1,20 @@
+# Find LZ4 Headers/Libs
+
+# Variables
+# LZ4_ROOT - set this to a location where LZ4 may be found
+#
+# LZ4_FOUND - True if LZ4 found
+# LZ4_INCLUDE_DIRS - Location of LZ4 includes
+# LZ4_LIBRARIES - LZ4 libraries
+
+include(FindPackageHandleStandardArgs)
+
+if (NOT LZ4_ROOT)
+    set(LZ4_ROOT "$ENV{LZ4_ROOT}")
+endif()
+
+find_path(LZ4_INCLUDE_DIRS NAMES lz4.h HINTS ${LZ4_ROOT}/include)
+find_library(LZ4_LIBRARIES NAMES lz4 HINTS ${LZ4_ROOT}/lib)
+
+find_package_handle_standard_args(LZ4 DEFAULT_MSG LZ4_LIBRARIES LZ4_INCLUDE_DIRS)
+mark_as_advanced(LZ4_INCLUDE_DIRS LZ4_LIBRARIES)
@@ -0,0 +1,20 @@
+# Find ZSTD Headers/Libs
+
+# Variables
+# ZSTD_ROOT - set this to a location where ZSTD may be found
+#
+# ZSTD_FOUND - True if ZSTD found
+# ZSTD_INCLUDE_DIRS - Location of ZSTD includes
+# ZSTD_LIBRARIES - ZSTD libraries
+
+include(FindPackageHandleStandardArgs)
+
+if (NOT ZSTD_ROOT)
+    set(ZSTD_ROOT "$ENV{ZSTD_ROOT}")
+endif()
+
+find_path(ZSTD_INCLUDE_DIRS NAMES zstd.h HINTS ${ZSTD_ROOT}/include)
+find_library(ZSTD_LIBRARIES NAMES zstd HINTS ${ZSTD_ROOT}/lib)
+
+find_package_handle_standard_args(ZSTD DEFAULT_MSG ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
+mark_as_advanced(ZSTD_INCLUDE_DIRS ZSTD_LIBRARIES)
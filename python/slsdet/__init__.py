@@ -8,9 +8,11 @@ from .mythen3 import Mythen3
 from .gotthard2 import Gotthard2
 from .gotthard import Gotthard
 from .moench import Moench
+from .indexedfile import IndexedFile
 
 import _slsdet
 xy = _slsdet.xy
+rxThreadAffinity = _slsdet.rxThreadAffinity
 defs = _slsdet.slsDetectorDefs
 
 from .enums import *
@@ -749,9 +749,10 @@ class Detector(CppDetectorApi):
         
             Note
             -----
-            Options: BINARY, HDF5
+            Options: BINARY, HDF5, INDEXED
             Default: BINARY
             For HDF5, package must be compiled with HDF5 flags. Default is binary. 
+            INDEXED files can be read with slsdet.IndexedFile. They hold at most 100000 frames each, also with rx_framesperfile 0.
 
             Example
             --------
@@ -837,6 +838,129 @@ class Detector(CppDetectorApi):
     def foverwrite(self, value):
         ut.set_using_dict(self.setFileOverWrite, value)
 
+    @property
+    @element
+    def fdirectio(self):
+        """Write binary files with direct io (O_DIRECT), bypassing the page cache. Default is disabled. The file format is unchanged."""
+        return self.getFileDirectIO()
+
+    @fdirectio.setter
+    def fdirectio(self, value):
+        ut.set_using_dict(self.setFileDirectIO, value)
+
+    @property
+    @element
+    def fiouring(self):
+        """Write binary files asynchronously with io_uring from the receiver fifo. Default is disabled. The file format is unchanged."""
+        return self.getFileIoUring()
+
+    @fiouring.setter
+    def fiouring(self, value):
+        ut.set_using_dict(self.setFileIoUring, value)
+
+    @property
+    @element
+    def fchunkframes(self):
+        """[HDF5] Number of images per chunk of the data dataset. Images are gathered and written as whole chunks. Default is 1. At most rx_framesperfile and a chunk below 4 GiB."""
+        return self.getHdf5ChunkFrames()
+
+    @fchunkframes.setter
+    def fchunkframes(self, value):
+        ut.set_using_dict(self.setHdf5ChunkFrames, value)
+
+    @property
+    @element
+    def fchunkrows(self):
+        """[HDF5] Number of rows per chunk of the data dataset, to tile the images. Default is 0 (whole image)."""
+        return self.getHdf5ChunkRows()
+
+    @fchunkrows.setter
+    def fchunkrows(self, value):
+        ut.set_using_dict(self.setHdf5ChunkRows, value)
+
+    @property
+    @element
+    def fcompoundheader(self):
+        """[HDF5] Write the receiver header of each image to one compound dataset 'header', instead of a dataset per parameter. Default is disabled."""
+        return self.getHdf5CompoundHeader()
+
+    @fcompoundheader.setter
+    def fcompoundheader(self, value):
+        ut.set_using_dict(self.setHdf5CompoundHeader, value)
+
+    @property
+    @element
+    def fh5process(self):
+        """[HDF5] Write the data file of each port in its own writer process, so that ports write in parallel. Reallocates the fifo as shared memory. Default is disabled."""
+        return self.getHdf5WriterProcess()
+
+    @fh5process.setter
+    def fh5process(self, value):
+        ut.set_using_dict(self.setHdf5WriterProcess, value)
+
+    @property
+    @element
+    def fswmr(self):
+        """[HDF5] Write the data files in single writer multiple reader mode, readable while the acquisition runs. Default is disabled."""
+        return self.getHdf5Swmr()
+
+    @fswmr.setter
+    def fswmr(self, value):
+        ut.set_using_dict(self.setHdf5Swmr, value)
+
+    @property
+    @element
+    def fflushframes(self):
+        """[HDF5] Number of images between flushes to readers in swmr mode. 0 for none. Default is 100."""
+        return self.getHdf5FlushFrames()
+
+    @fflushframes.setter
+    def fflushframes(self, value):
+        ut.set_using_dict(self.setHdf5FlushFrames, value)
+
+    @property
+    @element
+    def fflushtime(self):
+        """[HDF5] Time in ms between flushes to readers in swmr mode, checked as images are written. 0 for none. Default is 1000."""
+        return self.getHdf5FlushTime()
+
+    @fflushtime.setter
+    def fflushtime(self, value):
+        ut.set_using_dict(self.setHdf5FlushTime, value)
+
+    @property
+    @element
+    def fcompression(self):
+        """
+        Bitshuffle compression of the images. Enum: fileCompression
+        Note
+        -----
+        Options: NO_COMPRESSION, BITSHUFFLE_LZ4, BITSHUFFLE_ZSTD \n
+        Default: NO_COMPRESSION \n
+        [HDF5] Chunks are written with the bitshuffle filter. [Binary] Frames are written with their compressed size and an index of frame offsets at the end of the file. Requires a receiver built with SLS_USE_COMPRESSION.
+
+        Example
+        --------
+        >>> d.fcompression = fileCompression.BITSHUFFLE_LZ4
+        >>> d.fcompression
+        fileCompression.BITSHUFFLE_LZ4
+        """
+        return self.getFileCompression()
+
+    @fcompression.setter
+    def fcompression(self, value):
+        ut.set_using_dict(self.setFileCompression, value)
+
+    @property
+    @element
+    def rx_compressionthreads(self):
+        """Number of threads compressing the blocks of the images of all ports, besides the file writer thread of each port. Default is 4. Max is 64."""
+        return self.getRxCompressionThreads()
+
+    @rx_compressionthreads.setter
+    def rx_compressionthreads(self, value):
+        ut.set_using_dict(self.setRxCompressionThreads, value)
+
     @property
     def fmaster(self):
         """Enable or disable receiver master file. Default is enabled."""
@@ -1024,6 +1148,18 @@ class Detector(CppDetectorApi):
     def zmqhwm(self, n_frames):
         self.setClientZmqHwm(n_frames)
 
+    @property
+    def zmqpull(self):
+        """
+        Client pulls the frames of receivers pushing them (rx_zmqsocket STREAM_PUSH, or rx_zmqpushport with STREAM_PUB_PUSH) instead of subscribing, sharing them with the other pulling clients. Default is disabled.
+        Frames of different modules pulled by one client need not belong to the same image. Also restarts client zmq streaming if enabled.
+        """
+        return self.getClientZmqPull()
+
+    @zmqpull.setter
+    def zmqpull(self, enable):
+        self.setClientZmqPull(enable)
+
     @property
     def rx_zmqhwm(self):
         """
@@ -1035,6 +1171,153 @@ class Detector(CppDetectorApi):
     def rx_zmqhwm(self, n_frames):
         self.setRxZmqHwm(n_frames)
 
+    @property
+    @element
+    def rx_zmqzerocopy(self):
+        """Receiver streams images without copying them into zmq messages, the fifo slot is freed once zmq has sent the image. Default is disabled. At most half of rx_fifodepth is held by zmq, further images are copied."""
+        return self.getRxZmqZeroCopy()
+
+    @rx_zmqzerocopy.setter
+    def rx_zmqzerocopy(self, enable):
+        ut.set_using_dict(self.setRxZmqZeroCopy, enable)
+
+    @property
+    @element
+    def rx_zmqbinaryheader(self):
+        """Receiver streams a fixed layout binary header instead of the json header. Default is disabled (json). Clients detect the format of each header."""
+        return self.getRxZmqBinaryHeader()
+
+    @rx_zmqbinaryheader.setter
+    def rx_zmqbinaryheader(self, enable):
+        ut.set_using_dict(self.setRxZmqBinaryHeader, enable)
+
+    @property
+    @element
+    def rx_zmqpreview(self):
+        """
+        Binning factor of the preview stream of the receiver. 
+        Note
+        -----
+        Each block of factor x factor pixels is one pixel, [1-64]. 0 disables it (default). \n
+        Streamed on rx_zmqpreviewport every rx_zmqpreviewtimer, independent of rx_zmqfreq. \n
+        Requires rx_zmqstream.
+        """
+        return self.getRxZmqPreview()
+
+    @rx_zmqpreview.setter
+    def rx_zmqpreview(self, factor):
+        ut.set_using_dict(self.setRxZmqPreview, factor)
+
+    @property
+    @element
+    def rx_zmqpreviewmode(self):
+        """
+        Preview stream mode of the receiver. Enum: previewMode
+        Note
+        -----
+        Options: PREVIEW_BIN, PREVIEW_MAX \n
+        Default: PREVIEW_BIN (sum of a block as 32 bit pixel) \n
+        PREVIEW_MAX keeps the largest pixel of a block and its dynamic range.
+
+        Example
+        --------
+        >>> d.rx_zmqpreviewmode = previewMode.PREVIEW_MAX
+        >>> d.rx_zmqpreviewmode
+        previewMode.PREVIEW_MAX
+        """
+        return self.getRxZmqPreviewMode()
+
+    @rx_zmqpreviewmode.setter
+    def rx_zmqpreviewmode(self, mode):
+        ut.set_using_dict(self.setRxZmqPreviewMode, mode)
+
+    @property
+    @element
+    def rx_zmqpreviewtimer(self):
+        """Time between two images of the preview stream in ms. Default is 200 ms."""
+        return self.getRxZmqPreviewTimer()
+
+    @rx_zmqpreviewtimer.setter
+    def rx_zmqpreviewtimer(self, time_in_ms):
+        ut.set_using_dict(self.setRxZmqPreviewTimer, time_in_ms)
+
+    @property
+    @element
+    def rx_zmqpreviewport(self):
+        """
+        Zmq port of the preview stream of the receiver. 
+        Note
+        -----
+        Default is 31001. \n
+        Must be different for every detector (and udp port). \n
+        Multi command will automatically increment for individual modules, use setRxZmqPreviewPort.
+        """
+        return self.getRxZmqPreviewPort()
+
+    @rx_zmqpreviewport.setter
+    def rx_zmqpreviewport(self, port):
+        if isinstance(port, int):
+            self.setRxZmqPreviewPort(port, -1)
+        elif isinstance(port, dict):
+            ut.set_using_dict(self.setRxZmqPreviewPort, port)
+        elif is_iterable(port):
+            for i, p in enumerate(port):
+                self.setRxZmqPreviewPort(p, i)
+        else:
+            raise ValueError("Unknown argument type")
+
+    @property
+    @element
+    def rx_zmqsocket(self):
+        """
+        Zmq socket type of the receiver streaming. Enum: streamingSocketType
+        Note
+        -----
+        Options: STREAM_PUB, STREAM_PUSH, STREAM_PUB_PUSH \n
+        Default: STREAM_PUB, every frame to every client \n
+        STREAM_PUSH pushes each frame to one of the pulling clients (load balanced), skipped if none can take it. \n
+        The end of acquisition header is published to every pulling client on the push port + 3000. A worker pulls the frames with a zmq pull socket and subscribes to that port for the end (zmqpull). \n
+        STREAM_PUB_PUSH publishes on rx_zmqport and pushes on rx_zmqpushport. \n
+        Also restarts receiver zmq streaming if enabled.
+
+        Example
+        --------
+        >>> d.rx_zmqsocket = streamingSocketType.STREAM_PUSH
+        >>> d.rx_zmqsocket
+        streamingSocketType.STREAM_PUSH
+        """
+        return self.getRxZmqSocketType()
+
+    @rx_zmqsocket.setter
+    def rx_zmqsocket(self, value):
+        ut.set_using_dict(self.setRxZmqSocketType, value)
+
+    @property
+    @element
+    def rx_zmqpushport(self):
+        """
+        Zmq port of the receiver pushing frames, if rx_zmqsocket is STREAM_PUB_PUSH. 
+        Note
+        -----
+        Default is 32001. \n
+        Also restarts receiver zmq streaming if enabled. \n
+        Must be different for every detector (and udp port). \n
+        Multi command will automatically increment for individual modules, use setRxZmqPushPort.
+        """
+        return self.getRxZmqPushPort()
+
+    @rx_zmqpushport.setter
+    def rx_zmqpushport(self, port):
+        if isinstance(port, int):
+            self.setRxZmqPushPort(port, -1)
+        elif isinstance(port, dict):
+            ut.set_using_dict(self.setRxZmqPushPort, port)
+        elif is_iterable(port):
+            for i, p in enumerate(port):
+                self.setRxZmqPushPort(p, i)
+        else:
+            raise ValueError("Unknown argument type")
+
     @property
     @element
     def udp_dstip(self):
@@ -1337,6 +1620,99 @@ class Detector(CppDetectorApi):
         """Gets actual udp socket buffer size. Double the size of rx_udpsocksize due to kernel bookkeeping."""
         return self.getRxRealUDPSocketBufferSize()
 
+    @property
+    @element
+    def rx_udpbatch(self):
+        """Number of udp packets the receiver reads per system call. Default is 32. 1 reads one packet per system call. Max is 1024."""
+        return self.getRxUDPBatchSize()
+
+    @rx_udpbatch.setter
+    def rx_udpbatch(self, n_packets):
+        ut.set_using_dict(self.setRxUDPBatchSize, n_packets)
+
+    @property
+    @element
+    def rx_udpzerocopy(self):
+        """Receive udp packet data directly into the fifo buffer. Default is disabled. When enabled, rx_udpbatch is ignored. Not applicable to Gotthard, Chip Test Board and Moench."""
+        return self.getRxUDPZeroCopy()
+
+    @rx_udpzerocopy.setter
+    def rx_udpzerocopy(self, enable):
+        ut.set_using_dict(self.setRxUDPZeroCopy, enable)
+
+    @property
+    @element
+    def rx_udpbackend(self):
+        """
+        Udp capture backend of receiver. Enum: udpBackend
+        Note
+        -----
+        Options: UDP_SOCKET, PACKET_RING \n
+        Default: UDP_SOCKET \n
+        PACKET_RING reads from an AF_PACKET memory mapped ring without a system call per packet. It requires CAP_NET_RAW for the receiver, else it falls back to UDP_SOCKET.
+
+        Example
+        --------
+        >>> d.rx_udpbackend = udpBackend.PACKET_RING
+        >>> d.rx_udpbackend
+        udpBackend.PACKET_RING
+        """
+        return self.getRxUDPBackend()
+
+    @rx_udpbackend.setter
+    def rx_udpbackend(self, backend):
+        ut.set_using_dict(self.setRxUDPBackend, backend)
+
+    @property
+    @element
+    def rx_udpthreads(self):
+        """Number of threads receiving packets from each udp port. Default is 1. Max is 16. Packets are distributed over the threads by frame number. Only with socket backend, without zero copy and not applicable to Gotthard, Chip Test Board and Moench."""
+        return self.getRxUDPThreads()
+
+    @rx_udpthreads.setter
+    def rx_udpthreads(self, n_threads):
+        ut.set_using_dict(self.setRxUDPThreads, n_threads)
+
+    @property
+    @element
+    def rx_framewindow(self):
+        """Number of frames the receiver assembles at the same time per udp port, to reorder packets across frames. Default is 1, where a packet of a later frame closes the frame. Max is 1024 and less than the fifo depth. Not applicable to Gotthard, Chip Test Board, Moench and with zero copy."""
+        return self.getRxFrameWindow()
+
+    @rx_framewindow.setter
+    def rx_framewindow(self, n_frames):
+        ut.set_using_dict(self.setRxFrameWindow, n_frames)
+
+    @property
+    @element
+    def rx_frametimeout(self):
+        """Time in us without udp packets, after which the receiver passes on a partial frame (or discards it according to rx_discardpolicy), instead of waiting for a packet of a later frame. Default is 0 (disabled)."""
+        return self.getRxFrameTimeout()
+
+    @rx_frametimeout.setter
+    def rx_frametimeout(self, timeout_us):
+        ut.set_using_dict(self.setRxFrameTimeout, timeout_us)
+
+    @property
+    @element
+    def rx_fifohugepages(self):
+        """Back the receiver fifo memory with huge pages to reduce TLB misses. Default is disabled. Uses reserved huge pages if available, else transparent huge pages."""
+        return self.getRxFifoHugePages()
+
+    @rx_fifohugepages.setter
+    def rx_fifohugepages(self, enable):
+        ut.set_using_dict(self.setRxFifoHugePages, enable)
+
+    @property
+    @element
+    def rx_fifomlock(self):
+        """Lock the receiver fifo memory in ram. Default is disabled. Requires a sufficient memlock limit (ulimit -l) for the receiver."""
+        return self.getRxFifoMemoryLock()
+
+    @rx_fifomlock.setter
+    def rx_fifomlock(self, enable):
+        ut.set_using_dict(self.setRxFifoMemoryLock, enable)
+
     @property
     def trimbits(self):
         """
@@ -1410,6 +1786,23 @@ class Detector(CppDetectorApi):
     def rx_zmqstartfnum(self, value):
         ut.set_using_dict(self.setRxZmqStartingFrame, value)
 
+    @property
+    @element
+    def rx_zmqbandwidth(self):
+        """
+        Bandwidth budget of the zmq stream of each receiver port in MB/s, for both sockets with rx_zmqsocket STREAM_PUB_PUSH.
+        Note
+        ----
+        Frames due by rx_zmqfreq/ rx_zmqtimer are skipped to stay within it, and more while frames pile up in the receiver or a pulling client cannot take one. \n
+        The streamed fraction is in the zmq header (streamedFraction). \n
+        Default is 0 (unlimited).
+        """
+        return self.getRxZmqBandwidth()
+
+    @rx_zmqbandwidth.setter
+    def rx_zmqbandwidth(self, value):
+        ut.set_using_dict(self.setRxZmqBandwidth, value)
+
     @property
     @element
     def lastclient(self):
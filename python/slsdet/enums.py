@@ -5,6 +5,12 @@ speedLevel = _slsdet.slsDetectorDefs.speedLevel
 detectorType = _slsdet.slsDetectorDefs.detectorType
 frameDiscardPolicy = _slsdet.slsDetectorDefs.frameDiscardPolicy
 fileFormat = _slsdet.slsDetectorDefs.fileFormat
+udpBackend = _slsdet.slsDetectorDefs.udpBackend
+fileCompression = _slsdet.slsDetectorDefs.fileCompression
+previewMode = _slsdet.slsDetectorDefs.previewMode
+streamingSocketType = _slsdet.slsDetectorDefs.streamingSocketType
+rxThreadType = _slsdet.slsDetectorDefs.rxThreadType
+rxSchedPolicy = _slsdet.slsDetectorDefs.rxSchedPolicy
 dimension = _slsdet.slsDetectorDefs.dimension
 externalSignalFlag = _slsdet.slsDetectorDefs.externalSignalFlag
 timingMode = _slsdet.slsDetectorDefs.timingMode
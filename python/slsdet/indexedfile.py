@@ -0,0 +1,122 @@
+"""
+Reader of the indexed binary files written by the receiver (fformat indexed).
+The file is memory mapped, images are numpy views and any frame is read
+without scanning the file.
+"""
+
+import numpy as np
+
+MAGIC = b'SLSINDEX'
+
+superblock_dt = np.dtype([
+    ('magic', 'S8'),
+    ('version', '<u4'),
+    ('pageSize', '<u4'),
+    ('headerSize', '<u4'),
+    ('dynamicRange', '<u4'),
+    ('nPixelsX', '<u4'),
+    ('nPixelsY', '<u4'),
+    ('complete', '<u4'),
+    ('reserved', '<u4'),
+    ('numFrames', '<u8'),
+    ('headerTableOffset', '<u8'),
+    ('directoryOffset', '<u8'),
+])
+
+header_dt = np.dtype([
+    ('frameNumber', '<u8'),
+    ('expLength', '<u4'),
+    ('packetNumber', '<u4'),
+    ('bunchId', '<u8'),
+    ('timestamp', '<u8'),
+    ('modId', '<u2'),
+    ('row', '<u2'),
+    ('column', '<u2'),
+    ('reserved', '<u2'),
+    ('debug', '<u4'),
+    ('roundRNumber', '<u2'),
+    ('detType', 'u1'),
+    ('version', 'u1'),
+    ('packetsMask', 'u1', (64,)),
+])
+
+entry_dt = np.dtype([
+    ('frameNumber', '<u8'),
+    ('record', '<u8'),
+    ('offset', '<u8'),
+    ('size', '<u8'),
+])
+
+_pixel_types = {8: np.uint8, 16: np.uint16, 32: np.uint32}
+
+
+class IndexedFile:
+    """
+    Indexed binary file of one port
+
+    Example
+    --------
+    f = IndexedFile('/data/run_d0_f0_0.raw')
+    image = f.frame(1234)   # by frame number
+    image = f[0]            # by position in the file
+    header = f.header(0)
+    """
+
+    def __init__(self, fname):
+        self._data = np.memmap(fname, dtype=np.uint8, mode='r')
+        sb = self._data[:superblock_dt.itemsize].view(superblock_dt)[0]
+        if sb['magic'] != MAGIC:
+            raise ValueError(f'{fname} is not an indexed binary file')
+        if not sb['complete']:
+            raise ValueError(f'{fname} was not closed by the receiver')
+        if sb['headerSize'] != header_dt.itemsize:
+            raise ValueError(f'Unknown receiver header in {fname}')
+        self.dynamic_range = int(sb['dynamicRange'])
+        self.shape = (int(sb['nPixelsY']), int(sb['nPixelsX']))
+        n = int(sb['numFrames'])
+        offset = int(sb['headerTableOffset'])
+        self.headers = self._data[offset:offset + n * header_dt.itemsize].view(
+            header_dt)
+        offset = int(sb['directoryOffset'])
+        self.directory = self._data[offset:offset +
+                                    n * entry_dt.itemsize].view(entry_dt)
+        # directory is sorted by frame number
+        self.frame_numbers = self.directory['frameNumber']
+
+    def __len__(self):
+        return len(self.directory)
+
+    def __getitem__(self, i):
+        """Image of the i-th frame in frame number order"""
+        return self._image(self.directory[i])
+
+    def _find(self, frame_number):
+        i = np.searchsorted(self.frame_numbers, frame_number)
+        if i == len(self) or self.frame_numbers[i] != frame_number:
+            raise KeyError(f'Frame {frame_number} not in file')
+        return i
+
+    def frame(self, frame_number):
+        """Image of a frame by its frame number"""
+        return self[self._find(frame_number)]
+
+    def frame_header(self, frame_number):
+        """Receiver header of a frame by its frame number"""
+        return self.headers[self.directory[self._find(frame_number)]['record']]
+
+    def header(self, i):
+        """Receiver header of the i-th frame written"""
+        return self.headers[i]
+
+    def _image(self, entry):
+        """Image as a view of the file, raw bytes if it is not a full image
+        of 8, 16 or 32 bit pixels"""
+        offset = int(entry['offset'])
+        data = self._data[offset:offset + int(entry['size'])]
+        dtype = _pixel_types.get(self.dynamic_range)
+        if dtype is None:
+            return data
+        pixels = self.shape[0] * self.shape[1]
+        if data.size != pixels * np.dtype(dtype).itemsize:
+            return data
+        return data.view(dtype).reshape(self.shape)
@@ -619,6 +619,80 @@ void init_det(py::module &m) {
              (Result<int>(Detector::*)(sls::Positions) const) &
                  Detector::getRxRealUDPSocketBufferSize,
              py::arg() = Positions{})
+        .def("getRxUDPBatchSize",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxUDPBatchSize,
+             py::arg() = Positions{})
+        .def("setRxUDPBatchSize",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxUDPBatchSize,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxUDPZeroCopy",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxUDPZeroCopy,
+             py::arg() = Positions{})
+        .def("setRxUDPZeroCopy",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setRxUDPZeroCopy,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxUDPBackend",
+             (Result<defs::udpBackend>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxUDPBackend,
+             py::arg() = Positions{})
+        .def("setRxUDPBackend",
+             (void (Detector::*)(defs::udpBackend, sls::Positions)) &
+                 Detector::setRxUDPBackend,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxUDPThreads",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxUDPThreads,
+             py::arg() = Positions{})
+        .def("setRxUDPThreads",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxUDPThreads,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxFrameWindow",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxFrameWindow,
+             py::arg() = Positions{})
+        .def("setRxFrameWindow",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxFrameWindow,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxFrameTimeout",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxFrameTimeout,
+             py::arg() = Positions{})
+        .def("setRxFrameTimeout",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxFrameTimeout,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxFifoHugePages",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxFifoHugePages,
+             py::arg() = Positions{})
+        .def("setRxFifoHugePages",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setRxFifoHugePages,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxFifoMemoryLock",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxFifoMemoryLock,
+             py::arg() = Positions{})
+        .def("setRxFifoMemoryLock",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setRxFifoMemoryLock,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxThreadAffinity",
+             (Result<defs::rxThreadAffinity>(Detector::*)(
+                 defs::rxThreadType, int, sls::Positions) const) &
+                 Detector::getRxThreadAffinity,
+             py::arg(), py::arg(), py::arg() = Positions{})
+        .def("setRxThreadAffinity",
+             (void (Detector::*)(const defs::rxThreadAffinity &,
+                                 sls::Positions)) &
+                 Detector::setRxThreadAffinity,
+             py::arg(), py::arg() = Positions{})
         .def("getRxLock",
              (Result<bool>(Detector::*)(sls::Positions)) & Detector::getRxLock,
              py::arg() = Positions{})
@@ -686,6 +760,95 @@ void init_det(py::module &m) {
              (void (Detector::*)(bool, sls::Positions)) &
                  Detector::setFileOverWrite,
              py::arg(), py::arg() = Positions{})
+        .def("getFileDirectIO",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getFileDirectIO,
+             py::arg() = Positions{})
+        .def("setFileDirectIO",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setFileDirectIO,
+             py::arg(), py::arg() = Positions{})
+        .def("getFileIoUring",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getFileIoUring,
+             py::arg() = Positions{})
+        .def("setFileIoUring",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setFileIoUring,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5ChunkFrames",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5ChunkFrames,
+             py::arg() = Positions{})
+        .def("setHdf5ChunkFrames",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setHdf5ChunkFrames,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5ChunkRows",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5ChunkRows,
+             py::arg() = Positions{})
+        .def("setHdf5ChunkRows",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setHdf5ChunkRows,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5CompoundHeader",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5CompoundHeader,
+             py::arg() = Positions{})
+        .def("setHdf5CompoundHeader",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setHdf5CompoundHeader,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5WriterProcess",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5WriterProcess,
+             py::arg() = Positions{})
+        .def("setHdf5WriterProcess",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setHdf5WriterProcess,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5Swmr",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5Swmr,
+             py::arg() = Positions{})
+        .def("setHdf5Swmr",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setHdf5Swmr,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5FlushFrames",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5FlushFrames,
+             py::arg() = Positions{})
+        .def("setHdf5FlushFrames",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setHdf5FlushFrames,
+             py::arg(), py::arg() = Positions{})
+        .def("getHdf5FlushTime",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getHdf5FlushTime,
+             py::arg() = Positions{})
+        .def("setHdf5FlushTime",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setHdf5FlushTime,
+             py::arg(), py::arg() = Positions{})
+        .def("getFileCompression",
+             (Result<defs::fileCompression>(Detector::*)(sls::Positions)
+                  const) &
+                 Detector::getFileCompression,
+             py::arg() = Positions{})
+        .def("setFileCompression",
+             (void (Detector::*)(defs::fileCompression, sls::Positions)) &
+                 Detector::setFileCompression,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxCompressionThreads",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxCompressionThreads,
+             py::arg() = Positions{})
+        .def("setRxCompressionThreads",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxCompressionThreads,
+             py::arg(), py::arg() = Positions{})
         .def("getFramesPerFile",
              (Result<int>(Detector::*)(sls::Positions) const) &
                  Detector::getFramesPerFile,
@@ -726,6 +889,14 @@ void init_det(py::module &m) {
              (void (Detector::*)(int, sls::Positions)) &
                  Detector::setRxZmqStartingFrame,
              py::arg(), py::arg() = Positions{})
+        .def("getRxZmqBandwidth",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqBandwidth,
+             py::arg() = Positions{})
+        .def("setRxZmqBandwidth",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxZmqBandwidth,
+             py::arg(), py::arg() = Positions{})
         .def("getRxZmqPort",
              (Result<int>(Detector::*)(sls::Positions) const) &
                  Detector::getRxZmqPort,
@@ -761,12 +932,80 @@ void init_det(py::module &m) {
         .def("setClientZmqHwm",
              (void (Detector::*)(const int)) & Detector::setClientZmqHwm,
              py::arg())
+        .def("getClientZmqPull",
+             (bool (Detector::*)() const) & Detector::getClientZmqPull)
+        .def("setClientZmqPull",
+             (void (Detector::*)(bool)) & Detector::setClientZmqPull,
+             py::arg())
         .def("getRxZmqHwm",
              (Result<int>(Detector::*)(sls::Positions) const) &
                  Detector::getRxZmqHwm,
              py::arg() = Positions{})
         .def("setRxZmqHwm",
              (void (Detector::*)(const int)) & Detector::setRxZmqHwm, py::arg())
+        .def("getRxZmqZeroCopy",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqZeroCopy,
+             py::arg() = Positions{})
+        .def("setRxZmqZeroCopy",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setRxZmqZeroCopy,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqBinaryHeader",
+             (Result<bool>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqBinaryHeader,
+             py::arg() = Positions{})
+        .def("setRxZmqBinaryHeader",
+             (void (Detector::*)(bool, sls::Positions)) &
+                 Detector::setRxZmqBinaryHeader,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqPreview",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqPreview,
+             py::arg() = Positions{})
+        .def("setRxZmqPreview",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxZmqPreview,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqPreviewMode",
+             (Result<defs::previewMode>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqPreviewMode,
+             py::arg() = Positions{})
+        .def("setRxZmqPreviewMode",
+             (void (Detector::*)(defs::previewMode, sls::Positions)) &
+                 Detector::setRxZmqPreviewMode,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqPreviewTimer",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqPreviewTimer,
+             py::arg() = Positions{})
+        .def("setRxZmqPreviewTimer",
+             (void (Detector::*)(int, sls::Positions)) &
+                 Detector::setRxZmqPreviewTimer,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqPreviewPort",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqPreviewPort,
+             py::arg() = Positions{})
+        .def("setRxZmqPreviewPort",
+             (void (Detector::*)(int, int)) & Detector::setRxZmqPreviewPort,
+             py::arg(), py::arg() = -1)
+        .def("getRxZmqSocketType",
+             (Result<defs::streamingSocketType>(Detector::*)(sls::Positions)
+                  const) &
+                 Detector::getRxZmqSocketType,
+             py::arg() = Positions{})
+        .def("setRxZmqSocketType",
+             (void (Detector::*)(defs::streamingSocketType, sls::Positions)) &
+                 Detector::setRxZmqSocketType,
+             py::arg(), py::arg() = Positions{})
+        .def("getRxZmqPushPort",
+             (Result<int>(Detector::*)(sls::Positions) const) &
+                 Detector::getRxZmqPushPort,
+             py::arg() = Positions{})
+        .def("setRxZmqPushPort",
+             (void (Detector::*)(int, int)) & Detector::setRxZmqPushPort,
+             py::arg(), py::arg() = -1)
         .def("getSubExptime",
              (Result<sls::ns>(Detector::*)(sls::Positions) const) &
                  Detector::getSubExptime,
@@ -16,6 +16,39 @@ void init_enums(py::module &m) {
     xy.def_readwrite("x", &slsDetectorDefs::xy::x);
     xy.def_readwrite("y", &slsDetectorDefs::xy::y);
 
+    py::class_<slsDetectorDefs::rxThreadAffinity> rxThreadAffinity(
+        m, "rxThreadAffinity");
+    rxThreadAffinity.def(py::init());
+    rxThreadAffinity.def(
+        py::init<slsDetectorDefs::rxThreadType, int>());
+    rxThreadAffinity.def_readwrite(
+        "thread", &slsDetectorDefs::rxThreadAffinity::thread);
+    rxThreadAffinity.def_readwrite(
+        "index", &slsDetectorDefs::rxThreadAffinity::index);
+    rxThreadAffinity.def_readwrite(
+        "policy", &slsDetectorDefs::rxThreadAffinity::policy);
+    rxThreadAffinity.def_readwrite(
+        "priority", &slsDetectorDefs::rxThreadAffinity::priority);
+    rxThreadAffinity.def_property(
+        "cpus",
+        [](const slsDetectorDefs::rxThreadAffinity &a) {
+            std::vector<int> cpus;
+            for (int i = 0; i < MAX_RX_CPUS; ++i) {
+                if (a.hasCpu(i))
+                    cpus.push_back(i);
+            }
+            return cpus;
+        },
+        [](slsDetectorDefs::rxThreadAffinity &a, const std::vector<int> &cpus) {
+            for (auto &m : a.cpuMask)
+                m = 0;
+            for (auto i : cpus) {
+                if (i < 0 || i >= MAX_RX_CPUS)
+                    throw py::value_error("Invalid cpu");
+                a.addCpu(i);
+            }
+        });
+
     py::enum_<slsDetectorDefs::detectorType>(Defs, "detectorType")
         .value("GENERIC", slsDetectorDefs::detectorType::GENERIC)
         .value("EIGER", slsDetectorDefs::detectorType::EIGER)
@@ -47,9 +80,66 @@ void init_enums(py::module &m) {
                slsDetectorDefs::frameDiscardPolicy::NUM_DISCARD_POLICIES)
         .export_values();
 
+    py::enum_<slsDetectorDefs::udpBackend>(Defs, "udpBackend")
+        .value("UDP_SOCKET", slsDetectorDefs::udpBackend::UDP_SOCKET)
+        .value("PACKET_RING", slsDetectorDefs::udpBackend::PACKET_RING)
+        .value("NUM_UDP_BACKENDS",
+               slsDetectorDefs::udpBackend::NUM_UDP_BACKENDS)
+        .export_values();
+
+    py::enum_<slsDetectorDefs::fileCompression>(Defs, "fileCompression")
+        .value("NO_COMPRESSION",
+               slsDetectorDefs::fileCompression::NO_COMPRESSION)
+        .value("BITSHUFFLE_LZ4",
+               slsDetectorDefs::fileCompression::BITSHUFFLE_LZ4)
+        .value("BITSHUFFLE_ZSTD",
+               slsDetectorDefs::fileCompression::BITSHUFFLE_ZSTD)
+        .value("NUM_FILE_COMPRESSIONS",
+               slsDetectorDefs::fileCompression::NUM_FILE_COMPRESSIONS)
+        .export_values();
+
+    py::enum_<slsDetectorDefs::previewMode>(Defs, "previewMode")
+        .value("PREVIEW_BIN", slsDetectorDefs::previewMode::PREVIEW_BIN)
+        .value("PREVIEW_MAX", slsDetectorDefs::previewMode::PREVIEW_MAX)
+        .value("NUM_PREVIEW_MODES",
+               slsDetectorDefs::previewMode::NUM_PREVIEW_MODES)
+        .export_values();
+
+    py::enum_<slsDetectorDefs::streamingSocketType>(Defs,
+                                                    "streamingSocketType")
+        .value("STREAM_PUB", slsDetectorDefs::streamingSocketType::STREAM_PUB)
+        .value("STREAM_PUSH",
+               slsDetectorDefs::streamingSocketType::STREAM_PUSH)
+        .value("STREAM_PUB_PUSH",
+               slsDetectorDefs::streamingSocketType::STREAM_PUB_PUSH)
+        .value("NUM_STREAMING_SOCKET_TYPES",
+               slsDetectorDefs::streamingSocketType::NUM_STREAMING_SOCKET_TYPES)
+        .export_values();
+
+    py::enum_<slsDetectorDefs::rxThreadType>(Defs, "rxThreadType")
+        .value("LISTENER_THREAD",
+               slsDetectorDefs::rxThreadType::LISTENER_THREAD)
+        .value("PROCESSOR_THREAD",
+               slsDetectorDefs::rxThreadType::PROCESSOR_THREAD)
+        .value("STREAMER_THREAD",
+               slsDetectorDefs::rxThreadType::STREAMER_THREAD)
+        .value("TCP_THREAD", slsDetectorDefs::rxThreadType::TCP_THREAD)
+        .value("WRITER_THREAD", slsDetectorDefs::rxThreadType::WRITER_THREAD)
+        .value("NUM_RX_THREAD_TYPES",
+               slsDetectorDefs::rxThreadType::NUM_RX_THREAD_TYPES)
+        .export_values();
+
+    py::enum_<slsDetectorDefs::rxSchedPolicy>(Defs, "rxSchedPolicy")
+        .value("RX_SCHED_OTHER", slsDetectorDefs::rxSchedPolicy::RX_SCHED_OTHER)
+        .value("RX_SCHED_FIFO", slsDetectorDefs::rxSchedPolicy::RX_SCHED_FIFO)
+        .value("NUM_RX_SCHED_POLICIES",
+               slsDetectorDefs::rxSchedPolicy::NUM_RX_SCHED_POLICIES)
+        .export_values();
+
     py::enum_<slsDetectorDefs::fileFormat>(Defs, "fileFormat")
         .value("BINARY", slsDetectorDefs::fileFormat::BINARY)
         .value("HDF5", slsDetectorDefs::fileFormat::HDF5)
+        .value("INDEXED", slsDetectorDefs::fileFormat::INDEXED)
         .value("NUM_FILE_FORMATS",
                slsDetectorDefs::fileFormat::NUM_FILE_FORMATS)
         .export_values();
@@ -13,6 +13,39 @@ void init_enums(py::module &m) {
     xy.def_readwrite("x", &slsDetectorDefs::xy::x);
     xy.def_readwrite("y", &slsDetectorDefs::xy::y);
 
+    py::class_<slsDetectorDefs::rxThreadAffinity> rxThreadAffinity(
+        m, "rxThreadAffinity");
+    rxThreadAffinity.def(py::init());
+    rxThreadAffinity.def(
+        py::init<slsDetectorDefs::rxThreadType, int>());
+    rxThreadAffinity.def_readwrite(
+        "thread", &slsDetectorDefs::rxThreadAffinity::thread);
+    rxThreadAffinity.def_readwrite(
+        "index", &slsDetectorDefs::rxThreadAffinity::index);
+    rxThreadAffinity.def_readwrite(
+        "policy", &slsDetectorDefs::rxThreadAffinity::policy);
+    rxThreadAffinity.def_readwrite(
+        "priority", &slsDetectorDefs::rxThreadAffinity::priority);
+    rxThreadAffinity.def_property(
+        "cpus",
+        [](const slsDetectorDefs::rxThreadAffinity &a) {
+            std::vector<int> cpus;
+            for (int i = 0; i < MAX_RX_CPUS; ++i) {
+                if (a.hasCpu(i))
+                    cpus.push_back(i);
+            }
+            return cpus;
+        },
+        [](slsDetectorDefs::rxThreadAffinity &a, const std::vector<int> &cpus) {
+            for (auto &m : a.cpuMask)
+                m = 0;
+            for (auto i : cpus) {
+                if (i < 0 || i >= MAX_RX_CPUS)
+                    throw py::value_error("Invalid cpu");
+                a.addCpu(i);
+            }
+        });
+
 [[ENUMS]]
 
 }
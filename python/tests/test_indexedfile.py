@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Testing the reader of indexed binary files
+"""
+
+import numpy as np
+import pytest
+from slsdet.indexedfile import (IndexedFile, superblock_dt, header_dt,
+                                entry_dt)
+
+
+def write_file(path, frame_numbers, nx=4, ny=2, complete=1):
+    """Indexed file of 16 bit images as written by the receiver, frames
+    written in the given order"""
+    page = 4096
+    data = bytearray(page)
+    headers = np.zeros(len(frame_numbers), dtype=header_dt)
+    entries = np.zeros(len(frame_numbers), dtype=entry_dt)
+    for i, fnum in enumerate(frame_numbers):
+        image = np.arange(nx * ny, dtype=np.uint16) + fnum
+        headers[i]['frameNumber'] = fnum
+        headers[i]['row'] = i
+        entries[i] = (fnum, i, len(data), image.nbytes)
+        data += image.tobytes()
+        data += bytes(-len(data) % page)
+    sb = np.zeros(1, dtype=superblock_dt)
+    sb[0] = (b'SLSINDEX', 1, page, header_dt.itemsize, 16, nx, ny, complete,
+             0, len(frame_numbers), len(data),
+             len(data) + headers.nbytes)
+    data += headers.tobytes()
+    data += np.sort(entries, order='frameNumber').tobytes()
+    data[:superblock_dt.itemsize] = sb.tobytes()
+    path.write_bytes(bytes(data))
+
+
+def test_header_sizes_match_the_receiver():
+    assert superblock_dt.itemsize == 64
+    assert header_dt.itemsize == 112
+    assert entry_dt.itemsize == 32
+
+
+def test_frames_read_by_frame_number(tmp_path):
+    fname = tmp_path / 'run_d0_f0_0.raw'
+    write_file(fname, [12, 10, 11])
+    f = IndexedFile(fname)
+    assert len(f) == 3
+    assert list(f.frame_numbers) == [10, 11, 12]
+    image = f.frame(12)
+    assert image.shape == (2, 4)
+    assert image[0, 0] == 12
+    assert f.frame_header(12)['row'] == 0
+    assert f.header(1)['frameNumber'] == 10
+    assert f[0][1, 3] == 10 + 7
+    with pytest.raises(KeyError):
+        f.frame(13)
+
+
+def test_file_not_closed_is_refused(tmp_path):
+    fname = tmp_path / 'run_d0_f0_0.raw'
+    write_file(fname, [0], complete=0)
+    with pytest.raises(ValueError):
+        IndexedFile(fname)
@@ -67,7 +67,7 @@ int main(int argc, char *argv[]) {
   int nSubPixelsY=2;
 	// help
   if (argc < 3 ) {
-    cprintf(RED, "Help: ./trial [receive socket ip] [receive starting port number] [send_socket ip] [send starting port number] [nthreads] [nsubpix] [gainmap]  [etafile]\n");
+    cprintf(RED, "Help: ./trial [receive socket ip] [receive starting port number] [send_socket ip] [send starting port number] [nthreads] [nsubpix] [gainmap]  [etafile] [pull]\n");
     return EXIT_FAILURE;  
   }
   
@@ -133,6 +133,13 @@ int main(int argc, char *argv[]) {
     cout << "Eta file name is: " << etafname << endl;
   }
 
+  // pull frames shared with other workers (receiver rx_zmqsocket push)
+  bool pull=false;
+  if (argc>9) {
+    pull=atoi(argv[9]);
+    cout << "Pull from a push server: " << pull << endl;
+  }
+
   //slsDetectorData *det=new moench03T1ZmqDataNew(); 
 #ifndef MOENCH04
   moench03T1ZmqDataNew *det=new moench03T1ZmqDataNew(); 
@@ -221,7 +228,7 @@ int main(int argc, char *argv[]) {
   try{
 #endif
     
-    zmqsocket = new ZmqSocket(socketip,portnum); 
+    zmqsocket = new ZmqSocket(socketip,portnum,pull); 
     
 
 #ifdef NEWZMQ
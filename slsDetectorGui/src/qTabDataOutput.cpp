@@ -227,6 +227,7 @@ void qTabDataOutput::GetFileFormat() {
         switch (retval) {
         case slsDetectorDefs::BINARY:
         case slsDetectorDefs::HDF5:
+        case slsDetectorDefs::INDEXED:
             comboFileFormat->setCurrentIndex(static_cast<int>(retval));
             break;
         default:
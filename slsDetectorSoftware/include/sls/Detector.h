@@ -739,6 +739,93 @@ class Detector {
      */
     Result<int> getRxRealUDPSocketBufferSize(Positions pos = {}) const;
 
+    Result<int> getRxUDPBatchSize(Positions pos = {}) const;
+
+    /** Number of udp packets the receiver reads per system call (recvmmsg).
+     * \n Default is 32. 1 reads one packet per system call. Max is 1024. */
+    void setRxUDPBatchSize(int n_packets, Positions pos = {});
+
+    Result<bool> getRxUDPZeroCopy(Positions pos = {}) const;
+
+    /** Receive udp packet data directly into the fifo buffer, avoiding a copy
+     * per packet. Default is disabled. \n When enabled, one packet is read per
+     * system call and rx_udpbatch is ignored. \n Not applicable to Gotthard,
+     * Chip Test Board and Moench. */
+    void setRxUDPZeroCopy(bool enable, Positions pos = {});
+
+    Result<defs::udpBackend> getRxUDPBackend(Positions pos = {}) const;
+
+    /**
+     * Options: UDP_SOCKET, PACKET_RING
+     * Default: UDP_SOCKET
+     * PACKET_RING reads the udp packets from an AF_PACKET memory mapped ring
+     * without a system call per packet. It requires CAP_NET_RAW for the
+     * receiver, else the receiver falls back to UDP_SOCKET.
+     */
+    void setRxUDPBackend(defs::udpBackend b, Positions pos = {});
+
+    Result<int> getRxUDPThreads(Positions pos = {}) const;
+
+    /** Number of threads receiving packets from each udp port. \n Default
+     * is 1. Max is 16. More than 1 binds a socket per thread to the port
+     * (SO_REUSEPORT) and distributes packets over them by frame number. \n
+     * Only with the udp socket backend, without zero copy and for detectors
+     * with the standard packet header (not Chip Test Board and Moench). */
+    void setRxUDPThreads(int n_threads, Positions pos = {});
+
+    Result<int> getRxFrameWindow(Positions pos = {}) const;
+
+    /** Number of frames the receiver assembles at the same time per udp
+     * port, each in its own fifo buffer, to reorder packets across frames.
+     * Frames are passed on in order once complete or when the window slides.
+     * \n Default is 1, where a packet of a later frame closes the frame. Max
+     * is 1024 and less than the fifo depth. \n Not applicable to Gotthard,
+     * Chip Test Board, Moench and with zero copy. */
+    void setRxFrameWindow(int n_frames, Positions pos = {});
+
+    Result<int> getRxFrameTimeout(Positions pos = {}) const;
+
+    /** Time in us without udp packets, after which the receiver passes on
+     * a partial frame (or discards it according to the frame discard
+     * policy), instead of waiting for a packet of a later frame. \n Default
+     * is 0 (disabled). With the packet ring backend, packets are handed over
+     * at least every 8 ms. */
+    void setRxFrameTimeout(int timeout_us, Positions pos = {});
+
+    Result<bool> getRxFifoHugePages(Positions pos = {}) const;
+
+    /** Default: disabled
+     * Back the receiver fifo memory with huge pages to reduce TLB misses.
+     * Uses reserved huge pages (vm.nr_hugepages) if available, else
+     * transparent huge pages. Reallocates the fifo.
+     */
+    void setRxFifoHugePages(bool enable, Positions pos = {});
+
+    Result<bool> getRxFifoMemoryLock(Positions pos = {}) const;
+
+    /** Default: disabled
+     * Lock the receiver fifo memory in ram, so that it is never paged out.
+     * Requires a sufficient memlock limit (ulimit -l) for the receiver.
+     * Reallocates the fifo.
+     */
+    void setRxFifoMemoryLock(bool enable, Positions pos = {});
+
+    /** index is the udp interface index, 0 for the tcp thread */
+    Result<defs::rxThreadAffinity>
+    getRxThreadAffinity(defs::rxThreadType type, int index,
+                        Positions pos = {}) const;
+
+    /** Pins a receiver thread (listener, processor, streamer, file writer or
+     * tcp) to the cpus of a.cpuMask (none for any cpu of the receiver
+     * process) and sets its scheduling policy and priority (fifo [1-99],
+     * other [0]).
+     * Default: listeners fifo 90, others other 0, any cpu.
+     * Kept when the threads are created again, eg. on changing number of
+     * udp interfaces or enabling data streaming.
+     */
+    void setRxThreadAffinity(const defs::rxThreadAffinity &a,
+                             Positions pos = {});
+
     Result<bool> getRxLock(Positions pos = {});
 
     /** Lock receiver to one client IP, 1 locks, 0 unlocks. Default is unlocked.
@@ -765,7 +852,8 @@ class Detector {
     Result<defs::fileFormat> getFileFormat(Positions pos = {}) const;
 
     /** default binary, Options: BINARY, HDF5 (library must be compiled with
-     * this option) */
+     * this option), INDEXED (binary with page aligned images, a header table
+     * and a frame directory, at most 100000 frames per file) */
     void setFileFormat(defs::fileFormat f, Positions pos = {});
 
     Result<std::string> getFilePath(Positions pos = {}) const;
@@ -804,6 +892,111 @@ class Detector {
     /** default overwites */
     void setFileOverWrite(bool value, Positions pos = {});
 
+    Result<bool> getFileDirectIO(Positions pos = {}) const;
+
+    /** Default: disabled
+     * Write binary files with direct io (O_DIRECT), bypassing the page
+     * cache. Images are coalesced into large aligned buffers, flushed by a
+     * background thread. Falls back to buffered io if the file system does
+     * not support it. The file format is unchanged.
+     */
+    void setFileDirectIO(bool value, Positions pos = {});
+
+    Result<bool> getFileIoUring(Positions pos = {}) const;
+
+    /** Default: disabled
+     * Write binary files asynchronously with io_uring, straight from the
+     * receiver fifo buffers, which are only released once written. Falls
+     * back to the other binary writers if the kernel does not support it.
+     * The file format is unchanged.
+     */
+    void setFileIoUring(bool value, Positions pos = {});
+
+    Result<int> getHdf5ChunkFrames(Positions pos = {}) const;
+
+    /** [HDF5] Default: 1
+     * Number of images per chunk of the data dataset. Images are gathered
+     * and written as whole chunks, directly (H5Dwrite_chunk). \n At most
+     * rx_framesperfile and a chunk below 4 GiB for the current image size.
+     */
+    void setHdf5ChunkFrames(int value, Positions pos = {});
+
+    Result<int> getHdf5ChunkRows(Positions pos = {}) const;
+
+    /** [HDF5] Default: 0
+     * Number of rows per chunk of the data dataset, to tile the images.
+     * 0 for the whole image.
+     */
+    void setHdf5ChunkRows(int value, Positions pos = {});
+
+    Result<bool> getHdf5CompoundHeader(Positions pos = {}) const;
+
+    /** [HDF5] Default: disabled
+     * Write the receiver header of each image to one compound dataset
+     * "header" (a member per parameter), instead of a dataset per
+     * parameter. Headers are written in blocks of fchunkframes images.
+     */
+    void setHdf5CompoundHeader(bool value, Positions pos = {});
+
+    Result<bool> getHdf5WriterProcess(Positions pos = {}) const;
+
+    /** [HDF5] Default: disabled
+     * Write the data file of each port in its own writer process, so that
+     * ports write in parallel instead of taking turns on the hdf5 library.
+     * The master and virtual file are still written by the receiver.
+     * Reallocates the fifo as shared memory. The writer processes run
+     * slsHdf5Writer, found next to the receiver or in PATH.
+     */
+    void setHdf5WriterProcess(bool value, Positions pos = {});
+
+    Result<bool> getHdf5Swmr(Positions pos = {}) const;
+
+    /** [HDF5] Default: disabled
+     * Write the data files in single writer multiple reader mode, so that
+     * they can be read while the acquisition runs. The datasets grow with
+     * the images and are flushed to readers every fflushframes images or
+     * fflushtime ms. With one file per port (rx_framesperfile 0), the
+     * virtual file is created at start and grows with them.
+     */
+    void setHdf5Swmr(bool value, Positions pos = {});
+
+    Result<int> getHdf5FlushFrames(Positions pos = {}) const;
+
+    /** [HDF5] Default: 100
+     * Number of images between flushes to readers in swmr mode, 0 for none.
+     */
+    void setHdf5FlushFrames(int value, Positions pos = {});
+
+    Result<int> getHdf5FlushTime(Positions pos = {}) const;
+
+    /** [HDF5] Default: 1000
+     * Time in ms between flushes to readers in swmr mode, 0 for none.
+     * Checked as images are written.
+     */
+    void setHdf5FlushTime(int value, Positions pos = {});
+
+    Result<defs::fileCompression> getFileCompression(Positions pos = {}) const;
+
+    /**
+     * Options: NO_COMPRESSION, BITSHUFFLE_LZ4, BITSHUFFLE_ZSTD
+     * Default: NO_COMPRESSION
+     * Blocks of 8 kB of each image are bit shuffled and compressed with LZ4
+     * or zstd, over rx_compressionthreads threads. [HDF5] Chunks are
+     * written with the bitshuffle filter (32008). [Binary] Each frame is
+     * written as receiver header, compressed size (8 bytes) and compressed
+     * image, followed by an index of the frame offsets at the end of the
+     * file. Requires a receiver built with SLS_USE_COMPRESSION.
+     */
+    void setFileCompression(defs::fileCompression value, Positions pos = {});
+
+    Result<int> getRxCompressionThreads(Positions pos = {}) const;
+
+    /** Default: 4
+     * Number of threads compressing the blocks of the images of all ports,
+     * besides the file writer thread of each port. Max is 64.
+     */
+    void setRxCompressionThreads(int value, Positions pos = {});
+
     Result<int> getFramesPerFile(Positions pos = {}) const;
 
     /** Default depends on detector type. \n 0 will set frames per file in an
@@ -858,6 +1051,17 @@ class Detector {
      */
     void setRxZmqStartingFrame(int fnum, Positions pos = {});
 
+    Result<int> getRxZmqBandwidth(Positions pos = {}) const;
+
+    /**
+     * Bandwidth budget of the zmq stream of each receiver port in MB/s, for
+     * both sockets with STREAM_PUB_PUSH. Frames due by the rx zmq frequency/
+     * timer are skipped to stay within it, and more while frames pile up in
+     * the receiver or a pulling client cannot take one. The streamed fraction
+     * is in the zmq header. Default is 0 (unlimited).
+     */
+    void setRxZmqBandwidth(int mbps, Positions pos = {});
+
     Result<int> getRxZmqPort(Positions pos = {}) const;
 
     /** Zmq port for data to be streamed out of the receiver. \n
@@ -907,6 +1111,16 @@ class Detector {
      */
     void setClientZmqHwm(const int limit);
 
+    bool getClientZmqPull() const;
+
+    /** Client pulls the frames of receivers pushing them (rx_zmqsocket push,
+     * or rx_zmqpushport with pubpush) instead of subscribing, sharing them
+     * with the other pulling clients. Default is disabled. \n Frames of
+     * different modules pulled by one client need not belong to the same
+     * image. Also restarts client zmq streaming if enabled.
+     */
+    void setClientZmqPull(bool enable);
+
     Result<int> getRxZmqHwm(Positions pos = {}) const;
 
     /** Receiver's zmq send high water mark. \n Default is the zmq library's
@@ -917,6 +1131,81 @@ class Detector {
      */
     void setRxZmqHwm(const int limit);
 
+    Result<bool> getRxZmqZeroCopy(Positions pos = {}) const;
+
+    /** Receiver streams the images without copying them into zmq messages.
+     * The fifo slot is freed only once zmq has sent the image. Default is
+     * disabled. \n At most half of rx_fifodepth can be held by zmq, further
+     * images are copied. Not for Gotthard with roi.
+     */
+    void setRxZmqZeroCopy(bool enable, Positions pos = {});
+
+    Result<bool> getRxZmqBinaryHeader(Positions pos = {}) const;
+
+    /** Receiver streams a fixed layout binary header instead of the json
+     * header. Default is disabled (json). \n The client and other receivers
+     * of the stream detect the format of each header.
+     */
+    void setRxZmqBinaryHeader(bool enable, Positions pos = {});
+
+    Result<int> getRxZmqPreview(Positions pos = {}) const;
+
+    /** Receiver streams a binned preview of the images on its own zmq port.
+     * \n The value is the binning factor [1-64], each block of factor x
+     * factor pixels becomes one pixel. 0 disables it (default). \n Requires
+     * rx_zmqstream. The preview is sent every rx_zmqpreviewtimer,
+     * independent of rx_zmqfreq.
+     */
+    void setRxZmqPreview(int factor, Positions pos = {});
+
+    Result<defs::previewMode> getRxZmqPreviewMode(Positions pos = {}) const;
+
+    /** [PREVIEW_BIN, PREVIEW_MAX] \n PREVIEW_BIN (default) sums the pixels of
+     * a block into a 32 bit pixel, PREVIEW_MAX keeps the largest pixel of a
+     * block and its dynamic range. \n For 16 bit images the jungfrau gain
+     * bits of a block are or-ed into the top bits of the binned pixel.
+     */
+    void setRxZmqPreviewMode(defs::previewMode mode, Positions pos = {});
+
+    Result<int> getRxZmqPreviewTimer(Positions pos = {}) const;
+
+    /** Time between two preview images in ms. Default is 200 ms. */
+    void setRxZmqPreviewTimer(int time_in_ms, Positions pos = {});
+
+    Result<int> getRxZmqPreviewPort(Positions pos = {}) const;
+
+    /** Zmq port for the preview stream of the receiver. Default is 31001. \n
+     * Must be different for every detector (and udp port). \n module_id is
+     * -1 for all detectors, ports for each module is calculated (increment by
+     * 1 if no 2nd interface).
+     */
+    void setRxZmqPreviewPort(int port, int module_id = -1);
+
+    Result<defs::streamingSocketType>
+    getRxZmqSocketType(Positions pos = {}) const;
+
+    /** [STREAM_PUB, STREAM_PUSH, STREAM_PUB_PUSH] \n STREAM_PUB (default)
+     * publishes every frame to every client. STREAM_PUSH pushes each frame to
+     * one of the pulling clients (load balanced, eg. a pool of analysis
+     * workers). A frame is skipped if none of them can take it. The end of
+     * acquisition header is published to every pulling client on the push
+     * port + 3000. A worker pulls the frames with a zmq pull socket and
+     * subscribes to that port for the end (zmqpull). STREAM_PUB_PUSH
+     * publishes on rx_zmqport and pushes on rx_zmqpushport. \n Also restarts
+     * receiver zmq streaming if enabled.
+     */
+    void setRxZmqSocketType(defs::streamingSocketType type, Positions pos = {});
+
+    Result<int> getRxZmqPushPort(Positions pos = {}) const;
+
+    /** Zmq port of the receiver pushing frames, if rx_zmqsocket is
+     * STREAM_PUB_PUSH. Default is 32001. \n Must be different for every
+     * detector (and udp port). \n module_id is -1 for all detectors, ports
+     * for each module is calculated (increment by 1 if no 2nd interface). \n
+     * Also restarts receiver zmq streaming if enabled.
+     */
+    void setRxZmqPushPort(int port, int module_id = -1);
+
     ///@{
 
     /** @name Eiger Specific */
@@ -1227,6 +1227,65 @@ std::string CmdProxy::ReceiverHostname(int action) {
     }
     return os.str();
 }
+
+std::string CmdProxy::ReceiverThreadAffinity(int action) {
+    std::ostringstream os;
+    os << cmd << ' ';
+    if (action == defs::HELP_ACTION) {
+        os << "[listener|processor|streamer|writer|tcp] [udp interface "
+              "index] \n\t[listener|processor|streamer|writer|tcp] [udp "
+              "interface index] "
+              "[cpu list|all] [other|fifo] [priority]\n\tCpu affinity and "
+              "scheduling policy of a receiver thread. Udp interface index is "
+              "0 for the tcp thread. Cpu list is eg. 0-3,8, all for any cpu "
+              "of the receiver process. Priority is 1-99 for fifo and 0 (can "
+              "be left out) for other. Default is fifo 90 for listeners, other "
+              "for the rest, on any cpu. Kept when the receiver threads are "
+              "created again."
+           << '\n';
+    } else if (action == defs::GET_ACTION) {
+        if (args.size() != 2) {
+            WrongNumberOfParameters(2);
+        }
+        auto t = det->getRxThreadAffinity(
+            StringTo<defs::rxThreadType>(args[0]), StringTo<int>(args[1]),
+            std::vector<int>{det_id});
+        os << OutString(t) << '\n';
+    } else if (action == defs::PUT_ACTION) {
+        if (args.size() != 4 && args.size() != 5) {
+            WrongNumberOfParameters(5);
+        }
+        defs::rxThreadAffinity a(StringTo<defs::rxThreadType>(args[0]),
+                                 StringTo<int>(args[1]));
+        if (args[2] != "all") {
+            for (const auto &range : sls::split(args[2], ',')) {
+                auto limits = sls::split(range, '-');
+                if (limits.empty() || limits.size() > 2) {
+                    throw sls::RuntimeError("Invalid cpu list " + args[2]);
+                }
+                int first = StringTo<int>(limits[0]);
+                int last = StringTo<int>(limits.back());
+                if (first < 0 || last >= MAX_RX_CPUS || first > last) {
+                    throw sls::RuntimeError(
+                        "Invalid cpu list " + args[2] + ". Cpus must be 0-" +
+                        std::to_string(MAX_RX_CPUS - 1));
+                }
+                for (int i = first; i <= last; ++i) {
+                    a.addCpu(i);
+                }
+            }
+        }
+        a.policy = StringTo<defs::rxSchedPolicy>(args[3]);
+        if (args.size() == 5) {
+            a.priority = StringTo<int>(args[4]);
+        }
+        det->setRxThreadAffinity(a, std::vector<int>{det_id});
+        os << ToString(args) << '\n';
+    } else {
+        throw sls::RuntimeError("Unknown action");
+    }
+    return os.str();
+}
 /* File */
 
 /* ZMQ Streaming Parameters (Receiver<->Client) */
@@ -882,6 +882,15 @@ class CmdProxy {
         {"rx_discardpolicy", &CmdProxy::rx_discardpolicy},
         {"rx_padding", &CmdProxy::rx_padding},
         {"rx_udpsocksize", &CmdProxy::rx_udpsocksize},
+        {"rx_udpbatch", &CmdProxy::rx_udpbatch},
+        {"rx_udpzerocopy", &CmdProxy::rx_udpzerocopy},
+        {"rx_udpbackend", &CmdProxy::rx_udpbackend},
+        {"rx_udpthreads", &CmdProxy::rx_udpthreads},
+        {"rx_framewindow", &CmdProxy::rx_framewindow},
+        {"rx_frametimeout", &CmdProxy::rx_frametimeout},
+        {"rx_fifohugepages", &CmdProxy::rx_fifohugepages},
+        {"rx_fifomlock", &CmdProxy::rx_fifomlock},
+        {"rx_threadaffinity", &CmdProxy::ReceiverThreadAffinity},
         {"rx_realudpsocksize", &CmdProxy::rx_realudpsocksize},
         {"rx_lock", &CmdProxy::rx_lock},
         {"rx_lastclient", &CmdProxy::rx_lastclient},
@@ -895,18 +904,39 @@ class CmdProxy {
         {"fwrite", &CmdProxy::fwrite},
         {"fmaster", &CmdProxy::fmaster},
         {"foverwrite", &CmdProxy::foverwrite},
+        {"fdirectio", &CmdProxy::fdirectio},
+        {"fiouring", &CmdProxy::fiouring},
+        {"fchunkframes", &CmdProxy::fchunkframes},
+        {"fchunkrows", &CmdProxy::fchunkrows},
+        {"fcompoundheader", &CmdProxy::fcompoundheader},
+        {"fh5process", &CmdProxy::fh5process},
+        {"fswmr", &CmdProxy::fswmr},
+        {"fflushframes", &CmdProxy::fflushframes},
+        {"fflushtime", &CmdProxy::fflushtime},
+        {"fcompression", &CmdProxy::fcompression},
+        {"rx_compressionthreads", &CmdProxy::rx_compressionthreads},
         {"rx_framesperfile", &CmdProxy::rx_framesperfile},
 
         /* ZMQ Streaming Parameters (Receiver<->Client) */
         {"rx_zmqstream", &CmdProxy::rx_zmqstream},
         {"rx_zmqfreq", &CmdProxy::rx_zmqfreq},
         {"rx_zmqstartfnum", &CmdProxy::rx_zmqstartfnum},
+        {"rx_zmqbandwidth", &CmdProxy::rx_zmqbandwidth},
         {"rx_zmqport", &CmdProxy::rx_zmqport},
         {"zmqport", &CmdProxy::zmqport},
         {"rx_zmqip", &CmdProxy::rx_zmqip},
         {"zmqip", &CmdProxy::zmqip},
         {"zmqhwm", &CmdProxy::ZMQHWM},
+        {"zmqpull", &CmdProxy::zmqpull},
         {"rx_zmqhwm", &CmdProxy::rx_zmqhwm},
+        {"rx_zmqzerocopy", &CmdProxy::rx_zmqzerocopy},
+        {"rx_zmqbinaryheader", &CmdProxy::rx_zmqbinaryheader},
+        {"rx_zmqpreview", &CmdProxy::rx_zmqpreview},
+        {"rx_zmqpreviewmode", &CmdProxy::rx_zmqpreviewmode},
+        {"rx_zmqpreviewtimer", &CmdProxy::rx_zmqpreviewtimer},
+        {"rx_zmqpreviewport", &CmdProxy::rx_zmqpreviewport},
+        {"rx_zmqsocket", &CmdProxy::rx_zmqsocket},
+        {"rx_zmqpushport", &CmdProxy::rx_zmqpushport},
 
         /* Eiger Specific */
         {"subexptime", &CmdProxy::subexptime},
@@ -1108,6 +1138,7 @@ class CmdProxy {
     std::string UDPDestinationIP2(int action);
     /* Receiver Config */
     std::string ReceiverHostname(int action);
+    std::string ReceiverThreadAffinity(int action);
     /* File */
     /* ZMQ Streaming Parameters (Receiver<->Client) */
     std::string ZMQHWM(int action);
@@ -1639,6 +1670,62 @@ class CmdProxy {
                 "\n\tActual udp socket buffer size. Double the size of "
                 "rx_udpsocksize due to kernel bookkeeping.");
 
+    INTEGER_COMMAND_VEC_ID(
+        rx_udpbatch, getRxUDPBatchSize, setRxUDPBatchSize, StringTo<int>,
+        "[n_packets]\n\tNumber of udp packets the receiver reads per system "
+        "call. Default is 32. 1 reads one packet per system call. Max is "
+        "1024.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_udpzerocopy, getRxUDPZeroCopy, setRxUDPZeroCopy, StringTo<int>,
+        "[0, 1]\n\tReceive udp packet data directly into the fifo buffer. "
+        "Default is disabled. When enabled, rx_udpbatch is ignored. Not "
+        "applicable to Gotthard, Chip Test Board and Moench.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_udpbackend, getRxUDPBackend, setRxUDPBackend,
+        sls::StringTo<slsDetectorDefs::udpBackend>,
+        "[socket (default)|ring]\n\tUdp capture backend of receiver. socket "
+        "reads from a bound udp socket, ring reads from an AF_PACKET memory "
+        "mapped ring without a system call per packet. ring requires "
+        "CAP_NET_RAW for the receiver, else it falls back to socket.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_udpthreads, getRxUDPThreads, setRxUDPThreads, StringTo<int>,
+        "[n_threads]\n\tNumber of threads receiving packets from each udp "
+        "port. Default is 1. Max is 16. Packets are distributed over the "
+        "threads by frame number. Only with socket backend, without zero copy "
+        "and not applicable to Gotthard, Chip Test Board and Moench.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_framewindow, getRxFrameWindow, setRxFrameWindow, StringTo<int>,
+        "[n_frames]\n\tNumber of frames the receiver assembles at the same "
+        "time per udp port, to reorder packets across frames. Frames are "
+        "passed on in order once complete or when the window slides. Default "
+        "is 1, where a packet of a later frame closes the frame. Max is 1024 "
+        "and less than the fifo depth. Not applicable to Gotthard, Chip Test "
+        "Board, Moench and with zero copy.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_frametimeout, getRxFrameTimeout, setRxFrameTimeout, StringTo<int>,
+        "[timeout_us]\n\tTime in us without udp packets, after which the "
+        "receiver passes on a partial frame (or discards it according to "
+        "rx_discardpolicy), instead of waiting for a packet of a later "
+        "frame. Default is 0 (disabled).");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_fifohugepages, getRxFifoHugePages, setRxFifoHugePages,
+        StringTo<int>,
+        "[0, 1]\n\tBack the receiver fifo memory with huge pages. Default is "
+        "0. Uses reserved huge pages if available, else transparent huge "
+        "pages. Reallocates the fifo.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_fifomlock, getRxFifoMemoryLock, setRxFifoMemoryLock, StringTo<int>,
+        "[0, 1]\n\tLock the receiver fifo memory in ram. Default is 0. "
+        "Requires a sufficient memlock limit (ulimit -l) for the receiver. "
+        "Reallocates the fifo.");
+
     INTEGER_COMMAND_VEC_ID(
         rx_lock, getRxLock, setRxLock, StringTo<int>,
         "[0, 1]\n\tLock receiver to one client IP, 1 locks, 0 "
@@ -1661,8 +1748,10 @@ class CmdProxy {
     INTEGER_COMMAND_VEC_ID(
         fformat, getFileFormat, setFileFormat,
         sls::StringTo<slsDetectorDefs::fileFormat>,
-        "[binary|hdf5]\n\tFile format of data file. For HDF5, package must be "
-        "compiled with HDF5 flags. Default is binary.");
+        "[binary|hdf5|indexed]\n\tFile format of data file. For HDF5, package "
+        "must be compiled with HDF5 flags. Indexed is binary with page "
+        "aligned images, a header table and a frame directory, to memory map "
+        "the file, at most 100000 frames per file. Default is binary.");
 
     STRING_COMMAND(fpath, getFilePath, setFilePath,
                    "[path]\n\tDirectory where output data files are written in "
@@ -1690,6 +1779,73 @@ class CmdProxy {
         foverwrite, getFileOverWrite, setFileOverWrite, StringTo<int>,
         "[0, 1]\n\tEnable or disable file overwriting. Default is 1.");
 
+    INTEGER_COMMAND_VEC_ID(
+        fdirectio, getFileDirectIO, setFileDirectIO, StringTo<int>,
+        "[0, 1]\n\tWrite binary files with direct io (O_DIRECT), bypassing "
+        "the page cache. Default is 0. The file format is unchanged.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fiouring, getFileIoUring, setFileIoUring, StringTo<int>,
+        "[0, 1]\n\tWrite binary files asynchronously with io_uring from the "
+        "receiver fifo. Default is 0. The file format is unchanged.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fchunkframes, getHdf5ChunkFrames, setHdf5ChunkFrames, StringTo<int>,
+        "[n_images]\n\t[HDF5] Number of images per chunk of the data "
+        "dataset. Images are gathered and written as whole chunks. Default "
+        "is 1. At most rx_framesperfile and a chunk below 4 GiB.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fchunkrows, getHdf5ChunkRows, setHdf5ChunkRows, StringTo<int>,
+        "[n_rows]\n\t[HDF5] Number of rows per chunk of the data dataset, "
+        "to tile the images. Default is 0 (whole image).");
+
+    INTEGER_COMMAND_VEC_ID(
+        fcompoundheader, getHdf5CompoundHeader, setHdf5CompoundHeader,
+        StringTo<int>,
+        "[0, 1]\n\t[HDF5] Write the receiver header of each image to one "
+        "compound dataset 'header', instead of a dataset per parameter. "
+        "Default is 0.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fh5process, getHdf5WriterProcess, setHdf5WriterProcess,
+        StringTo<int>,
+        "[0, 1]\n\t[HDF5] Write the data file of each port in its own writer "
+        "process, so that ports write in parallel. Reallocates the fifo as "
+        "shared memory. The writer processes run slsHdf5Writer, found next "
+        "to the receiver or in PATH. Default is 0.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fswmr, getHdf5Swmr, setHdf5Swmr, StringTo<int>,
+        "[0, 1]\n\t[HDF5] Write the data files in single writer multiple "
+        "reader mode, readable while the acquisition runs. Default is 0.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fflushframes, getHdf5FlushFrames, setHdf5FlushFrames, StringTo<int>,
+        "[n_images]\n\t[HDF5] Number of images between flushes to readers "
+        "in swmr mode. 0 for none. Default is 100.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fflushtime, getHdf5FlushTime, setHdf5FlushTime, StringTo<int>,
+        "[ms]\n\t[HDF5] Time in ms between flushes to readers in swmr "
+        "mode, checked as images are written. 0 for none. Default is 1000.");
+
+    INTEGER_COMMAND_VEC_ID(
+        fcompression, getFileCompression, setFileCompression,
+        sls::StringTo<slsDetectorDefs::fileCompression>,
+        "[none (default)|bslz4|bszstd]\n\tBitshuffle compression of the "
+        "images with LZ4 or zstd. [HDF5] Chunks written with the bitshuffle "
+        "filter. [Binary] Frames written with their compressed size and an "
+        "index of frame offsets at the end of the file. Requires a receiver "
+        "built with SLS_USE_COMPRESSION.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_compressionthreads, getRxCompressionThreads,
+        setRxCompressionThreads, StringTo<int>,
+        "[n_threads]\n\tNumber of threads compressing the blocks of the "
+        "images of all ports, besides the file writer thread of each port. "
+        "Default is 4. Max is 64.");
+
     INTEGER_COMMAND_VEC_ID(
         rx_framesperfile, getFramesPerFile, setFramesPerFile, StringTo<int>,
         "[n_frames]\n\tNumber of frames per file in receiver in an "
@@ -1722,6 +1878,15 @@ class CmdProxy {
         "default, which streams the first frame in an acquisition, "
         "and then depending on the rx zmq frequency/ timer");
 
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqbandwidth, getRxZmqBandwidth, setRxZmqBandwidth, StringTo<int>,
+        "[MB/s]\n\tBandwidth budget of the zmq stream of each receiver port, "
+        "for both sockets with rx_zmqsocket pubpush. Frames due by "
+        "rx_zmqfreq/ rx_zmqtimer are skipped to stay within it, and more "
+        "while frames pile up in the receiver or a pulling client cannot take "
+        "one. The streamed fraction is in the zmq header (streamedFraction). "
+        "Default is 0 (unlimited).");
+
     INTEGER_COMMAND_VEC_ID_GET(
         rx_zmqport, getRxZmqPort, setRxZmqPort, StringTo<int>,
         "[port]\n\tZmq port for data to be streamed out of the receiver. Also "
@@ -1764,6 +1929,75 @@ class CmdProxy {
         "receiver zmq streaming if enabled. Can set to -1 to set default "
         "value.");
 
+    INTEGER_COMMAND_NOID(
+        zmqpull, getClientZmqPull, setClientZmqPull, StringTo<int>,
+        "[0, 1]\n\tClient pulls the frames of receivers pushing them "
+        "(rx_zmqsocket push, or rx_zmqpushport with pubpush) instead of "
+        "subscribing, sharing them with the other pulling clients. Default is "
+        "0. Frames of different modules pulled by one client need not belong "
+        "to the same image. Also restarts client zmq streaming if enabled.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqzerocopy, getRxZmqZeroCopy, setRxZmqZeroCopy, StringTo<int>,
+        "[0, 1]\n\tReceiver streams images without copying them into zmq "
+        "messages, the fifo slot is freed once zmq has sent the image. "
+        "Default is disabled. At most half of rx_fifodepth is held by zmq, "
+        "further images are copied.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqbinaryheader, getRxZmqBinaryHeader, setRxZmqBinaryHeader,
+        StringTo<int>,
+        "[0, 1]\n\tReceiver streams a fixed layout binary header instead of "
+        "the json header. Default is disabled (json). Clients detect the "
+        "format of each header.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqpreview, getRxZmqPreview, setRxZmqPreview, StringTo<int>,
+        "[0, 1-64]\n\tBinning factor of the preview stream of the receiver, "
+        "each block of factor x factor pixels is one pixel. The preview is "
+        "streamed on rx_zmqpreviewport every rx_zmqpreviewtimer, independent "
+        "of rx_zmqfreq. Requires rx_zmqstream. Default is 0 (disabled).");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqpreviewmode, getRxZmqPreviewMode, setRxZmqPreviewMode,
+        sls::StringTo<slsDetectorDefs::previewMode>,
+        "[bin|max]\n\tbin (default) sums the pixels of a block into a 32 bit "
+        "pixel, max keeps the largest pixel of a block and its dynamic range. "
+        "For 16 bit images, the jungfrau gain bits of a block are or-ed into "
+        "the top bits of the preview pixel.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqpreviewtimer, getRxZmqPreviewTimer, setRxZmqPreviewTimer,
+        StringTo<int>,
+        "[duration]\n\tTime between two images of the preview stream in ms. "
+        "Default is 200 ms.");
+
+    INTEGER_COMMAND_VEC_ID_GET(
+        rx_zmqpreviewport, getRxZmqPreviewPort, setRxZmqPreviewPort,
+        StringTo<int>,
+        "[port]\n\tZmq port of the preview stream of the receiver. Default "
+        "is 31001. Must be different for every detector (and udp port). "
+        "Multi command will automatically increment for individual modules.");
+
+    INTEGER_COMMAND_VEC_ID(
+        rx_zmqsocket, getRxZmqSocketType, setRxZmqSocketType,
+        sls::StringTo<slsDetectorDefs::streamingSocketType>,
+        "[pub|push|pubpush]\n\tpub (default) publishes every frame to every "
+        "client. push pushes each frame to one of the pulling clients (load "
+        "balanced, eg. a pool of analysis workers), a frame is skipped if none "
+        "of them can take it. The end of acquisition header is published to "
+        "every pulling client on the push port + 3000. A worker pulls the "
+        "frames with a zmq pull socket and subscribes to that port for the "
+        "end (zmqpull). pubpush publishes on rx_zmqport and pushes on "
+        "rx_zmqpushport. Also restarts receiver zmq streaming if enabled.");
+
+    INTEGER_COMMAND_VEC_ID_GET(
+        rx_zmqpushport, getRxZmqPushPort, setRxZmqPushPort, StringTo<int>,
+        "[port]\n\tZmq port of the receiver pushing frames, if rx_zmqsocket "
+        "is pubpush. Default is 32001. Also restarts receiver zmq streaming if "
+        "enabled. Must be different for every detector (and udp port). Multi "
+        "command will automatically increment for individual modules.");
+
     /* Eiger Specific */
 
     TIME_COMMAND(subexptime, getSubExptime, setSubExptime,
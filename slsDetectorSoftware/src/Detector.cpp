@@ -667,6 +667,10 @@ void Detector::setNumberofUDPInterfaces(int n, Positions pos) {
     if (getUseReceiverFlag().squash(false) && size()) {
         int startingPort = getRxZmqPort({0}).squash(0);
         setRxZmqPort(startingPort, -1);
+        int startingPreviewPort = getRxZmqPreviewPort({0}).squash(0);
+        setRxZmqPreviewPort(startingPreviewPort, -1);
+        int startingPushPort = getRxZmqPushPort({0}).squash(0);
+        setRxZmqPushPort(startingPushPort, -1);
     }
     // redo the zmq sockets if enabled
     if (previouslyClientStreaming) {
@@ -933,6 +937,82 @@ Result<int> Detector::getRxRealUDPSocketBufferSize(Positions pos) const {
     return pimpl->Parallel(&Module::getReceiverRealUDPSocketBufferSize, pos);
 }
 
+Result<int> Detector::getRxUDPBatchSize(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverUDPBatchSize, pos);
+}
+
+void Detector::setRxUDPBatchSize(int n_packets, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverUDPBatchSize, pos, n_packets);
+}
+
+Result<bool> Detector::getRxUDPZeroCopy(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverUDPZeroCopy, pos);
+}
+
+void Detector::setRxUDPZeroCopy(bool enable, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverUDPZeroCopy, pos, enable);
+}
+
+Result<defs::udpBackend> Detector::getRxUDPBackend(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverUDPBackend, pos);
+}
+
+void Detector::setRxUDPBackend(defs::udpBackend b, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverUDPBackend, pos, b);
+}
+
+Result<int> Detector::getRxUDPThreads(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverUDPThreads, pos);
+}
+
+void Detector::setRxUDPThreads(int n_threads, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverUDPThreads, pos, n_threads);
+}
+
+Result<int> Detector::getRxFrameWindow(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverFrameWindow, pos);
+}
+
+void Detector::setRxFrameWindow(int n_frames, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverFrameWindow, pos, n_frames);
+}
+
+Result<int> Detector::getRxFrameTimeout(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverFrameTimeout, pos);
+}
+
+void Detector::setRxFrameTimeout(int timeout_us, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverFrameTimeout, pos, timeout_us);
+}
+
+Result<bool> Detector::getRxFifoHugePages(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverFifoHugePages, pos);
+}
+
+void Detector::setRxFifoHugePages(bool enable, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverFifoHugePages, pos, enable);
+}
+
+Result<bool> Detector::getRxFifoMemoryLock(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverFifoMemoryLock, pos);
+}
+
+void Detector::setRxFifoMemoryLock(bool enable, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverFifoMemoryLock, pos, enable);
+}
+
+Result<defs::rxThreadAffinity>
+Detector::getRxThreadAffinity(defs::rxThreadType type, int index,
+                              Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverThreadAffinity, pos, type,
+                           index);
+}
+
+void Detector::setRxThreadAffinity(const defs::rxThreadAffinity &a,
+                                   Positions pos) {
+    pimpl->Parallel(&Module::setReceiverThreadAffinity, pos, a);
+}
+
 Result<bool> Detector::getRxLock(Positions pos) {
     return pimpl->Parallel(&Module::getReceiverLock, pos);
 }
@@ -1008,6 +1088,95 @@ void Detector::setFileOverWrite(bool value, Positions pos) {
     pimpl->Parallel(&Module::setFileOverWrite, pos, value);
 }
 
+Result<bool> Detector::getFileDirectIO(Positions pos) const {
+    return pimpl->Parallel(&Module::getFileDirectIO, pos);
+}
+
+void Detector::setFileDirectIO(bool value, Positions pos) {
+    pimpl->Parallel(&Module::setFileDirectIO, pos, value);
+}
+
+Result<bool> Detector::getFileIoUring(Positions pos) const {
+    return pimpl->Parallel(&Module::getFileIoUring, pos);
+}
+
+void Detector::setFileIoUring(bool value, Positions pos) {
+    pimpl->Parallel(&Module::setFileIoUring, pos, value);
+}
+
+Result<int> Detector::getHdf5ChunkFrames(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5ChunkFrames, pos);
+}
+
+void Detector::setHdf5ChunkFrames(int value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5ChunkFrames, pos, value);
+}
+
+Result<int> Detector::getHdf5ChunkRows(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5ChunkRows, pos);
+}
+
+void Detector::setHdf5ChunkRows(int value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5ChunkRows, pos, value);
+}
+
+Result<bool> Detector::getHdf5CompoundHeader(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5CompoundHeader, pos);
+}
+
+void Detector::setHdf5CompoundHeader(bool value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5CompoundHeader, pos, value);
+}
+
+Result<bool> Detector::getHdf5WriterProcess(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5WriterProcess, pos);
+}
+
+void Detector::setHdf5WriterProcess(bool value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5WriterProcess, pos, value);
+}
+
+Result<bool> Detector::getHdf5Swmr(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5Swmr, pos);
+}
+
+void Detector::setHdf5Swmr(bool value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5Swmr, pos, value);
+}
+
+Result<int> Detector::getHdf5FlushFrames(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5FlushFrames, pos);
+}
+
+void Detector::setHdf5FlushFrames(int value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5FlushFrames, pos, value);
+}
+
+Result<int> Detector::getHdf5FlushTime(Positions pos) const {
+    return pimpl->Parallel(&Module::getHdf5FlushTime, pos);
+}
+
+void Detector::setHdf5FlushTime(int value, Positions pos) {
+    pimpl->Parallel(&Module::setHdf5FlushTime, pos, value);
+}
+
+Result<defs::fileCompression>
+Detector::getFileCompression(Positions pos) const {
+    return pimpl->Parallel(&Module::getFileCompression, pos);
+}
+
+void Detector::setFileCompression(defs::fileCompression value, Positions pos) {
+    pimpl->Parallel(&Module::setFileCompression, pos, value);
+}
+
+Result<int> Detector::getRxCompressionThreads(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverCompressionThreads, pos);
+}
+
+void Detector::setRxCompressionThreads(int value, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverCompressionThreads, pos, value);
+}
+
 Result<int> Detector::getFramesPerFile(Positions pos) const {
     return pimpl->Parallel(&Module::getFramesPerFile, pos);
 }
@@ -1050,6 +1219,14 @@ void Detector::setRxZmqStartingFrame(int fnum, Positions pos) {
     pimpl->Parallel(&Module::setReceiverStreamingStartingFrame, pos, fnum);
 }
 
+Result<int> Detector::getRxZmqBandwidth(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingBandwidth, pos);
+}
+
+void Detector::setRxZmqBandwidth(int mbps, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingBandwidth, pos, mbps);
+}
+
 Result<int> Detector::getRxZmqPort(Positions pos) const {
     return pimpl->Parallel(&Module::getReceiverStreamingPort, pos);
 }
@@ -1125,6 +1302,14 @@ void Detector::setClientZmqHwm(const int limit) {
     pimpl->setClientStreamingHwm(limit);
 }
 
+bool Detector::getClientZmqPull() const {
+    return pimpl->getClientStreamingPull();
+}
+
+void Detector::setClientZmqPull(bool enable) {
+    pimpl->setClientStreamingPull(enable);
+}
+
 Result<int> Detector::getRxZmqHwm(Positions pos) const {
     return pimpl->Parallel(&Module::getReceiverStreamingHwm, pos);
 }
@@ -1138,6 +1323,102 @@ void Detector::setRxZmqHwm(const int limit) {
     }
 }
 
+Result<bool> Detector::getRxZmqZeroCopy(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingZeroCopy, pos);
+}
+
+void Detector::setRxZmqZeroCopy(bool enable, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingZeroCopy, pos, enable);
+}
+
+Result<bool> Detector::getRxZmqBinaryHeader(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingBinaryHeader, pos);
+}
+
+void Detector::setRxZmqBinaryHeader(bool enable, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingBinaryHeader, pos, enable);
+}
+
+Result<int> Detector::getRxZmqPreview(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingPreviewBinning, pos);
+}
+
+void Detector::setRxZmqPreview(int factor, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingPreviewBinning, pos, factor);
+}
+
+Result<defs::previewMode> Detector::getRxZmqPreviewMode(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingPreviewMode, pos);
+}
+
+void Detector::setRxZmqPreviewMode(defs::previewMode mode, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingPreviewMode, pos, mode);
+}
+
+Result<int> Detector::getRxZmqPreviewTimer(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingPreviewTimer, pos);
+}
+
+void Detector::setRxZmqPreviewTimer(int time_in_ms, Positions pos) {
+    pimpl->Parallel(&Module::setReceiverStreamingPreviewTimer, pos,
+                    time_in_ms);
+}
+
+Result<int> Detector::getRxZmqPreviewPort(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingPreviewPort, pos);
+}
+
+void Detector::setRxZmqPreviewPort(int port, int module_id) {
+    if (module_id == -1) {
+        std::vector<int> port_list = getPortNumbers(port);
+        for (int idet = 0; idet < size(); ++idet) {
+            pimpl->Parallel(&Module::setReceiverStreamingPreviewPort, {idet},
+                            port_list[idet]);
+        }
+    } else {
+        pimpl->Parallel(&Module::setReceiverStreamingPreviewPort, {module_id},
+                        port);
+    }
+}
+
+Result<defs::streamingSocketType>
+Detector::getRxZmqSocketType(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingSocketType, pos);
+}
+
+void Detector::setRxZmqSocketType(defs::streamingSocketType type,
+                                  Positions pos) {
+    bool previouslyReceiverStreaming = getRxZmqDataStream(pos).squash(false);
+    pimpl->Parallel(&Module::setReceiverStreamingSocketType, pos, type);
+    if (previouslyReceiverStreaming) {
+        setRxZmqDataStream(false, pos);
+        setRxZmqDataStream(true, pos);
+    }
+}
+
+Result<int> Detector::getRxZmqPushPort(Positions pos) const {
+    return pimpl->Parallel(&Module::getReceiverStreamingPushPort, pos);
+}
+
+void Detector::setRxZmqPushPort(int port, int module_id) {
+    bool previouslyReceiverStreaming =
+        getRxZmqDataStream(std::vector<int>{module_id}).squash(false);
+    if (module_id == -1) {
+        std::vector<int> port_list = getPortNumbers(port);
+        for (int idet = 0; idet < size(); ++idet) {
+            pimpl->Parallel(&Module::setReceiverStreamingPushPort, {idet},
+                            port_list[idet]);
+        }
+    } else {
+        pimpl->Parallel(&Module::setReceiverStreamingPushPort, {module_id},
+                        port);
+    }
+    if (previouslyReceiverStreaming) {
+        setRxZmqDataStream(false, std::vector<int>{module_id});
+        setRxZmqDataStream(true, std::vector<int>{module_id});
+    }
+}
+
 // Eiger Specific
 
 Result<ns> Detector::getSubExptime(Positions pos) const {
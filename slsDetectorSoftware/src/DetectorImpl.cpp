@@ -160,6 +160,7 @@ void DetectorImpl::initializeDetectorStructure() {
     multi_shm()->gapPixels = false;
     // zmqlib default
     multi_shm()->zmqHwm = -1;
+    multi_shm()->zmqPull = false;
 }
 
 void DetectorImpl::initializeMembers(bool verify) {
@@ -419,7 +420,7 @@ int DetectorImpl::createReceivingDataSockets() {
                     ->getClientStreamingIP()
                     .str()
                     .c_str(),
-                portnum));
+                portnum, multi_shm()->zmqPull));
             // set high water mark
             int hwm = multi_shm()->zmqHwm;
             if (hwm >= 0) {
@@ -431,7 +432,8 @@ int DetectorImpl::createReceivingDataSockets() {
             }
             LOG(logINFO) << "Zmq Client[" << iSocket << "] at "
                          << zmqSocket.back()->GetZmqServerAddress() << "[hwm: "
-                         << zmqSocket.back()->GetReceiveHighWaterMark() << "]";
+                         << zmqSocket.back()->GetReceiveHighWaterMark()
+                         << (multi_shm()->zmqPull ? ", pull" : "") << "]";
         } catch (...) {
             LOG(logERROR) << "Could not create Zmq socket on port " << portnum;
             destroyReceivingDataSockets();
@@ -1039,6 +1041,19 @@ void DetectorImpl::setClientStreamingHwm(const int limit) {
     }
 }
 
+bool DetectorImpl::getClientStreamingPull() const {
+    return multi_shm()->zmqPull;
+}
+
+void DetectorImpl::setClientStreamingPull(bool enable) {
+    multi_shm()->zmqPull = enable;
+    // sockets have to be created again
+    if (client_downstream) {
+        setDataStreamingToClient(false);
+        setDataStreamingToClient(true);
+    }
+}
+
 void DetectorImpl::registerAcquisitionFinishedCallback(void (*func)(double, int,
                                                                     void *),
                                                        void *pArg) {
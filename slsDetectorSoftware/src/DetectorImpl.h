@@ -16,7 +16,7 @@ class detectorData;
 #include <vector>
 
 #define MULTI_SHMAPIVERSION 0x190809
-#define MULTI_SHMVERSION    0x201007
+#define MULTI_SHMVERSION    0x201008
 #define SHORT_STRING_LENGTH 50
 
 #include <future>
@@ -64,6 +64,8 @@ struct sharedMultiSlsDetector {
     bool gapPixels;
     /** high water mark of listening tcp port (only data) */
     int zmqHwm;
+    /** pull the data from receivers pushing it instead of subscribing */
+    bool zmqPull;
 };
 
 class DetectorImpl : public virtual slsDetectorDefs {
@@ -244,6 +246,8 @@ class DetectorImpl : public virtual slsDetectorDefs {
     void setDataStreamingToClient(bool enable);
     int getClientStreamingHwm() const;
     void setClientStreamingHwm(const int limit);
+    bool getClientStreamingPull() const;
+    void setClientStreamingPull(bool enable);
 
     /**
      * register callback for accessing acquisition final data
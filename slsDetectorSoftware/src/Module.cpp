@@ -879,6 +879,84 @@ void Module::setReceiverUDPSocketBufferSize(int udpsockbufsize) {
     sendToReceiver<int>(F_RECEIVER_UDP_SOCK_BUF_SIZE, udpsockbufsize);
 }
 
+int Module::getReceiverUDPBatchSize() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_UDP_BATCH_SIZE);
+}
+
+void Module::setReceiverUDPBatchSize(int n_packets) {
+    sendToReceiver(F_SET_RECEIVER_UDP_BATCH_SIZE, n_packets, nullptr);
+}
+
+bool Module::getReceiverUDPZeroCopy() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_UDP_ZERO_COPY);
+}
+
+void Module::setReceiverUDPZeroCopy(bool enable) {
+    sendToReceiver(F_SET_RECEIVER_UDP_ZERO_COPY, static_cast<int>(enable),
+                   nullptr);
+}
+
+slsDetectorDefs::udpBackend Module::getReceiverUDPBackend() const {
+    return sendToReceiver<udpBackend>(F_GET_RECEIVER_UDP_BACKEND);
+}
+
+void Module::setReceiverUDPBackend(udpBackend b) {
+    sendToReceiver(F_SET_RECEIVER_UDP_BACKEND, static_cast<int>(b), nullptr);
+}
+
+int Module::getReceiverUDPThreads() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_UDP_THREADS);
+}
+
+void Module::setReceiverUDPThreads(int n_threads) {
+    sendToReceiver(F_SET_RECEIVER_UDP_THREADS, n_threads, nullptr);
+}
+
+int Module::getReceiverFrameWindow() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FRAME_WINDOW);
+}
+
+void Module::setReceiverFrameWindow(int n_frames) {
+    sendToReceiver(F_SET_RECEIVER_FRAME_WINDOW, n_frames, nullptr);
+}
+
+int Module::getReceiverFrameTimeout() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FRAME_TIMEOUT);
+}
+
+void Module::setReceiverFrameTimeout(int timeout_us) {
+    sendToReceiver(F_SET_RECEIVER_FRAME_TIMEOUT, timeout_us, nullptr);
+}
+
+bool Module::getReceiverFifoHugePages() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FIFO_HUGEPAGES);
+}
+
+void Module::setReceiverFifoHugePages(bool enable) {
+    sendToReceiver(F_SET_RECEIVER_FIFO_HUGEPAGES, static_cast<int>(enable),
+                   nullptr);
+}
+
+bool Module::getReceiverFifoMemoryLock() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FIFO_MLOCK);
+}
+
+void Module::setReceiverFifoMemoryLock(bool enable) {
+    sendToReceiver(F_SET_RECEIVER_FIFO_MLOCK, static_cast<int>(enable),
+                   nullptr);
+}
+
+slsDetectorDefs::rxThreadAffinity
+Module::getReceiverThreadAffinity(rxThreadType type, int index) const {
+    int args[]{static_cast<int>(type), index};
+    return sendToReceiver<rxThreadAffinity>(F_GET_RECEIVER_THREAD_AFFINITY,
+                                            args);
+}
+
+void Module::setReceiverThreadAffinity(const rxThreadAffinity &a) {
+    sendToReceiver(F_SET_RECEIVER_THREAD_AFFINITY, a, nullptr);
+}
+
 bool Module::getReceiverLock() const {
     return sendToReceiver<int>(F_LOCK_RECEIVER, GET_FLAG);
 }
@@ -970,6 +1048,99 @@ void Module::setFileOverWrite(bool value) {
     sendToReceiver(F_SET_RECEIVER_OVERWRITE, static_cast<int>(value), nullptr);
 }
 
+bool Module::getFileDirectIO() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FILE_DIRECT_IO);
+}
+
+void Module::setFileDirectIO(bool value) {
+    sendToReceiver(F_SET_RECEIVER_FILE_DIRECT_IO, static_cast<int>(value),
+                   nullptr);
+}
+
+bool Module::getFileIoUring() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_FILE_IO_URING);
+}
+
+void Module::setFileIoUring(bool value) {
+    sendToReceiver(F_SET_RECEIVER_FILE_IO_URING, static_cast<int>(value),
+                   nullptr);
+}
+
+int Module::getHdf5ChunkFrames() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_CHUNK_FRAMES);
+}
+
+void Module::setHdf5ChunkFrames(int value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_CHUNK_FRAMES, value, nullptr);
+}
+
+int Module::getHdf5ChunkRows() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_CHUNK_ROWS);
+}
+
+void Module::setHdf5ChunkRows(int value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_CHUNK_ROWS, value, nullptr);
+}
+
+bool Module::getHdf5CompoundHeader() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_COMPOUND_HEADER);
+}
+
+void Module::setHdf5CompoundHeader(bool value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_COMPOUND_HEADER, static_cast<int>(value),
+                   nullptr);
+}
+
+bool Module::getHdf5WriterProcess() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_WRITER_PROCESS);
+}
+
+void Module::setHdf5WriterProcess(bool value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_WRITER_PROCESS, static_cast<int>(value),
+                   nullptr);
+}
+
+bool Module::getHdf5Swmr() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_SWMR);
+}
+
+void Module::setHdf5Swmr(bool value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_SWMR, static_cast<int>(value), nullptr);
+}
+
+int Module::getHdf5FlushFrames() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_FLUSH_FRAMES);
+}
+
+void Module::setHdf5FlushFrames(int value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_FLUSH_FRAMES, value, nullptr);
+}
+
+int Module::getHdf5FlushTime() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_HDF5_FLUSH_TIME);
+}
+
+void Module::setHdf5FlushTime(int value) {
+    sendToReceiver(F_SET_RECEIVER_HDF5_FLUSH_TIME, value, nullptr);
+}
+
+slsDetectorDefs::fileCompression Module::getFileCompression() const {
+    return sendToReceiver<fileCompression>(F_GET_RECEIVER_FILE_COMPRESSION);
+}
+
+void Module::setFileCompression(fileCompression value) {
+    sendToReceiver(F_SET_RECEIVER_FILE_COMPRESSION, static_cast<int>(value),
+                   nullptr);
+}
+
+int Module::getReceiverCompressionThreads() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_COMPRESSION_THREADS);
+}
+
+void Module::setReceiverCompressionThreads(int value) {
+    sendToReceiver(F_SET_RECEIVER_COMPRESSION_THREADS, value, nullptr);
+}
+
 int Module::getFramesPerFile() const {
     return sendToReceiver<int>(F_GET_RECEIVER_FRAMES_PER_FILE);
 }
@@ -1020,6 +1191,18 @@ void Module::setReceiverStreamingStartingFrame(int fnum) {
     sendToReceiver(F_SET_RECEIVER_STREAMING_START_FNUM, fnum, nullptr);
 }
 
+int Module::getReceiverStreamingBandwidth() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_BANDWIDTH);
+}
+
+void Module::setReceiverStreamingBandwidth(int mbps) {
+    if (mbps < 0) {
+        throw RuntimeError("Invalid streaming bandwidth " +
+                           std::to_string(mbps));
+    }
+    sendToReceiver(F_SET_RECEIVER_STREAMING_BANDWIDTH, mbps, nullptr);
+}
+
 int Module::getReceiverStreamingPort() const {
     return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PORT);
 }
@@ -1064,6 +1247,78 @@ void Module::setReceiverStreamingHwm(const int limit) {
     sendToReceiver(F_SET_RECEIVER_STREAMING_HWM, limit, nullptr);
 }
 
+bool Module::getReceiverStreamingZeroCopy() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_ZERO_COPY);
+}
+
+void Module::setReceiverStreamingZeroCopy(bool enable) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_ZERO_COPY,
+                   static_cast<int>(enable), nullptr);
+}
+
+bool Module::getReceiverStreamingBinaryHeader() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_BINARY_HEADER);
+}
+
+void Module::setReceiverStreamingBinaryHeader(bool enable) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_BINARY_HEADER,
+                   static_cast<int>(enable), nullptr);
+}
+
+int Module::getReceiverStreamingPreviewBinning() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PREVIEW_BINNING);
+}
+
+void Module::setReceiverStreamingPreviewBinning(int factor) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_PREVIEW_BINNING, factor, nullptr);
+}
+
+slsDetectorDefs::previewMode Module::getReceiverStreamingPreviewMode() const {
+    return static_cast<previewMode>(
+        sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PREVIEW_MODE));
+}
+
+void Module::setReceiverStreamingPreviewMode(previewMode mode) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_PREVIEW_MODE,
+                   static_cast<int>(mode), nullptr);
+}
+
+int Module::getReceiverStreamingPreviewTimer() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PREVIEW_TIMER);
+}
+
+void Module::setReceiverStreamingPreviewTimer(int time_in_ms) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_PREVIEW_TIMER, time_in_ms,
+                   nullptr);
+}
+
+int Module::getReceiverStreamingPreviewPort() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PREVIEW_PORT);
+}
+
+void Module::setReceiverStreamingPreviewPort(int port) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_PREVIEW_PORT, port, nullptr);
+}
+
+slsDetectorDefs::streamingSocketType
+Module::getReceiverStreamingSocketType() const {
+    return static_cast<streamingSocketType>(
+        sendToReceiver<int>(F_GET_RECEIVER_STREAMING_SOCKET_TYPE));
+}
+
+void Module::setReceiverStreamingSocketType(streamingSocketType type) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_SOCKET_TYPE,
+                   static_cast<int>(type), nullptr);
+}
+
+int Module::getReceiverStreamingPushPort() const {
+    return sendToReceiver<int>(F_GET_RECEIVER_STREAMING_PUSH_PORT);
+}
+
+void Module::setReceiverStreamingPushPort(int port) {
+    sendToReceiver(F_SET_RECEIVER_STREAMING_PUSH_PORT, port, nullptr);
+}
+
 //  Eiger Specific
 
 int64_t Module::getSubExptime() const {
@@ -244,6 +244,25 @@ class Module : public virtual slsDetectorDefs {
     int getReceiverUDPSocketBufferSize() const;
     int getReceiverRealUDPSocketBufferSize() const;
     void setReceiverUDPSocketBufferSize(int udpsockbufsize);
+    int getReceiverUDPBatchSize() const;
+    void setReceiverUDPBatchSize(int n_packets);
+    bool getReceiverUDPZeroCopy() const;
+    void setReceiverUDPZeroCopy(bool enable);
+    udpBackend getReceiverUDPBackend() const;
+    void setReceiverUDPBackend(udpBackend b);
+    int getReceiverUDPThreads() const;
+    void setReceiverUDPThreads(int n_threads);
+    int getReceiverFrameWindow() const;
+    void setReceiverFrameWindow(int n_frames);
+    int getReceiverFrameTimeout() const;
+    void setReceiverFrameTimeout(int timeout_us);
+    bool getReceiverFifoHugePages() const;
+    void setReceiverFifoHugePages(bool enable);
+    bool getReceiverFifoMemoryLock() const;
+    void setReceiverFifoMemoryLock(bool enable);
+    rxThreadAffinity getReceiverThreadAffinity(rxThreadType type,
+                                               int index) const;
+    void setReceiverThreadAffinity(const rxThreadAffinity &a);
     bool getReceiverLock() const;
     void setReceiverLock(bool lock);
     sls::IpAddr getReceiverLastClientIP() const;
@@ -269,6 +288,28 @@ class Module : public virtual slsDetectorDefs {
     void setMasterFileWrite(bool value);
     bool getFileOverWrite() const;
     void setFileOverWrite(bool value);
+    bool getFileDirectIO() const;
+    void setFileDirectIO(bool value);
+    bool getFileIoUring() const;
+    void setFileIoUring(bool value);
+    int getHdf5ChunkFrames() const;
+    void setHdf5ChunkFrames(int value);
+    int getHdf5ChunkRows() const;
+    void setHdf5ChunkRows(int value);
+    bool getHdf5CompoundHeader() const;
+    void setHdf5CompoundHeader(bool value);
+    bool getHdf5WriterProcess() const;
+    void setHdf5WriterProcess(bool value);
+    bool getHdf5Swmr() const;
+    void setHdf5Swmr(bool value);
+    int getHdf5FlushFrames() const;
+    void setHdf5FlushFrames(int value);
+    int getHdf5FlushTime() const;
+    void setHdf5FlushTime(int value);
+    fileCompression getFileCompression() const;
+    void setFileCompression(fileCompression value);
+    int getReceiverCompressionThreads() const;
+    void setReceiverCompressionThreads(int value);
     int getFramesPerFile() const;
     /** 0 will set frames per file to unlimited */
     void setFramesPerFile(int n_frames);
@@ -287,6 +328,8 @@ class Module : public virtual slsDetectorDefs {
     void setReceiverStreamingTimer(int time_in_ms = 200);
     int getReceiverStreamingStartingFrame() const;
     void setReceiverStreamingStartingFrame(int fnum);
+    int getReceiverStreamingBandwidth() const;
+    void setReceiverStreamingBandwidth(int mbps);
     int getReceiverStreamingPort() const;
     void setReceiverStreamingPort(int port);
     sls::IpAddr getReceiverStreamingIP() const;
@@ -297,6 +340,23 @@ class Module : public virtual slsDetectorDefs {
     void setClientStreamingIP(const sls::IpAddr ip);
     int getReceiverStreamingHwm() const;
     void setReceiverStreamingHwm(const int limit);
+    bool getReceiverStreamingZeroCopy() const;
+    void setReceiverStreamingZeroCopy(bool enable);
+    bool getReceiverStreamingBinaryHeader() const;
+    void setReceiverStreamingBinaryHeader(bool enable);
+    int getReceiverStreamingPreviewBinning() const;
+    void setReceiverStreamingPreviewBinning(int factor);
+    slsDetectorDefs::previewMode getReceiverStreamingPreviewMode() const;
+    void setReceiverStreamingPreviewMode(slsDetectorDefs::previewMode mode);
+    int getReceiverStreamingPreviewTimer() const;
+    void setReceiverStreamingPreviewTimer(int time_in_ms);
+    int getReceiverStreamingPreviewPort() const;
+    void setReceiverStreamingPreviewPort(int port);
+    slsDetectorDefs::streamingSocketType getReceiverStreamingSocketType() const;
+    void
+    setReceiverStreamingSocketType(slsDetectorDefs::streamingSocketType type);
+    int getReceiverStreamingPushPort() const;
+    void setReceiverStreamingPushPort(int port);
 
     /**************************************************
      *                                                *
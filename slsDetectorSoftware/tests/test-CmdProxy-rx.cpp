@@ -342,6 +342,234 @@ TEST_CASE("rx_realudpsocksize", "[.cmd][.rx]") {
     }
 }
 
+TEST_CASE("rx_udpbatch", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxUDPBatchSize();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbatch", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpbatch 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbatch", {"64"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpbatch 64\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbatch", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_udpbatch 64\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_udpbatch", {"0"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_udpbatch", {"1025"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxUDPBatchSize(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_udpzerocopy", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxUDPZeroCopy();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpzerocopy", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpzerocopy 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpzerocopy", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpzerocopy 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpzerocopy", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_udpzerocopy 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxUDPZeroCopy(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_udpbackend", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxUDPBackend();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbackend", {"ring"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpbackend ring\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbackend", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_udpbackend ring\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpbackend", {"socket"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpbackend socket\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_udpbackend", {"mmap"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxUDPBackend(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_udpthreads", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxUDPThreads();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpthreads", {"4"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpthreads 4\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpthreads", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_udpthreads 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_udpthreads", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_udpthreads 1\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_udpthreads", {"0"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_udpthreads", {"17"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxUDPThreads(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_framewindow", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxFrameWindow();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_framewindow", {"8"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_framewindow 8\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_framewindow", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_framewindow 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_framewindow", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_framewindow 1\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_framewindow", {"0"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_framewindow", {"1025"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxFrameWindow(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_frametimeout", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxFrameTimeout();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_frametimeout", {"500"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_frametimeout 500\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_frametimeout", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_frametimeout 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_frametimeout", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_frametimeout 0\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_frametimeout", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxFrameTimeout(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_fifohugepages", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxFifoHugePages();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifohugepages", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_fifohugepages 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifohugepages", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_fifohugepages 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifohugepages", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_fifohugepages 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxFifoHugePages(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_fifomlock", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxFifoMemoryLock();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifomlock", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_fifomlock 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifomlock", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_fifomlock 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_fifomlock", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_fifomlock 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxFifoMemoryLock(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_threadaffinity", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxThreadAffinity(defs::PROCESSOR_THREAD, 0);
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_threadaffinity", {"processor", "0", "0-1,3", "other"},
+                   -1, PUT, oss);
+        REQUIRE(oss.str() ==
+                "rx_threadaffinity [processor, 0, 0-1,3, other]\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_threadaffinity", {"processor", "0"}, -1, GET, oss);
+        REQUIRE(oss.str() ==
+                "rx_threadaffinity [processor 0, cpus 0-1,3, other 0]\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_threadaffinity",
+                              {"processor", "0", "all", "fifo", "0"}, -1,
+                              PUT));
+    REQUIRE_THROWS(proxy.Call("rx_threadaffinity",
+                              {"tcp", "1", "all", "other"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_threadaffinity", {"tcp"}, -1, GET));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxThreadAffinity(prev_val[i], {i});
+    }
+}
+
 TEST_CASE("rx_lock", "[.cmd][.rx]") {
     Detector det;
     CmdProxy proxy(&det);
@@ -399,6 +627,11 @@ TEST_CASE("fformat", "[.cmd]") {
         proxy.Call("fformat", {}, -1, GET, oss);
         REQUIRE(oss.str() == "fformat binary\n");
     }
+    {
+        std::ostringstream oss;
+        proxy.Call("fformat", {"indexed"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fformat indexed\n");
+    }
     for (int i = 0; i != det.size(); ++i) {
         det.setFileFormat(prev_val[i], {i});
     }
@@ -541,6 +774,272 @@ TEST_CASE("foverwrite", "[.cmd]") {
     }
 }
 
+TEST_CASE("fdirectio", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getFileDirectIO();
+    {
+        std::ostringstream oss;
+        proxy.Call("fdirectio", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fdirectio 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fdirectio", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fdirectio 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fdirectio", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fdirectio 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setFileDirectIO(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fiouring", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getFileIoUring();
+    {
+        std::ostringstream oss;
+        proxy.Call("fiouring", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fiouring 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fiouring", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fiouring 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fiouring", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fiouring 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setFileIoUring(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fchunkframes", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5ChunkFrames();
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkframes", {"16"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fchunkframes 16\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkframes", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fchunkframes 16\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkframes", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fchunkframes 1\n");
+    }
+    REQUIRE_THROWS(proxy.Call("fchunkframes", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5ChunkFrames(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fchunkrows", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5ChunkRows();
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkrows", {"64"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fchunkrows 64\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkrows", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fchunkrows 64\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fchunkrows", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fchunkrows 0\n");
+    }
+    REQUIRE_THROWS(proxy.Call("fchunkrows", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5ChunkRows(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fcompoundheader", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5CompoundHeader();
+    {
+        std::ostringstream oss;
+        proxy.Call("fcompoundheader", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fcompoundheader 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fcompoundheader", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fcompoundheader 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fcompoundheader", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fcompoundheader 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5CompoundHeader(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fh5process", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5WriterProcess();
+    {
+        std::ostringstream oss;
+        proxy.Call("fh5process", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fh5process 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fh5process", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fh5process 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fh5process", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fh5process 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5WriterProcess(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fswmr", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5Swmr();
+    {
+        std::ostringstream oss;
+        proxy.Call("fswmr", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fswmr 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fswmr", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fswmr 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fswmr", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fswmr 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5Swmr(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fflushframes", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5FlushFrames();
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushframes", {"10"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fflushframes 10\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushframes", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fflushframes 10\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushframes", {"100"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fflushframes 100\n");
+    }
+    REQUIRE_THROWS(proxy.Call("fflushframes", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5FlushFrames(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fflushtime", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getHdf5FlushTime();
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushtime", {"200"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fflushtime 200\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushtime", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fflushtime 200\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fflushtime", {"1000"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fflushtime 1000\n");
+    }
+    REQUIRE_THROWS(proxy.Call("fflushtime", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setHdf5FlushTime(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("fcompression", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getFileCompression();
+    {
+        std::ostringstream oss;
+        proxy.Call("fcompression", {"none"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "fcompression none\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("fcompression", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "fcompression none\n");
+    }
+    REQUIRE_THROWS(proxy.Call("fcompression", {"gzip"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setFileCompression(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_compressionthreads", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxCompressionThreads();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_compressionthreads", {"2"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_compressionthreads 2\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_compressionthreads", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_compressionthreads 2\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_compressionthreads", {"4"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_compressionthreads 4\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_compressionthreads", {"-1"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_compressionthreads", {"65"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxCompressionThreads(prev_val[i], {i});
+    }
+}
+
 TEST_CASE("rx_framesperfile", "[.cmd][.rx]") {
     Detector det;
     CmdProxy proxy(&det);
@@ -646,6 +1145,31 @@ TEST_CASE("rx_zmqstartfnum", "[.cmd][.rx]") {
     }
 }
 
+TEST_CASE("rx_zmqbandwidth", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqBandwidth();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbandwidth", {"100"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqbandwidth 100\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbandwidth", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqbandwidth 100\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbandwidth", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqbandwidth 0\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_zmqbandwidth", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqBandwidth(prev_val[i], {i});
+    }
+}
+
 TEST_CASE("rx_zmqport", "[.cmd][.rx]") {
     Detector det;
     CmdProxy proxy(&det);
@@ -734,6 +1258,213 @@ TEST_CASE("rx_zmqhwm", "[.cmd]") {
     det.setRxZmqHwm(prev_val);
 }
 
+TEST_CASE("rx_zmqzerocopy", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqZeroCopy();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqzerocopy", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqzerocopy 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqzerocopy", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqzerocopy 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqzerocopy", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqzerocopy 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqZeroCopy(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqbinaryheader", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqBinaryHeader();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbinaryheader", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqbinaryheader 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbinaryheader", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqbinaryheader 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqbinaryheader", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqbinaryheader 0\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqBinaryHeader(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqpreview", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqPreview();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreview", {"4"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreview 4\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreview", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreview 0\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreview", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqpreview 0\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_zmqpreview", {"65"}, -1, PUT));
+    REQUIRE_THROWS(proxy.Call("rx_zmqpreview", {"-1"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqPreview(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqpreviewmode", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqPreviewMode();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewmode", {"max"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewmode max\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewmode", {"bin"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewmode bin\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewmode", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewmode bin\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_zmqpreviewmode", {"sum"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqPreviewMode(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqpreviewtimer", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqPreviewTimer();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewtimer", {"1000"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewtimer 1000\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewtimer", {"200"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewtimer 200\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewtimer", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewtimer 200\n");
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqPreviewTimer(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqpreviewport", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqPreviewPort();
+
+    int socketsperdetector = 1;
+    auto det_type = det.getDetectorType().squash();
+    if (det_type == defs::EIGER) {
+        socketsperdetector *= 2;
+    } else if (det_type == defs::JUNGFRAU &&
+               det.getNumberofUDPInterfaces().squash() == 2) {
+        socketsperdetector *= 2;
+    }
+    int port = 3600;
+    proxy.Call("rx_zmqpreviewport", {std::to_string(port)}, -1, PUT);
+    for (int i = 0; i != det.size(); ++i) {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpreviewport", {}, i, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqpreviewport " +
+                                 std::to_string(port + i * socketsperdetector) +
+                                 '\n');
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqPreviewPort(prev_val[i], i);
+    }
+}
+
+TEST_CASE("rx_zmqsocket", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqSocketType();
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqsocket", {"push"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqsocket push\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqsocket", {"pubpush"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqsocket pubpush\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqsocket", {"pub"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "rx_zmqsocket pub\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqsocket", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqsocket pub\n");
+    }
+    REQUIRE_THROWS(proxy.Call("rx_zmqsocket", {"pull"}, -1, PUT));
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqSocketType(prev_val[i], {i});
+    }
+}
+
+TEST_CASE("rx_zmqpushport", "[.cmd][.rx]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getRxZmqPushPort();
+
+    int socketsperdetector = 1;
+    auto det_type = det.getDetectorType().squash();
+    if (det_type == defs::EIGER) {
+        socketsperdetector *= 2;
+    } else if (det_type == defs::JUNGFRAU &&
+               det.getNumberofUDPInterfaces().squash() == 2) {
+        socketsperdetector *= 2;
+    }
+    int port = 3700;
+    proxy.Call("rx_zmqpushport", {std::to_string(port)}, -1, PUT);
+    for (int i = 0; i != det.size(); ++i) {
+        std::ostringstream oss;
+        proxy.Call("rx_zmqpushport", {}, i, GET, oss);
+        REQUIRE(oss.str() == "rx_zmqpushport " +
+                                 std::to_string(port + i * socketsperdetector) +
+                                 '\n');
+    }
+    for (int i = 0; i != det.size(); ++i) {
+        det.setRxZmqPushPort(prev_val[i], i);
+    }
+}
+
 /* CTB Specific */
 
 TEST_CASE("rx_dbitlist", "[.cmd][.rx]") {
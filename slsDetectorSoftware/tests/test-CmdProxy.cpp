@@ -1912,6 +1912,28 @@ TEST_CASE("zmqhwm", "[.cmd]") {
     det.setClientZmqHwm(prev_val);
 }
 
+TEST_CASE("zmqpull", "[.cmd]") {
+    Detector det;
+    CmdProxy proxy(&det);
+    auto prev_val = det.getClientZmqPull();
+    {
+        std::ostringstream oss;
+        proxy.Call("zmqpull", {"1"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "zmqpull 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("zmqpull", {}, -1, GET, oss);
+        REQUIRE(oss.str() == "zmqpull 1\n");
+    }
+    {
+        std::ostringstream oss;
+        proxy.Call("zmqpull", {"0"}, -1, PUT, oss);
+        REQUIRE(oss.str() == "zmqpull 0\n");
+    }
+    det.setClientZmqPull(prev_val);
+}
+
 /* Advanced */
 
 TEST_CASE("programfpga", "[.cmd]") {
@@ -1,47 +1,93 @@
 #pragma once
 /* CircularFifo.h
- * Code & platform dependent issues with it was originally
- * published at http://www.kjellkod.cc/threadsafecircularqueue
- * 2009-11-02
- * @author Kjell Hedstr�m, hedstrom@kjellkod.cc
+ * Lock-free single producer, single consumer ring of pointers, with
+ * producers serialized by a mutex if there are several of them.
+ * Originally a semaphore based circular queue published at
+ * http://www.kjellkod.cc/threadsafecircularqueue 2009-11-02
+ * by Kjell Hedstrom, hedstrom@kjellkod.cc
  * modified by the sls detector group
  * */
 
-#include <iostream>
-#include <semaphore.h>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <linux/futex.h>
+#include <mutex>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 namespace sls {
 
 /** Circular Fifo (a.k.a. Circular Buffer)
- * Thread safe for one reader, and one writer */
+ * Thread safe for one reader, and one writer (or several writers if
+ * constructed multi producer, their pushes then take a mutex).
+ * head and tail only increase, their difference is the number of items. The
+ * producer only writes tail, the consumer only writes head, each on its own
+ * cache line. A blocked push or pop spins for a while before sleeping on a
+ * futex, which is only woken by the other side if someone is sleeping. */
 template <typename Element> class CircularFifo {
   private:
-    size_t tail{0};
-    size_t head{0};
-    size_t capacity;
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr int SPIN_COUNT = 200;
+
+    /** waiting side of the fifo, sequence is bumped on every wake up */
+    struct Waiter {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<bool> sleeping{false};
+    };
+
+    // producer
+    std::atomic<size_t> tail{0};
+    size_t cachedHead{0};
+    char pad0[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    // consumer
+    std::atomic<size_t> head{0};
+    size_t cachedTail{0};
+    char pad1[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    Waiter dataWaiter; // consumer waiting for data
+    char pad2[CACHE_LINE - sizeof(Waiter)];
+    Waiter freeWaiter; // producer waiting for free slots
+    char pad3[CACHE_LINE - sizeof(Waiter)];
+
+    const size_t capacity;
     std::vector<Element *> data;
-    mutable sem_t data_mutex;
-    mutable sem_t free_mutex;
-    size_t increment(size_t i) const;
+
+    /** serializes pushes if there are several producers */
+    const bool multiProducer;
+    std::mutex producerMutex;
+    std::unique_lock<std::mutex> lockProducer();
+
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Ready>
+    static bool wait(Waiter &w, Ready ready,
+                     const Clock::time_point *deadline = nullptr);
+    static void notify(Waiter &w);
+
+    size_t pop(Element **items, size_t n, bool no_block,
+               const Clock::time_point *deadline);
 
   public:
-    explicit CircularFifo(size_t size) : capacity(size + 1), data(capacity) {
-        sem_init(&data_mutex, 0, 0);
-        sem_init(&free_mutex, 0, size);
-    }
+    explicit CircularFifo(size_t size, bool multiProducer = false)
+        : capacity(size), data(size), multiProducer(multiProducer) {}
 
     CircularFifo(const CircularFifo &) = delete;
     CircularFifo(CircularFifo &&) = delete;
 
-    virtual ~CircularFifo() {
-        sem_destroy(&data_mutex);
-        sem_destroy(&free_mutex);
-    }
+    virtual ~CircularFifo() = default;
 
     bool push(Element *&item, bool no_block = false);
     bool pop(Element *&item, bool no_block = false);
 
+    size_t push(Element **items, size_t n);
+    size_t pop(Element **items, size_t n, bool no_block = false);
+
+    bool pop(Element *&item, std::chrono::nanoseconds timeout);
+
     bool isEmpty() const;
     bool isFull() const;
 
@@ -50,15 +96,74 @@ template <typename Element> class CircularFifo {
 };
 
 template <typename Element> int CircularFifo<Element>::getDataValue() const {
-    int value;
-    sem_getvalue(&data_mutex, &value);
-    return value;
+    size_t h = head.load(std::memory_order_acquire);
+    return static_cast<int>(tail.load(std::memory_order_acquire) - h);
 }
 
 template <typename Element> int CircularFifo<Element>::getFreeValue() const {
-    int value;
-    sem_getvalue(&free_mutex, &value);
-    return value;
+    return static_cast<int>(capacity) - getDataValue();
+}
+
+/** Spins and then sleeps on the futex of w until ready() or the deadline
+ * (if any) has passed
+ *
+ * \return whether ready() */
+template <typename Element>
+template <typename Ready>
+bool CircularFifo<Element>::wait(Waiter &w, Ready ready,
+                                 const Clock::time_point *deadline) {
+    // spinning only helps if the other side runs on another cpu
+    static const bool spin = std::thread::hardware_concurrency() > 1;
+    for (int i = 0; spin && i < SPIN_COUNT; ++i) {
+        if (ready())
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+    while (!ready()) {
+        timespec ts{};
+        if (deadline != nullptr) {
+            std::chrono::nanoseconds left = *deadline - Clock::now();
+            if (left.count() <= 0)
+                return false;
+            ts.tv_sec = left.count() / 1000000000;
+            ts.tv_nsec = left.count() % 1000000000;
+        }
+        uint32_t seq = w.sequence.load(std::memory_order_acquire);
+        w.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // recheck after announcing, so that a notify cannot be missed
+        if (ready()) {
+            w.sleeping.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&w.sequence),
+                FUTEX_WAIT_PRIVATE, seq,
+                (deadline != nullptr) ? &ts : nullptr, nullptr, 0);
+        w.sleeping.store(false, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/** Wakes up the other side only if it is sleeping */
+template <typename Element>
+void CircularFifo<Element>::notify(Waiter &w) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (w.sleeping.load(std::memory_order_relaxed)) {
+        w.sequence.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&w.sequence),
+                FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+}
+
+/** Locks the producer side, only if there are several producers */
+template <typename Element>
+std::unique_lock<std::mutex> CircularFifo<Element>::lockProducer() {
+    std::unique_lock<std::mutex> lock(producerMutex, std::defer_lock);
+    if (multiProducer)
+        lock.lock();
+    return lock;
 }
 
 /** Producer only: Adds item to the circular queue.
@@ -70,14 +175,23 @@ template <typename Element> int CircularFifo<Element>::getFreeValue() const {
  * \return whether operation was successful or not */
 template <typename Element>
 bool CircularFifo<Element>::push(Element *&item, bool no_block) {
-    // check for fifo full
-    if (no_block && isFull())
-        return false;
-
-    sem_wait(&free_mutex);
-    data[tail] = item;
-    tail = increment(tail);
-    sem_post(&data_mutex);
+    auto lock = lockProducer();
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - cachedHead == capacity) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (t - cachedHead == capacity) {
+            // check for fifo full
+            if (no_block || capacity == 0)
+                return false;
+            wait(freeWaiter, [&] {
+                cachedHead = head.load(std::memory_order_acquire);
+                return t - cachedHead != capacity;
+            });
+        }
+    }
+    data[t % capacity] = item;
+    tail.store(t + 1, std::memory_order_release);
+    notify(dataWaiter);
     return true;
 }
 
@@ -86,21 +200,96 @@ bool CircularFifo<Element>::push(Element *&item, bool no_block) {
  * It is up to the caller to handle this case
  *
  * \param item return by reference the wanted item
- * \param no_block if true, return immediately if fifo is full
+ * \param no_block if true, return immediately if fifo is empty
  * \return whether operation was successful or not */
 template <typename Element>
 bool CircularFifo<Element>::pop(Element *&item, bool no_block) {
-    // check for fifo empty
-    if (no_block && isEmpty())
+    Element *items[1];
+    if (pop(items, 1, no_block) == 0)
         return false;
+    item = items[0];
+    return true;
+}
 
-    sem_wait(&data_mutex);
-    item = data[head];
-    head = increment(head);
-    sem_post(&free_mutex);
+/** Producer only: Adds up to n items, never blocks, one notification
+ * for all of them
+ *
+ * \return number of items added */
+template <typename Element>
+size_t CircularFifo<Element>::push(Element **items, size_t n) {
+    auto lock = lockProducer();
+    size_t t = tail.load(std::memory_order_relaxed);
+    cachedHead = head.load(std::memory_order_acquire);
+    size_t count = capacity - (t - cachedHead);
+    if (count > n)
+        count = n;
+    if (count == 0)
+        return 0;
+    for (size_t i = 0; i < count; ++i)
+        data[(t + i) % capacity] = items[i];
+    tail.store(t + count, std::memory_order_release);
+    notify(dataWaiter);
+    return count;
+}
+
+/** Consumer only: Removes item from the queue, waiting at most timeout
+ * if it is empty
+ *
+ * \param item return by reference the wanted item
+ * \param timeout maximum time to wait for an item
+ * \return whether operation was successful or not */
+template <typename Element>
+bool CircularFifo<Element>::pop(Element *&item,
+                                std::chrono::nanoseconds timeout) {
+    Element *items[1];
+    auto deadline = Clock::now() + timeout;
+    if (pop(items, 1, false, &deadline) == 0)
+        return false;
+    item = items[0];
     return true;
 }
 
+/** Consumer only: Removes up to n items, waiting only for the first one
+ * unless no_block
+ *
+ * \return number of items removed */
+template <typename Element>
+size_t CircularFifo<Element>::pop(Element **items, size_t n, bool no_block) {
+    return pop(items, n, no_block, nullptr);
+}
+
+/** Waits for the first item till the deadline, if any */
+template <typename Element>
+size_t CircularFifo<Element>::pop(Element **items, size_t n, bool no_block,
+                                  const Clock::time_point *deadline) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (cachedTail - h < n) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (cachedTail == h) {
+            // check for fifo empty
+            if (no_block || capacity == 0 || n == 0)
+                return 0;
+            bool ready = wait(
+                dataWaiter,
+                [&] {
+                    cachedTail = tail.load(std::memory_order_acquire);
+                    return cachedTail != h;
+                },
+                deadline);
+            if (!ready)
+                return 0;
+        }
+    }
+    size_t count = cachedTail - h;
+    if (count > n)
+        count = n;
+    for (size_t i = 0; i < count; ++i)
+        items[i] = data[(h + i) % capacity];
+    head.store(h + count, std::memory_order_release);
+    notify(freeWaiter);
+    return count;
+}
+
 /** Useful for testing and Consumer check of status
  * Remember that the 'empty' status can change quickly
  * as the Producer adds more items.
@@ -119,15 +308,4 @@ template <typename Element> bool CircularFifo<Element>::isFull() const {
     return (getFreeValue() == 0);
 }
 
-/** Increment helper function for index of the circular queue
- * index is incremented or wrapped
- *
- *  \param i the index to the incremented/wrapped
- *  \return new value for the index */
-template <typename Element>
-size_t CircularFifo<Element>::increment(size_t i) const {
-    i = (i + 1) % capacity;
-    return i;
-}
-
-} // namespace sls
\ No newline at end of file
+} // namespace sls
@@ -5,9 +5,14 @@
  ***********************************************/
 
 #include "BinaryFile.h"
+#include "Compressor.h"
+#include "DirectWriter.h"
+#include "UringWriter.h"
 #include "Fifo.h"
+#include "FileRotation.h"
 #include "MasterAttributes.h"
 #include "receiver_defs.h"
+#include "sls/container_utils.h"
 
 #include <iomanip>
 #include <iostream>
@@ -18,9 +23,11 @@ FILE *BinaryFile::masterfd = nullptr;
 BinaryFile::BinaryFile(int ind, uint32_t *maxf, int *nd, std::string *fname,
                        std::string *fpath, uint64_t *findex, bool *owenable,
                        int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
-                       uint32_t *portno, bool *smode)
+                       uint32_t *portno, bool *smode, bool *dio, bool *uring,
+                       Compressor *comp)
     : File(ind, BINARY, maxf, nd, fname, fpath, findex, owenable, dindex,
-           nunits, nf, dr, portno, smode) {
+           nunits, nf, dr, portno, smode),
+      directIO(dio), ioUring(uring), compressor(comp) {
 #ifdef VERBOSE
     PrintMembers();
 #endif
@@ -34,41 +41,188 @@ void BinaryFile::PrintMembers(TLogLevel level) {
     LOG(logINFO) << "Number of Frames in File: " << numFramesInFile;
 }
 
-void BinaryFile::CreateFile() {
-    numFramesInFile = 0;
-    numActualPacketsInFile = 0;
-
+std::string BinaryFile::GetFileName(uint32_t subIndex) const {
     std::ostringstream os;
     os << *filePath << "/" << *fileNamePrefix << "_d"
-       << (*detIndex * (*numUnitsPerDetector) + index) << "_f" << subFileIndex
+       << (*detIndex * (*numUnitsPerDetector) + index) << "_f" << subIndex
        << '_' << *fileIndex << ".raw";
-    currentFileName = os.str();
+    return os.str();
+}
+
+void BinaryFile::CreateFile() {
+    currentFileName = GetFileName(subFileIndex);
+
+    bool compress = (compressor != nullptr && compressor->IsEnabled());
+    if (compress && *ioUring && !(*silentMode)) {
+        LOG(logWARNING) << "[" << *udpPortNumber
+                        << "]: io_uring does not write compressed files";
+    }
+
+    // writes straight from the fifo buffers, only with a contiguous bitset
+    if (*ioUring && !uringUnavailable && !compress &&
+        sizeof(sls_bitset) == sizeof(bitset_storage)) {
+        if (uringWriter == nullptr) {
+            try {
+                uringWriter = sls::make_unique<UringWriter>();
+            } catch (const sls::RuntimeError &e) {
+                LOG(logWARNING) << e.what() << ", using binary file writer";
+                uringUnavailable = true;
+            }
+        }
+        if (uringWriter != nullptr) {
+            if (bufferMemory != nullptr) {
+                uringWriter->RegisterBuffers(bufferMemory, bufferMemorySize);
+            }
+            uringWriter->Open(currentFileName, *overWriteEnable);
+            SetupNewFile();
+            return;
+        }
+    }
+
+    if (!(*directIO)) {
+        // no staging buffers when not needed
+        directWriter.reset();
+        nextDirectWriter.reset();
+        oldDirectWriter.reset();
+    }
+    OpenDataFile(currentFileName, filefd, directWriter);
+    SetupNewFile();
+    PrepareNextFile();
+}
+
+void BinaryFile::OpenDataFile(const std::string &fname, FILE *&fd,
+                              std::unique_ptr<DirectWriter> &writer) {
+    if (*directIO) {
+        if (writer == nullptr) {
+            writer = sls::make_unique<DirectWriter>();
+        }
+        writer->Open(fname, *overWriteEnable);
+        return;
+    }
 
     if (!(*overWriteEnable)) {
-        if (nullptr ==
-            (filefd = fopen((const char *)currentFileName.c_str(), "wx"))) {
-            filefd = nullptr;
+        if (nullptr == (fd = fopen((const char *)fname.c_str(), "wx"))) {
+            fd = nullptr;
             throw sls::RuntimeError("Could not create/overwrite file " +
-                                    currentFileName);
+                                    fname);
         }
-    } else if (nullptr ==
-               (filefd = fopen((const char *)currentFileName.c_str(), "w"))) {
-        filefd = nullptr;
-        throw sls::RuntimeError("Could not create file " + currentFileName);
+    } else if (nullptr == (fd = fopen((const char *)fname.c_str(), "w"))) {
+        fd = nullptr;
+        throw sls::RuntimeError("Could not create file " + fname);
     }
     // setting to no file buffering
-    setvbuf(filefd, nullptr, _IONBF, 0);
+    setvbuf(fd, nullptr, _IONBF, 0);
+}
+
+void BinaryFile::SetupNewFile() {
+    numFramesInFile = 0;
+    numActualPacketsInFile = 0;
+    compressedFile = (compressor != nullptr && compressor->IsEnabled() &&
+                      !(uringWriter && uringWriter->IsOpen()));
+    fileOffset = 0;
+    recordOffsets.clear();
 
     if (!(*silentMode)) {
-        LOG(logINFO) << "[" << *udpPortNumber
-                     << "]: Binary File created: " << currentFileName;
+        std::string mode;
+        if (uringWriter && uringWriter->IsOpen()) {
+            mode = " (io_uring)";
+        } else if (directWriter && directWriter->IsOpen() &&
+                   directWriter->IsDirect()) {
+            mode = " (direct io)";
+        }
+        LOG(logINFO) << "[" << *udpPortNumber << "]: Binary File created"
+                     << mode << ": " << currentFileName;
+    }
+}
+
+void BinaryFile::PrepareNextFile() {
+    // io_uring files are closed inline, once their writes are completed
+    if ((uringWriter && uringWriter->IsOpen()) ||
+        !FileRotation::HasNextFile(subFileIndex, *maxFramesPerFile,
+                                   *numImages)) {
+        return;
+    }
+    if (rotation == nullptr) {
+        rotation =
+            sls::make_unique<FileRotation>(std::to_string(*udpPortNumber));
+    }
+    std::string fname = GetFileName(subFileIndex + 1);
+    rotation->PrepareNext(fname, [this, fname]() {
+        OpenDataFile(fname, nextFilefd, nextDirectWriter);
+    });
+}
+
+bool BinaryFile::IsNextFileOpen() const {
+    return (nextFilefd != nullptr ||
+            (nextDirectWriter && nextDirectWriter->IsOpen()));
+}
+
+void BinaryFile::RotateFile() {
+    std::string fname;
+    if (rotation != nullptr) {
+        fname = rotation->TakeNext([this]() { return IsNextFileOpen(); });
+    }
+    if (fname.empty()) {
+        CloseCurrentFile();
+        ++subFileIndex;
+        CreateFile();
+        return;
+    }
+
+    if (compressedFile) {
+        WriteIndex();
+    }
+    // swap to the next file, the current one is closed in the background
+    oldFilefd = filefd;
+    filefd = nextFilefd;
+    nextFilefd = nullptr;
+    std::swap(oldDirectWriter, directWriter);
+    std::swap(directWriter, nextDirectWriter);
+    rotation->Queue([this]() {
+        if (oldFilefd) {
+            fclose(oldFilefd);
+            oldFilefd = nullptr;
+        }
+        if (oldDirectWriter) {
+            oldDirectWriter->Close();
+        }
+    });
+
+    ++subFileIndex;
+    currentFileName = fname;
+    SetupNewFile();
+    PrepareNextFile();
+}
+
+void BinaryFile::DiscardNextFile() {
+    if (rotation == nullptr) {
+        return;
     }
+    rotation->DiscardNext([this]() {
+        bool opened = IsNextFileOpen();
+        if (nextFilefd) {
+            fclose(nextFilefd);
+            nextFilefd = nullptr;
+        }
+        if (nextDirectWriter) {
+            nextDirectWriter->Close();
+        }
+        return opened;
+    });
 }
 
 void BinaryFile::CloseCurrentFile() {
+    DiscardNextFile();
+    if (compressedFile) {
+        WriteIndex();
+    }
     if (filefd)
         fclose(filefd);
     filefd = nullptr;
+    if (directWriter)
+        directWriter->Close();
+    if (uringWriter)
+        uringWriter->Close();
 }
 
 void BinaryFile::CloseAllFiles() {
@@ -81,6 +235,12 @@ void BinaryFile::CloseAllFiles() {
 }
 
 int BinaryFile::WriteData(char *buf, int bsize) {
+    if (uringWriter && uringWriter->IsOpen()) {
+        uringWriter->Write(buf, bsize);
+        return bsize;
+    }
+    if (directWriter && directWriter->IsOpen())
+        return directWriter->Write(buf, bsize);
     if (!filefd)
         return 0;
     return fwrite(buf, 1, bsize, filefd);
@@ -91,13 +251,20 @@ void BinaryFile::WriteToFile(char *buffer, int buffersize,
                              uint32_t numPacketsCaught) {
     // check if maxframesperfile = 0 for infinite
     if ((*maxFramesPerFile) && (numFramesInFile >= (*maxFramesPerFile))) {
-        CloseCurrentFile();
-        ++subFileIndex;
-        CreateFile();
+        RotateFile();
+    }
+    // disk space for all frames of the file
+    if (numFramesInFile == 0 && uringWriter && uringWriter->IsOpen()) {
+        uringWriter->Preallocate((size_t)(*maxFramesPerFile) * buffersize);
     }
     numFramesInFile++;
     numActualPacketsInFile += numPacketsCaught;
 
+    if (compressedFile) {
+        WriteCompressed(buffer, buffersize, currentFrameNumber);
+        return;
+    }
+
     // write to file
     int ret = 0;
 
@@ -108,20 +275,10 @@ void BinaryFile::WriteToFile(char *buffer, int buffersize,
 
     // not contiguous bitset
     else {
-        // write detector header
-        ret = WriteData(buffer, sizeof(sls_detector_header));
-
-        // get contiguous representation of bit mask
-        bitset_storage storage;
-        memset(storage, 0, sizeof(bitset_storage));
-        sls_bitset bits = *(sls_bitset *)(buffer + sizeof(sls_detector_header));
-        for (int i = 0; i < MAX_NUM_PACKETS; ++i)
-            storage[i >> 3] |= (bits[i] << (i & 7));
-        // write bitmask
-        ret += WriteData((char *)storage, sizeof(bitset_storage));
-
-        // write data
-        ret += WriteData(buffer + sizeof(sls_detector_header),
+        ret = WriteHeader(buffer);
+
+        // write data, after the whole receiver header (bitmask included)
+        ret += WriteData(buffer + sizeof(sls_receiver_header),
                          buffersize - sizeof(sls_receiver_header));
     }
 
@@ -133,6 +290,104 @@ void BinaryFile::WriteToFile(char *buffer, int buffersize,
     }
 }
 
+size_t BinaryFile::ElementSize() const {
+    if (*dynamicRange == 32) {
+        return 4;
+    }
+    if (*dynamicRange == 16) {
+        return 2;
+    }
+    // 4 and 8 bit pixels as bytes
+    return 1;
+}
+
+int BinaryFile::WriteHeader(char *buffer) {
+    if (sizeof(sls_bitset) == sizeof(bitset_storage)) {
+        return WriteData(buffer, sizeof(sls_receiver_header));
+    }
+    // write detector header
+    int ret = WriteData(buffer, sizeof(sls_detector_header));
+
+    // get contiguous representation of bit mask
+    bitset_storage storage;
+    memset(storage, 0, sizeof(bitset_storage));
+    sls_bitset bits = *(sls_bitset *)(buffer + sizeof(sls_detector_header));
+    for (int i = 0; i < MAX_NUM_PACKETS; ++i)
+        storage[i >> 3] |= (bits[i] << (i & 7));
+    // write bitmask
+    ret += WriteData((char *)storage, sizeof(bitset_storage));
+    return ret;
+}
+
+void BinaryFile::WriteCompressed(char *buffer, int buffersize,
+                                 uint64_t currentFrameNumber) {
+    size_t imageSize = buffersize - sizeof(sls_receiver_header);
+    size_t packedSize = 0;
+    const char *packed =
+        compressor->Compress(buffer + sizeof(sls_receiver_header), imageSize,
+                             ElementSize(), packedSize);
+
+    // frame record: header, compressed size, compressed image
+    recordOffsets.push_back(fileOffset);
+    uint64_t size = packedSize;
+    size_t recordSize =
+        sizeof(sls_detector_header) + sizeof(bitset_storage) + sizeof(size) +
+        packedSize;
+    size_t ret = WriteHeader(buffer);
+    ret += WriteData((char *)&size, sizeof(size));
+    ret += WriteData(const_cast<char *>(packed), packedSize);
+    fileOffset += ret;
+    if (ret != recordSize) {
+        throw sls::RuntimeError(std::to_string(index) +
+                                " : Write to file failed for image number " +
+                                std::to_string(currentFrameNumber));
+    }
+}
+
+void BinaryFile::WriteIndex() {
+    compressedFile = false;
+    if (filefd == nullptr && !(directWriter && directWriter->IsOpen())) {
+        return;
+    }
+    compressed_file_trailer trailer{};
+    memcpy(trailer.magic, COMPRESSED_FILE_MAGIC, sizeof(trailer.magic));
+    trailer.version = COMPRESSED_FILE_VERSION;
+    trailer.compression = compressor->GetType();
+    trailer.elementSize = ElementSize();
+    trailer.numFrames = recordOffsets.size();
+    trailer.indexOffset = fileOffset;
+    size_t indexSize = recordOffsets.size() * sizeof(uint64_t);
+    size_t ret = 0;
+    try {
+        ret = WriteData((char *)recordOffsets.data(), indexSize);
+        ret += WriteData((char *)&trailer, sizeof(trailer));
+    } catch (const sls::RuntimeError &e) {
+        LOG(logERROR) << e.what();
+    }
+    if (ret != indexSize + sizeof(trailer)) {
+        LOG(logERROR) << index << " : Could not write index of compressed file "
+                      << currentFileName;
+    }
+}
+
+void BinaryFile::SetBufferMemory(char *memory, size_t size, int fd) {
+    bufferMemory = memory;
+    bufferMemorySize = size;
+    // unregister freed memory
+    if (memory == nullptr && uringWriter != nullptr && !uringWriter->IsOpen()) {
+        uringWriter.reset();
+    }
+}
+
+bool BinaryFile::HasPendingWrites() const {
+    return (uringWriter && uringWriter->HasPending());
+}
+
+void BinaryFile::GetCompletedWrites(std::vector<char *> &buffers, bool wait) {
+    if (uringWriter)
+        uringWriter->GetCompleted(buffers, wait);
+}
+
 void BinaryFile::CreateMasterFile(bool masterFileWriteEnable,
                                   MasterAttributes *attr) {
     // beginning of every acquisition
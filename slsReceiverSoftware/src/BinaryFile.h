@@ -11,8 +11,14 @@
 
 #include "File.h"
 
+#include <memory>
 #include <string>
 
+class Compressor;
+class DirectWriter;
+class FileRotation;
+class UringWriter;
+
 class BinaryFile : private virtual slsDetectorDefs, public File {
 
   public:
@@ -32,11 +38,15 @@ class BinaryFile : private virtual slsDetectorDefs, public File {
      * @param dr pointer to dynamic range
      * @param portno pointer to udp port number for logging
      * @param smode pointer to silent mode
+     * @param dio pointer to direct io enable
+     * @param uring pointer to io_uring enable
+     * @param comp compressor of the images (nullptr for none)
      */
     BinaryFile(int ind, uint32_t *maxf, int *nd, std::string *fname,
                std::string *fpath, uint64_t *findex, bool *owenable,
                int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
-               uint32_t *portno, bool *smode);
+               uint32_t *portno, bool *smode, bool *dio, bool *uring,
+               Compressor *comp = nullptr);
     ~BinaryFile();
 
     void PrintMembers(TLogLevel level = logDEBUG1) override;
@@ -47,12 +57,70 @@ class BinaryFile : private virtual slsDetectorDefs, public File {
     void CloseAllFiles() override;
     void WriteToFile(char *buffer, int buffersize, uint64_t currentFrameNumber,
                      uint32_t numPacketsCaught) override;
+    void SetBufferMemory(char *memory, size_t size, int fd) override;
+    bool HasPendingWrites() const override;
+    void GetCompletedWrites(std::vector<char *> &buffers, bool wait) override;
 
   private:
+    /** name of a sub file of the acquisition */
+    std::string GetFileName(uint32_t subIndex) const;
+    /** opens a data file, with direct io if enabled */
+    void OpenDataFile(const std::string &fname, FILE *&fd,
+                      std::unique_ptr<DirectWriter> &writer);
+    /** resets the file counters and logs the file created */
+    void SetupNewFile();
+    /** opens the next sub file in the background if the acquisition has
+     * more images than fit in the current one */
+    void PrepareNextFile();
+    /** true if the next sub file was opened */
+    bool IsNextFileOpen() const;
+    /** closes the current file in the background and continues with the
+     * next one, created inline if it could not be prepared */
+    void RotateFile();
+    /** closes the next file if it was prepared but not used, removed if
+     * it did not exist before */
+    void DiscardNextFile();
     int WriteData(char *buf, int bsize);
+    /** size of a pixel to compress */
+    size_t ElementSize() const;
+    /** writes the receiver header with a contiguous bitset */
+    int WriteHeader(char *buffer);
+    /** writes a frame record of a compressed file */
+    void WriteCompressed(char *buffer, int buffersize,
+                         uint64_t currentFrameNumber);
+    /** writes the index of the frame records and the trailer of a
+     * compressed file, errors are logged */
+    void WriteIndex();
 
     FILE *filefd = nullptr;
+    /** direct io enable */
+    bool *directIO;
+    /** writer of the current file with direct io */
+    std::unique_ptr<DirectWriter> directWriter;
+    /** io_uring enable */
+    bool *ioUring;
+    /** asynchronous writer of the current file with io_uring */
+    std::unique_ptr<UringWriter> uringWriter;
+    /** io_uring not supported by the kernel */
+    bool uringUnavailable{false};
+    /** memory of the buffers to write, registered with io_uring */
+    char *bufferMemory{nullptr};
+    size_t bufferMemorySize{0};
     static FILE *masterfd;
     uint32_t numFramesInFile = 0;
     uint64_t numActualPacketsInFile = 0;
+    Compressor *compressor;
+    /** current file is compressed, with an index of its frame records */
+    bool compressedFile{false};
+    uint64_t fileOffset{0};
+    std::vector<uint64_t> recordOffsets;
+
+    /** opens the next sub file and closes the previous one */
+    std::unique_ptr<FileRotation> rotation;
+    /** next sub file, opened in the background */
+    FILE *nextFilefd{nullptr};
+    std::unique_ptr<DirectWriter> nextDirectWriter;
+    /** previous sub file, closed in the background */
+    FILE *oldFilefd{nullptr};
+    std::unique_ptr<DirectWriter> oldDirectWriter;
 };
\ No newline at end of file
@@ -208,6 +208,64 @@ int ClientInterface::functionTable(){
     flist[F_RECEIVER_SET_THRESHOLD]         =   &ClientInterface::set_threshold;
     flist[F_GET_RECEIVER_STREAMING_HWM]     =   &ClientInterface::get_streaming_hwm;
     flist[F_SET_RECEIVER_STREAMING_HWM]     =   &ClientInterface::set_streaming_hwm;
+    flist[F_GET_RECEIVER_UDP_BATCH_SIZE]    =   &ClientInterface::get_udp_batch_size;
+    flist[F_SET_RECEIVER_UDP_BATCH_SIZE]    =   &ClientInterface::set_udp_batch_size;
+    flist[F_GET_RECEIVER_UDP_ZERO_COPY]     =   &ClientInterface::get_udp_zero_copy;
+    flist[F_SET_RECEIVER_UDP_ZERO_COPY]     =   &ClientInterface::set_udp_zero_copy;
+    flist[F_GET_RECEIVER_UDP_BACKEND]       =   &ClientInterface::get_udp_backend;
+    flist[F_SET_RECEIVER_UDP_BACKEND]       =   &ClientInterface::set_udp_backend;
+    flist[F_GET_RECEIVER_FIFO_HUGEPAGES]    =   &ClientInterface::get_fifo_hugepages;
+    flist[F_SET_RECEIVER_FIFO_HUGEPAGES]    =   &ClientInterface::set_fifo_hugepages;
+    flist[F_GET_RECEIVER_FIFO_MLOCK]        =   &ClientInterface::get_fifo_mlock;
+    flist[F_SET_RECEIVER_FIFO_MLOCK]        =   &ClientInterface::set_fifo_mlock;
+    flist[F_GET_RECEIVER_THREAD_AFFINITY]   =   &ClientInterface::get_thread_affinity;
+    flist[F_SET_RECEIVER_THREAD_AFFINITY]   =   &ClientInterface::set_thread_affinity;
+    flist[F_GET_RECEIVER_UDP_THREADS]       =   &ClientInterface::get_udp_threads;
+    flist[F_SET_RECEIVER_UDP_THREADS]       =   &ClientInterface::set_udp_threads;
+    flist[F_GET_RECEIVER_FRAME_WINDOW]      =   &ClientInterface::get_frame_window;
+    flist[F_SET_RECEIVER_FRAME_WINDOW]      =   &ClientInterface::set_frame_window;
+    flist[F_GET_RECEIVER_FRAME_TIMEOUT]     =   &ClientInterface::get_frame_timeout;
+    flist[F_SET_RECEIVER_FRAME_TIMEOUT]     =   &ClientInterface::set_frame_timeout;
+    flist[F_GET_RECEIVER_FILE_DIRECT_IO]    =   &ClientInterface::get_file_direct_io;
+    flist[F_SET_RECEIVER_FILE_DIRECT_IO]    =   &ClientInterface::set_file_direct_io;
+    flist[F_GET_RECEIVER_FILE_IO_URING]     =   &ClientInterface::get_file_io_uring;
+    flist[F_SET_RECEIVER_FILE_IO_URING]     =   &ClientInterface::set_file_io_uring;
+    flist[F_GET_RECEIVER_HDF5_CHUNK_FRAMES] =   &ClientInterface::get_hdf5_chunk_frames;
+    flist[F_SET_RECEIVER_HDF5_CHUNK_FRAMES] =   &ClientInterface::set_hdf5_chunk_frames;
+    flist[F_GET_RECEIVER_HDF5_CHUNK_ROWS]   =   &ClientInterface::get_hdf5_chunk_rows;
+    flist[F_SET_RECEIVER_HDF5_CHUNK_ROWS]   =   &ClientInterface::set_hdf5_chunk_rows;
+    flist[F_GET_RECEIVER_HDF5_COMPOUND_HEADER] =   &ClientInterface::get_hdf5_compound_header;
+    flist[F_SET_RECEIVER_HDF5_COMPOUND_HEADER] =   &ClientInterface::set_hdf5_compound_header;
+    flist[F_GET_RECEIVER_HDF5_WRITER_PROCESS] =   &ClientInterface::get_hdf5_writer_process;
+    flist[F_SET_RECEIVER_HDF5_WRITER_PROCESS] =   &ClientInterface::set_hdf5_writer_process;
+    flist[F_GET_RECEIVER_HDF5_SWMR]         =   &ClientInterface::get_hdf5_swmr;
+    flist[F_SET_RECEIVER_HDF5_SWMR]         =   &ClientInterface::set_hdf5_swmr;
+    flist[F_GET_RECEIVER_HDF5_FLUSH_FRAMES] =   &ClientInterface::get_hdf5_flush_frames;
+    flist[F_SET_RECEIVER_HDF5_FLUSH_FRAMES] =   &ClientInterface::set_hdf5_flush_frames;
+    flist[F_GET_RECEIVER_HDF5_FLUSH_TIME]   =   &ClientInterface::get_hdf5_flush_time;
+    flist[F_SET_RECEIVER_HDF5_FLUSH_TIME]   =   &ClientInterface::set_hdf5_flush_time;
+    flist[F_GET_RECEIVER_FILE_COMPRESSION]  =   &ClientInterface::get_file_compression;
+    flist[F_SET_RECEIVER_FILE_COMPRESSION]  =   &ClientInterface::set_file_compression;
+    flist[F_GET_RECEIVER_COMPRESSION_THREADS] =   &ClientInterface::get_compression_threads;
+    flist[F_SET_RECEIVER_COMPRESSION_THREADS] =   &ClientInterface::set_compression_threads;
+    flist[F_GET_RECEIVER_STREAMING_ZERO_COPY] =   &ClientInterface::get_streaming_zero_copy;
+    flist[F_SET_RECEIVER_STREAMING_ZERO_COPY] =   &ClientInterface::set_streaming_zero_copy;
+    flist[F_GET_RECEIVER_STREAMING_BINARY_HEADER] = &ClientInterface::get_streaming_binary_header;
+    flist[F_SET_RECEIVER_STREAMING_BINARY_HEADER] = &ClientInterface::set_streaming_binary_header;
+    flist[F_GET_RECEIVER_STREAMING_PREVIEW_BINNING] = &ClientInterface::get_streaming_preview_binning;
+    flist[F_SET_RECEIVER_STREAMING_PREVIEW_BINNING] = &ClientInterface::set_streaming_preview_binning;
+    flist[F_GET_RECEIVER_STREAMING_PREVIEW_MODE] = &ClientInterface::get_streaming_preview_mode;
+    flist[F_SET_RECEIVER_STREAMING_PREVIEW_MODE] = &ClientInterface::set_streaming_preview_mode;
+    flist[F_GET_RECEIVER_STREAMING_PREVIEW_TIMER] = &ClientInterface::get_streaming_preview_timer;
+    flist[F_SET_RECEIVER_STREAMING_PREVIEW_TIMER] = &ClientInterface::set_streaming_preview_timer;
+    flist[F_GET_RECEIVER_STREAMING_PREVIEW_PORT] = &ClientInterface::get_streaming_preview_port;
+    flist[F_SET_RECEIVER_STREAMING_PREVIEW_PORT] = &ClientInterface::set_streaming_preview_port;
+    flist[F_GET_RECEIVER_STREAMING_SOCKET_TYPE] = &ClientInterface::get_streaming_socket_type;
+    flist[F_SET_RECEIVER_STREAMING_SOCKET_TYPE] = &ClientInterface::set_streaming_socket_type;
+    flist[F_GET_RECEIVER_STREAMING_PUSH_PORT] = &ClientInterface::get_streaming_push_port;
+    flist[F_SET_RECEIVER_STREAMING_PUSH_PORT] = &ClientInterface::set_streaming_push_port;
+    flist[F_GET_RECEIVER_STREAMING_BANDWIDTH] = &ClientInterface::get_streaming_bandwidth;
+    flist[F_SET_RECEIVER_STREAMING_BANDWIDTH] = &ClientInterface::set_streaming_bandwidth;
 
 	for (int i = NUM_DET_FUNCTIONS + 1; i < NUM_REC_FUNCTIONS ; i++) {
 		LOG(logDEBUG1) << "function fnum: " << i << " (" <<
@@ -1677,3 +1735,553 @@ int ClientInterface::set_streaming_hwm(Interface &socket) {
     impl()->setStreamingHwm(limit);
     return socket.Send(OK);
 }
+
+int ClientInterface::get_udp_batch_size(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getUDPBatchSize());
+    LOG(logDEBUG1) << "udp batch size:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_udp_batch_size(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 1 || value > MAX_UDP_BATCH_SIZE) {
+        throw RuntimeError("Invalid udp batch size " + std::to_string(value) +
+                           ". Options [1 - " +
+                           std::to_string(MAX_UDP_BATCH_SIZE) + "]");
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting udp batch size:" << value;
+    impl()->setUDPBatchSize(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_udp_zero_copy(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getUDPZeroCopy());
+    LOG(logDEBUG1) << "udp zero copy:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_udp_zero_copy(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid udp zero copy enable: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting udp zero copy:" << enable;
+    impl()->setUDPZeroCopy(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_udp_backend(Interface &socket) {
+    int retval = impl()->getUDPBackend();
+    LOG(logDEBUG1) << "udp backend:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_udp_backend(Interface &socket) {
+    auto index = socket.Receive<int>();
+    if (index < 0 || index >= NUM_UDP_BACKENDS) {
+        throw RuntimeError("Invalid udp backend " + std::to_string(index));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting udp backend:" << index;
+    impl()->setUDPBackend(static_cast<udpBackend>(index));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_fifo_hugepages(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFifoHugePages());
+    LOG(logDEBUG1) << "fifo huge pages:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_fifo_hugepages(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid fifo huge pages: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting fifo huge pages:" << enable;
+    impl()->setFifoHugePages(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_fifo_mlock(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFifoMemoryLock());
+    LOG(logDEBUG1) << "fifo memory lock:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_fifo_mlock(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid fifo memory lock: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting fifo memory lock:" << enable;
+    impl()->setFifoMemoryLock(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_thread_affinity(Interface &socket) {
+    int args[2]{-1, -1};
+    socket.Receive(args);
+    auto type = static_cast<rxThreadType>(args[0]);
+    int index = args[1];
+    if (args[0] < 0 || args[0] >= NUM_RX_THREAD_TYPES) {
+        throw RuntimeError("Invalid receiver thread type " +
+                           std::to_string(args[0]));
+    }
+    if (index < 0 || index >= MAX_NUMBER_OF_LISTENING_THREADS ||
+        (type == TCP_THREAD && index != 0)) {
+        throw RuntimeError("Invalid receiver thread index " +
+                           std::to_string(index));
+    }
+    auto retval = impl()->getThreadAffinity(type, index);
+    LOG(logDEBUG1) << "thread affinity:" << sls::ToString(retval);
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_thread_affinity(Interface &socket) {
+    auto arg = socket.Receive<rxThreadAffinity>();
+    LOG(logDEBUG1) << "Setting thread affinity:" << sls::ToString(arg);
+    if (arg.thread < 0 || arg.thread >= NUM_RX_THREAD_TYPES) {
+        throw RuntimeError("Invalid receiver thread type " +
+                           std::to_string(arg.thread));
+    }
+    if (arg.index < 0 || arg.index >= MAX_NUMBER_OF_LISTENING_THREADS ||
+        (arg.thread == TCP_THREAD && arg.index != 0)) {
+        throw RuntimeError("Invalid receiver thread index " +
+                           std::to_string(arg.index));
+    }
+    if (arg.policy < 0 || arg.policy >= NUM_RX_SCHED_POLICIES) {
+        throw RuntimeError("Invalid scheduling policy " +
+                           std::to_string(arg.policy));
+    }
+    if ((arg.policy == RX_SCHED_FIFO &&
+         (arg.priority < 1 || arg.priority > 99)) ||
+        (arg.policy == RX_SCHED_OTHER && arg.priority != 0)) {
+        throw RuntimeError("Invalid priority " + std::to_string(arg.priority) +
+                           " for scheduling policy " +
+                           sls::ToString(arg.policy) +
+                           ". Options: fifo [1-99], other [0]");
+    }
+    verifyIdle(socket);
+    impl()->setThreadAffinity(arg);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_udp_threads(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getUDPThreads());
+    LOG(logDEBUG1) << "udp threads:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_udp_threads(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 1 || value > MAX_UDP_THREADS_PER_PORT) {
+        throw RuntimeError("Invalid udp threads " + std::to_string(value) +
+                           ". Options [1 - " +
+                           std::to_string(MAX_UDP_THREADS_PER_PORT) + "]");
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting udp threads:" << value;
+    impl()->setUDPThreads(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_frame_window(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFrameWindow());
+    LOG(logDEBUG1) << "frame window:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_frame_window(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 1 || value > MAX_FRAME_WINDOW) {
+        throw RuntimeError("Invalid frame window " + std::to_string(value) +
+                           ". Options [1 - " +
+                           std::to_string(MAX_FRAME_WINDOW) + "]");
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting frame window:" << value;
+    impl()->setFrameWindow(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_frame_timeout(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFrameTimeout());
+    LOG(logDEBUG1) << "frame timeout:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_frame_timeout(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 0) {
+        throw RuntimeError("Invalid frame timeout " + std::to_string(value));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting frame timeout:" << value;
+    impl()->setFrameTimeout(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_file_direct_io(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFileDirectIO());
+    LOG(logDEBUG1) << "file direct io:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_file_direct_io(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid file direct io: " + std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting file direct io:" << enable;
+    impl()->setFileDirectIO(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_file_io_uring(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getFileIoUring());
+    LOG(logDEBUG1) << "file io_uring:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_file_io_uring(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid file io_uring: " + std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting file io_uring:" << enable;
+    impl()->setFileIoUring(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_chunk_frames(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5ChunkFrames());
+    LOG(logDEBUG1) << "hdf5 chunk frames:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_chunk_frames(Interface &socket) {
+    auto value = socket.Receive<int>();
+    auto maxValue = impl()->getHdf5MaxChunkFrames();
+    if (value < 1 || (uint32_t)value > maxValue) {
+        throw RuntimeError("Invalid number of images per chunk " +
+                           std::to_string(value) + ". Options [1-" +
+                           std::to_string(maxValue) +
+                           "] (chunk below 4 GiB, at most frames per file)");
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 chunk frames:" << value;
+    impl()->setHdf5ChunkFrames(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_chunk_rows(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5ChunkRows());
+    LOG(logDEBUG1) << "hdf5 chunk rows:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_chunk_rows(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 0) {
+        throw RuntimeError("Invalid number of rows per chunk " +
+                           std::to_string(value));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 chunk rows:" << value;
+    impl()->setHdf5ChunkRows(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_compound_header(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5CompoundHeader());
+    LOG(logDEBUG1) << "hdf5 compound header:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_compound_header(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid hdf5 compound header: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 compound header:" << enable;
+    impl()->setHdf5CompoundHeader(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_writer_process(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5WriterProcess());
+    LOG(logDEBUG1) << "hdf5 writer process:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_writer_process(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid hdf5 writer process: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 writer process:" << enable;
+    impl()->setHdf5WriterProcess(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_swmr(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5Swmr());
+    LOG(logDEBUG1) << "hdf5 swmr:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_swmr(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid hdf5 swmr: " + std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 swmr:" << enable;
+    impl()->setHdf5Swmr(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_flush_frames(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5FlushFrames());
+    LOG(logDEBUG1) << "hdf5 swmr flush frames:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_flush_frames(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 0) {
+        throw RuntimeError("Invalid number of images between swmr flushes " +
+                           std::to_string(value));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 swmr flush frames:" << value;
+    impl()->setHdf5FlushFrames(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_hdf5_flush_time(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getHdf5FlushTime());
+    LOG(logDEBUG1) << "hdf5 swmr flush time:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_hdf5_flush_time(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 0) {
+        throw RuntimeError("Invalid time between swmr flushes " +
+                           std::to_string(value));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting hdf5 swmr flush time:" << value;
+    impl()->setHdf5FlushTime(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_file_compression(Interface &socket) {
+    int retval = impl()->getFileCompression();
+    LOG(logDEBUG1) << "file compression:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_file_compression(Interface &socket) {
+    auto index = socket.Receive<int>();
+    if (index < 0 || index >= NUM_FILE_COMPRESSIONS) {
+        throw RuntimeError("Invalid file compression " + std::to_string(index));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting file compression:" << index;
+    impl()->setFileCompression(static_cast<fileCompression>(index));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_compression_threads(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getCompressionThreads());
+    LOG(logDEBUG1) << "compression threads:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_compression_threads(Interface &socket) {
+    auto value = socket.Receive<int>();
+    if (value < 0 || value > MAX_COMPRESSION_THREADS) {
+        throw RuntimeError("Invalid number of compression threads " +
+                           std::to_string(value));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting compression threads:" << value;
+    impl()->setCompressionThreads(value);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_zero_copy(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingZeroCopy());
+    LOG(logDEBUG1) << "streaming zero copy:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_zero_copy(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid streaming zero copy enable: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming zero copy:" << enable;
+    impl()->setStreamingZeroCopy(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_binary_header(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingBinaryHeader());
+    LOG(logDEBUG1) << "streaming binary header:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_binary_header(Interface &socket) {
+    auto enable = socket.Receive<int>();
+    if (enable < 0) {
+        throw RuntimeError("Invalid streaming binary header enable: " +
+                           std::to_string(enable));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming binary header:" << enable;
+    impl()->setStreamingBinaryHeader(static_cast<bool>(enable));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_preview_binning(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingPreviewBinning());
+    LOG(logDEBUG1) << "streaming preview binning:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_preview_binning(Interface &socket) {
+    auto factor = socket.Receive<int>();
+    if (factor < 0 || factor > MAX_PREVIEW_BINNING) {
+        throw RuntimeError("Invalid streaming preview binning " +
+                           std::to_string(factor));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming preview binning:" << factor;
+    impl()->setStreamingPreviewBinning(factor);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_preview_mode(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingPreviewMode());
+    LOG(logDEBUG1) << "streaming preview mode:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_preview_mode(Interface &socket) {
+    auto mode = socket.Receive<int>();
+    if (mode < 0 || mode >= NUM_PREVIEW_MODES) {
+        throw RuntimeError("Invalid streaming preview mode " +
+                           std::to_string(mode));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming preview mode:" << mode;
+    impl()->setStreamingPreviewMode(static_cast<previewMode>(mode));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_preview_timer(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingPreviewTimer());
+    LOG(logDEBUG1) << "streaming preview timer:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_preview_timer(Interface &socket) {
+    auto time_in_ms = socket.Receive<int>();
+    if (time_in_ms < 0) {
+        throw RuntimeError("Invalid streaming preview timer " +
+                           std::to_string(time_in_ms));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming preview timer:" << time_in_ms;
+    impl()->setStreamingPreviewTimer(time_in_ms);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_preview_port(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingPreviewPort());
+    LOG(logDEBUG1) << "streaming preview port:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_preview_port(Interface &socket) {
+    auto port = socket.Receive<int>();
+    if (port < 0) {
+        throw RuntimeError("Invalid zmq preview port " + std::to_string(port));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming preview port:" << port;
+    impl()->setStreamingPreviewPort(port);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_socket_type(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingSocketType());
+    LOG(logDEBUG1) << "streaming socket type:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_socket_type(Interface &socket) {
+    auto type = socket.Receive<int>();
+    if (type < 0 || type >= NUM_STREAMING_SOCKET_TYPES) {
+        throw RuntimeError("Invalid streaming socket type " +
+                           std::to_string(type));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming socket type:" << type;
+    impl()->setStreamingSocketType(static_cast<streamingSocketType>(type));
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_push_port(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingPushPort());
+    LOG(logDEBUG1) << "streaming push port:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_push_port(Interface &socket) {
+    auto port = socket.Receive<int>();
+    if (port < 0) {
+        throw RuntimeError("Invalid zmq push port " + std::to_string(port));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming push port:" << port;
+    impl()->setStreamingPushPort(port);
+    return socket.Send(OK);
+}
+
+int ClientInterface::get_streaming_bandwidth(Interface &socket) {
+    auto retval = static_cast<int>(impl()->getStreamingBandwidth());
+    LOG(logDEBUG1) << "streaming bandwidth:" << retval;
+    return socket.sendResult(retval);
+}
+
+int ClientInterface::set_streaming_bandwidth(Interface &socket) {
+    auto mbps = socket.Receive<int>();
+    if (mbps < 0) {
+        throw RuntimeError("Invalid streaming bandwidth " +
+                           std::to_string(mbps));
+    }
+    verifyIdle(socket);
+    LOG(logDEBUG1) << "Setting streaming bandwidth:" << mbps;
+    impl()->setStreamingBandwidth(mbps);
+    return socket.Send(OK);
+}
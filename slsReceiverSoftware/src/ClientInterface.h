@@ -161,6 +161,64 @@ class ClientInterface : private virtual slsDetectorDefs {
     int set_threshold(sls::ServerInterface &socket);
     int get_streaming_hwm(sls::ServerInterface &socket);
     int set_streaming_hwm(sls::ServerInterface &socket);
+    int get_udp_batch_size(sls::ServerInterface &socket);
+    int set_udp_batch_size(sls::ServerInterface &socket);
+    int get_udp_zero_copy(sls::ServerInterface &socket);
+    int set_udp_zero_copy(sls::ServerInterface &socket);
+    int get_udp_backend(sls::ServerInterface &socket);
+    int set_udp_backend(sls::ServerInterface &socket);
+    int get_fifo_hugepages(sls::ServerInterface &socket);
+    int set_fifo_hugepages(sls::ServerInterface &socket);
+    int get_fifo_mlock(sls::ServerInterface &socket);
+    int set_fifo_mlock(sls::ServerInterface &socket);
+    int get_thread_affinity(sls::ServerInterface &socket);
+    int set_thread_affinity(sls::ServerInterface &socket);
+    int get_udp_threads(sls::ServerInterface &socket);
+    int set_udp_threads(sls::ServerInterface &socket);
+    int get_frame_window(sls::ServerInterface &socket);
+    int set_frame_window(sls::ServerInterface &socket);
+    int get_frame_timeout(sls::ServerInterface &socket);
+    int set_frame_timeout(sls::ServerInterface &socket);
+    int get_file_direct_io(sls::ServerInterface &socket);
+    int set_file_direct_io(sls::ServerInterface &socket);
+    int get_file_io_uring(sls::ServerInterface &socket);
+    int set_file_io_uring(sls::ServerInterface &socket);
+    int get_hdf5_chunk_frames(sls::ServerInterface &socket);
+    int set_hdf5_chunk_frames(sls::ServerInterface &socket);
+    int get_hdf5_chunk_rows(sls::ServerInterface &socket);
+    int set_hdf5_chunk_rows(sls::ServerInterface &socket);
+    int get_hdf5_compound_header(sls::ServerInterface &socket);
+    int set_hdf5_compound_header(sls::ServerInterface &socket);
+    int get_hdf5_writer_process(sls::ServerInterface &socket);
+    int set_hdf5_writer_process(sls::ServerInterface &socket);
+    int get_hdf5_swmr(sls::ServerInterface &socket);
+    int set_hdf5_swmr(sls::ServerInterface &socket);
+    int get_hdf5_flush_frames(sls::ServerInterface &socket);
+    int set_hdf5_flush_frames(sls::ServerInterface &socket);
+    int get_hdf5_flush_time(sls::ServerInterface &socket);
+    int set_hdf5_flush_time(sls::ServerInterface &socket);
+    int get_file_compression(sls::ServerInterface &socket);
+    int set_file_compression(sls::ServerInterface &socket);
+    int get_compression_threads(sls::ServerInterface &socket);
+    int set_compression_threads(sls::ServerInterface &socket);
+    int get_streaming_zero_copy(sls::ServerInterface &socket);
+    int set_streaming_zero_copy(sls::ServerInterface &socket);
+    int get_streaming_binary_header(sls::ServerInterface &socket);
+    int set_streaming_binary_header(sls::ServerInterface &socket);
+    int get_streaming_preview_binning(sls::ServerInterface &socket);
+    int set_streaming_preview_binning(sls::ServerInterface &socket);
+    int get_streaming_preview_mode(sls::ServerInterface &socket);
+    int set_streaming_preview_mode(sls::ServerInterface &socket);
+    int get_streaming_preview_timer(sls::ServerInterface &socket);
+    int set_streaming_preview_timer(sls::ServerInterface &socket);
+    int get_streaming_preview_port(sls::ServerInterface &socket);
+    int set_streaming_preview_port(sls::ServerInterface &socket);
+    int get_streaming_socket_type(sls::ServerInterface &socket);
+    int set_streaming_socket_type(sls::ServerInterface &socket);
+    int get_streaming_push_port(sls::ServerInterface &socket);
+    int set_streaming_push_port(sls::ServerInterface &socket);
+    int get_streaming_bandwidth(sls::ServerInterface &socket);
+    int set_streaming_bandwidth(sls::ServerInterface &socket);
 
     Implementation *impl() {
         if (receiver != nullptr) {
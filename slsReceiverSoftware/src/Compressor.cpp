@@ -0,0 +1,399 @@
+/************************************************
+ * @file Compressor.cpp
+ * @short bitshuffle LZ4/zstd compression of images,
+ * in the chunk format of the hdf5 bitshuffle filter,
+ * with the blocks of an image compressed in parallel
+ ***********************************************/
+
+#include "Compressor.h"
+#include "sls/logger.h"
+#include "sls/sls_detector_exceptions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef COMPRESSIONC
+#include <lz4.h>
+#include <zstd.h>
+#endif
+
+namespace {
+// bitshuffle: target size of a block, elements of a block are a multiple of
+// 8 and at least 128
+constexpr size_t TARGET_BLOCK_BYTES = 8192;
+constexpr size_t BLOCK_MULTIPLE = 8;
+constexpr size_t MIN_BLOCK_ELEMENTS = 128;
+// chunk header: uncompressed size (uint64) and block size in bytes (uint32)
+constexpr size_t HEADER_BYTES = 12;
+// hdf5 bitshuffle filter: version and compression codes
+constexpr unsigned int FILTER_VERSION_MAJOR = 0;
+constexpr unsigned int FILTER_VERSION_MINOR = 5;
+constexpr unsigned int FILTER_LZ4 = 2;
+constexpr unsigned int FILTER_ZSTD = 3;
+
+void WriteBigEndian(char *dst, uint64_t value, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; ++i) {
+        dst[i] = static_cast<char>(value >> (8 * (nbytes - 1 - i)));
+    }
+}
+
+#ifdef COMPRESSIONC
+uint64_t ReadBigEndian(const char *src, size_t nbytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < nbytes; ++i) {
+        value = (value << 8) | static_cast<uint8_t>(src[i]);
+    }
+    return value;
+}
+#endif
+
+// transposes the 8x8 bit matrix of byte m bit k to byte k bit m
+inline uint64_t TransposeBits(uint64_t x) {
+    uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+} // namespace
+
+CompressionPool::CompressionPool(int n) : numThreads(n) {}
+
+CompressionPool::~CompressionPool() { Stop(); }
+
+void CompressionPool::SetNumberOfThreads(int n) {
+    Stop();
+    numThreads = n;
+}
+
+int CompressionPool::GetNumberOfThreads() const { return numThreads; }
+
+void CompressionPool::Start() {
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back(&CompressionPool::Worker, this);
+    }
+}
+
+void CompressionPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopThreads = true;
+    }
+    workAvailable.notify_all();
+    for (auto &t : threads) {
+        t.join();
+    }
+    threads.clear();
+    stopThreads = false;
+}
+
+void CompressionPool::Worker() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock,
+                           [this]() { return stopThreads || !jobs.empty(); });
+        if (stopThreads) {
+            return;
+        }
+        RunOne(*jobs.front(), lock);
+    }
+}
+
+void CompressionPool::RunOne(Job &job, std::unique_lock<std::mutex> &lock) {
+    size_t i = job.next++;
+    // all claimed, only its owner waits for it from now on
+    if (job.next == job.size) {
+        jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+    }
+    lock.unlock();
+    std::exception_ptr failure;
+    try {
+        (*job.task)(i);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    lock.lock();
+    if (failure && !job.failure) {
+        job.failure = failure;
+    }
+    if (++job.done == job.size) {
+        jobDone.notify_all();
+    }
+}
+
+void CompressionPool::Run(size_t n, const std::function<void(size_t)> &task) {
+    if (n == 0) {
+        return;
+    }
+    Job job{&task, n, 0, 0, nullptr};
+    std::unique_lock<std::mutex> lock(mutex);
+    if (threads.empty()) {
+        Start();
+    }
+    jobs.push_back(&job);
+    workAvailable.notify_all();
+    while (job.next < job.size) {
+        RunOne(job, lock);
+    }
+    jobDone.wait(lock, [&job]() { return job.done == job.size; });
+    if (job.failure) {
+        std::rethrow_exception(job.failure);
+    }
+}
+
+Compressor::Compressor(fileCompression *type, CompressionPool *pool)
+    : compressionType(type), threadPool(pool) {}
+
+bool Compressor::IsEnabled() const {
+    return *compressionType != NO_COMPRESSION;
+}
+
+slsDetectorDefs::fileCompression Compressor::GetType() const {
+    return *compressionType;
+}
+
+size_t Compressor::BlockSize(size_t elemSize) {
+    size_t n =
+        (TARGET_BLOCK_BYTES / elemSize) / BLOCK_MULTIPLE * BLOCK_MULTIPLE;
+    return std::max(n, MIN_BLOCK_ELEMENTS);
+}
+
+void Compressor::BitShuffle(const char *in, char *out, size_t numElements,
+                            size_t elemSize) {
+    const auto *src = reinterpret_cast<const uint8_t *>(in);
+    size_t rowBytes = numElements / 8;
+    for (size_t j = 0; j < elemSize; ++j) {
+        for (size_t g = 0; g < rowBytes; ++g) {
+            // byte j of 8 elements
+            const uint8_t *p = src + 8 * g * elemSize + j;
+            uint64_t x = 0;
+            for (size_t m = 0; m < 8; ++m) {
+                x |= static_cast<uint64_t>(p[m * elemSize]) << (8 * m);
+            }
+            x = TransposeBits(x);
+            for (size_t k = 0; k < 8; ++k) {
+                out[(j * 8 + k) * rowBytes + g] =
+                    static_cast<char>(x >> (8 * k));
+            }
+        }
+    }
+}
+
+void Compressor::BitUnshuffle(const char *in, char *out, size_t numElements,
+                              size_t elemSize) {
+    const auto *src = reinterpret_cast<const uint8_t *>(in);
+    size_t rowBytes = numElements / 8;
+    for (size_t j = 0; j < elemSize; ++j) {
+        for (size_t g = 0; g < rowBytes; ++g) {
+            uint64_t x = 0;
+            for (size_t k = 0; k < 8; ++k) {
+                x |= static_cast<uint64_t>(src[(j * 8 + k) * rowBytes + g])
+                     << (8 * k);
+            }
+            x = TransposeBits(x);
+            char *p = out + 8 * g * elemSize + j;
+            for (size_t m = 0; m < 8; ++m) {
+                p[m * elemSize] = static_cast<char>(x >> (8 * m));
+            }
+        }
+    }
+}
+
+std::vector<unsigned int> Compressor::FilterParameters(fileCompression type,
+                                                       size_t elemSize) {
+    std::vector<unsigned int> cd{
+        FILTER_VERSION_MAJOR, FILTER_VERSION_MINOR,
+        static_cast<unsigned int>(elemSize),
+        static_cast<unsigned int>(BlockSize(elemSize))};
+    if (type == BITSHUFFLE_ZSTD) {
+        cd.push_back(FILTER_ZSTD);
+        cd.push_back(COMPRESSION_ZSTD_LEVEL);
+    } else {
+        cd.push_back(FILTER_LZ4);
+    }
+    return cd;
+}
+
+void Compressor::CompressBlock(size_t i) {
+    size_t n = (i < numFullBlocks) ? blockElements : lastBlockElements;
+    size_t nbytes = n * elementSize;
+    auto &shuffledBlock = shuffled[i];
+    if (shuffledBlock.size() < nbytes) {
+        shuffledBlock.resize(nbytes);
+    }
+    BitShuffle(blockData + i * blockElements * elementSize,
+               shuffledBlock.data(), n, elementSize);
+
+    auto &packed = packedBlocks[i];
+#ifdef COMPRESSIONC
+    if (*compressionType == BITSHUFFLE_ZSTD) {
+        size_t bound = ZSTD_compressBound(nbytes);
+        if (packed.size() < bound) {
+            packed.resize(bound);
+        }
+        size_t ret = ZSTD_compress(packed.data(), bound, shuffledBlock.data(),
+                                   nbytes, COMPRESSION_ZSTD_LEVEL);
+        if (ZSTD_isError(ret)) {
+            throw sls::RuntimeError(std::string("zstd compression failed: ") +
+                                    ZSTD_getErrorName(ret));
+        }
+        packedSizes[i] = ret;
+        return;
+    }
+    auto bound = static_cast<size_t>(LZ4_compressBound((int)nbytes));
+    if (packed.size() < bound) {
+        packed.resize(bound);
+    }
+    int ret = LZ4_compress_default(shuffledBlock.data(), packed.data(),
+                                   (int)nbytes, (int)bound);
+    if (ret <= 0) {
+        throw sls::RuntimeError("LZ4 compression failed");
+    }
+    packedSizes[i] = ret;
+#else
+    (void)packed;
+    throw sls::RuntimeError("Compression not compiled in receiver");
+#endif
+}
+
+const char *Compressor::Compress(const char *data, size_t size,
+                                 size_t elemSize, size_t &packedSize) {
+    auto start = std::chrono::steady_clock::now();
+    blockData = data;
+    elementSize = elemSize;
+    blockElements = BlockSize(elemSize);
+    size_t numElements = size / elemSize;
+    numFullBlocks = numElements / blockElements;
+    lastBlockElements =
+        (numElements % blockElements) / BLOCK_MULTIPLE * BLOCK_MULTIPLE;
+    size_t numBlocks = numFullBlocks + (lastBlockElements != 0 ? 1 : 0);
+    if (shuffled.size() < numBlocks) {
+        shuffled.resize(numBlocks);
+        packedBlocks.resize(numBlocks);
+    }
+    packedSizes.resize(numBlocks);
+
+    if (threadPool != nullptr && numBlocks > 1) {
+        threadPool->Run(numBlocks, [this](size_t i) { CompressBlock(i); });
+    } else {
+        for (size_t i = 0; i < numBlocks; ++i) {
+            CompressBlock(i);
+        }
+    }
+
+    // elements left over and bytes of a partial element are copied as is
+    size_t leftover =
+        size - (numFullBlocks * blockElements + lastBlockElements) * elemSize;
+    packedSize = HEADER_BYTES + leftover;
+    for (size_t i = 0; i < numBlocks; ++i) {
+        packedSize += 4 + packedSizes[i];
+    }
+    if (output.size() < packedSize) {
+        output.resize(packedSize);
+    }
+    char *dst = output.data();
+    WriteBigEndian(dst, size, 8);
+    WriteBigEndian(dst + 8, blockElements * elemSize, 4);
+    dst += HEADER_BYTES;
+    for (size_t i = 0; i < numBlocks; ++i) {
+        WriteBigEndian(dst, packedSizes[i], 4);
+        memcpy(dst + 4, packedBlocks[i].data(), packedSizes[i]);
+        dst += 4 + packedSizes[i];
+    }
+    memcpy(dst, data + size - leftover, leftover);
+
+    rawBytes += size;
+    packedBytes += packedSize;
+    compressionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    return output.data();
+}
+
+std::vector<char> Compressor::Decompress(const char *packed, size_t packedSize,
+                                         size_t elemSize,
+                                         fileCompression type) {
+#ifdef COMPRESSIONC
+    if (packedSize < HEADER_BYTES) {
+        throw sls::RuntimeError("Compressed data too small");
+    }
+    size_t size = ReadBigEndian(packed, 8);
+    size_t blockBytes = ReadBigEndian(packed + 8, 4);
+    if (elemSize == 0 || blockBytes == 0 || blockBytes % elemSize != 0) {
+        throw sls::RuntimeError("Invalid block size of compressed data");
+    }
+    size_t blockSize = blockBytes / elemSize;
+    size_t numElements = size / elemSize;
+    std::vector<char> out(size);
+    std::vector<char> block(blockBytes);
+    size_t pos = HEADER_BYTES;
+    size_t done = 0;
+    while (true) {
+        size_t n = std::min(blockSize, numElements - done) / BLOCK_MULTIPLE *
+                   BLOCK_MULTIPLE;
+        if (n == 0) {
+            break;
+        }
+        if (pos + 4 > packedSize) {
+            throw sls::RuntimeError("Compressed data truncated");
+        }
+        size_t blockPacked = ReadBigEndian(packed + pos, 4);
+        pos += 4;
+        if (pos + blockPacked > packedSize) {
+            throw sls::RuntimeError("Compressed data truncated");
+        }
+        size_t nbytes = n * elemSize;
+        size_t ret = 0;
+        if (type == BITSHUFFLE_ZSTD) {
+            ret = ZSTD_decompress(block.data(), nbytes, packed + pos,
+                                  blockPacked);
+            if (ZSTD_isError(ret)) {
+                ret = 0;
+            }
+        } else {
+            int r = LZ4_decompress_safe(packed + pos, block.data(),
+                                        (int)blockPacked, (int)nbytes);
+            ret = (r < 0) ? 0 : (size_t)r;
+        }
+        if (ret != nbytes) {
+            throw sls::RuntimeError("Could not decompress block");
+        }
+        BitUnshuffle(block.data(), out.data() + done * elemSize, n, elemSize);
+        pos += blockPacked;
+        done += n;
+    }
+    size_t leftover = size - done * elemSize;
+    if (pos + leftover > packedSize) {
+        throw sls::RuntimeError("Compressed data truncated");
+    }
+    memcpy(out.data() + done * elemSize, packed + pos, leftover);
+    return out;
+#else
+    (void)packed;
+    (void)packedSize;
+    (void)elemSize;
+    (void)type;
+    throw sls::RuntimeError("Compression not compiled in receiver");
+#endif
+}
+
+void Compressor::ResetStatistics() {
+    rawBytes = 0;
+    packedBytes = 0;
+    compressionTime = 0;
+}
+
+void Compressor::AddStatistics(uint64_t raw, uint64_t packed, uint64_t ns) {
+    rawBytes += raw;
+    packedBytes += packed;
+    compressionTime += ns;
+}
+
+uint64_t Compressor::GetRawBytes() const { return rawBytes; }
+
+uint64_t Compressor::GetPackedBytes() const { return packedBytes; }
+
+uint64_t Compressor::GetCompressionTime() const { return compressionTime; }
@@ -0,0 +1,188 @@
+#pragma once
+/************************************************
+ * @file Compressor.h
+ * @short bitshuffle LZ4/zstd compression of images,
+ * in the chunk format of the hdf5 bitshuffle filter,
+ * with the blocks of an image compressed in parallel
+ ***********************************************/
+/**
+ *@short compresses images block wise over a thread pool shared by the ports
+ */
+
+#include "receiver_defs.h"
+#include "sls/sls_detector_defs.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CompressionPool {
+
+  public:
+    /**
+     * Constructor
+     * Threads are only started with the first task
+     * @param n number of threads
+     */
+    explicit CompressionPool(int n = DEFAULT_COMPRESSION_THREADS);
+
+    /**
+     * Destructor
+     * Stops the threads
+     */
+    ~CompressionPool();
+
+    CompressionPool(const CompressionPool &) = delete;
+    CompressionPool &operator=(const CompressionPool &) = delete;
+
+    /**
+     * Sets the number of threads, restarted with the next task.
+     * Not to be called while tasks run
+     * @param n number of threads
+     */
+    void SetNumberOfThreads(int n);
+
+    int GetNumberOfThreads() const;
+
+    /**
+     * Runs task(0) to task(n-1) over the threads, the calling thread helping,
+     * and returns once all are done. Several threads may run tasks at once
+     * @param n number of tasks
+     * @param task task to run for each index
+     */
+    void Run(size_t n, const std::function<void(size_t)> &task);
+
+  private:
+    struct Job {
+        const std::function<void(size_t)> *task;
+        size_t size;
+        size_t next;
+        size_t done;
+        std::exception_ptr failure;
+    };
+
+    void Start();
+    void Stop();
+    void Worker();
+    /** runs the next index of the job, lock held on entry and exit */
+    void RunOne(Job &job, std::unique_lock<std::mutex> &lock);
+
+    int numThreads;
+    std::vector<std::thread> threads;
+    bool stopThreads{false};
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable jobDone;
+    /** jobs with indices not yet claimed */
+    std::deque<Job *> jobs;
+};
+
+class Compressor : private virtual slsDetectorDefs {
+
+  public:
+    /**
+     * Constructor
+     * @param type pointer to compression type
+     * @param pool thread pool to compress the blocks (nullptr for none)
+     */
+    Compressor(fileCompression *type, CompressionPool *pool);
+
+    /** true if compression is enabled */
+    bool IsEnabled() const;
+
+    fileCompression GetType() const;
+
+    /**
+     * Compresses data, each block of elements bit shuffled and compressed
+     * @param data data to compress
+     * @param size size of data in bytes
+     * @param elemSize size of an element in bytes
+     * @param packedSize size of the compressed data in bytes
+     * @returns compressed data, valid till the next call
+     */
+    const char *Compress(const char *data, size_t size, size_t elemSize,
+                         size_t &packedSize);
+
+    /**
+     * Decompresses data compressed by Compress (or the hdf5 bitshuffle
+     * filter)
+     * @param packed compressed data
+     * @param packedSize size of compressed data in bytes
+     * @param elemSize size of an element in bytes
+     * @param type compression type
+     * @returns decompressed data
+     */
+    static std::vector<char> Decompress(const char *packed, size_t packedSize,
+                                        size_t elemSize, fileCompression type);
+
+    /** number of elements of a compressed block */
+    static size_t BlockSize(size_t elemSize);
+
+    /**
+     * Transposes the bits of a block: for each bit of an element, the bits
+     * of all the elements one after the other
+     * @param in elements
+     * @param out transposed bits
+     * @param numElements number of elements, a multiple of 8
+     * @param elemSize size of an element in bytes
+     */
+    static void BitShuffle(const char *in, char *out, size_t numElements,
+                           size_t elemSize);
+
+    /** inverse of BitShuffle */
+    static void BitUnshuffle(const char *in, char *out, size_t numElements,
+                             size_t elemSize);
+
+    /** parameters of the hdf5 bitshuffle filter */
+    static std::vector<unsigned int> FilterParameters(fileCompression type,
+                                                      size_t elemSize);
+
+    void ResetStatistics();
+
+    /**
+     * Adds the statistics of compression done elsewhere, eg. by the
+     * compressor of an hdf5 writer process
+     * @param raw bytes compressed
+     * @param packed compressed bytes
+     * @param ns time spent compressing in ns
+     */
+    void AddStatistics(uint64_t raw, uint64_t packed, uint64_t ns);
+
+    /** bytes compressed since the last reset */
+    uint64_t GetRawBytes() const;
+
+    /** compressed bytes since the last reset */
+    uint64_t GetPackedBytes() const;
+
+    /** time spent compressing in ns since the last reset */
+    uint64_t GetCompressionTime() const;
+
+  private:
+    /** bit shuffles and compresses block i of the current data */
+    void CompressBlock(size_t i);
+
+    fileCompression *compressionType;
+    CompressionPool *threadPool;
+
+    /** current data, split into blocks */
+    const char *blockData{nullptr};
+    size_t blockElements{0};
+    size_t elementSize{0};
+    size_t numFullBlocks{0};
+    size_t lastBlockElements{0};
+    /** bit shuffled and compressed data of each block */
+    std::vector<std::vector<char>> shuffled;
+    std::vector<std::vector<char>> packedBlocks;
+    std::vector<size_t> packedSizes;
+    std::vector<char> output;
+
+    std::atomic<uint64_t> rawBytes{0};
+    std::atomic<uint64_t> packedBytes{0};
+    std::atomic<uint64_t> compressionTime{0};
+};
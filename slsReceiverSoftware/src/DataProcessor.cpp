@@ -2,18 +2,14 @@
  * @file DataProcessor.cpp
  * @short creates data processor thread that
  * pulls pointers to memory addresses from fifos
- * and processes data stored in them & writes them to file
+ * and processes data stored in them & passes them on to
+ * the file writer
  ***********************************************/
 
 #include "DataProcessor.h"
-#include "BinaryFile.h"
+#include "DataStreamer.h"
 #include "Fifo.h"
 #include "GeneralData.h"
-#include "MasterAttributes.h"
-#ifdef HDF5C
-#include "HDF5File.h"
-#endif
-#include "DataStreamer.h"
 #include "sls/sls_detector_exceptions.h"
 
 #include <cerrno>
@@ -23,24 +19,25 @@
 const std::string DataProcessor::TypeName = "DataProcessor";
 
 DataProcessor::DataProcessor(int ind, detectorType dtype, Fifo *f,
-                             fileFormat *ftype, bool fwenable, bool *mfwenable,
-                             bool *dsEnable, uint32_t *freq, uint32_t *timer,
-                             uint32_t *sfnum, bool *fp, bool *act,
+                             bool *fwenable, bool *dsEnable, uint32_t *freq,
+                             uint32_t *timer, uint32_t *sfnum, uint32_t *bw,
+                             streamingSocketType *stype, uint32_t *pbin,
+                             uint32_t *ptimer, bool *fp, bool *act,
                              bool *depaden, bool *sm, std::vector<int> *cdl,
                              int *cdo, int *cad)
     : ThreadObject(ind, TypeName), fifo(f), myDetectorType(dtype),
-      dataStreamEnable(dsEnable), fileFormatType(ftype),
-      fileWriteEnable(fwenable), masterFileWriteEnable(mfwenable),
+      dataStreamEnable(dsEnable), fileWriteEnable(fwenable),
       streamingFrequency(freq), streamingTimerInMs(timer),
-      streamingStartFnum(sfnum), activated(act),
+      streamingStartFnum(sfnum), streamingBandwidth(bw), streamingType(stype),
+      previewBinning(pbin), previewTimerInMs(ptimer), activated(act),
       deactivatedPaddingEnable(depaden), silentMode(sm), framePadding(fp),
-      ctbDbitList(cdl), ctbDbitOffset(cdo), ctbAnalogDataBytes(cad),
-      firstStreamerFrame(false) {
+      ctbDbitList(cdl), ctbDbitOffset(cdo), ctbAnalogDataBytes(cad) {
     LOG(logDEBUG) << "DataProcessor " << ind << " created";
     memset((void *)&timerBegin, 0, sizeof(timespec));
+    memset((void *)&previewTimerBegin, 0, sizeof(timespec));
 }
 
-DataProcessor::~DataProcessor() { delete file; }
+DataProcessor::~DataProcessor() = default;
 
 /** getters */
 
@@ -48,6 +45,8 @@ bool DataProcessor::GetStartedFlag() { return startedFlag; }
 
 uint64_t DataProcessor::GetNumFramesCaught() { return numFramesCaught; }
 
+uint64_t DataProcessor::GetNumFramesToStream() { return numFramesToStream; }
+
 uint64_t DataProcessor::GetCurrentFrameIndex() { return currentFrameIndex; }
 
 uint64_t DataProcessor::GetProcessedIndex() {
@@ -60,9 +59,9 @@ void DataProcessor::ResetParametersforNewAcquisition() {
     StopRunning();
     startedFlag = false;
     numFramesCaught = 0;
+    numFramesToStream = 0;
     firstIndex = 0;
     currentFrameIndex = 0;
-    firstStreamerFrame = true;
 }
 
 void DataProcessor::RecordFirstIndex(uint64_t fnum) {
@@ -75,99 +74,7 @@ void DataProcessor::RecordFirstIndex(uint64_t fnum) {
     LOG(logDEBUG1) << index << " First Index:" << firstIndex;
 }
 
-void DataProcessor::SetGeneralData(GeneralData *g) {
-    generalData = g;
-    if (file != nullptr) {
-        if (file->GetFileType() == HDF5) {
-            file->SetNumberofPixels(generalData->nPixelsX,
-                                    generalData->nPixelsY);
-        }
-    }
-}
-
-void DataProcessor::SetFileFormat(const fileFormat f) {
-    if ((file != nullptr) && file->GetFileType() != f) {
-        // remember the pointer values before they are destroyed
-        int nd[MAX_DIMENSIONS];
-        nd[0] = 0;
-        nd[1] = 0;
-        uint32_t *maxf = nullptr;
-        std::string *fname = nullptr;
-        std::string *fpath = nullptr;
-        uint64_t *findex = nullptr;
-        bool *owenable = nullptr;
-        int *dindex = nullptr;
-        int *nunits = nullptr;
-        uint64_t *nf = nullptr;
-        uint32_t *dr = nullptr;
-        uint32_t *port = nullptr;
-        file->GetMemberPointerValues(nd, maxf, fname, fpath, findex, owenable,
-                                     dindex, nunits, nf, dr, port);
-        // create file writer with same pointers
-        SetupFileWriter(fileWriteEnable, nd, maxf, fname, fpath, findex,
-                        owenable, dindex, nunits, nf, dr, port);
-    }
-}
-
-void DataProcessor::SetupFileWriter(bool fwe, int *nd, uint32_t *maxf,
-                                    std::string *fname, std::string *fpath,
-                                    uint64_t *findex, bool *owenable,
-                                    int *dindex, int *nunits, uint64_t *nf,
-                                    uint32_t *dr, uint32_t *portno,
-                                    GeneralData *g) {
-    fileWriteEnable = fwe;
-    if (g != nullptr)
-        generalData = g;
-
-    if (file != nullptr) {
-        delete file;
-        file = nullptr;
-    }
-
-    if (fileWriteEnable) {
-        switch (*fileFormatType) {
-#ifdef HDF5C
-        case HDF5:
-            file = new HDF5File(index, maxf, nd, fname, fpath, findex, owenable,
-                                dindex, nunits, nf, dr, portno,
-                                generalData->nPixelsX, generalData->nPixelsY,
-                                silentMode);
-            break;
-#endif
-        default:
-            file =
-                new BinaryFile(index, maxf, nd, fname, fpath, findex, owenable,
-                               dindex, nunits, nf, dr, portno, silentMode);
-            break;
-        }
-    }
-}
-
-// only the first file
-void DataProcessor::CreateNewFile(MasterAttributes *attr) {
-    if (file == nullptr) {
-        throw sls::RuntimeError("file object not contstructed");
-    }
-    file->CloseAllFiles();
-    file->resetSubFileIndex();
-    file->CreateMasterFile(*masterFileWriteEnable, attr);
-    file->CreateFile();
-}
-
-void DataProcessor::CloseFiles() {
-    if (file != nullptr)
-        file->CloseAllFiles();
-}
-
-void DataProcessor::EndofAcquisition(bool anyPacketsCaught, uint64_t numf) {
-    if ((file != nullptr) && file->GetFileType() == HDF5) {
-        try {
-            file->EndofAcquisition(anyPacketsCaught, numf);
-        } catch (const sls::RuntimeError &e) {
-            ; // ignore for now //TODO: send error to client via stop receiver
-        }
-    }
-}
+void DataProcessor::SetGeneralData(GeneralData *g) { generalData = g; }
 
 void DataProcessor::ThreadExecution() {
     char *buffer = nullptr;
@@ -184,40 +91,56 @@ void DataProcessor::ThreadExecution() {
         StopProcessing(buffer);
         return;
     }
+    // frame discarded by listener, only to be freed
+    if (numBytes == DISCARD_PACKET_VALUE) {
+        PassOn(buffer, *dataStreamEnable);
+        return;
+    }
 
     uint64_t fnum = 0;
     try {
         fnum = ProcessAnImage(buffer);
     } catch (const std::exception &e) {
-        fifo->FreeAddress(buffer);
+        // only to be freed, by whoever is last in the pipeline
+        (*((uint32_t *)buffer)) = DISCARD_PACKET_VALUE;
+        PassOn(buffer, *dataStreamEnable);
         return;
     }
-    // stream (if time/freq to stream) or free
-    if (*dataStreamEnable && SendToStreamer()) {
-        // if first frame to stream, add frame index to fifo header (might
-        // not be the first)
-        if (firstStreamerFrame) {
-            firstStreamerFrame = false;
-            (*((uint32_t *)(buffer + FIFO_DATASIZE_NUMBYTES))) =
-                (uint32_t)(fnum - firstIndex);
+    // stream (if time/freq to stream and within budget), preview (if time to
+    // preview) or free
+    auto size = (uint32_t)(*((uint32_t *)buffer));
+    bool stream = (*dataStreamEnable && SendToStreamer(size));
+    bool preview = (*dataStreamEnable && SendToPreview());
+    if (stream || preview) {
+        // add frame index to fifo header (streamer calculates the first index
+        // from it) and if to bin into the preview stream
+        auto streamIndex = (uint32_t)(fnum - firstIndex) & STREAM_INDEX_MASK;
+        if (preview) {
+            streamIndex |= (stream ? PREVIEW_STREAM_FLAG : PREVIEW_ONLY_FLAG);
         }
-        fifo->PushAddressToStream(buffer);
+        (*((uint32_t *)(buffer + FIFO_DATASIZE_NUMBYTES))) = streamIndex;
+    } else if (*fileWriteEnable) {
+        (*((uint32_t *)(buffer + FIFO_DATASIZE_NUMBYTES))) = NOT_STREAMED_VALUE;
+    }
+    PassOn(buffer, stream || preview);
+}
+
+void DataProcessor::PassOn(char *buf, bool stream) {
+    // the writer streams or frees it once written
+    if (*fileWriteEnable) {
+        fifo->PushAddressToWrite(buf);
+    } else if (stream) {
+        fifo->PushAddressToStream(buf);
     } else {
-        fifo->FreeAddress(buffer);
+        fifo->FreeAddress(buf);
     }
 }
 
 void DataProcessor::StopProcessing(char *buf) {
     LOG(logDEBUG1) << "DataProcessing " << index << ": Dummy";
 
-    // stream or free
-    if (*dataStreamEnable)
-        fifo->PushAddressToStream(buf);
-    else
-        fifo->FreeAddress(buf);
-
-    if (file != nullptr)
-        file->CloseCurrentFile();
+    // write (closes file), stream or free
+    PassOn(buf, *dataStreamEnable);
     StopRunning();
     LOG(logDEBUG1) << index << ": Processing Completed";
 }
@@ -245,6 +168,17 @@ uint64_t DataProcessor::ProcessAnImage(char *buf) {
 
             // to send first image
             currentFreqCount = *streamingFrequency - *streamingStartFnum;
+
+            // full bucket and rate
+            budget.Reset(*streamingBandwidth);
+            // forget congestion of the previous acquisition
+            fifo->GetStreamCongested();
+
+            // to preview first image
+            clock_gettime(CLOCK_REALTIME, &previewTimerBegin);
+            previewTimerBegin.tv_sec -= (*previewTimerInMs) / 1000;
+            previewTimerBegin.tv_nsec -=
+                ((*previewTimerInMs) % 1000) * 1000000;
         }
     }
 
@@ -283,52 +217,59 @@ uint64_t DataProcessor::ProcessAnImage(char *buf) {
         throw sls::RuntimeError("Get Data Callback Error: " +
                                 std::string(e.what()));
     }
-
-    // write to file
-    if (file != nullptr) {
-        try {
-            file->WriteToFile(
-                buf + FIFO_HEADER_NUMBYTES,
-                sizeof(sls_receiver_header) +
-                    (uint32_t)(*((uint32_t *)buf)), //+ size of data (resizable
-                                                    // from previous call back
-                fnum - firstIndex, nump);
-        } catch (const sls::RuntimeError &e) {
-            ; // ignore write exception for now (TODO: send error message
-              // via stopReceiver tcp)
-        }
-    }
     return fnum;
 }
 
-bool DataProcessor::SendToStreamer() {
+bool DataProcessor::SendToStreamer(uint32_t size) {
+    ++numFramesToStream;
     // skip
     if ((*streamingFrequency) == 0u) {
-        if (!CheckTimer())
+        if (!CheckTimer(timerBegin, *streamingTimerInMs))
             return false;
     } else {
         if (!CheckCount())
             return false;
     }
-    return true;
+    return CheckBandwidth(size);
 }
 
-bool DataProcessor::CheckTimer() {
+bool DataProcessor::CheckBandwidth(uint32_t size) {
+    if ((*streamingBandwidth) == 0u)
+        return true;
+    // streamer falling behind (or zmq still holding zero copy images), or
+    // a pulling client could not take an image
+    bool congested = (fifo->GetNumToStream() > fifo->GetFifoDepth() / 4) ||
+                     fifo->GetStreamCongested();
+    // published and pushed
+    uint64_t bytes = size;
+    if ((*streamingType) == STREAM_PUB_PUSH) {
+        bytes *= 2;
+    }
+    return budget.Take(bytes, congested);
+}
+
+bool DataProcessor::SendToPreview() {
+    if ((*previewBinning) == 0u)
+        return false;
+    return CheckTimer(previewTimerBegin, *previewTimerInMs);
+}
+
+bool DataProcessor::CheckTimer(struct timespec &begin, uint32_t timeInMs) {
     struct timespec end;
     clock_gettime(CLOCK_REALTIME, &end);
 
     LOG(logDEBUG1) << index << " Timer elapsed time:"
-                   << ((end.tv_sec - timerBegin.tv_sec) +
-                       (end.tv_nsec - timerBegin.tv_nsec) / 1000000000.0)
+                   << ((end.tv_sec - begin.tv_sec) +
+                       (end.tv_nsec - begin.tv_nsec) / 1000000000.0)
                    << " seconds";
     // still less than streaming timer, keep waiting
-    if (((end.tv_sec - timerBegin.tv_sec) +
-         (end.tv_nsec - timerBegin.tv_nsec) / 1000000000.0) <
-        ((double)*streamingTimerInMs / 1000.00))
+    if (((end.tv_sec - begin.tv_sec) +
+         (end.tv_nsec - begin.tv_nsec) / 1000000000.0) <
+        ((double)timeInMs / 1000.00))
         return false;
 
     // restart timer
-    clock_gettime(CLOCK_REALTIME, &timerBegin);
+    clock_gettime(CLOCK_REALTIME, &begin);
     return true;
 }
 
@@ -341,15 +282,6 @@ bool DataProcessor::CheckCount() {
     return false;
 }
 
-void DataProcessor::SetPixelDimension() {
-    if (file != nullptr) {
-        if (file->GetFileType() == HDF5) {
-            file->SetNumberofPixels(generalData->nPixelsX,
-                                    generalData->nPixelsY);
-        }
-    }
-}
-
 void DataProcessor::registerCallBackRawDataReady(void (*func)(char *, char *,
                                                               uint32_t, void *),
                                                  void *arg) {
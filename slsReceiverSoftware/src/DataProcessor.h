@@ -3,20 +3,20 @@
  * @file DataProcessor.h
  * @short creates data processor thread that
  * pulls pointers to memory addresses from fifos
- * and processes data stored in them & writes them to file
+ * and processes data stored in them & passes them on to
+ * the file writer
  ***********************************************/
 /**
  *@short creates & manages a data processor thread each
  */
 
+#include "StreamBudget.h"
 #include "ThreadObject.h"
 #include "receiver_defs.h"
 
 class GeneralData;
 class Fifo;
-class File;
 class DataStreamer;
-struct MasterAttributes;
 
 #include <atomic>
 #include <vector>
@@ -31,14 +31,17 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
      * @param ind self index
      * @param dtype detector type
      * @param f address of Fifo pointer
-     * @param ftype pointer to file format type
-     * @param fwenable file writer enable
-     * @param mfwenable pointer to master file write enable
+     * @param fwenable pointer to file write enable
      * @param dsEnable pointer to data stream enable
      * @param dr pointer to dynamic range
      * @param freq pointer to streaming frequency
      * @param timer pointer to timer if streaming frequency is random
      * @param sfnum pointer to streaming starting fnum
+     * @param bw pointer to streaming bandwidth budget in MB/s (0 unlimited)
+     * @param stype pointer to streaming socket type (frames sent twice with
+     * pub and push)
+     * @param pbin pointer to preview binning factor (0 if no preview)
+     * @param ptimer pointer to timer between preview images
      * @param fp pointer to frame padding enable
      * @param act pointer to activated
      * @param depaden pointer to deactivated padding enable
@@ -48,11 +51,12 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
      * @param cdo pointer to digital bits offset
      * @param cad pointer to ctb analog databytes
      */
-    DataProcessor(int ind, detectorType dtype, Fifo *f, fileFormat *ftype,
-                  bool fwenable, bool *mfwenable, bool *dsEnable,
-                  uint32_t *freq, uint32_t *timer, uint32_t *sfnum, bool *fp,
-                  bool *act, bool *depaden, bool *sm, std::vector<int> *cdl,
-                  int *cdo, int *cad);
+    DataProcessor(int ind, detectorType dtype, Fifo *f, bool *fwenable,
+                  bool *dsEnable, uint32_t *freq, uint32_t *timer,
+                  uint32_t *sfnum, uint32_t *bw, streamingSocketType *stype,
+                  uint32_t *pbin, uint32_t *ptimer, bool *fp, bool *act,
+                  bool *depaden, bool *sm, std::vector<int> *cdl, int *cdo,
+                  int *cad);
 
     /**
      * Destructor
@@ -74,6 +78,12 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
      */
     uint64_t GetNumFramesCaught();
 
+    /**
+     * Get Frames processed while streaming, streamed or skipped
+     * @return number of frames
+     */
+    uint64_t GetNumFramesToStream();
+
     /**
      * Gets Actual Current Frame Index (that has not been subtracted from
      * firstIndex) thats been processed
@@ -104,56 +114,6 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
      */
     void SetGeneralData(GeneralData *g);
 
-    /**
-     * Set File Format
-     * @param fs file format
-     */
-    void SetFileFormat(const fileFormat fs);
-
-    /**
-     * Set up file writer object and call backs
-     * @param fwe file write enable
-     * @param nd pointer to number of detectors in each dimension
-     * @param maxf pointer to max frames per file
-     * @param fname pointer to file name prefix
-     * @param fpath pointer to file path
-     * @param findex pointer to file index
-     * @param owenable pointer to over write enable
-     * @param dindex pointer to detector index
-     * @param nunits pointer to number of threads/ units per detector
-     * @param nf pointer to number of images in acquisition
-     * @param dr pointer to dynamic range
-     * @param portno pointer to udp port number
-     * @param g address of GeneralData (Detector Data) pointer
-     */
-    void SetupFileWriter(bool fwe, int *nd, uint32_t *maxf, std::string *fname,
-                         std::string *fpath, uint64_t *findex, bool *owenable,
-                         int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
-                         uint32_t *portno, GeneralData *g = nullptr);
-
-    /**
-     * Create New File
-     * @param attr master file attributes
-     */
-    void CreateNewFile(MasterAttributes *attr);
-
-    /**
-     * Closes files
-     */
-    void CloseFiles();
-
-    /**
-     * End of Acquisition
-     * @param anyPacketsCaught true if any packets are caught, else false
-     * @param numf number of images caught
-     */
-    void EndofAcquisition(bool anyPacketsCaught, uint64_t numf);
-
-    /**
-     * Update pixel dimensions in file writer
-     */
-    void SetPixelDimension();
-
     /**
      * Call back for raw data
      * args to raw data ready callback are
@@ -188,38 +148,65 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
     /**
      * Thread Exeution for DataProcessor Class
      * Pop bound addresses, process them,
-     * write to file if needed & free the address
+     * pass them on to the file writer, streamer or free the address
      */
     void ThreadExecution() override;
 
     /**
-     * Frees dummy buffer,
+     * Passes on dummy buffer,
      * reset running mask by calling StopRunning()
      * @param buf address of pointer
      */
     void StopProcessing(char *buf);
 
     /**
-     * Process an image popped from fifo,
-     * write to file if fw enabled & update parameters
+     * Process an image popped from fifo & update parameters
      * @param buf address of pointer
      * @returns frame number
      */
     uint64_t ProcessAnImage(char *buf);
 
+    /**
+     * Passes on the address to the file writer if file write enabled,
+     * else streams or frees it
+     * @param buf address of pointer
+     * @param stream true if the image is to be streamed
+     */
+    void PassOn(char *buf, bool stream);
+
     /**
      * Calls CheckTimer and CheckCount for streaming frequency and timer
+     * and CheckBandwidth for the bandwidth budget
      * and determines if the current image should be sent to streamer
+     * @param size image size
      * @returns true if it should to streamer, else false
      */
-    bool SendToStreamer();
+    bool SendToStreamer(uint32_t size);
+
+    /**
+     * Checks if the image fits into the bandwidth budget, backing off while
+     * images pile up for the streamer or a client could not take one. The
+     * image is charged once per socket sending it
+     * @param size image size
+     * @returns true if within budget, else false
+     */
+    bool CheckBandwidth(uint32_t size);
 
     /**
      * This function should be called only in random frequency mode
      * Checks if timer is done and ready to send to stream
+     * @param begin timer beginning stamp, restarted if done
+     * @param timeInMs timer
      * @returns true if ready to send to stream, else false
      */
-    bool CheckTimer();
+    bool CheckTimer(struct timespec &begin, uint32_t timeInMs);
+
+    /**
+     * Checks if the preview timer is done and the current image is to be
+     * binned into the preview stream
+     * @returns true if to preview, else false
+     */
+    bool SendToPreview();
 
     /**
      * This function should be called only in non random frequency mode
@@ -253,20 +240,11 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
     /** Detector Type */
     detectorType myDetectorType;
 
-    /** File writer implemented as binary or hdf5 File */
-    File *file{nullptr};
-
     /** Data Stream Enable */
     bool *dataStreamEnable;
 
-    /** File Format Type */
-    fileFormat *fileFormatType;
-
     /** File Write Enable */
-    bool fileWriteEnable;
-
-    /** Master File Write Enable */
-    bool *masterFileWriteEnable;
+    bool *fileWriteEnable;
 
     /** Pointer to Streaming frequency, if 0, sending random images with a timer
      */
@@ -284,6 +262,24 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
     /** timer beginning stamp for random streaming */
     struct timespec timerBegin;
 
+    /** Pointer to streaming bandwidth budget in MB/s, 0 if unlimited */
+    uint32_t *streamingBandwidth;
+
+    /** Pointer to streaming socket type */
+    streamingSocketType *streamingType;
+
+    /** token bucket of the bandwidth budget */
+    StreamBudget budget;
+
+    /** Pointer to preview binning factor, 0 if no preview stream */
+    uint32_t *previewBinning;
+
+    /** Pointer to the timer between preview images */
+    uint32_t *previewTimerInMs;
+
+    /** timer beginning stamp for the preview stream */
+    struct timespec previewTimerBegin;
+
     /** Activated/Deactivated */
     bool *activated;
 
@@ -316,12 +312,12 @@ class DataProcessor : private virtual slsDetectorDefs, public ThreadObject {
     /** Number of complete frames caught */
     uint64_t numFramesCaught{0};
 
+    /** Number of frames processed while streaming */
+    std::atomic<uint64_t> numFramesToStream{0};
+
     /** Frame Number of latest processed frame number */
     std::atomic<uint64_t> currentFrameIndex{0};
 
-    /** first streamer frame to add frame index in fifo header */
-    bool firstStreamerFrame{false};
-
     // call back
     /**
      * Call back for raw data
@@ -6,6 +6,7 @@
 #include "DataStreamer.h"
 #include "Fifo.h"
 #include "GeneralData.h"
+#include "sls/ToString.h"
 #include "sls/ZmqSocket.h"
 #include "sls/sls_detector_exceptions.h"
 
@@ -14,10 +15,22 @@
 
 const std::string DataStreamer::TypeName = "DataStreamer";
 
+namespace {
+/** called by zmq once an image streamed without a copy is sent */
+void FreeStreamedImage(void *data, void *hint) {
+    char *buf = static_cast<char *>(data) - FIFO_HEADER_NUMBYTES -
+                sizeof(slsDetectorDefs::sls_receiver_header);
+    Fifo::FreeAddressInFlight(buf, hint);
+}
+} // namespace
+
 DataStreamer::DataStreamer(int ind, Fifo *f, uint32_t *dr, ROI *r, uint64_t *fi,
-                           int fd, int *nd, bool *qe, uint64_t *tot)
-    : ThreadObject(ind, TypeName), fifo(f), dynamicRange(dr), roi(r),
-      fileIndex(fi), flippedDataX(fd), quadEnable(qe), totalNumFrames(tot) {
+                           int fd, int *nd, bool *qe, uint64_t *tot,
+                           uint32_t *bw, uint32_t *pbin, previewMode *pmode)
+    : ThreadObject(ind, TypeName), fifo(f), previewBinning(pbin),
+      previewBinMode(pmode), dynamicRange(dr), roi(r), fileIndex(fi),
+      flippedDataX(fd), quadEnable(qe), totalNumFrames(tot),
+      streamingBandwidth(bw) {
     numDet[0] = nd[0];
     numDet[1] = nd[1];
 
@@ -26,17 +39,24 @@ DataStreamer::DataStreamer(int ind, Fifo *f, uint32_t *dr, ROI *r, uint64_t *fi,
 
 DataStreamer::~DataStreamer() {
     CloseZmqSocket();
+    ClosePreviewSocket();
     delete[] completeBuffer;
 }
 
 void DataStreamer::SetFifo(Fifo *f) { fifo = f; }
 
+uint64_t DataStreamer::GetNumFramesStreamed() const {
+    return numFramesStreamed;
+}
+
 void DataStreamer::ResetParametersforNewAcquisition(const std::string &fname) {
     StopRunning();
     startedFlag = false;
     firstIndex = 0;
+    numFramesStreamed = 0;
 
     fileNametoStream = fname;
+    fifo->GetMaxLevelForFifoInFlight();
     if (completeBuffer) {
         delete[] completeBuffer;
         completeBuffer = nullptr;
@@ -51,7 +71,9 @@ void DataStreamer::ResetParametersforNewAcquisition(const std::string &fname) {
 void DataStreamer::RecordFirstIndex(uint64_t fnum, char *buf) {
     startedFlag = true;
     // streamer first index needn't be
-    uint64_t firstVal = fnum - (*((uint32_t *)(buf + FIFO_DATASIZE_NUMBYTES)));
+    uint64_t firstVal =
+        fnum - ((*((uint32_t *)(buf + FIFO_DATASIZE_NUMBYTES))) &
+                STREAM_INDEX_MASK);
 
     firstIndex = firstVal;
     LOG(logDEBUG1) << index << " First Index: " << firstIndex
@@ -74,36 +96,107 @@ void DataStreamer::SetAdditionalJsonHeader(
     isAdditionalJsonUpdated = true;
 }
 
+void DataStreamer::SetBinaryHeader(bool enable) {
+    binaryHeader = enable;
+    if (zmqSocket) {
+        zmqSocket->SetBinaryHeader(binaryHeader);
+    }
+    if (pushSocket) {
+        pushSocket->SetBinaryHeader(binaryHeader);
+    }
+    if (previewSocket) {
+        previewSocket->SetBinaryHeader(binaryHeader);
+    }
+}
+
 void DataStreamer::CreateZmqSockets(int *nunits, uint32_t port,
-                                    const sls::IpAddr ip, int hwm) {
-    uint32_t portnum = port + index;
+                                    const sls::IpAddr ip, int hwm,
+                                    streamingSocketType type,
+                                    uint32_t pushPort) {
+    zmqSocket = CreateSocket(port + index, ip, hwm, type == STREAM_PUSH);
+    if (type == STREAM_PUB_PUSH) {
+        try {
+            pushSocket = CreateSocket(pushPort + index, ip, hwm, true);
+        } catch (...) {
+            CloseZmqSocket();
+            throw;
+        }
+    }
+}
+
+ZmqSocket *DataStreamer::CreateSocket(uint32_t portnum, const sls::IpAddr ip,
+                                      int hwm, bool push) {
+    ZmqSocket *socket = nullptr;
     std::string sip = ip.str();
     try {
-        zmqSocket = new ZmqSocket(portnum, (ip != 0 ? sip.c_str() : nullptr));
+        socket =
+            new ZmqSocket(portnum, (ip != 0 ? sip.c_str() : nullptr), push);
+        socket->SetBinaryHeader(binaryHeader);
         // set if custom
         if (hwm >= 0) {
-            zmqSocket->SetSendHighWaterMark(hwm);
-            if (zmqSocket->GetSendHighWaterMark() != hwm) {
+            socket->SetSendHighWaterMark(hwm);
+            if (socket->GetSendHighWaterMark() != hwm) {
                 throw sls::RuntimeError(
                     "Could not set zmq send high water mark to " +
                     std::to_string(hwm));
             }
         }
     } catch (...) {
+        delete socket;
         LOG(logERROR) << "Could not create Zmq socket on port " << portnum
                       << " for Streamer " << index;
         throw;
     }
     LOG(logINFO) << index << " Streamer: Zmq Server started at "
-                 << zmqSocket->GetZmqServerAddress()
-                 << "[hwm: " << zmqSocket->GetSendHighWaterMark() << "]";
+                 << socket->GetZmqServerAddress()
+                 << "[hwm: " << socket->GetSendHighWaterMark()
+                 << (push ? ", push" : "")
+                 << (binaryHeader ? ", binary header" : "") << "]";
+    return socket;
 }
 
 void DataStreamer::CloseZmqSocket() {
+    // drop the images still queued for slow clients, zero copy ones are freed
+    // back into the fifo by the time the socket is deleted
     if (zmqSocket) {
+        zmqSocket->SetLinger(0);
         delete zmqSocket;
         zmqSocket = nullptr;
     }
+    if (pushSocket) {
+        pushSocket->SetLinger(0);
+        delete pushSocket;
+        pushSocket = nullptr;
+    }
+}
+
+void DataStreamer::CreatePreviewSocket(uint32_t port, const sls::IpAddr ip,
+                                       int hwm) {
+    ClosePreviewSocket();
+    uint32_t portnum = port + index;
+    std::string sip = ip.str();
+    try {
+        previewSocket =
+            new ZmqSocket(portnum, (ip != 0 ? sip.c_str() : nullptr));
+        previewSocket->SetBinaryHeader(binaryHeader);
+        // set if custom
+        if (hwm >= 0) {
+            previewSocket->SetSendHighWaterMark(hwm);
+        }
+    } catch (...) {
+        LOG(logERROR) << "Could not create preview Zmq socket on port "
+                      << portnum << " for Streamer " << index;
+        throw;
+    }
+    LOG(logINFO) << index << " Streamer: Preview Zmq Server started at "
+                 << previewSocket->GetZmqServerAddress();
+}
+
+void DataStreamer::ClosePreviewSocket() {
+    if (previewSocket) {
+        delete previewSocket;
+        previewSocket = nullptr;
+    }
 }
 
 void DataStreamer::ThreadExecution() {
@@ -122,10 +215,21 @@ void DataStreamer::ThreadExecution() {
         return;
     }
 
-    ProcessAnImage(buffer);
+    if (numBytes == DISCARD_PACKET_VALUE) {
+        fifo->FreeAddress(buffer);
+        return;
+    }
+
+    // preview before streaming, zmq might free it once sent
+    auto streamIndex = *((uint32_t *)(buffer + FIFO_DATASIZE_NUMBYTES));
+    if (streamIndex & (PREVIEW_STREAM_FLAG | PREVIEW_ONLY_FLAG)) {
+        SendPreview(buffer);
+    }
 
-    // free
-    fifo->FreeAddress(buffer);
+    // free, unless zmq frees it once sent
+    if ((streamIndex & PREVIEW_ONLY_FLAG) || !ProcessAnImage(buffer)) {
+        fifo->FreeAddress(buffer);
+    }
 }
 
 void DataStreamer::StopProcessing(char *buf) {
@@ -137,6 +241,15 @@ void DataStreamer::StopProcessing(char *buf) {
         LOG(logERROR) << "Could not send zmq dummy header for streamer "
                       << index;
     }
+    if (pushSocket && !SendEndHeader(pushSocket)) {
+        LOG(logERROR) << "Could not push zmq dummy header for streamer "
+                      << index;
+    }
+    if (previewSocket && !SendEndHeader(previewSocket)) {
+        LOG(logERROR) << "Could not send preview zmq dummy header for "
+                         "streamer "
+                      << index;
+    }
 
     fifo->FreeAddress(buf);
     StopRunning();
@@ -144,7 +257,7 @@ void DataStreamer::StopProcessing(char *buf) {
 }
 
 /** buf includes only the standard header */
-void DataStreamer::ProcessAnImage(char *buf) {
+bool DataStreamer::ProcessAnImage(char *buf) {
 
     sls_receiver_header *header =
         (sls_receiver_header *)(buf + FIFO_HEADER_NUMBYTES);
@@ -163,52 +276,167 @@ void DataStreamer::ProcessAnImage(char *buf) {
         // listener
         // write imagesize
 
-        if (!SendHeader(header, generalData->imageSizeComplete,
-                        generalData->nPixelsXComplete,
-                        generalData->nPixelsYComplete, false)) {
-            LOG(logERROR) << "Could not send zmq header for fnum " << fnum
-                          << " and streamer " << index;
-        }
+        int ret = SendHeader(header, generalData->imageSizeComplete,
+                             generalData->nPixelsXComplete,
+                             generalData->nPixelsYComplete, false);
         memcpy(completeBuffer + ((generalData->imageSize) * adcConfigured),
                buf + FIFO_HEADER_NUMBYTES + sizeof(sls_receiver_header),
                (uint32_t)(*((uint32_t *)buf)));
-
+        if (pushSocket) {
+            PushImage(header, completeBuffer, generalData->imageSizeComplete,
+                      generalData->nPixelsXComplete,
+                      generalData->nPixelsYComplete);
+        }
+        if (!SentHeader(ret, fnum)) {
+            return false;
+        }
         if (!zmqSocket->SendData(completeBuffer,
                                  generalData->imageSizeComplete)) {
             LOG(logERROR) << "Could not send zmq data for fnum " << fnum
                           << " and streamer " << index;
+        } else {
+            ++numFramesStreamed;
         }
+        return false;
     }
 
     // normal
     else {
+        // copied before zero copy streaming frees it
+        if (pushSocket) {
+            PushImage(header,
+                      buf + FIFO_HEADER_NUMBYTES + sizeof(sls_receiver_header),
+                      (uint32_t)(*((uint32_t *)buf)), generalData->nPixelsX,
+                      generalData->nPixelsY);
+        }
 
-        if (!SendHeader(header, (uint32_t)(*((uint32_t *)buf)),
-                        generalData->nPixelsX, generalData->nPixelsY,
-                        false)) { // new size possibly from callback
-            LOG(logERROR) << "Could not send zmq header for fnum " << fnum
-                          << " and streamer " << index;
+        char *data = buf + FIFO_HEADER_NUMBYTES + sizeof(sls_receiver_header);
+        // new size possibly from callback
+        auto size = (uint32_t)(*((uint32_t *)buf));
+        if (!SentHeader(SendHeader(header, size, generalData->nPixelsX,
+                                   generalData->nPixelsY, false),
+                        fnum)) {
+            return false;
         }
-        if (!zmqSocket->SendData(
-                buf + FIFO_HEADER_NUMBYTES + sizeof(sls_receiver_header),
-                (uint32_t)(
-                    *((uint32_t *)buf)))) { // new size possibly from callback
+        // without a copy, freed by zmq once sent (even if send fails)
+        if (fifo->SetAddressInFlight()) {
+            if (!zmqSocket->SendDataZeroCopy(data, size, FreeStreamedImage,
+                                             fifo->GetInFlightHint())) {
+                LOG(logERROR) << "Could not send zmq data for fnum " << fnum
+                              << " and streamer " << index;
+            } else {
+                ++numFramesStreamed;
+            }
+            return true;
+        }
+        if (!zmqSocket->SendData(data, size)) {
             LOG(logERROR) << "Could not send zmq data for fnum " << fnum
                           << " and streamer " << index;
+        } else {
+            ++numFramesStreamed;
         }
     }
+    return false;
+}
+
+void DataStreamer::PushImage(sls_receiver_header *rheader, char *data,
+                             uint32_t size, uint32_t nx, uint32_t ny) {
+    uint64_t fnum = rheader->detHeader.frameNumber;
+    if (!SentHeader(
+            pushSocket->SendHeader(index, CreateHeader(rheader, size, nx, ny)),
+            fnum)) {
+        return;
+    }
+    if (!pushSocket->SendData(data, size)) {
+        LOG(logERROR) << "Could not push zmq data for fnum " << fnum
+                      << " and streamer " << index;
+    }
+}
+
+void DataStreamer::SendPreview(char *buf) {
+    if (!previewSocket || (*previewBinning) == 0u) {
+        return;
+    }
+    sls_receiver_header *header =
+        (sls_receiver_header *)(buf + FIFO_HEADER_NUMBYTES);
+    uint64_t fnum = header->detHeader.frameNumber;
+    if (!startedFlag) {
+        RecordFirstIndex(fnum, buf);
+    }
+
+    // jungfrau gain bits
+    uint32_t gainMask = 0;
+    if (generalData->myDetectorType == JUNGFRAU && *dynamicRange == 16) {
+        gainMask = 0xC000;
+    }
+    const char *binned = binner.Bin(
+        buf + FIFO_HEADER_NUMBYTES + sizeof(sls_receiver_header),
+        (uint32_t)(*((uint32_t *)buf)), generalData->nPixelsX,
+        generalData->nPixelsY, *dynamicRange, *previewBinning,
+        *previewBinMode, gainMask);
+    if (binned == nullptr) {
+        LOG(logDEBUG1) << "Could not bin image for preview of fnum " << fnum
+                       << " and streamer " << index;
+        return;
+    }
+
+    zmqHeader zHeader =
+        CreateHeader(header, binner.GetSize(), binner.GetNumPixelsX(),
+                     binner.GetNumPixelsY());
+    zHeader.dynamicRange = binner.GetDynamicRange();
+    zHeader.addJsonHeader["preview"] = std::to_string(*previewBinning);
+    zHeader.addJsonHeader["previewMode"] = sls::ToString(*previewBinMode);
+    if (binner.GetGainMask() != 0) {
+        zHeader.addJsonHeader["gainMask"] =
+            std::to_string(binner.GetGainMask());
+    }
+    if (!previewSocket->SendHeader(index, zHeader)) {
+        LOG(logERROR) << "Could not send preview zmq header for fnum " << fnum
+                      << " and streamer " << index;
+    }
+    if (!previewSocket->SendData(const_cast<char *>(binned),
+                                 binner.GetSize())) {
+        LOG(logERROR) << "Could not send preview zmq data for fnum " << fnum
+                      << " and streamer " << index;
+    }
 }
 
 int DataStreamer::SendHeader(sls_receiver_header *rheader, uint32_t size,
                              uint32_t nx, uint32_t ny, bool dummy) {
 
+    if (dummy) {
+        return SendEndHeader(zmqSocket);
+    }
+    return zmqSocket->SendHeader(index, CreateHeader(rheader, size, nx, ny));
+}
+
+bool DataStreamer::SentHeader(int ret, uint64_t fnum) {
+    // no pulling client can take it, the frame is skipped
+    if (ret == ZMQ_SEND_SKIPPED) {
+        fifo->SetStreamCongested();
+        return false;
+    }
+    if (ret == 0) {
+        LOG(logERROR) << "Could not send zmq header for fnum " << fnum
+                      << " and streamer " << index;
+        return false;
+    }
+    return true;
+}
+
+int DataStreamer::SendEndHeader(ZmqSocket *socket) {
     zmqHeader zHeader;
-    zHeader.data = !dummy;
+    zHeader.data = false;
     zHeader.jsonversion = SLS_DETECTOR_JSON_HEADER_VERSION;
+    return socket->SendHeader(index, zHeader);
+}
 
-    if (dummy) {
-        return zmqSocket->SendHeader(index, zHeader);
-    }
+zmqHeader DataStreamer::CreateHeader(sls_receiver_header *rheader,
+                                     uint32_t size, uint32_t nx, uint32_t ny) {
+
+    zmqHeader zHeader;
+    zHeader.data = true;
+    zHeader.jsonversion = SLS_DETECTOR_JSON_HEADER_VERSION;
 
     sls_detector_header header = rheader->detHeader;
 
@@ -252,19 +480,30 @@ int DataStreamer::SendHeader(sls_receiver_header *rheader, uint32_t size,
         isAdditionalJsonUpdated = false;
     }
     zHeader.addJsonHeader = localAdditionalJsonHeader;
-
-    return zmqSocket->SendHeader(index, zHeader);
+    // frames skipped to stay within the bandwidth budget (this one included)
+    if ((*streamingBandwidth) != 0u) {
+        zHeader.addJsonHeader["streamedFraction"] = std::to_string(
+            (double)(numFramesStreamed + 1) / (double)(frameIndex + 1));
+    }
+    return zHeader;
 }
 
 void DataStreamer::RestreamStop() {
     // send dummy header
-    zmqHeader zHeader;
-    zHeader.data = false;
-    zHeader.jsonversion = SLS_DETECTOR_JSON_HEADER_VERSION;
-    int ret = zmqSocket->SendHeader(index, zHeader);
+    int ret = SendEndHeader(zmqSocket);
     if (!ret) {
         throw sls::RuntimeError(
             "Could not restream Dummy Header via ZMQ for port " +
             std::to_string(zmqSocket->GetPortNumber()));
     }
+    if (pushSocket && !SendEndHeader(pushSocket)) {
+        throw sls::RuntimeError(
+            "Could not restream Dummy Header via ZMQ for port " +
+            std::to_string(pushSocket->GetPortNumber()));
+    }
+    if (previewSocket && !SendEndHeader(previewSocket)) {
+        throw sls::RuntimeError(
+            "Could not restream Dummy Header via ZMQ for port " +
+            std::to_string(previewSocket->GetPortNumber()));
+    }
 }
@@ -7,6 +7,7 @@
  *@short creates & manages a data streamer thread each
  */
 
+#include "PreviewBinner.h"
 #include "ThreadObject.h"
 #include "sls/network_utils.h"
 
@@ -14,7 +15,9 @@ class GeneralData;
 class Fifo;
 class DataStreamer;
 class ZmqSocket;
+struct zmqHeader;
 
+#include <atomic>
 #include <map>
 #include <mutex>
 
@@ -34,9 +37,13 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
      * @param nd pointer to number of detectors in each dimension
      * @param qe pointer to quad Enable
      * @param tot pointer to total number of frames
+     * @param bw pointer to streaming bandwidth budget in MB/s (0 unlimited)
+     * @param pbin pointer to preview binning factor
+     * @param pmode pointer to preview mode (binned or max pooled)
      */
     DataStreamer(int ind, Fifo *f, uint32_t *dr, ROI *r, uint64_t *fi, int fd,
-                 int *nd, bool *qe, uint64_t *tot);
+                 int *nd, bool *qe, uint64_t *tot, uint32_t *bw,
+                 uint32_t *pbin, previewMode *pmode);
 
     /**
      * Destructor
@@ -55,6 +62,13 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
      */
     void ResetParametersforNewAcquisition(const std::string &fname);
 
+    /**
+     * Get number of frames sent, not skipped by the frequency, timer,
+     * bandwidth budget or busy pulling clients
+     * @return number of frames
+     */
+    uint64_t GetNumFramesStreamed() const;
+
     /**
      * Set GeneralData pointer to the one given
      * @param g address of GeneralData (Detector Data) pointer
@@ -80,6 +94,12 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
     void
     SetAdditionalJsonHeader(const std::map<std::string, std::string> &json);
 
+    /**
+     * Set binary instead of json zmq headers
+     * @param enable true for binary headers
+     */
+    void SetBinaryHeader(bool enable);
+
     /**
      * Creates Zmq Sockets
      * (throws an exception if it couldnt create zmq sockets)
@@ -87,15 +107,33 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
      * @param port streaming port start index
      * @param ip streaming source ip
      * @param hwm streaming high water mark
+     * @param type publish every frame to every client, push each frame to
+     * one client (load balanced) on port, or both (pushed on pushPort)
+     * @param pushPort push port start index (for both)
      */
     void CreateZmqSockets(int *nunits, uint32_t port, const sls::IpAddr ip,
-                          int hwm);
+                          int hwm, streamingSocketType type,
+                          uint32_t pushPort);
 
     /**
-     * Shuts down and deletes Zmq Sockets
+     * Shuts down and deletes Zmq Sockets, dropping the images still queued
      */
     void CloseZmqSocket();
 
+    /**
+     * Creates the Zmq Socket of the preview stream
+     * (throws an exception if it couldnt create zmq socket)
+     * @param port preview port start index
+     * @param ip streaming source ip
+     * @param hwm streaming high water mark
+     */
+    void CreatePreviewSocket(uint32_t port, const sls::IpAddr ip, int hwm);
+
+    /**
+     * Shuts down and deletes the Zmq Socket of the preview stream
+     */
+    void ClosePreviewSocket();
+
     /**
      * Restream stop dummy packet
      */
@@ -126,8 +164,49 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
      * Process an image popped from fifo,
      * write to file if fw enabled & update parameters
      * @param buf address of pointer
+     * @returns true if zmq frees buf once sent (zero copy), else false
      */
-    void ProcessAnImage(char *buf);
+    bool ProcessAnImage(char *buf);
+
+    /**
+     * Creates a Zmq server socket
+     * @param portnum port number
+     * @param ip streaming source ip
+     * @param hwm streaming high water mark
+     * @param push true to push, else publish
+     * @returns socket
+     */
+    ZmqSocket *CreateSocket(uint32_t portnum, const sls::IpAddr ip, int hwm,
+                            bool push);
+
+    /**
+     * Pushes header and a copy of data to the push socket. The frame is
+     * skipped if no pulling client can take it
+     * @param rheader header of image
+     * @param data image
+     * @param size data size
+     * @param nx number of pixels in x dim
+     * @param ny number of pixels in y dim
+     */
+    void PushImage(sls_receiver_header *rheader, char *data, uint32_t size,
+                   uint32_t nx, uint32_t ny);
+
+    /**
+     * Bins an image popped from fifo and sends it to the preview stream
+     * @param buf address of pointer
+     */
+    void SendPreview(char *buf);
+
+    /**
+     * Create Json Header
+     * @param rheader header of image
+     * @param size data size
+     * @param nx number of pixels in x dim
+     * @param ny number of pixels in y dim
+     * @returns zmq header
+     */
+    zmqHeader CreateHeader(sls_receiver_header *rheader, uint32_t size,
+                           uint32_t nx, uint32_t ny);
 
     /**
      * Create and send Json Header
@@ -136,11 +215,30 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
      * @param nx number of pixels in x dim
      * @param ny number of pixels in y dim
      * @param dummy true if its a dummy header
-     * @returns 0 if error, else 1
+     * @returns 0 if error, ZMQ_SEND_SKIPPED if no pulling client can take
+     * it, else 1
      */
     int SendHeader(sls_receiver_header *rheader, uint32_t size = 0,
                    uint32_t nx = 0, uint32_t ny = 0, bool dummy = true);
 
+    /**
+     * Checks the result of sending the header of a frame, whose data is only
+     * to be sent if it was. A frame no pulling client can take is skipped
+     * like a congested stream, else an error is logged
+     * @param ret result of ZmqSocket::SendHeader
+     * @param fnum frame number
+     * @returns true if the header was sent
+     */
+    bool SentHeader(int ret, uint64_t fnum);
+
+    /**
+     * Send end of acquisition dummy header, published to every client (by a
+     * push socket on its port + ZMQ_PUSH_END_PORT_OFFSET)
+     * @param socket zmq socket
+     * @returns 0 if error, else 1
+     */
+    int SendEndHeader(ZmqSocket *socket);
+
     /** type of thread */
     static const std::string TypeName;
 
@@ -153,6 +251,25 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
     /** ZMQ Socket - Receiver to Client */
     ZmqSocket *zmqSocket{nullptr};
 
+    /** ZMQ Socket - Receiver pushing to pulling clients, in addition to
+     * zmqSocket publishing */
+    ZmqSocket *pushSocket{nullptr};
+
+    /** send binary zmq headers */
+    bool binaryHeader{false};
+
+    /** ZMQ Socket - Receiver to preview clients */
+    ZmqSocket *previewSocket{nullptr};
+
+    /** Pointer to preview binning factor */
+    uint32_t *previewBinning;
+
+    /** Pointer to preview mode */
+    previewMode *previewBinMode;
+
+    /** bins the images of the preview stream */
+    PreviewBinner binner;
+
     /** Pointer to dynamic range */
     uint32_t *dynamicRange;
 
@@ -201,4 +318,10 @@ class DataStreamer : private virtual slsDetectorDefs, public ThreadObject {
 
     /** Total number of frames */
     uint64_t *totalNumFrames;
+
+    /** Pointer to streaming bandwidth budget in MB/s, 0 if unlimited */
+    uint32_t *streamingBandwidth;
+
+    /** Number of frames sent, for the streamed fraction */
+    std::atomic<uint64_t> numFramesStreamed{0};
 };
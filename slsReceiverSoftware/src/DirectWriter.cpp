@@ -0,0 +1,177 @@
+/************************************************
+ * @file DirectWriter.cpp
+ * @short writes a file with direct io (O_DIRECT),
+ * coalescing writes into two aligned staging buffers
+ * that are flushed alternately by a background thread
+ ***********************************************/
+
+#include "DirectWriter.h"
+#include "sls/logger.h"
+#include "sls/sls_detector_exceptions.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// logical block size of direct io, largest in common use
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+size_t AlignUp(size_t size) {
+    return ((size + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT) *
+           DIRECT_IO_ALIGNMENT;
+}
+} // namespace
+
+DirectWriter::DirectWriter(size_t size)
+    : bufferSize(AlignUp(std::max(size, DIRECT_IO_ALIGNMENT))) {
+    for (auto &b : buffers) {
+        void *p = nullptr;
+        if (posix_memalign(&p, DIRECT_IO_ALIGNMENT, bufferSize) != 0) {
+            free(buffers[0]);
+            throw sls::RuntimeError(
+                "Could not allocate staging buffers for direct io");
+        }
+        b = static_cast<char *>(p);
+    }
+}
+
+DirectWriter::~DirectWriter() {
+    Close();
+    free(buffers[0]);
+    free(buffers[1]);
+}
+
+void DirectWriter::Open(const std::string &fname, bool overwrite) {
+    Close();
+    int flags = O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_EXCL);
+    fd = open(fname.c_str(), flags, 0664);
+    if (fd < 0) {
+        throw sls::RuntimeError("Could not create file " + fname + " (" +
+                                strerror(errno) + ")");
+    }
+    // not supported by all file systems (eg. tmpfs)
+    direct = (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_DIRECT) == 0);
+    if (!direct) {
+        LOG(logWARNING) << "Direct io not supported for " << fname
+                        << ", using buffered io";
+    }
+    fileName = fname;
+    current = 0;
+    fill = 0;
+    fileSize = 0;
+    pendingSize = 0;
+    stopFlag = false;
+    writeError = false;
+    flushThread = std::thread(&DirectWriter::FlushThread, this);
+}
+
+void DirectWriter::Close() {
+    if (fd < 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopFlag = true;
+    }
+    condition.notify_all();
+    flushThread.join();
+
+    // partial block: direct io writes whole blocks, cut the padding after
+    bool ok = !writeError;
+    if (ok && fill != 0) {
+        if (direct) {
+            size_t aligned = AlignUp(fill);
+            memset(buffers[current] + fill, 0, aligned - fill);
+            ok = WriteAll(buffers[current], aligned) &&
+                 (ftruncate(fd, fileSize) == 0);
+        } else {
+            ok = WriteAll(buffers[current], fill);
+        }
+    }
+    if (close(fd) != 0) {
+        ok = false;
+    }
+    fd = -1;
+    fill = 0;
+    if (!ok) {
+        LOG(logERROR) << "Could not write all data to file " << fileName;
+    }
+}
+
+bool DirectWriter::IsOpen() const { return (fd >= 0); }
+
+bool DirectWriter::IsDirect() const { return direct; }
+
+size_t DirectWriter::Write(const char *buf, size_t size) {
+    if (fd < 0) {
+        return 0;
+    }
+    size_t remaining = size;
+    while (remaining != 0) {
+        size_t n = std::min(remaining, bufferSize - fill);
+        memcpy(buffers[current] + fill, buf, n);
+        fill += n;
+        buf += n;
+        remaining -= n;
+        if (fill == bufferSize) {
+            SubmitBuffer();
+        }
+    }
+    fileSize += size;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (writeError) {
+        throw sls::RuntimeError("Could not write to file " + fileName);
+    }
+    return size;
+}
+
+void DirectWriter::SubmitBuffer() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return pendingSize == 0; });
+        pendingBuffer = buffers[current];
+        pendingSize = fill;
+    }
+    condition.notify_all();
+    current = 1 - current;
+    fill = 0;
+}
+
+void DirectWriter::FlushThread() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        condition.wait(lock, [this] { return pendingSize != 0 || stopFlag; });
+        if (pendingSize == 0) {
+            return;
+        }
+        const char *buf = pendingBuffer;
+        size_t size = pendingSize;
+        lock.unlock();
+        bool ok = WriteAll(buf, size);
+        lock.lock();
+        if (!ok) {
+            writeError = true;
+        }
+        pendingSize = 0;
+        condition.notify_all();
+    }
+}
+
+bool DirectWriter::WriteAll(const char *buf, size_t size) {
+    while (size != 0) {
+        ssize_t rc = write(fd, buf, size);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += rc;
+        size -= rc;
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#pragma once
+/************************************************
+ * @file DirectWriter.h
+ * @short writes a file with direct io (O_DIRECT),
+ * coalescing writes into two aligned staging buffers
+ * that are flushed alternately by a background thread
+ ***********************************************/
+/**
+ *@short direct io file writer with double buffering
+ */
+
+#include "receiver_defs.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class DirectWriter {
+
+  public:
+    /**
+     * Constructor
+     * Allocates the staging buffers
+     * @param size size of each staging buffer, rounded up to the alignment
+     */
+    explicit DirectWriter(size_t size = FILE_BUFFER_SIZE);
+
+    /**
+     * Destructor
+     * Closes the file
+     */
+    ~DirectWriter();
+
+    DirectWriter(const DirectWriter &) = delete;
+    DirectWriter &operator=(const DirectWriter &) = delete;
+
+    /**
+     * Creates the file and starts the flushing thread. Falls back to
+     * buffered io if the file system does not support direct io
+     * @param fname file name
+     * @param overwrite overwrite an existing file
+     */
+    void Open(const std::string &fname, bool overwrite);
+
+    /**
+     * Writes the remaining data (padding the last block and truncating
+     * the file to its size), stops the flushing thread and closes the file
+     */
+    void Close();
+
+    /** true if a file is open */
+    bool IsOpen() const;
+
+    /** true if the open file uses direct io */
+    bool IsDirect() const;
+
+    /**
+     * Copies data into the staging buffer, handing it over to the flushing
+     * thread when full. Throws if a previous flush failed
+     * @param buf data
+     * @param size size of data in bytes
+     * @returns size
+     */
+    size_t Write(const char *buf, size_t size);
+
+  private:
+    /** Waits for the previous flush and hands over the current buffer */
+    void SubmitBuffer();
+
+    /** Thread flushing the handed over buffers */
+    void FlushThread();
+
+    /** Writes all of buf to the file, returns false on error */
+    bool WriteAll(const char *buf, size_t size);
+
+    /** size of each staging buffer */
+    size_t bufferSize;
+
+    /** staging buffers, aligned for direct io */
+    char *buffers[2]{nullptr, nullptr};
+
+    /** index of the buffer being filled */
+    int current{0};
+
+    /** bytes filled in the current buffer */
+    size_t fill{0};
+
+    /** bytes written to the file so far (including staged) */
+    size_t fileSize{0};
+
+    int fd{-1};
+
+    bool direct{false};
+
+    std::string fileName;
+
+    std::thread flushThread;
+
+    /** guards the members below, shared with the flushing thread */
+    std::mutex mutex;
+
+    std::condition_variable condition;
+
+    /** buffer handed over to be flushed */
+    const char *pendingBuffer{nullptr};
+
+    /** size of the pending buffer, 0 when flushed */
+    size_t pendingSize{0};
+
+    /** stop the flushing thread once pending buffer is flushed */
+    bool stopFlag{false};
+
+    /** a flush failed */
+    bool writeError{false};
+};
@@ -6,17 +6,56 @@
  ***********************************************/
 
 #include "Fifo.h"
+#include "receiver_defs.h"
 #include "sls/sls_detector_exceptions.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <linux/memfd.h>
+#include <linux/mempolicy.h>
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <unistd.h>
+#include <vector>
 
-Fifo::Fifo(int ind, uint32_t fifoItemSize, uint32_t depth)
-    : index(ind), memory(nullptr), fifoBound(nullptr), fifoFree(nullptr),
-      fifoStream(nullptr), fifoDepth(depth), status_fifoBound(0),
-      status_fifoFree(depth) {
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/** Counts dTLB load misses of this thread, -1 if not permitted */
+int OpenTlbMissCounter() {
+    struct perf_event_attr attr {};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::string ReadTlbMissCounter(int fd) {
+    uint64_t value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) {
+        return "n/a";
+    }
+    return std::to_string(value);
+}
+
+} // namespace
+
+Fifo::Fifo(int ind, uint32_t fifoItemSize, uint32_t depth, bool hugepages,
+           bool locked, int node, bool shared)
+    : index(ind), memory(nullptr), hugePages(hugepages), memoryLock(locked),
+      numaNode(node), sharedMemory(shared), fifoBound(nullptr),
+      fifoFree(nullptr), fifoStream(nullptr), fifoDepth(depth),
+      status_fifoBound(0), status_fifoFree(depth) {
     LOG(logDEBUG3) << __SHORT_AT__ << " called";
     CreateFifos(fifoItemSize);
 }
@@ -33,68 +72,235 @@ void Fifo::CreateFifos(uint32_t fifoItemSize) {
     DestroyFifos();
 
     // create fifos
+    // freed by processor, writer, streamer and zmq io thread, streamed after
+    // processing or writing
     fifoBound = new sls::CircularFifo<char>(fifoDepth);
-    fifoFree = new sls::CircularFifo<char>(fifoDepth);
-    fifoStream = new sls::CircularFifo<char>(fifoDepth);
+    fifoFree = new sls::CircularFifo<char>(fifoDepth, true);
+    fifoStream = new sls::CircularFifo<char>(fifoDepth, true);
+    fifoWrite = new sls::CircularFifo<char>(fifoDepth);
+    inFlight = new InFlight;
+    inFlight->fifoFree = fifoFree;
     // allocate memory
     size_t mem_len = (size_t)fifoItemSize * (size_t)fifoDepth * sizeof(char);
-    memory = (char *)malloc(mem_len);
+    size_t pagesize = getpagesize();
+    if (mem_len == 0) {
+        mem_len = pagesize;
+    }
+    struct rusage usage_before {};
+    getrusage(RUSAGE_THREAD, &usage_before);
+    int tlbMissCounter = OpenTlbMissCounter();
+
+    std::string backing = "normal pages";
+    if (hugePages) {
+        memorySize = ((mem_len + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) *
+                     HUGE_PAGE_SIZE;
+        memory = MapMemory(memorySize, true);
+        if (memory != nullptr) {
+            backing = "hugetlbfs pages";
+        }
+    }
     if (memory == nullptr) {
-        throw sls::RuntimeError("Could not allocate memory for fifos");
+        if (!hugePages) {
+            memorySize = ((mem_len + pagesize - 1) / pagesize) * pagesize;
+        }
+        memory = MapMemory(memorySize, false);
+        if (memory == nullptr) {
+            memorySize = 0;
+            throw sls::RuntimeError("Could not allocate memory for fifos");
+        }
+        // no reserved huge pages, try transparent huge pages
+        if (hugePages) {
+            if (madvise(memory, memorySize, MADV_HUGEPAGE) == 0) {
+                backing = "transparent huge pages";
+            } else {
+                LOG(logWARNING) << "Fifo " << index
+                                << ": Could not get huge pages for memory";
+            }
+        }
+    }
+
+    // before any page is touched
+    if (numaNode >= 0 && numaNode < (int)(8 * sizeof(unsigned long))) {
+        unsigned long nodemask = 1UL << numaNode;
+        if (syscall(SYS_mbind, memory, memorySize, MPOL_PREFERRED, &nodemask,
+                    8 * sizeof(nodemask), 0) != 0) {
+            LOG(logWARNING) << "Fifo " << index
+                            << ": Could not bind memory to numa node "
+                            << numaNode;
+        }
     }
-    memset(memory, 0, mem_len);
-    int pagesize = getpagesize();
-    for (size_t i = 0; i < mem_len; i += pagesize) {
-        strcpy(memory + i, "memory");
+
+    // fault in all pages now instead of while receiving
+    bool locked = false;
+    if (memoryLock) {
+        locked = (mlock(memory, memorySize) == 0);
+        if (!locked) {
+            LOG(logWARNING) << "Fifo " << index
+                            << ": Could not lock memory (check ulimit -l)";
+        }
+    }
+    if (!locked) {
+        for (size_t i = 0; i < memorySize; i += pagesize) {
+            memory[i] = 0;
+        }
+    }
+
+    struct rusage usage_after {};
+    getrusage(RUSAGE_THREAD, &usage_after);
+    LOG(logINFO) << "Fifo " << index << " memory: "
+                 << (double)memorySize / (double)(1024 * 1024) << " MB, "
+                 << backing << (sharedMemory ? ", shared" : "")
+                 << (locked ? ", locked" : "")
+                 << (numaNode >= 0 ? ", numa node " + std::to_string(numaNode)
+                                   : "");
+    LOG(logINFO) << "Fifo " << index
+                 << " page faults (minor, major) before: "
+                 << usage_before.ru_minflt << ", " << usage_before.ru_majflt
+                 << " after: " << usage_after.ru_minflt << ", "
+                 << usage_after.ru_majflt << ", dTLB load misses: "
+                 << ReadTlbMissCounter(tlbMissCounter);
+    if (tlbMissCounter >= 0) {
+        close(tlbMissCounter);
     }
-    LOG(logDEBUG) << "Memory Allocated " << index << ": "
-                  << (double)mem_len / (double)(1024 * 1024) << " MB";
 
     { // push free addresses into fifoFree fifo
-        char *buffer = memory;
+        std::vector<char *> buffers(fifoDepth);
         for (int i = 0; i < fifoDepth; ++i) {
-            // sprintf(buffer,"memory");
-            FreeAddress(buffer);
-            buffer += fifoItemSize;
+            buffers[i] = memory + (size_t)i * fifoItemSize;
         }
+        fifoFree->push(buffers.data(), buffers.size());
     }
     LOG(logINFO) << "Fifo " << index << " reconstructed Depth (rx_fifodepth): "
                  << fifoFree->getDataValue();
 }
 
+char *Fifo::MapMemory(size_t size, bool hugetlb) {
+    if (!sharedMemory) {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | (hugetlb ? MAP_HUGETLB : 0);
+        void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return (p == MAP_FAILED) ? nullptr : (char *)p;
+    }
+    // a memory file, so that writer processes can map it after exec
+    unsigned flags = MFD_CLOEXEC | (hugetlb ? MFD_HUGETLB : 0);
+    int fd = static_cast<int>(
+        syscall(SYS_memfd_create, "slsReceiverFifo", flags));
+    if (fd < 0) {
+        return nullptr;
+    }
+    void *p = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+        p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (p == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    memoryFd = fd;
+    return (char *)p;
+}
+
 void Fifo::DestroyFifos() {
     LOG(logDEBUG3) << __SHORT_AT__ << " called";
 
+    // zmq could still be sending from the memory, as the streamer sockets
+    // drop their queued images when closed, only if they are still open
+    if (!WaitForAddressesInFlight()) {
+        LOG(logERROR) << "Fifo " << index << ": " << inFlight->count
+                      << " images still streamed by zmq, leaking its memory";
+        memory = nullptr;
+        memorySize = 0;
+        fifoFree = nullptr;
+        inFlight = nullptr;
+    }
+
     if (memory) {
-        free(memory);
+        munmap(memory, memorySize);
         memory = nullptr;
+        memorySize = 0;
+    }
+    if (memoryFd >= 0) {
+        close(memoryFd);
+        memoryFd = -1;
     }
+    unusedAddress = nullptr;
     delete fifoBound;
     fifoBound = nullptr;
     delete fifoFree;
     fifoFree = nullptr;
     delete fifoStream;
     fifoStream = nullptr;
+    delete fifoWrite;
+    fifoWrite = nullptr;
+    delete inFlight;
+    inFlight = nullptr;
 }
 
 void Fifo::FreeAddress(char *&address) { fifoFree->push(address); }
 
+bool Fifo::SetAddressInFlight() {
+    // keep half of the fifo for the listener
+    if (!zeroCopyStreaming ||
+        inFlight->count >= std::max(1, fifoDepth / 2)) {
+        return false;
+    }
+    int temp = ++inFlight->count;
+    if (temp > status_fifoInFlight)
+        status_fifoInFlight = temp;
+    return true;
+}
+
+void Fifo::FreeAddressInFlight(char *address) {
+    FreeAddressInFlight(address, inFlight);
+}
+
+void Fifo::FreeAddressInFlight(char *address, void *hint) {
+    auto *images = static_cast<InFlight *>(hint);
+    images->fifoFree->push(address);
+    --images->count;
+}
+
+void *Fifo::GetInFlightHint() { return inFlight; }
+
+void Fifo::SetZeroCopyStreaming(bool enable) { zeroCopyStreaming = enable; }
+
+bool Fifo::WaitForAddressesInFlight() {
+    if (inFlight == nullptr) {
+        return true;
+    }
+    // released once sent to all subscribers (or dropped by zmq)
+    for (int i = 1; inFlight->count > 0; ++i) {
+        if (i > FIFO_IN_FLIGHT_TIMEOUT_MS) {
+            return false;
+        }
+        if (i % 1000 == 0) {
+            LOG(logWARNING) << "Fifo " << index << ": Waiting for "
+                            << inFlight->count
+                            << " images still streamed by zmq";
+        }
+        usleep(1000);
+    }
+    return true;
+}
+
 void Fifo::GetNewAddress(char *&address) {
+    if (unusedAddress != nullptr) {
+        address = unusedAddress;
+        unusedAddress = nullptr;
+        return;
+    }
     int temp = fifoFree->getDataValue();
     if (temp < status_fifoFree)
         status_fifoFree = temp;
     fifoFree->pop(address);
 }
 
+void Fifo::ReturnNewAddress(char *&address) { unusedAddress = address; }
+
 void Fifo::PushAddress(char *&address) {
     int temp = fifoBound->getDataValue();
     if (temp > status_fifoBound)
         status_fifoBound = temp;
-    while (!fifoBound->push(address))
-        ;
-    /*temp = fifoBound->getDataValue();
-    if (temp > status_fifoBound)
-            status_fifoBound = temp;*/
+    fifoBound->push(address);
 }
 
 void Fifo::PopAddress(char *&address) { fifoBound->pop(address); }
@@ -103,14 +309,58 @@ void Fifo::PushAddressToStream(char *&address) { fifoStream->push(address); }
 
 void Fifo::PopAddressToStream(char *&address) { fifoStream->pop(address); }
 
+void Fifo::PushAddressToWrite(char *&address) {
+    int temp = fifoWrite->getDataValue();
+    if (temp > status_fifoWrite)
+        status_fifoWrite = temp;
+    fifoWrite->push(address);
+}
+
+void Fifo::PopAddressToWrite(char *&address) { fifoWrite->pop(address); }
+
+bool Fifo::PopAddressToWrite(char *&address,
+                             std::chrono::milliseconds timeout) {
+    return fifoWrite->pop(address, timeout);
+}
+
 int Fifo::GetMaxLevelForFifoBound() {
     int temp = status_fifoBound;
     status_fifoBound = 0;
     return temp;
 }
 
+int Fifo::GetMaxLevelForFifoWrite() {
+    int temp = status_fifoWrite;
+    status_fifoWrite = 0;
+    return temp;
+}
+
 int Fifo::GetMinLevelForFifoFree() {
     int temp = status_fifoFree;
     status_fifoFree = fifoDepth;
     return temp;
 }
+
+int Fifo::GetMaxLevelForFifoInFlight() {
+    int temp = status_fifoInFlight;
+    status_fifoInFlight = 0;
+    return temp;
+}
+
+int Fifo::GetFifoDepth() const { return fifoDepth; }
+
+int Fifo::GetNumToStream() const {
+    return fifoStream->getDataValue() + inFlight->count;
+}
+
+void Fifo::SetStreamCongested() { streamCongested = true; }
+
+bool Fifo::GetStreamCongested() { return streamCongested.exchange(false); }
+
+bool Fifo::IsEmptyToWrite() const { return fifoWrite->isEmpty(); }
+
+char *Fifo::GetMemory() const { return memory; }
+
+size_t Fifo::GetMemorySize() const { return memorySize; }
+
+int Fifo::GetMemoryFd() const { return memoryFd; }
@@ -14,6 +14,9 @@
 
 #include "sls/CircularFifo.h"
 
+#include <atomic>
+#include <chrono>
+
 class Fifo : private virtual slsDetectorDefs {
 
   public:
@@ -23,8 +26,16 @@ class Fifo : private virtual slsDetectorDefs {
      * @param ind self index
      * @param fifoItemSize size of each fifo item
      * @param depth fifo depth
+     * @param hugepages back memory with huge pages (hugetlbfs, else
+     * transparent huge pages)
+     * @param locked lock memory in ram
+     * @param node numa node to allocate memory on, -1 for any
+     * @param shared map memory from a memory file, to be mapped by writer
+     * processes
      */
-    Fifo(int ind, uint32_t fifoItemSize, uint32_t depth);
+    Fifo(int ind, uint32_t fifoItemSize, uint32_t depth,
+         bool hugepages = false, bool locked = false, int node = -1,
+         bool shared = false);
 
     /**
      * Destructor
@@ -36,11 +47,49 @@ class Fifo : private virtual slsDetectorDefs {
      */
     void FreeAddress(char *&address);
 
+    /**
+     * Counts an address handed over to zmq to be streamed without a copy, to
+     * be freed with FreeAddressInFlight once sent
+     * @returns false if zero copy streaming is disabled or half of the fifo
+     * is already in flight, then the image is to be copied instead
+     */
+    bool SetAddressInFlight();
+
+    /**
+     * Frees an address streamed without a copy by pushing into fifoFree. Can
+     * be called from any thread (zmq io thread)
+     */
+    void FreeAddressInFlight(char *address);
+
+    /**
+     * Frees an address streamed without a copy from the zmq io thread, even
+     * if the fifo is already destroyed
+     * @param address address streamed
+     * @param hint GetInFlightHint of the fifo
+     */
+    static void FreeAddressInFlight(char *address, void *hint);
+
+    /** @returns hint to free the addresses streamed without a copy with */
+    void *GetInFlightHint();
+
+    /**
+     * Enable images to be streamed without a copy, freed from the zmq io
+     * thread. Disabling leaves the addresses still in flight to zmq
+     */
+    void SetZeroCopyStreaming(bool enable);
+
     /**
      * Pops free address from fifoFree
      */
     void GetNewAddress(char *&address);
 
+    /**
+     * Gives back an unused address from GetNewAddress, to be returned by the
+     * next GetNewAddress. Only for the listener, as fifoFree takes a single
+     * producer
+     */
+    void ReturnNewAddress(char *&address);
+
     /**
      * Pushes bound address into fifoBound
      */
@@ -61,6 +110,24 @@ class Fifo : private virtual slsDetectorDefs {
      */
     void PopAddressToStream(char *&address);
 
+    /**
+     * Pushes processed address into fifoWrite
+     */
+    void PushAddressToWrite(char *&address);
+
+    /**
+     * Pops processed address from fifoWrite to write to file
+     */
+    void PopAddressToWrite(char *&address);
+
+    /**
+     * Pops processed address from fifoWrite to write to file
+     * @param address popped address
+     * @param timeout maximum time to wait for an address
+     * @returns false if none came within timeout
+     */
+    bool PopAddressToWrite(char *&address, std::chrono::milliseconds timeout);
+
     /**
      * Get Maximum Level filled in Fifo Bound
      * and reset this value for next intake
@@ -73,6 +140,48 @@ class Fifo : private virtual slsDetectorDefs {
      */
     int GetMinLevelForFifoFree();
 
+    /**
+     * Get Maximum Level filled in Fifo Write
+     * and reset this value for next intake
+     */
+    int GetMaxLevelForFifoWrite();
+
+    /**
+     * Get Maximum number of addresses in flight in zmq
+     * and reset this value for next intake
+     */
+    int GetMaxLevelForFifoInFlight();
+
+    /** Fifo depth */
+    int GetFifoDepth() const;
+
+    /** Number of addresses waiting to be streamed or still in flight in zmq */
+    int GetNumToStream() const;
+
+    /**
+     * Flags that the streamer could not hand an image to a client (no
+     * pulling client could take it). Can be called from the streamer thread
+     */
+    void SetStreamCongested();
+
+    /**
+     * Get if the streamer could not hand an image to a client
+     * and reset this flag for next intake
+     */
+    bool GetStreamCongested();
+
+    /** true if no address is waiting to be written */
+    bool IsEmptyToWrite() const;
+
+    /** Memory allocated for the fifo items */
+    char *GetMemory() const;
+
+    /** Size of memory allocated for the fifo items */
+    size_t GetMemorySize() const;
+
+    /** Memory file of the fifo items if shared, else -1 */
+    int GetMemoryFd() const;
+
   private:
     /**
      * Create Fifos, allocate memory & push addresses into fifo
@@ -85,24 +194,81 @@ class Fifo : private virtual slsDetectorDefs {
      */
     void DestroyFifos();
 
+    /**
+     * Maps memory for the fifo items, through a memory file if shared
+     * @param size size of memory
+     * @param hugetlb back memory with hugetlbfs pages
+     * @returns memory, nullptr if it could not be mapped
+     */
+    char *MapMemory(size_t size, bool hugetlb);
+
+    /**
+     * Waits till zmq has freed all the addresses in flight, at most
+     * FIFO_IN_FLIGHT_TIMEOUT_MS
+     * @returns false if addresses are still in flight
+     */
+    bool WaitForAddressesInFlight();
+
     /** Self Index */
     int index;
 
     /** Memory allocated, whose addresses are pushed into the fifos */
     char *memory;
 
+    /** Size of mapped memory */
+    size_t memorySize{0};
+
+    /** Memory file of shared memory, -1 if not shared */
+    int memoryFd{-1};
+
+    /** Memory backed by huge pages */
+    bool hugePages;
+
+    /** Memory locked in ram */
+    bool memoryLock;
+
+    /** Numa node of memory, -1 for any */
+    int numaNode;
+
+    /** Memory shared with writer processes */
+    bool sharedMemory;
+
     /** Circular Fifo pointing to addresses of bound data in memory */
     sls::CircularFifo<char> *fifoBound;
 
-    /** Circular Fifo pointing to addresses of freed data in memory */
+    /** Circular Fifo pointing to addresses of freed data in memory (several
+     * producers) */
     sls::CircularFifo<char> *fifoFree;
 
-    /** Circular Fifo pointing to addresses of to be streamed data in memory */
+    /** Circular Fifo pointing to addresses of to be streamed data in memory
+     * (several producers) */
     sls::CircularFifo<char> *fifoStream;
 
+    /** Circular Fifo pointing to addresses of to be written data in memory */
+    sls::CircularFifo<char> *fifoWrite{nullptr};
+
     /** Fifo depth set */
     int fifoDepth;
 
+    /** Address given back by the listener */
+    char *unusedAddress{nullptr};
+
+    /** Images streamed without a copy, freed by the zmq io thread */
+    std::atomic<bool> zeroCopyStreaming{false};
+
+    /** Addresses streamed without a copy, not yet freed by zmq. Leaked with
+     * fifoFree and the memory if zmq never frees them */
+    struct InFlight {
+        sls::CircularFifo<char> *fifoFree{nullptr};
+        std::atomic<int> count{0};
+    };
+    InFlight *inFlight{nullptr};
+
+    /** Streamer could not hand an image to a client */
+    std::atomic<bool> streamCongested{false};
+
     volatile int status_fifoBound;
     volatile int status_fifoFree;
+    volatile int status_fifoWrite{0};
+    volatile int status_fifoInFlight{0};
 };
@@ -14,6 +14,7 @@
 #include "sls/sls_detector_defs.h"
 
 #include <string>
+#include <vector>
 
 struct MasterAttributes;
 
@@ -90,6 +91,27 @@ class File : private virtual slsDetectorDefs {
      */
     virtual void CreateMasterFile(bool mfwenable, MasterAttributes *attr) = 0;
 
+    // asynchronous writes (binary with io_uring, hdf5 writer process)
+    /** memory the buffers to write are in, to register or share it (fd of
+     * its memory file if shared, else -1). nullptr once it is freed, even if
+     * the next is at the same address */
+    virtual void SetBufferMemory(char *memory, size_t size, int fd) {}
+
+    /** true if buffers given to WriteToFile are not yet released */
+    virtual bool HasPendingWrites() const { return false; }
+
+    /**
+     * Appends the buffers given to WriteToFile that are written (in order)
+     * and can be released. Buffers of a throwing WriteToFile are not kept
+     * @param buffers written buffers
+     * @param wait wait for all writes in flight
+     */
+    virtual void GetCompletedWrites(std::vector<char *> &buffers, bool wait) {}
+
+    /** called while no image comes to write, flushes images written since
+     * the last time based flush (hdf5 swmr) */
+    virtual void FlushIfIdle() {}
+
     // HDf5 specific
     /**
      * Set Number of pixels
@@ -0,0 +1,121 @@
+/************************************************
+ * @file FileRotation.cpp
+ * @short runs the opening of the next sub file and
+ * the closing of the previous one on a background
+ * thread, so that the writer only swaps the handles
+ * when the current sub file is full
+ ***********************************************/
+
+#include "FileRotation.h"
+#include "sls/logger.h"
+
+#include <cstdio>
+#include <unistd.h>
+
+FileRotation::FileRotation(std::string logPrefix)
+    : logPrefix(std::move(logPrefix)) {}
+
+FileRotation::~FileRotation() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopThread = true;
+    }
+    taskAvailable.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void FileRotation::Queue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        if (!thread.joinable()) {
+            thread = std::thread(&FileRotation::Worker, this);
+        }
+    }
+    taskAvailable.notify_all();
+}
+
+void FileRotation::Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    tasksDone.wait(lock, [this] { return tasks.empty() && !running; });
+    if (failure) {
+        std::exception_ptr e = failure;
+        failure = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+bool FileRotation::HasNextFile(uint32_t subIndex, uint32_t maxFramesPerFile,
+                               uint64_t numImages) {
+    return maxFramesPerFile != 0 &&
+           (uint64_t)(subIndex + 1) * maxFramesPerFile < numImages;
+}
+
+void FileRotation::PrepareNext(const std::string &fname,
+                               std::function<void()> open) {
+    nextFileName = fname;
+    Queue([this, fname, open]() {
+        nextFileCreated = (access(fname.c_str(), F_OK) != 0);
+        open();
+    });
+}
+
+std::string FileRotation::TakeNext(const std::function<bool()> &isOpen) {
+    std::string fname;
+    std::swap(fname, nextFileName);
+    if (fname.empty()) {
+        return fname;
+    }
+    try {
+        Wait();
+    } catch (const std::exception &e) {
+        LOG(logWARNING) << "[" << logPrefix << "]: " << e.what();
+    }
+    if (!isOpen()) {
+        fname.clear();
+    }
+    return fname;
+}
+
+void FileRotation::DiscardNext(const std::function<bool()> &close) {
+    try {
+        Wait();
+    } catch (const std::exception &e) {
+        LOG(logERROR) << "[" << logPrefix << "]: " << e.what();
+    }
+    // only a file created here, not one that existed
+    if (close() && nextFileCreated && !nextFileName.empty()) {
+        remove(nextFileName.c_str());
+    }
+    nextFileName.clear();
+}
+
+void FileRotation::Worker() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        taskAvailable.wait(lock,
+                           [this] { return !tasks.empty() || stopThread; });
+        // queued tasks are run before stopping, files are not left open
+        if (tasks.empty()) {
+            return;
+        }
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        running = true;
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception &) {
+            lock.lock();
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            lock.unlock();
+        }
+        lock.lock();
+        running = false;
+        tasksDone.notify_all();
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+/************************************************
+ * @file FileRotation.h
+ * @short runs the opening of the next sub file and
+ * the closing of the previous one on a background
+ * thread, so that the writer only swaps the handles
+ * when the current sub file is full
+ ***********************************************/
+/**
+ *@short background thread opening and closing sub files in order
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class FileRotation {
+
+  public:
+    /**
+     * Constructor
+     * The thread is only started with the first task
+     * @param logPrefix prefix of the logged errors (udp port)
+     */
+    explicit FileRotation(std::string logPrefix);
+
+    /**
+     * Destructor
+     * Runs the queued tasks and stops the thread
+     */
+    ~FileRotation();
+
+    FileRotation(const FileRotation &) = delete;
+    FileRotation &operator=(const FileRotation &) = delete;
+
+    /**
+     * Queues a task, run after the ones queued before
+     * @param task task to run, must not throw anything but exceptions
+     * derived from std::exception
+     */
+    void Queue(std::function<void()> task);
+
+    /**
+     * Waits for the queued tasks to be done. Throws the first exception
+     * of a task since the last wait
+     */
+    void Wait();
+
+    /**
+     * @param subIndex index of the current sub file
+     * @param maxFramesPerFile frames per sub file, 0 for a single file
+     * @param numImages images of the acquisition
+     * @returns true if the images do not fit into the sub files up to
+     * subIndex
+     */
+    static bool HasNextFile(uint32_t subIndex, uint32_t maxFramesPerFile,
+                            uint64_t numImages);
+
+    /**
+     * Queues the opening of the next sub file, noting if it did not exist
+     * before (only then is it removed when discarded)
+     * @param fname name of the next sub file
+     * @param open opens the next sub file
+     */
+    void PrepareNext(const std::string &fname, std::function<void()> open);
+
+    /**
+     * Waits for the next sub file to be opened, errors are logged
+     * @param isOpen returns true if the next sub file is open
+     * @returns name of the next sub file, empty if none was prepared or
+     * could not be opened
+     */
+    std::string TakeNext(const std::function<bool()> &isOpen);
+
+    /**
+     * Waits for the queued tasks and closes the next sub file if it was
+     * prepared but not used, errors are logged
+     * @param close closes the next sub file, returns true if it was open
+     */
+    void DiscardNext(const std::function<bool()> &close);
+
+  private:
+    void Worker();
+
+    std::string logPrefix;
+    /** next sub file, empty if none prepared */
+    std::string nextFileName;
+    /** next sub file did not exist before */
+    bool nextFileCreated{false};
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable tasksDone;
+    std::deque<std::function<void()>> tasks;
+    bool running{false};
+    bool stopThread{false};
+    std::exception_ptr failure;
+};
@@ -0,0 +1,346 @@
+/************************************************
+ * @file FileWriter.cpp
+ * @short creates file writer thread that
+ * pulls processed images from the fifo, writes them
+ * to file and only then streams or frees them
+ ***********************************************/
+
+#include "FileWriter.h"
+#include "BinaryFile.h"
+#include "Fifo.h"
+#include "GeneralData.h"
+#include "IndexedFile.h"
+#include "MasterAttributes.h"
+#ifdef HDF5C
+#include "HDF5File.h"
+#include "HDF5ProcessFile.h"
+#endif
+#include "sls/sls_detector_exceptions.h"
+
+#include <chrono>
+
+const std::string FileWriter::TypeName = "FileWriter";
+
+FileWriter::FileWriter(int ind, Fifo *f, fileFormat *ftype, bool *mfwenable,
+                       bool *dsEnable, bool *sm, bool *dio, bool *uring,
+                       uint32_t *cframes, uint32_t *crows, bool *cheader,
+                       bool *h5process, bool *swmr, uint32_t *flushf,
+                       uint32_t *flusht, fileCompression *comp,
+                       CompressionPool *pool)
+    : ThreadObject(ind, TypeName), fifo(f), fileFormatType(ftype),
+      masterFileWriteEnable(mfwenable), dataStreamEnable(dsEnable),
+      silentMode(sm), directIO(dio), ioUring(uring), chunkFrames(cframes),
+      chunkRows(crows), compoundHeader(cheader), writerProcess(h5process),
+      swmrMode(swmr), flushFrames(flushf), flushTime(flusht),
+      compressor(comp, pool) {
+    LOG(logDEBUG) << "FileWriter " << ind << " created";
+}
+
+FileWriter::~FileWriter() { delete file; }
+
+void FileWriter::SetFifo(Fifo *f) {
+    fifo = f;
+    // memory of the previous fifo is freed
+    if (file != nullptr) {
+        file->SetBufferMemory(nullptr, 0, -1);
+    }
+}
+
+void FileWriter::ResetParametersforNewAcquisition() {
+    StopRunning();
+    startedFlag = false;
+    firstIndex = 0;
+    numImagesWritten = 0;
+    totalWriteTime = 0;
+    maxWriteTime = 0;
+    compressor.ResetStatistics();
+    fifo->GetMaxLevelForFifoWrite();
+}
+
+void FileWriter::SetGeneralData(GeneralData *g) {
+    generalData = g;
+    SetPixelDimension();
+}
+
+void FileWriter::SetFileFormat(const fileFormat f) {
+    if ((file != nullptr) && file->GetFileType() != f) {
+        RecreateFile();
+    }
+}
+
+void FileWriter::RecreateFile() {
+    // remember the pointer values before they are destroyed
+    int nd[MAX_DIMENSIONS];
+    nd[0] = 0;
+    nd[1] = 0;
+    uint32_t *maxf = nullptr;
+    std::string *fname = nullptr;
+    std::string *fpath = nullptr;
+    uint64_t *findex = nullptr;
+    bool *owenable = nullptr;
+    int *dindex = nullptr;
+    int *nunits = nullptr;
+    uint64_t *nf = nullptr;
+    uint32_t *dr = nullptr;
+    uint32_t *port = nullptr;
+    file->GetMemberPointerValues(nd, maxf, fname, fpath, findex, owenable,
+                                 dindex, nunits, nf, dr, port);
+    // create file writer with same pointers
+    SetupFileWriter(fileWriteEnable, nd, maxf, fname, fpath, findex, owenable,
+                    dindex, nunits, nf, dr, port);
+}
+
+void FileWriter::SetupFileWriter(bool fwe, int *nd, uint32_t *maxf,
+                                 std::string *fname, std::string *fpath,
+                                 uint64_t *findex, bool *owenable, int *dindex,
+                                 int *nunits, uint64_t *nf, uint32_t *dr,
+                                 uint32_t *portno, GeneralData *g) {
+    fileWriteEnable = fwe;
+    if (g != nullptr)
+        generalData = g;
+
+    if (file != nullptr) {
+        delete file;
+        file = nullptr;
+    }
+
+    if (fileWriteEnable) {
+        switch (*fileFormatType) {
+#ifdef HDF5C
+        case HDF5:
+            fileInProcess = *writerProcess;
+            if (fileInProcess) {
+                file = new HDF5ProcessFile(
+                    index, maxf, nd, fname, fpath, findex, owenable, dindex,
+                    nunits, nf, dr, portno, generalData->nPixelsX,
+                    generalData->nPixelsY, silentMode, chunkFrames, chunkRows,
+                    compoundHeader, swmrMode, flushFrames, flushTime,
+                    &compressor);
+                break;
+            }
+            file = new HDF5File(index, maxf, nd, fname, fpath, findex, owenable,
+                                dindex, nunits, nf, dr, portno,
+                                generalData->nPixelsX, generalData->nPixelsY,
+                                silentMode, chunkFrames, chunkRows,
+                                compoundHeader, swmrMode, flushFrames,
+                                flushTime, &compressor);
+            break;
+#endif
+        case INDEXED:
+            file = new IndexedFile(index, maxf, nd, fname, fpath, findex,
+                                   owenable, dindex, nunits, nf, dr, portno,
+                                   generalData->nPixelsX,
+                                   generalData->nPixelsY, silentMode);
+            break;
+        default:
+            file =
+                new BinaryFile(index, maxf, nd, fname, fpath, findex, owenable,
+                               dindex, nunits, nf, dr, portno, silentMode,
+                               directIO, ioUring, &compressor);
+            break;
+        }
+    }
+}
+
+// only the first file
+void FileWriter::CreateNewFile(MasterAttributes *attr) {
+    if (file == nullptr) {
+        throw sls::RuntimeError("file object not contstructed");
+    }
+    // writer process enabled or disabled since
+    if (file->GetFileType() == HDF5 && fileInProcess != *writerProcess) {
+        RecreateFile();
+    }
+    // indexed files are written plainly
+    if (file->GetFileType() == INDEXED &&
+        (*directIO || *ioUring || compressor.IsEnabled())) {
+        LOG(logWARNING) << index
+                        << ": Indexed binary files are written without "
+                           "direct io, io_uring and compression";
+    }
+    file->CloseAllFiles();
+    file->resetSubFileIndex();
+    file->CreateMasterFile(*masterFileWriteEnable, attr);
+    file->SetBufferMemory(fifo->GetMemory(), fifo->GetMemorySize(),
+                          fifo->GetMemoryFd());
+    file->CreateFile();
+}
+
+void FileWriter::CloseFiles() {
+    if (file != nullptr)
+        file->CloseAllFiles();
+}
+
+void FileWriter::EndofAcquisition(bool anyPacketsCaught, uint64_t numf) {
+    if ((file != nullptr) && file->GetFileType() == HDF5) {
+        try {
+            file->EndofAcquisition(anyPacketsCaught, numf);
+        } catch (const sls::RuntimeError &e) {
+            ; // ignore for now //TODO: send error to client via stop receiver
+        }
+    }
+}
+
+void FileWriter::SetPixelDimension() {
+    if (file != nullptr) {
+        if (file->GetFileType() == HDF5 || file->GetFileType() == INDEXED) {
+            file->SetNumberofPixels(generalData->nPixelsX,
+                                    generalData->nPixelsY);
+        }
+    }
+}
+
+uint64_t FileWriter::GetNumImagesWritten() const { return numImagesWritten; }
+
+double FileWriter::GetAverageWriteLatency() const {
+    uint64_t n = numImagesWritten;
+    if (n == 0) {
+        return 0;
+    }
+    return (double)totalWriteTime / (double)n / 1000.00;
+}
+
+double FileWriter::GetMaxWriteLatency() const {
+    return (double)maxWriteTime / 1000.00;
+}
+
+int FileWriter::GetMaxQueueLevel() { return fifo->GetMaxLevelForFifoWrite(); }
+
+uint64_t FileWriter::GetNumBytesRaw() const {
+    return compressor.GetRawBytes();
+}
+
+uint64_t FileWriter::GetNumBytesPacked() const {
+    return compressor.GetPackedBytes();
+}
+
+double FileWriter::GetCompressionRate() const {
+    uint64_t ns = compressor.GetCompressionTime();
+    if (ns == 0) {
+        return 0;
+    }
+    // bytes per ns to MB/s
+    return (double)compressor.GetRawBytes() * 1000.00 / (double)ns;
+}
+
+void FileWriter::ThreadExecution() {
+    // nothing more to queue, let the writes in flight complete
+    if ((file != nullptr) && file->HasPendingWrites() &&
+        fifo->IsEmptyToWrite()) {
+        ReleaseWritten(true);
+    }
+
+    char *buffer = nullptr;
+    // idle, swmr readers still see the last images in time
+    auto idle = std::chrono::milliseconds(WRITER_IDLE_CHECK_MS);
+    if (!fifo->PopAddressToWrite(buffer, idle)) {
+        if (file != nullptr) {
+            file->FlushIfIdle();
+        }
+        return;
+    }
+    LOG(logDEBUG5) << "FileWriter " << index << ", pop 0x" << std::hex
+                   << (void *)(buffer) << std::dec;
+
+    auto numBytes = (uint32_t)(*((uint32_t *)buffer));
+    if (numBytes == DUMMY_PACKET_VALUE) {
+        StopWriting(buffer);
+        return;
+    }
+    // discarded by listener or processor, only to be freed
+    if (numBytes == DISCARD_PACKET_VALUE) {
+        ReleaseWritten(false);
+        ReleaseImage(buffer);
+        return;
+    }
+    // released once written, after the images before it
+    bool queued = WriteAnImage(buffer);
+    ReleaseWritten(false);
+    if (!queued) {
+        ReleaseImage(buffer);
+    }
+}
+
+void FileWriter::ReleaseImage(char *buf) {
+    bool stream = *dataStreamEnable;
+    auto numBytes = (uint32_t)(*((uint32_t *)buf));
+    if (numBytes != DISCARD_PACKET_VALUE && numBytes != DUMMY_PACKET_VALUE) {
+        auto streamIndex = *((uint32_t *)(buf + FIFO_DATASIZE_NUMBYTES));
+        stream = stream && (streamIndex != NOT_STREAMED_VALUE);
+    }
+    // stream or free, only once written (concurrently with the streamer
+    // freeing the images it has sent)
+    if (stream) {
+        fifo->PushAddressToStream(buf);
+    } else {
+        fifo->FreeAddress(buf);
+    }
+}
+
+void FileWriter::ReleaseWritten(bool wait) {
+    if (file == nullptr || !file->HasPendingWrites()) {
+        return;
+    }
+    file->GetCompletedWrites(writtenBuffers, wait);
+    // file was given the image after the fifo header
+    for (auto *b : writtenBuffers) {
+        ReleaseImage(b - FIFO_HEADER_NUMBYTES);
+    }
+    writtenBuffers.clear();
+}
+
+void FileWriter::StopWriting(char *buf) {
+    LOG(logDEBUG1) << "FileWriter " << index << ": Dummy";
+
+    if (file != nullptr)
+        file->CloseCurrentFile();
+    ReleaseWritten(true);
+
+    // stream or free
+    if (*dataStreamEnable)
+        fifo->PushAddressToStream(buf);
+    else
+        fifo->FreeAddress(buf);
+
+    StopRunning();
+    LOG(logDEBUG1) << index << ": Writing Completed";
+}
+
+bool FileWriter::WriteAnImage(char *buf) {
+    auto *rheader = (sls_receiver_header *)(buf + FIFO_HEADER_NUMBYTES);
+    uint64_t fnum = rheader->detHeader.frameNumber;
+    uint32_t nump = rheader->detHeader.packetNumber;
+    if (!startedFlag) {
+        startedFlag = true;
+        firstIndex = fnum;
+    }
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool async = false;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        file->WriteToFile(
+            buf + FIFO_HEADER_NUMBYTES,
+            sizeof(sls_receiver_header) +
+                (uint32_t)(*((uint32_t *)buf)), //+ size of data (resizable
+                                                // from previous call back
+            fnum - firstIndex, nump);
+        async = file->HasPendingWrites();
+    } catch (const sls::RuntimeError &e) {
+        ; // ignore write exception for now (TODO: send error message
+          // via stopReceiver tcp)
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    // only this thread updates them
+    ++numImagesWritten;
+    totalWriteTime += elapsed;
+    if ((uint64_t)elapsed > maxWriteTime) {
+        maxWriteTime = elapsed;
+    }
+    return async;
+}
@@ -0,0 +1,269 @@
+#pragma once
+/************************************************
+ * @file FileWriter.h
+ * @short creates file writer thread that
+ * pulls processed images from the fifo, writes them
+ * to file and only then streams or frees them
+ ***********************************************/
+/**
+ *@short creates & manages a file writer thread each
+ */
+
+#include "Compressor.h"
+#include "ThreadObject.h"
+#include "receiver_defs.h"
+
+class GeneralData;
+class Fifo;
+class File;
+struct MasterAttributes;
+
+#include <atomic>
+#include <vector>
+
+class FileWriter : private virtual slsDetectorDefs, public ThreadObject {
+
+  public:
+    /**
+     * Constructor
+     * @param ind self index
+     * @param f address of Fifo pointer
+     * @param ftype pointer to file format type
+     * @param mfwenable pointer to master file write enable
+     * @param dsEnable pointer to data stream enable
+     * @param sm pointer to silent mode
+     * @param dio pointer to direct io enable for binary files
+     * @param uring pointer to io_uring enable for binary files
+     * @param cframes pointer to number of images per hdf5 chunk
+     * @param crows pointer to number of rows per hdf5 chunk (0 for all)
+     * @param cheader pointer to hdf5 receiver header as one compound dataset
+     * @param h5process pointer to hdf5 data file written by a writer process
+     * @param swmr pointer to hdf5 single writer multiple reader mode
+     * @param flushf pointer to number of images between swmr flushes
+     * @param flusht pointer to time in ms between swmr flushes
+     * @param comp pointer to file compression type
+     * @param pool thread pool compressing the blocks of an image (nullptr
+     * for none)
+     */
+    FileWriter(int ind, Fifo *f, fileFormat *ftype, bool *mfwenable,
+               bool *dsEnable, bool *sm, bool *dio, bool *uring,
+               uint32_t *cframes, uint32_t *crows, bool *cheader,
+               bool *h5process, bool *swmr, uint32_t *flushf, uint32_t *flusht,
+               fileCompression *comp, CompressionPool *pool);
+
+    /**
+     * Destructor
+     */
+    ~FileWriter() override;
+
+    /**
+     * Set Fifo pointer to the one given
+     * @param f address of Fifo pointer
+     */
+    void SetFifo(Fifo *f);
+
+    /**
+     * Reset parameters for new acquisition
+     */
+    void ResetParametersforNewAcquisition();
+
+    /**
+     * Set GeneralData pointer to the one given
+     * @param g address of GeneralData (Detector Data) pointer
+     */
+    void SetGeneralData(GeneralData *g);
+
+    /**
+     * Set File Format
+     * @param fs file format
+     */
+    void SetFileFormat(const fileFormat fs);
+
+    /**
+     * Set up file writer object
+     * @param fwe file write enable
+     * @param nd pointer to number of detectors in each dimension
+     * @param maxf pointer to max frames per file
+     * @param fname pointer to file name prefix
+     * @param fpath pointer to file path
+     * @param findex pointer to file index
+     * @param owenable pointer to over write enable
+     * @param dindex pointer to detector index
+     * @param nunits pointer to number of threads/ units per detector
+     * @param nf pointer to number of images in acquisition
+     * @param dr pointer to dynamic range
+     * @param portno pointer to udp port number
+     * @param g address of GeneralData (Detector Data) pointer
+     */
+    void SetupFileWriter(bool fwe, int *nd, uint32_t *maxf, std::string *fname,
+                         std::string *fpath, uint64_t *findex, bool *owenable,
+                         int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
+                         uint32_t *portno, GeneralData *g = nullptr);
+
+    /**
+     * Create New File
+     * @param attr master file attributes
+     */
+    void CreateNewFile(MasterAttributes *attr);
+
+    /**
+     * Closes files
+     */
+    void CloseFiles();
+
+    /**
+     * End of Acquisition
+     * @param anyPacketsCaught true if any packets are caught, else false
+     * @param numf number of images caught
+     */
+    void EndofAcquisition(bool anyPacketsCaught, uint64_t numf);
+
+    /**
+     * Update pixel dimensions in file writer
+     */
+    void SetPixelDimension();
+
+    /** Number of images written in this acquisition */
+    uint64_t GetNumImagesWritten() const;
+
+    /** Average time in us to write an image in this acquisition */
+    double GetAverageWriteLatency() const;
+
+    /** Maximum time in us to write an image in this acquisition */
+    double GetMaxWriteLatency() const;
+
+    /**
+     * Maximum number of images queued to be written since the last call
+     */
+    int GetMaxQueueLevel();
+
+    /** Uncompressed bytes of the images compressed in this acquisition */
+    uint64_t GetNumBytesRaw() const;
+
+    /** Compressed bytes written in this acquisition */
+    uint64_t GetNumBytesPacked() const;
+
+    /** Compression speed in MB/s of uncompressed data in this acquisition */
+    double GetCompressionRate() const;
+
+  private:
+    /**
+     * Creates the file object again with the same pointers, for the current
+     * file format and options
+     */
+    void RecreateFile();
+
+    /**
+     * Thread Execution for FileWriter Class
+     * Pop processed addresses, write them to file,
+     * then stream or free the address
+     */
+    void ThreadExecution() override;
+
+    /**
+     * Closes the current file, passes on the dummy buffer
+     * and resets running mask by calling StopRunning()
+     * @param buf address of pointer
+     */
+    void StopWriting(char *buf);
+
+    /**
+     * Write an image popped from fifo to file and update statistics
+     * @param buf address of pointer
+     * @returns true if the file keeps the buffer till written (io_uring)
+     */
+    bool WriteAnImage(char *buf);
+
+    /**
+     * Stream or free a buffer once written. The streamer (and the zmq io
+     * thread) free buffers concurrently, fifoFree and fifoStream take
+     * several producers
+     * @param buf address of pointer
+     */
+    void ReleaseImage(char *buf);
+
+    /**
+     * Stream or free the buffers the file has finished writing
+     * @param wait wait for all writes in flight
+     */
+    void ReleaseWritten(bool wait);
+
+    /** type of thread */
+    static const std::string TypeName;
+
+    /** GeneralData (Detector Data) object */
+    const GeneralData *generalData{nullptr};
+
+    /** Fifo structure */
+    Fifo *fifo;
+
+    /** File writer implemented as binary or hdf5 File */
+    File *file{nullptr};
+
+    /** File Format Type */
+    fileFormat *fileFormatType;
+
+    /** File Write Enable */
+    bool fileWriteEnable{false};
+
+    /** Master File Write Enable */
+    bool *masterFileWriteEnable;
+
+    /** Data Stream Enable */
+    bool *dataStreamEnable;
+
+    /** Silent Mode */
+    bool *silentMode;
+
+    /** Direct io enable for binary files */
+    bool *directIO;
+
+    /** io_uring enable for binary files */
+    bool *ioUring;
+
+    /** Number of images per hdf5 chunk */
+    uint32_t *chunkFrames;
+
+    /** Number of rows per hdf5 chunk, 0 for all */
+    uint32_t *chunkRows;
+
+    /** hdf5 receiver header as one compound dataset */
+    bool *compoundHeader;
+
+    /** hdf5 data file written by a writer process */
+    bool *writerProcess;
+
+    /** hdf5 single writer multiple reader mode */
+    bool *swmrMode;
+
+    /** Number of images between swmr flushes, 0 for none */
+    uint32_t *flushFrames;
+
+    /** Time in ms between swmr flushes, 0 for none */
+    uint32_t *flushTime;
+
+    /** compresses the images of the file (not in a writer process) */
+    Compressor compressor;
+
+    /** file object writes in a writer process */
+    bool fileInProcess{false};
+
+    /** buffers written asynchronously, to be released */
+    std::vector<char *> writtenBuffers;
+
+    /** Aquisition Started flag */
+    bool startedFlag{false};
+
+    /** Frame Number of First Frame */
+    uint64_t firstIndex{0};
+
+    // for statistics
+    /** Number of images written */
+    std::atomic<uint64_t> numImagesWritten{0};
+
+    /** Total time spent writing images in ns */
+    std::atomic<uint64_t> totalWriteTime{0};
+
+    /** Longest time spent writing an image in ns */
+    std::atomic<uint64_t> maxWriteTime{0};
+};
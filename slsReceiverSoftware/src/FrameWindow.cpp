@@ -0,0 +1,206 @@
+/************************************************
+ * @file FrameWindow.cpp
+ * @short window of consecutive frames being assembled
+ * in fifo buffers, shared by all threads receiving
+ * packets of one udp port
+ ***********************************************/
+
+#include "FrameWindow.h"
+#include "Fifo.h"
+#include "receiver_defs.h"
+#include "sls/sls_detector_exceptions.h"
+
+#include <climits>
+#include <cstring>
+#include <thread>
+
+namespace {
+constexpr uint64_t CLOSED_SLOT = UINT64_MAX;
+constexpr size_t MASK_WORD_BITS = sizeof(unsigned long) * CHAR_BIT;
+
+/** Sets bit pnum of the packets mask atomically, the bitset is stored as an
+ * array of unsigned long. Returns false if it was already set */
+bool SetMaskBit(slsDetectorDefs::sls_bitset &mask, uint32_t pnum) {
+    static_assert(sizeof(slsDetectorDefs::sls_bitset) ==
+                      MAX_NUM_PACKETS / CHAR_BIT,
+                  "packets mask is not a plain array of words");
+    auto *words = reinterpret_cast<unsigned long *>(&mask);
+    unsigned long bit = 1UL << (pnum % MASK_WORD_BITS);
+    return (__atomic_fetch_or(&words[pnum / MASK_WORD_BITS], bit,
+                              __ATOMIC_RELAXED) &
+            bit) == 0;
+}
+} // namespace
+
+FrameWindow::FrameWindow(Fifo *f, uint32_t size, uint32_t ppf, uint32_t dsize,
+                         uint32_t isize, uint32_t fifohsize,
+                         frameDiscardPolicy *fdp)
+    : fifo(f), windowSize(size), packetsPerFrame(ppf), dataSize(dsize),
+      imageSize(isize), fifoBufferHeaderSize(fifohsize),
+      frameDiscardMode(fdp) {
+    if (windowSize == 0 || packetsPerFrame > MAX_NUM_PACKETS) {
+        throw sls::RuntimeError("Invalid frame window");
+    }
+    slots.reset(new Slot[windowSize]);
+    for (uint32_t i = 0; i < windowSize; ++i) {
+        slots[i].frameNumber = CLOSED_SLOT;
+    }
+}
+
+FrameWindow::~FrameWindow() = default;
+
+void FrameWindow::SetHardCodedPosition(uint16_t r, uint16_t c) {
+    row = r;
+    column = c;
+}
+
+bool FrameWindow::HasStarted() const { return startedFlag; }
+
+uint64_t FrameWindow::GetFirstFrameNumber() const { return firstFrame; }
+
+uint64_t FrameWindow::GetNextFrameNumber() const { return nextFrame; }
+
+uint64_t FrameWindow::GetNumFramesPushed() const { return numFramesPushed; }
+
+bool FrameWindow::AddPacket(uint64_t fnum, uint32_t pnum,
+                            const sls_detector_header *header,
+                            const char *data) {
+    while (true) {
+        Slot &s = slots[fnum % windowSize];
+        // announce writer before checking the frame, so that the slot is not
+        // pushed while writing into it (pairs with PushOldest)
+        s.writers.fetch_add(1, std::memory_order_seq_cst);
+        if (s.frameNumber.load(std::memory_order_seq_cst) == fnum) {
+            auto *new_header = (sls_receiver_header *)(s.buffer +
+                                                       FIFO_HEADER_NUMBYTES);
+            // duplicate
+            if (!SetMaskBit(new_header->packetsMask, pnum)) {
+                s.writers.fetch_sub(1, std::memory_order_release);
+                return false;
+            }
+            memcpy(s.buffer + fifoBufferHeaderSize + (pnum * dataSize), data,
+                   dataSize);
+            bool expected = false;
+            if (s.headerWritten.compare_exchange_strong(expected, true)) {
+                memcpy((char *)new_header, (const char *)header,
+                       sizeof(sls_detector_header));
+            }
+            uint32_t n = s.numPackets.fetch_add(1) + 1;
+            s.writers.fetch_sub(1, std::memory_order_release);
+            if (n == packetsPerFrame) {
+                std::lock_guard<std::mutex> lock(mutex);
+                PushCompleted();
+            }
+            return true;
+        }
+        s.writers.fetch_sub(1, std::memory_order_release);
+
+        // open frame, sliding the window if required
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!startedFlag) {
+            firstFrame = fnum;
+            nextFrame = fnum;
+            lastFrame = fnum;
+            startedFlag = true;
+        }
+        // frame already pushed
+        if (fnum < nextFrame) {
+            return false;
+        }
+        while (fnum >= nextFrame + windowSize) {
+            PushOldest();
+        }
+        if (s.frameNumber != fnum) {
+            OpenSlot(s, fnum);
+        }
+        if (fnum > lastFrame) {
+            lastFrame = fnum;
+        }
+    }
+}
+
+void FrameWindow::Flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!startedFlag) {
+        return;
+    }
+    while (nextFrame <= lastFrame) {
+        PushOldest();
+    }
+}
+
+void FrameWindow::OpenSlot(Slot &s, uint64_t fnum) {
+    char *buffer = nullptr;
+    fifo->GetNewAddress(buffer);
+    memset(buffer, 0, fifoBufferHeaderSize);
+    s.buffer = buffer;
+    s.numPackets = 0;
+    s.headerWritten = false;
+    s.frameNumber.store(fnum, std::memory_order_seq_cst);
+}
+
+void FrameWindow::PushOldest() {
+    uint64_t fnum = nextFrame;
+    Slot &s = slots[fnum % windowSize];
+    char *buffer = nullptr;
+    uint32_t numPackets = 0;
+    bool headerWritten = false;
+    if (s.frameNumber.load(std::memory_order_seq_cst) == fnum) {
+        // close the slot and wait for writers already in it
+        s.frameNumber.store(CLOSED_SLOT, std::memory_order_seq_cst);
+        while (s.writers.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        buffer = s.buffer;
+        s.buffer = nullptr;
+        numPackets = s.numPackets;
+        headerWritten = s.headerWritten;
+    }
+    nextFrame = fnum + 1;
+    ++numFramesPushed;
+
+    bool discard = false;
+    switch (*frameDiscardMode) {
+    case DISCARD_EMPTY_FRAMES:
+        discard = (numPackets == 0);
+        break;
+    case DISCARD_PARTIAL_FRAMES:
+        discard = (numPackets != packetsPerFrame);
+        break;
+    default:
+        break;
+    }
+    if (discard) {
+        // the processor frees it
+        if (buffer != nullptr) {
+            (*((uint32_t *)buffer)) = DISCARD_PACKET_VALUE;
+            fifo->PushAddress(buffer);
+        }
+        return;
+    }
+
+    // empty frame
+    if (buffer == nullptr) {
+        fifo->GetNewAddress(buffer);
+        memset(buffer, 0, fifoBufferHeaderSize);
+    }
+    auto *new_header = (sls_receiver_header *)(buffer + FIFO_HEADER_NUMBYTES);
+    if (!headerWritten) {
+        new_header->detHeader.row = row;
+        new_header->detHeader.column = column;
+    }
+    new_header->detHeader.frameNumber = fnum;
+    new_header->detHeader.packetNumber = numPackets;
+    (*((uint32_t *)buffer)) = imageSize;
+    fifo->PushAddress(buffer);
+}
+
+void FrameWindow::PushCompleted() {
+    while (true) {
+        Slot &s = slots[nextFrame % windowSize];
+        if (s.frameNumber != nextFrame || s.numPackets != packetsPerFrame) {
+            return;
+        }
+        PushOldest();
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+/************************************************
+ * @file FrameWindow.h
+ * @short window of consecutive frames being assembled
+ * in fifo buffers, shared by all threads receiving
+ * packets of one udp port
+ ***********************************************/
+/**
+ *@short assembles packets into frames & pushes them in order into the fifo
+ */
+
+#include "sls/logger.h"
+#include "sls/sls_detector_defs.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+class Fifo;
+
+class FrameWindow : private virtual slsDetectorDefs {
+
+  public:
+    /**
+     * Constructor
+     * @param f fifo to take buffers from and push frames to
+     * @param size number of frames assembled at the same time
+     * @param ppf packets per frame
+     * @param dsize data bytes per packet
+     * @param isize image size
+     * @param fifohsize fifo buffer header size
+     * @param fdp pointer to frame discard policy
+     */
+    FrameWindow(Fifo *f, uint32_t size, uint32_t ppf, uint32_t dsize,
+                uint32_t isize, uint32_t fifohsize, frameDiscardPolicy *fdp);
+
+    ~FrameWindow();
+
+    /**
+     * Set hard coded row and column for frames without packets
+     */
+    void SetHardCodedPosition(uint16_t r, uint16_t c);
+
+    /**
+     * Places a packet into its frame, thread safe. Frames older than the
+     * window are pushed into the fifo (as partial frames) to make place for
+     * it. A completed frame is pushed once all frames before it are pushed.
+     * @param fnum frame number
+     * @param pnum packet number (< packets per frame)
+     * @param header detector header of the packet
+     * @param data data of the packet (data bytes per packet)
+     * @returns false if packet was dropped, as it is a duplicate or its frame
+     * was already pushed
+     */
+    bool AddPacket(uint64_t fnum, uint32_t pnum,
+                   const sls_detector_header *header, const char *data);
+
+    /**
+     * Pushes all frames up to the last frame that got a packet into the fifo,
+     * giving back all buffers of the window. Packets of these frames added
+     * later are dropped.
+     */
+    void Flush();
+
+    /** If any packet has been added */
+    bool HasStarted() const;
+
+    /** Frame number of the first packet added */
+    uint64_t GetFirstFrameNumber() const;
+
+    /** Frame number of the next frame to be pushed */
+    uint64_t GetNextFrameNumber() const;
+
+    /** Number of frames pushed into the fifo (including discarded ones) */
+    uint64_t GetNumFramesPushed() const;
+
+  private:
+    /** frame being assembled in a fifo buffer */
+    struct Slot {
+        /** frame number, CLOSED_SLOT if not assembling a frame */
+        std::atomic<uint64_t> frameNumber;
+        /** threads adding a packet at the moment */
+        std::atomic<uint32_t> writers{0};
+        std::atomic<uint32_t> numPackets{0};
+        std::atomic<bool> headerWritten{false};
+        char *buffer{nullptr};
+    };
+
+    /** pops a free buffer for frame fnum in its slot, with lock */
+    void OpenSlot(Slot &s, uint64_t fnum);
+
+    /** pushes the oldest frame of the window into the fifo, with lock */
+    void PushOldest();
+
+    /** pushes completed frames at the start of the window, with lock */
+    void PushCompleted();
+
+    Fifo *fifo;
+    const uint32_t windowSize;
+    const uint32_t packetsPerFrame;
+    const uint32_t dataSize;
+    const uint32_t imageSize;
+    const uint32_t fifoBufferHeaderSize;
+    frameDiscardPolicy *frameDiscardMode;
+    uint16_t row{0};
+    uint16_t column{0};
+
+    std::unique_ptr<Slot[]> slots;
+
+    /** guards opening and pushing of frames (fifo takes one producer) */
+    std::mutex mutex;
+    std::atomic<bool> startedFlag{false};
+    uint64_t firstFrame{0};
+    std::atomic<uint64_t> nextFrame{0};
+    /** highest frame opened */
+    uint64_t lastFrame{0};
+    std::atomic<uint64_t> numFramesPushed{0};
+};
@@ -5,9 +5,13 @@
  ***********************************************/
 #include "HDF5File.h"
 #include "Fifo.h"
+#include "FileRotation.h"
 #include "MasterAttributes.h"
 #include "receiver_defs.h"
+#include "sls/container_utils.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <libgen.h> //basename
@@ -15,10 +19,21 @@
 
 std::mutex HDF5File::hdf5Lib;
 
+namespace {
+/** receiver header as written to the parameter datasets */
+struct HeaderRecord {
+    slsDetectorDefs::sls_detector_header detHeader;
+    slsDetectorDefs::bitset_storage packetsMask;
+};
+} // namespace
+
 HDF5File::HDF5File(int ind, uint32_t *maxf, int *nd, std::string *fname,
                    std::string *fpath, uint64_t *findex, bool *owenable,
                    int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
-                   uint32_t *portno, uint32_t nx, uint32_t ny, bool *smode)
+                   uint32_t *portno, uint32_t nx, uint32_t ny, bool *smode,
+                   uint32_t *cframes, uint32_t *crows, bool *cheader,
+                   bool *swmr, uint32_t *flushf, uint32_t *flusht,
+                   Compressor *comp)
     :
 
       File(ind, HDF5, maxf, nd, fname, fpath, findex, owenable, dindex, nunits,
@@ -26,7 +41,16 @@ HDF5File::HDF5File(int ind, uint32_t *maxf, int *nd, std::string *fname,
       masterfd(nullptr), virtualfd(0), filefd(nullptr), dataspace(nullptr),
       dataset(nullptr), datatype(PredType::STD_U16LE), nPixelsX(nx),
       nPixelsY(ny), numFramesInFile(0), numActualPacketsInFile(0),
-      numFilesinAcquisition(0), dataspace_para(nullptr), extNumImages(0) {
+      numFilesinAcquisition(0), headerType(sizeof(HeaderRecord)),
+      compoundHeader(cheader), writeCompoundHeader(false),
+      dataspace_para(nullptr), extNumImages(0), chunkFrames(cframes),
+      chunkRows(crows),
+      directChunkWrite(H5Tget_order(H5T_NATIVE_INT) == H5T_ORDER_LE),
+      chunkDims{1, ny, nx}, numTiles(1), rowSize(0), tileSize(0),
+      bufferedChunk(-1), bufferedHeaders(-1), swmrMode(swmr),
+      flushFrames(flushf), flushTime(flusht), swmrFile(false), swmrExtent(0),
+      swmrImages(0), framesSinceFlush(0), liveVirtual(false), compressor(comp),
+      compressChunks(false) {
     PrintMembers();
     dataset_para.clear();
     parameterNames.clear();
@@ -55,6 +79,27 @@ HDF5File::HDF5File(int ind, uint32_t *maxf, int *nd, std::string *fname,
         PredType::STD_U16LE, PredType::STD_U16LE, PredType::STD_U16LE,
         PredType::STD_U32LE, PredType::STD_U16LE, PredType::STD_U8LE,
         PredType::STD_U8LE,  strdatatype};
+
+    size_t h = offsetof(HeaderRecord, detHeader);
+    parameterOffsets = std::vector<size_t>{
+        h + offsetof(sls_detector_header, frameNumber),
+        h + offsetof(sls_detector_header, expLength),
+        h + offsetof(sls_detector_header, packetNumber),
+        h + offsetof(sls_detector_header, bunchId),
+        h + offsetof(sls_detector_header, timestamp),
+        h + offsetof(sls_detector_header, modId),
+        h + offsetof(sls_detector_header, row),
+        h + offsetof(sls_detector_header, column),
+        h + offsetof(sls_detector_header, reserved),
+        h + offsetof(sls_detector_header, debug),
+        h + offsetof(sls_detector_header, roundRNumber),
+        h + offsetof(sls_detector_header, detType),
+        h + offsetof(sls_detector_header, version),
+        offsetof(HeaderRecord, packetsMask)};
+    for (unsigned int i = 0; i < parameterNames.size(); ++i) {
+        headerType.insertMember(parameterNames[i], parameterOffsets[i],
+                                parameterDataTypes[i]);
+    }
 }
 
 HDF5File::~HDF5File() { CloseAllFiles(); }
@@ -65,55 +110,80 @@ void HDF5File::SetNumberofPixels(uint32_t nx, uint32_t ny) {
 }
 
 void HDF5File::CreateFile() {
+    SetupNewFile();
+    CreateDataFile();
+}
+
+void HDF5File::SetupNewFile() {
     numFilesinAcquisition++;
     numFramesInFile = 0;
     numActualPacketsInFile = 0;
+    currentFileName = GetFileName(subFileIndex);
+}
 
-    // first time
-    if (subFileIndex == 0u) {
-        switch (*dynamicRange) {
-        case 16:
-            datatype = PredType::STD_U16LE;
-            break;
-        case 32:
-            datatype = PredType::STD_U32LE;
-            break;
-        default:
-            datatype = PredType::STD_U8LE;
-            break;
-        }
-    }
-    CreateDataFile();
+std::string HDF5File::GetFileName(uint32_t subIndex) const {
+    std::ostringstream os;
+    os << *filePath << "/" << *fileNamePrefix << "_d"
+       << (*detIndex * (*numUnitsPerDetector) + index) << "_f" << subIndex
+       << '_' << *fileIndex << ".h5";
+    return os.str();
 }
 
-void HDF5File::CloseCurrentFile() {
-    CloseFile(filefd, false);
-    for (unsigned int i = 0; i < dataset_para.size(); ++i)
-        delete dataset_para[i];
-    dataset_para.clear();
-    if (dataspace_para) {
-        delete dataspace_para;
-        dataspace_para = nullptr;
+uint64_t HDF5File::GetFramesToSave(uint32_t subIndex) const {
+    return ((*maxFramesPerFile == 0) ? *numImages : // infinite images
+                (((extNumImages - subIndex) > (*maxFramesPerFile))
+                     ? // save up to maximum at a time
+                     (*maxFramesPerFile)
+                     : (extNumImages - subIndex)));
+}
+
+void HDF5File::SetupDatasetTypes() {
+    switch (*dynamicRange) {
+    case 16:
+        datatype = PredType::STD_U16LE;
+        break;
+    case 32:
+        datatype = PredType::STD_U32LE;
+        break;
+    default:
+        datatype = PredType::STD_U8LE;
+        break;
     }
-    if (dataset) {
-        delete dataset;
-        dataset = nullptr;
-    }
-    if (dataspace) {
-        delete dataspace;
-        dataspace = nullptr;
+    // one compound or a dataset per parameter
+    writeCompoundHeader = *compoundHeader;
+    if (writeCompoundHeader) {
+        paraDatasetNames = std::vector<std::string>{"header"};
+        paraDatasetTypes = std::vector<DataType>{headerType};
+    } else {
+        paraDatasetNames = parameterNames;
+        paraDatasetTypes = parameterDataTypes;
     }
 }
 
+void HDF5File::SetDirectChunkWrite(bool enable) { directChunkWrite = enable; }
+
+void HDF5File::CloseCurrentFile() {
+    DiscardNextFile();
+    FlushAtClose();
+    DataFile f;
+    ReleaseDataFile(f);
+    CloseDataFile(f);
+}
+
 void HDF5File::CloseAllFiles() {
     numFilesinAcquisition = 0;
+    DiscardNextFile();
+    FlushAtClose();
     {
-        CloseFile(filefd, false);
+        DataFile f;
+        ReleaseDataFile(f);
+        CloseDataFile(f);
         if (master) {
             CloseFile(masterfd, true);
             // close virtual file
             // c code due to only c implementation of H5Pset_virtual available
             if (virtualfd != 0) {
+                std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
                 if (H5Fclose(virtualfd) < 0) {
                     LOG(logERROR) << "Could not close virtual HDF5 handles";
                 }
@@ -121,12 +191,61 @@ void HDF5File::CloseAllFiles() {
             }
         }
     }
-    for (unsigned int i = 0; i < dataset_para.size(); ++i)
-        delete dataset_para[i];
-    dataset_para.clear();
-    delete dataspace_para;
-    delete dataset;
-    delete dataspace;
+}
+
+void HDF5File::PrepareNextFile() {
+    if (!FileRotation::HasNextFile(subFileIndex, *maxFramesPerFile,
+                                   extNumImages)) {
+        return;
+    }
+    if (rotation == nullptr) {
+        rotation =
+            sls::make_unique<FileRotation>(std::to_string(*udpPortNumber));
+    }
+    uint32_t subIndex = subFileIndex + 1;
+    uint64_t framestosave = GetFramesToSave(subIndex);
+    bool swmr = swmrFile;
+    nextFile.name = GetFileName(subIndex);
+    rotation->PrepareNext(
+        nextFile.name, [this, subIndex, framestosave, swmr]() {
+            OpenDataFile(nextFile, subIndex, framestosave, swmr);
+        });
+}
+
+void HDF5File::RotateFile() {
+    std::string fname;
+    if (rotation != nullptr) {
+        fname = rotation->TakeNext([this]() { return nextFile.fd != nullptr; });
+    }
+    if (fname.empty()) {
+        CloseCurrentFile();
+        ++subFileIndex;
+        CreateFile();
+        return;
+    }
+
+    // the current file is closed in the background
+    FlushAtClose();
+    ReleaseDataFile(oldFile);
+    rotation->Queue([this]() { CloseDataFile(oldFile); });
+
+    ++subFileIndex;
+    SetupNewFile();
+    UseDataFile(nextFile);
+    PrepareNextFile();
+}
+
+void HDF5File::DiscardNextFile() {
+    if (rotation == nullptr) {
+        return;
+    }
+    rotation->DiscardNext([this]() {
+        if (nextFile.fd == nullptr) {
+            return false;
+        }
+        CloseDataFile(nextFile);
+        return true;
+    });
 }
 
 void HDF5File::WriteToFile(char *buffer, int bufferSize,
@@ -135,23 +254,38 @@ void HDF5File::WriteToFile(char *buffer, int bufferSize,
 
     // check if maxframesperfile = 0 for infinite
     if ((*maxFramesPerFile) && (numFramesInFile >= (*maxFramesPerFile))) {
-        CloseCurrentFile();
-        ++subFileIndex;
-        CreateFile();
+        RotateFile();
     }
     numFramesInFile++;
     numActualPacketsInFile += numPacketsCaught;
 
+    // swmr datasets grow with the images
+    if (swmrFile) {
+        ExtendToImage((*maxFramesPerFile == 0)
+                          ? currentFrameNumber
+                          : currentFrameNumber % (*maxFramesPerFile));
+    }
     // extend dataset (when receiver start followed by many status starts
     // (jungfrau)))
-    if (currentFrameNumber >= extNumImages) {
+    else if (currentFrameNumber >= extNumImages) {
         ExtendDataset();
     }
 
     WriteDataFile(currentFrameNumber, buffer + sizeof(sls_receiver_header));
     WriteParameterDatasets(currentFrameNumber, (sls_receiver_header *)(buffer));
+
+    if (swmrFile) {
+        ++framesSinceFlush;
+        if (*flushFrames != 0 && framesSinceFlush >= *flushFrames) {
+            FlushForReaders();
+        } else {
+            FlushOnTime();
+        }
+    }
 }
 
+void HDF5File::FlushIfIdle() { FlushOnTime(); }
+
 void HDF5File::CreateMasterFile(bool masterFileWriteEnable,
                                 MasterAttributes *attr) {
 
@@ -159,17 +293,25 @@ void HDF5File::CreateMasterFile(bool masterFileWriteEnable,
     numFramesInFile = 0;
     numActualPacketsInFile = 0;
     extNumImages = *numImages;
+    SetupDatasetTypes();
+    liveVirtual = false;
 
     if (masterFileWriteEnable && master) {
         virtualfd = 0;
         CreateMasterDataFile(attr);
+        // swmr readers see the acquisition in the virtual file while it is
+        // written, only with a file per port
+        if (*swmrMode && *maxFramesPerFile == 0) {
+            CreateVirtualDataFile(0, 0, true);
+            liveVirtual = true;
+        }
     }
 }
 
 void HDF5File::EndofAcquisition(bool anyPacketsCaught,
                                 uint64_t numImagesCaught) {
     // not created before
-    if (!virtualfd && anyPacketsCaught) {
+    if (!virtualfd && anyPacketsCaught && !liveVirtual) {
         // called only by the one maser receiver
         if (master && masterfd != nullptr) {
             // only one file and one sub image (link current file in master)
@@ -215,22 +357,68 @@ void HDF5File::CloseFile(H5File *&fd, bool masterFile) {
 }
 
 void HDF5File::WriteDataFile(uint64_t currentFrameNumber, char *buffer) {
-    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
-
     uint64_t nDimx =
         ((*maxFramesPerFile == 0) ? currentFrameNumber
                                   : currentFrameNumber % (*maxFramesPerFile));
-    uint32_t nDimy = nPixelsY;
-    uint32_t nDimz = ((*dynamicRange == 4) ? (nPixelsX / 2) : nPixelsX);
+    uint64_t chunkIndex = nDimx / chunkDims[0];
+
+    // image is a chunk
+    if (chunkBuffer.empty()) {
+        WriteChunk(chunkIndex, 0, buffer);
+        return;
+    }
+
+    // images come in order, so the previous chunk is complete
+    if ((int64_t)chunkIndex != bufferedChunk) {
+        FlushChunk();
+        bufferedChunk = chunkIndex;
+    }
+    uint32_t image = nDimx % chunkDims[0];
+    for (uint32_t i = 0; i < numTiles; ++i) {
+        uint32_t row = i * chunkDims[1];
+        uint32_t nrows = std::min<uint32_t>(chunkDims[1], nPixelsY - row);
+        memcpy(&chunkBuffer[i * tileSize + image * chunkDims[1] * rowSize],
+               buffer + row * rowSize, nrows * rowSize);
+    }
+    chunkImages[image] = true;
+    if (image == chunkDims[0] - 1) {
+        FlushChunk();
+    }
+}
+
+void HDF5File::WriteChunk(uint64_t chunkIndex, uint32_t tile,
+                          const char *buffer) {
+    hsize_t start[3] = {chunkIndex * chunkDims[0], tile * chunkDims[1], 0};
+
+    // outside the lock, so that ports compress at the same time
+    size_t size = tileSize;
+    if (compressChunks) {
+        buffer = compressor->Compress(buffer, tileSize, fillPixel.size(), size);
+    }
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+
+    if (directChunkWrite) {
+        if (H5Dwrite_chunk(dataset->getId(), H5P_DEFAULT, 0, start, size,
+                           buffer) < 0) {
+            throw sls::RuntimeError("Could not write chunk to file in object " +
+                                    std::to_string(index));
+        }
+        return;
+    }
 
-    hsize_t count[3] = {1, nDimy, nDimz};
-    hsize_t start[3] = {nDimx, 0, 0};
-    hsize_t dims2[2] = {nDimy, nDimz};
     try {
         Exception::dontPrint(); // to handle errors
 
+        // only the part of the chunk within the dataset
+        hsize_t dims[3];
+        dataspace->getSimpleExtentDims(dims);
+        hsize_t count[3] = {std::min(chunkDims[0], dims[0] - start[0]),
+                            std::min(chunkDims[1], dims[1] - start[1]),
+                            chunkDims[2]};
+        hsize_t memstart[3] = {0, 0, 0};
         dataspace->selectHyperslab(H5S_SELECT_SET, count, start);
-        DataSpace memspace(2, dims2);
+        DataSpace memspace(3, chunkDims);
+        memspace.selectHyperslab(H5S_SELECT_SET, count, memstart);
         dataset->write(buffer, datatype, memspace, *dataspace);
         memspace.close();
     } catch (const Exception &error) {
@@ -241,6 +429,133 @@ void HDF5File::WriteDataFile(uint64_t currentFrameNumber, char *buffer) {
     }
 }
 
+void HDF5File::FlushChunk(bool keep) {
+    if (bufferedChunk < 0) {
+        return;
+    }
+    uint64_t chunkIndex = bufferedChunk;
+    if (!keep) {
+        bufferedChunk = -1;
+    }
+
+    // missing images have the fill value (till written if kept)
+    size_t imageTileSize = chunkDims[1] * rowSize;
+    for (uint32_t image = 0; image < chunkDims[0]; ++image) {
+        if (chunkImages[image]) {
+            chunkImages[image] = keep;
+            continue;
+        }
+        for (uint32_t i = 0; i < numTiles; ++i) {
+            char *dst = &chunkBuffer[i * tileSize + image * imageTileSize];
+            for (size_t j = 0; j < imageTileSize; j += fillPixel.size()) {
+                memcpy(dst + j, fillPixel.data(), fillPixel.size());
+            }
+        }
+    }
+    for (uint32_t i = 0; i < numTiles; ++i) {
+        WriteChunk(chunkIndex, i, &chunkBuffer[i * tileSize]);
+    }
+}
+
+void HDF5File::FlushAtClose() {
+    if (dataset == nullptr) {
+        bufferedChunk = -1;
+        bufferedHeaders = -1;
+        return;
+    }
+    try {
+        FlushChunk();
+    } catch (const sls::RuntimeError &e) {
+        ; // logged, images of the last chunk are lost
+    }
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+    try {
+        FlushHeaders();
+    } catch (const sls::RuntimeError &e) {
+        ; // logged, headers of the last chunk are lost
+    }
+    // no fill values after the last image
+    if (swmrFile && swmrExtent != swmrImages) {
+        try {
+            Exception::dontPrint(); // to handle errors
+            hsize_t dims[3];
+            dataspace->getSimpleExtentDims(dims);
+            dims[0] = swmrImages;
+            dataset->extend(dims);
+            for (unsigned int i = 0; i < dataset_para.size(); ++i)
+                dataset_para[i]->extend(dims);
+            swmrExtent = swmrImages;
+        } catch (const Exception &error) {
+            LOG(logERROR) << "Could not trim swmr datasets in object "
+                          << index;
+            error.printErrorStack();
+        }
+    }
+}
+
+void HDF5File::ExtendToImage(uint64_t nDimx) {
+    swmrImages = std::max(swmrImages, nDimx + 1);
+    if (nDimx < swmrExtent) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+
+    // by whole chunks, images not yet written have the fill value
+    uint64_t extent = (nDimx / chunkDims[0] + 1) * chunkDims[0];
+    if (*maxFramesPerFile != 0) {
+        extent = std::min<uint64_t>(extent, *maxFramesPerFile);
+    }
+    try {
+        Exception::dontPrint(); // to handle errors
+        hsize_t dims[3];
+        dataspace->getSimpleExtentDims(dims);
+        dims[0] = extent;
+        dataset->extend(dims);
+        delete dataspace;
+        dataspace = nullptr;
+        dataspace = new DataSpace(dataset->getSpace());
+
+        for (unsigned int i = 0; i < dataset_para.size(); ++i)
+            dataset_para[i]->extend(dims);
+        delete dataspace_para;
+        dataspace_para = nullptr;
+        dataspace_para = new DataSpace(dataset_para[0]->getSpace());
+    } catch (const Exception &error) {
+        error.printErrorStack();
+        throw sls::RuntimeError("Could not extend swmr dataset in object " +
+                                std::to_string(index));
+    }
+    swmrExtent = extent;
+}
+
+void HDF5File::FlushForReaders() {
+    framesSinceFlush = 0;
+    lastFlush = std::chrono::steady_clock::now();
+    try {
+        // partial chunks too, rewritten once complete
+        FlushChunk(true);
+    } catch (const sls::RuntimeError &e) {
+        ; // logged, written again with the chunk
+    }
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+    try {
+        FlushHeaders(true);
+    } catch (const sls::RuntimeError &e) {
+        ; // logged, written again with the chunk
+    }
+    if (H5Fflush(filefd->getId(), H5F_SCOPE_LOCAL) < 0) {
+        LOG(logERROR) << "Could not flush swmr file in object " << index;
+    }
+}
+
+void HDF5File::FlushOnTime() {
+    if (swmrFile && framesSinceFlush != 0 && *flushTime != 0 &&
+        std::chrono::steady_clock::now() - lastFlush >=
+            std::chrono::milliseconds(*flushTime)) {
+        FlushForReaders();
+    }
+}
+
 void HDF5File::WriteParameterDatasets(uint64_t currentFrameNumber,
                                       sls_receiver_header *rheader) {
     std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
@@ -249,74 +564,85 @@ void HDF5File::WriteParameterDatasets(uint64_t currentFrameNumber,
         ((*maxFramesPerFile == 0) ? currentFrameNumber
                                   : currentFrameNumber % (*maxFramesPerFile));
 
-    sls_detector_header header = rheader->detHeader;
-    hsize_t count[1] = {1};
-    hsize_t start[1] = {fnum};
-    int i = 0;
+    // headers written per chunk, images come in order
+    uint64_t chunkIndex = fnum / chunkDims[0];
+    if ((int64_t)chunkIndex != bufferedHeaders) {
+        FlushHeaders();
+        bufferedHeaders = chunkIndex;
+    }
+    uint32_t image = fnum % chunkDims[0];
+    auto *record = reinterpret_cast<HeaderRecord *>(
+        &headerBuffer[image * sizeof(HeaderRecord)]);
+    record->detHeader = rheader->detHeader;
+
+    // contiguous bitset
+    if (sizeof(sls_bitset) == sizeof(bitset_storage)) {
+        memcpy(record->packetsMask, &(rheader->packetsMask),
+               sizeof(bitset_storage));
+    }
+
+    // not contiguous bitset
+    else {
+        // get contiguous representation of bit mask
+        memset(record->packetsMask, 0, sizeof(bitset_storage));
+        sls_bitset bits = rheader->packetsMask;
+        for (int i = 0; i < MAX_NUM_PACKETS; ++i)
+            record->packetsMask[i >> 3] |= (bits[i] << (i & 7));
+    }
+    headerImages[image] = true;
+    if (image == chunkDims[0] - 1) {
+        FlushHeaders();
+    }
+}
+
+void HDF5File::FlushHeaders(bool keep) {
+    if (bufferedHeaders < 0) {
+        return;
+    }
+    uint64_t chunkIndex = bufferedHeaders;
+    if (!keep) {
+        bufferedHeaders = -1;
+    }
+
+    // missing images have zeros, the default fill value
+    for (uint32_t image = 0; image < chunkDims[0]; ++image) {
+        if (!headerImages[image]) {
+            memset(&headerBuffer[image * sizeof(HeaderRecord)], 0,
+                   sizeof(HeaderRecord));
+        }
+        headerImages[image] = headerImages[image] && keep;
+    }
+
+    unsigned int i = 0;
     try {
         Exception::dontPrint(); // to handle errors
+
+        // only the part of the chunk within the dataset
+        hsize_t dims[1];
+        dataspace_para->getSimpleExtentDims(dims);
+        hsize_t start[1] = {chunkIndex * chunkDims[0]};
+        hsize_t count[1] = {std::min(chunkDims[0], dims[0] - start[0])};
         dataspace_para->selectHyperslab(H5S_SELECT_SET, count, start);
-        DataSpace memspace(H5S_SCALAR);
-        dataset_para[0]->write(&header.frameNumber, parameterDataTypes[0],
-                               memspace, *dataspace_para);
-        i = 1;
-        dataset_para[1]->write(&header.expLength, parameterDataTypes[1],
-                               memspace, *dataspace_para);
-        i = 2;
-        dataset_para[2]->write(&header.packetNumber, parameterDataTypes[2],
-                               memspace, *dataspace_para);
-        i = 3;
-        dataset_para[3]->write(&header.bunchId, parameterDataTypes[3], memspace,
-                               *dataspace_para);
-        i = 4;
-        dataset_para[4]->write(&header.timestamp, parameterDataTypes[4],
-                               memspace, *dataspace_para);
-        i = 5;
-        dataset_para[5]->write(&header.modId, parameterDataTypes[5], memspace,
-                               *dataspace_para);
-        i = 6;
-        dataset_para[6]->write(&header.row, parameterDataTypes[6], memspace,
-                               *dataspace_para);
-        i = 7;
-        dataset_para[7]->write(&header.column, parameterDataTypes[7], memspace,
-                               *dataspace_para);
-        i = 8;
-        dataset_para[8]->write(&header.reserved, parameterDataTypes[8],
-                               memspace, *dataspace_para);
-        i = 9;
-        dataset_para[9]->write(&header.debug, parameterDataTypes[9], memspace,
-                               *dataspace_para);
-        i = 10;
-        dataset_para[10]->write(&header.roundRNumber, parameterDataTypes[10],
-                                memspace, *dataspace_para);
-        i = 11;
-        dataset_para[11]->write(&header.detType, parameterDataTypes[11],
-                                memspace, *dataspace_para);
-        i = 12;
-        dataset_para[12]->write(&header.version, parameterDataTypes[12],
-                                memspace, *dataspace_para);
-        i = 13;
-
-        // contiguous bitset
-        if (sizeof(sls_bitset) == sizeof(bitset_storage)) {
-            dataset_para[13]->write((char *)&(rheader->packetsMask),
-                                    parameterDataTypes[13], memspace,
-                                    *dataspace_para);
-        }
-
-        // not contiguous bitset
-        else {
-            // get contiguous representation of bit mask
-            bitset_storage storage;
-            memset(storage, 0, sizeof(bitset_storage));
-            sls_bitset bits = rheader->packetsMask;
-            for (int i = 0; i < MAX_NUM_PACKETS; ++i)
-                storage[i >> 3] |= (bits[i] << (i & 7));
-            // write bitmask
-            dataset_para[13]->write((char *)storage, parameterDataTypes[13],
-                                    memspace, *dataspace_para);
-        }
-        i = 14;
+        DataSpace memspace(1, count);
+
+        if (writeCompoundHeader) {
+            dataset_para[0]->write(headerBuffer.data(), headerType, memspace,
+                                   *dataspace_para);
+            return;
+        }
+        // gather each parameter of the chunk
+        for (i = 0; i < parameterNames.size(); ++i) {
+            size_t size = parameterDataTypes[i].getSize();
+            for (hsize_t j = 0; j < count[0]; ++j) {
+                memcpy(&parameterBuffer[j * size],
+                       &headerBuffer[j * sizeof(HeaderRecord) +
+                                     parameterOffsets[i]],
+                       size);
+            }
+            dataset_para[i]->write(parameterBuffer.data(),
+                                   parameterDataTypes[i], memspace,
+                                   *dataspace_para);
+        }
     } catch (const Exception &error) {
         error.printErrorStack();
         throw sls::RuntimeError(
@@ -360,25 +686,75 @@ void HDF5File::ExtendDataset() {
 }
 
 void HDF5File::CreateDataFile() {
+    SetupChunks();
+
+    // swmr: extended as images arrive, so readers only see written images
+    swmrFile = *swmrMode;
+    DataFile f;
+    f.name = currentFileName;
+    OpenDataFile(f, subFileIndex, GetFramesToSave(subFileIndex), swmrFile);
+    UseDataFile(f);
+    PrepareNextFile();
+}
 
-    std::ostringstream os;
-    os << *filePath << "/" << *fileNamePrefix << "_d"
-       << (*detIndex * (*numUnitsPerDetector) + index) << "_f" << subFileIndex
-       << '_' << *fileIndex << ".h5";
-    currentFileName = os.str();
+void HDF5File::SetupChunks() {
+    uint32_t nDimy = nPixelsY;
+    uint32_t nDimz = ((*dynamicRange == 4) ? (nPixelsX / 2) : nPixelsX);
 
-    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+    // fill value
+    {
+        std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+        DSetCreatPropList plist;
+        int fill_value = -1;
+        plist.setFillValue(datatype, &fill_value);
+        fillPixel.resize(datatype.getSize());
+        plist.getFillValue(datatype, fillPixel.data());
+    }
 
-    uint64_t framestosave =
-        ((*maxFramesPerFile == 0) ? *numImages : // infinite images
-             (((extNumImages - subFileIndex) > (*maxFramesPerFile))
-                  ? // save up to maximum at a time
-                  (*maxFramesPerFile)
-                  : (extNumImages - subFileIndex)));
+    // chunk of several images, optionally tiled in rows
+    uint32_t crows =
+        ((*chunkRows == 0 || *chunkRows > nDimy) ? nDimy : *chunkRows);
+    rowSize = nDimz * fillPixel.size();
+    // the image could have grown since the images per chunk were set
+    uint64_t tileBytes = std::max<uint64_t>((uint64_t)crows * rowSize, 1);
+    uint64_t maxFrames =
+        std::max<uint64_t>(HDF5_MAX_CHUNK_BYTES / tileBytes, 1);
+    chunkDims[0] = std::min<uint64_t>(std::max(*chunkFrames, 1u), maxFrames);
+    chunkDims[1] = crows;
+    chunkDims[2] = nDimz;
+    numTiles = (nDimy + crows - 1) / crows;
+    tileSize = chunkDims[0] * crows * rowSize;
+    if (chunkDims[0] == 1 && numTiles == 1) {
+        chunkBuffer.clear();
+    } else {
+        chunkBuffer.resize(numTiles * tileSize);
+    }
+    chunkImages.assign(chunkDims[0], false);
+    bufferedChunk = -1;
+    headerBuffer.resize(chunkDims[0] * sizeof(HeaderRecord));
+    headerImages.assign(chunkDims[0], false);
+    bufferedHeaders = -1;
+    parameterBuffer.resize(chunkDims[0] * sizeof(HeaderRecord));
+
+    // chunks are compressed before written
+    compressChunks = false;
+    if (compressor != nullptr && compressor->IsEnabled()) {
+        if (directChunkWrite) {
+            compressChunks = true;
+        } else {
+            LOG(logWARNING) << "Compression requires direct chunk write, "
+                               "writing uncompressed data";
+        }
+    }
+}
 
-    uint64_t nDimx = framestosave;
+void HDF5File::OpenDataFile(DataFile &f, uint32_t subIndex,
+                            uint64_t framestosave, bool swmr) {
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+
+    uint64_t nDimx = (swmr ? 0 : framestosave);
     uint32_t nDimy = nPixelsY;
-    uint32_t nDimz = ((*dynamicRange == 4) ? (nPixelsX / 2) : nPixelsX);
+    hsize_t nDimz = chunkDims[2];
 
     try {
         Exception::dontPrint(); // to handle errors
@@ -386,32 +762,36 @@ void HDF5File::CreateDataFile() {
         // file
         FileAccPropList fapl;
         fapl.setFcloseDegree(H5F_CLOSE_STRONG);
-        filefd = nullptr;
+        if (swmr) {
+            // swmr requires the latest file format
+            fapl.setLibverBounds(H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        }
         if (!(*overWriteEnable))
-            filefd = new H5File(currentFileName.c_str(), H5F_ACC_EXCL,
-                                FileCreatPropList::DEFAULT, fapl);
+            f.fd = new H5File(f.name.c_str(), H5F_ACC_EXCL,
+                              FileCreatPropList::DEFAULT, fapl);
         else
-            filefd = new H5File(currentFileName.c_str(), H5F_ACC_TRUNC,
-                                FileCreatPropList::DEFAULT, fapl);
+            f.fd = new H5File(f.name.c_str(), H5F_ACC_TRUNC,
+                              FileCreatPropList::DEFAULT, fapl);
 
         // attributes - version
-        double dValue = HDF5_WRITER_VERSION;
-        DataSpace dataspace_attr = DataSpace(H5S_SCALAR);
-        Attribute attribute = filefd->createAttribute(
-            "version", PredType::NATIVE_DOUBLE, dataspace_attr);
-        attribute.write(PredType::NATIVE_DOUBLE, &dValue);
+        {
+            double dValue = HDF5_WRITER_VERSION;
+            DataSpace dataspace_attr = DataSpace(H5S_SCALAR);
+            Attribute attribute = f.fd->createAttribute(
+                "version", PredType::NATIVE_DOUBLE, dataspace_attr);
+            attribute.write(PredType::NATIVE_DOUBLE, &dValue);
+        }
 
         // dataspace
         hsize_t srcdims[3] = {nDimx, nDimy, nDimz};
         hsize_t srcdimsmax[3] = {H5S_UNLIMITED, nDimy, nDimz};
-        dataspace = nullptr;
-        dataspace = new DataSpace(3, srcdims, srcdimsmax);
+        f.dataspace = new DataSpace(3, srcdims, srcdimsmax);
 
         // dataset name
         std::ostringstream osfn;
         osfn << "/data";
         if (*numImages > 1)
-            osfn << "_f" << std::setfill('0') << std::setw(12) << subFileIndex;
+            osfn << "_f" << std::setfill('0') << std::setw(12) << subIndex;
         std::string dsetname = osfn.str();
 
         // dataset
@@ -421,44 +801,121 @@ void HDF5File::CreateDataFile() {
         plist.setFillValue(datatype, &fill_value);
         // always create chunked dataset as unlimited is only
         // supported with chunked layout
-        hsize_t chunk_dims[3] = {MAX_CHUNKED_IMAGES, nDimy, nDimz};
-        plist.setChunk(3, chunk_dims);
-        dataset = nullptr;
-        dataset = new DataSet(filefd->createDataSet(dsetname.c_str(), datatype,
-                                                    *dataspace, plist));
+        plist.setChunk(3, chunkDims);
+        // bitshuffle filter, optional so that the file can be created
+        // without the filter plugin
+        if (compressChunks) {
+            auto cd = Compressor::FilterParameters(compressor->GetType(),
+                                                   fillPixel.size());
+            plist.setFilter(BITSHUFFLE_FILTER_ID, H5Z_FLAG_OPTIONAL,
+                            cd.size(), cd.data());
+        }
+        f.dataset = new DataSet(
+            f.fd->createDataSet(dsetname.c_str(), datatype, *f.dataspace,
+                                plist));
 
         // create parameter datasets
         hsize_t dims[1] = {nDimx};
         hsize_t dimsmax[1] = {H5S_UNLIMITED};
-        dataspace_para = nullptr;
-        dataspace_para = new DataSpace(1, dims, dimsmax);
+        f.dataspace_para = new DataSpace(1, dims, dimsmax);
 
         // always create chunked dataset as unlimited is only
         // supported with chunked layout
         DSetCreatPropList paralist;
-        hsize_t chunkpara_dims[3] = {MAX_CHUNKED_IMAGES};
+        hsize_t chunkpara_dims[1] = {chunkDims[0]};
         paralist.setChunk(1, chunkpara_dims);
 
-        for (unsigned int i = 0; i < parameterNames.size(); ++i) {
-            DataSet *ds = new DataSet(filefd->createDataSet(
-                parameterNames[i].c_str(), parameterDataTypes[i],
-                *dataspace_para, paralist));
-            dataset_para.push_back(ds);
+        for (unsigned int i = 0; i < paraDatasetNames.size(); ++i) {
+            DataSet *ds = new DataSet(f.fd->createDataSet(
+                paraDatasetNames[i].c_str(), paraDatasetTypes[i],
+                *f.dataspace_para, paralist));
+            f.dataset_para.push_back(ds);
+        }
+
+        // readers can open the file from now on (no attributes or groups
+        // open, only datasets)
+        if (swmr && H5Fstart_swmr_write(f.fd->getId()) < 0) {
+            throw Exception("H5Fstart_swmr_write");
         }
     } catch (const Exception &error) {
         error.printErrorStack();
-        if (filefd) {
-            filefd->close();
+        for (auto *ds : f.dataset_para)
+            delete ds;
+        f.dataset_para.clear();
+        delete f.dataspace_para;
+        f.dataspace_para = nullptr;
+        delete f.dataset;
+        f.dataset = nullptr;
+        delete f.dataspace;
+        f.dataspace = nullptr;
+        if (f.fd) {
+            f.fd->close();
+            delete f.fd;
+            f.fd = nullptr;
         }
         throw sls::RuntimeError("Could not create HDF5 handles in object " +
-                                index);
+                                std::to_string(index));
     }
+}
+
+void HDF5File::CloseDataFile(DataFile &f) {
+    std::lock_guard<std::mutex> lock(HDF5File::hdf5Lib);
+    for (unsigned int i = 0; i < f.dataset_para.size(); ++i)
+        delete f.dataset_para[i];
+    f.dataset_para.clear();
+    delete f.dataspace_para;
+    f.dataspace_para = nullptr;
+    delete f.dataset;
+    f.dataset = nullptr;
+    delete f.dataspace;
+    f.dataspace = nullptr;
+    try {
+        Exception::dontPrint(); // to handle errors
+        if (f.fd) {
+            f.fd->close();
+            delete f.fd;
+            f.fd = nullptr;
+        }
+    } catch (const Exception &error) {
+        LOG(logERROR) << "Could not close data HDF5 handles of index "
+                      << index;
+        error.printErrorStack();
+    }
+}
+
+void HDF5File::UseDataFile(DataFile &f) {
+    filefd = f.fd;
+    dataspace = f.dataspace;
+    dataset = f.dataset;
+    dataspace_para = f.dataspace_para;
+    dataset_para.swap(f.dataset_para);
+    f = DataFile();
+
+    swmrExtent = 0;
+    swmrImages = 0;
+    framesSinceFlush = 0;
+    lastFlush = std::chrono::steady_clock::now();
+
     if (!(*silentMode)) {
         LOG(logINFO) << *udpPortNumber
                      << ": HDF5 File created: " << currentFileName;
     }
 }
 
+void HDF5File::ReleaseDataFile(DataFile &f) {
+    f.name = currentFileName;
+    f.fd = filefd;
+    f.dataspace = dataspace;
+    f.dataset = dataset;
+    f.dataspace_para = dataspace_para;
+    f.dataset_para.swap(dataset_para);
+    filefd = nullptr;
+    dataspace = nullptr;
+    dataset = nullptr;
+    dataspace_para = nullptr;
+    dataset_para.clear();
+}
+
 void HDF5File::CreateMasterDataFile(MasterAttributes *attr) {
 
     std::ostringstream os;
@@ -505,7 +962,8 @@ void HDF5File::CreateMasterDataFile(MasterAttributes *attr) {
     }
 }
 
-void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
+void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf,
+                                     bool unlimited) {
 
     std::ostringstream osfn;
     osfn << *filePath << "/" << *fileNamePrefix;
@@ -535,6 +993,10 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
             throw sls::RuntimeError(
                 "Could not set strong file close degree for virtual file " +
                 vname);
+        if (unlimited && H5Pset_libver_bounds(dfal, H5F_LIBVER_LATEST,
+                                              H5F_LIBVER_LATEST) < 0)
+            throw sls::RuntimeError(
+                "Could not set latest file format for virtual file " + vname);
         virtualfd = H5Fcreate(vname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, dfal);
         if (virtualfd < 0)
             throw sls::RuntimeError("Could not create virtual file " + vname);
@@ -559,13 +1021,23 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
                 "Could not close attribute in virtual file " + vname);
 
         // virtual dataspace
+        // unlimited: grows with the (swmr) source files, one per port
+        if (unlimited) {
+            numf = 0;
+        }
         hsize_t vdsdims[3] = {numf, numDetY * nDimy, numDetz * nDimz};
-        hid_t vdsDataspace = H5Screate_simple(3, vdsdims, nullptr);
+        hsize_t vdsdimsmax[3] = {H5S_UNLIMITED, numDetY * nDimy,
+                                 numDetz * nDimz};
+        hid_t vdsDataspace =
+            H5Screate_simple(3, vdsdims, unlimited ? vdsdimsmax : nullptr);
         if (vdsDataspace < 0)
             throw sls::RuntimeError(
                 "Could not create virtual dataspace in virtual file " + vname);
         hsize_t vdsdims_para[2] = {numf, (unsigned int)numDetY * numDetz};
-        hid_t vdsDataspace_para = H5Screate_simple(2, vdsdims_para, nullptr);
+        hsize_t vdsdimsmax_para[2] = {H5S_UNLIMITED,
+                                      (unsigned int)numDetY * numDetz};
+        hid_t vdsDataspace_para = H5Screate_simple(
+            2, vdsdims_para, unlimited ? vdsdimsmax_para : nullptr);
         if (vdsDataspace_para < 0)
             throw sls::RuntimeError("Could not create virtual dataspace "
                                     "(parameters) in virtual file " +
@@ -581,16 +1053,19 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
         if (H5Pset_fill_value(dcpl, GetDataTypeinC(datatype), &fill_value) < 0)
             throw sls::RuntimeError(
                 "Could not create fill value in virtual file " + vname);
-        std::vector<hid_t> dcpl_para(parameterNames.size());
-        for (unsigned int i = 0; i < parameterNames.size(); ++i) {
+        std::vector<hid_t> dcpl_para(paraDatasetNames.size());
+        for (unsigned int i = 0; i < paraDatasetNames.size(); ++i) {
             dcpl_para[i] = H5Pcreate(H5P_DATASET_CREATE);
             if (dcpl_para[i] < 0)
                 throw sls::RuntimeError(
                     "Could not create file creation properties (parameters) in "
                     "virtual file " +
                     vname);
+            // compound header keeps the default fill value (zeros)
+            if (paraDatasetTypes[i].getClass() == H5T_COMPOUND)
+                continue;
             if (H5Pset_fill_value(dcpl_para[i],
-                                  GetDataTypeinC(parameterDataTypes[i]),
+                                  GetDataTypeinC(paraDatasetTypes[i]),
                                   &fill_value) < 0)
                 throw sls::RuntimeError("Could not create fill value "
                                         "(parameters) in virtual file " +
@@ -598,9 +1073,12 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
         }
 
         // hyperslab
-        int numMajorHyperslab = numf / maxFramesPerFile;
-        if (numf % maxFramesPerFile)
-            numMajorHyperslab++;
+        int numMajorHyperslab = 1;
+        if (!unlimited) {
+            numMajorHyperslab = numf / maxFramesPerFile;
+            if (numf % maxFramesPerFile)
+                numMajorHyperslab++;
+        }
         uint64_t framesSaved = 0;
         for (int j = 0; j < numMajorHyperslab; j++) {
 
@@ -611,17 +1089,25 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
             hsize_t count[3] = {nDimx, nDimy, nDimz};
             hsize_t offset_para[2] = {framesSaved, 0};
             hsize_t count_para[2] = {nDimx, 1};
+            // unlimited: blocks of one image, as many as written
+            hsize_t unlimCount[3] = {H5S_UNLIMITED, 1, 1};
+            hsize_t unlimBlock[3] = {1, nDimy, nDimz};
+            hsize_t unlimCount_para[2] = {H5S_UNLIMITED, 1};
+            hsize_t unlimBlock_para[2] = {1, 1};
 
             for (int i = 0; i < numDetY * numDetz; ++i) {
 
                 // setect hyperslabs
-                if (H5Sselect_hyperslab(vdsDataspace, H5S_SELECT_SET, offset,
-                                        nullptr, count, nullptr) < 0) {
+                if (H5Sselect_hyperslab(
+                        vdsDataspace, H5S_SELECT_SET, offset, nullptr,
+                        unlimited ? unlimCount : count,
+                        unlimited ? unlimBlock : nullptr) < 0) {
                     throw sls::RuntimeError("Could not select hyperslab");
                 }
-                if (H5Sselect_hyperslab(vdsDataspace_para, H5S_SELECT_SET,
-                                        offset_para, nullptr, count_para,
-                                        nullptr) < 0) {
+                if (H5Sselect_hyperslab(
+                        vdsDataspace_para, H5S_SELECT_SET, offset_para,
+                        nullptr, unlimited ? unlimCount_para : count_para,
+                        unlimited ? unlimBlock_para : nullptr) < 0) {
                     throw sls::RuntimeError(
                         "Could not select hyperslab for parameters");
                 }
@@ -666,6 +1152,18 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
                     throw sls::RuntimeError("Could not create source dataspace "
                                             "(parameters) in virtual file " +
                                             vname);
+                if (unlimited) {
+                    hsize_t start[3] = {0, 0, 0};
+                    if (H5Sselect_hyperslab(srcDataspace, H5S_SELECT_SET,
+                                            start, nullptr, unlimCount,
+                                            unlimBlock) < 0 ||
+                        H5Sselect_hyperslab(srcDataspace_para, H5S_SELECT_SET,
+                                            start, nullptr, unlimCount,
+                                            unlimBlock_para) < 0) {
+                        throw sls::RuntimeError(
+                            "Could not select unlimited source hyperslab");
+                    }
+                }
 
                 // mapping
                 if (H5Pset_virtual(dcpl, vdsDataspace,
@@ -675,10 +1173,10 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
                         "Could not set mapping for paramter 1");
                 }
 
-                for (unsigned int k = 0; k < parameterNames.size(); ++k) {
+                for (unsigned int k = 0; k < paraDatasetNames.size(); ++k) {
                     if (H5Pset_virtual(dcpl_para[k], vdsDataspace_para,
                                        relative_srcFileName.c_str(),
-                                       parameterNames[k].c_str(),
+                                       paraDatasetNames[k].c_str(),
                                        srcDataspace_para) < 0) {
                         throw sls::RuntimeError(
                             "Could not set mapping for paramter " +
@@ -708,10 +1206,10 @@ void HDF5File::CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf) {
                 "Could not create virutal dataset in virtual file " + vname);
 
         // virtual parameter dataset
-        for (unsigned int i = 0; i < parameterNames.size(); ++i) {
+        for (unsigned int i = 0; i < paraDatasetNames.size(); ++i) {
             hid_t vdsdataset_para = H5Dcreate2(
-                virtualfd, parameterNames[i].c_str(),
-                GetDataTypeinC(parameterDataTypes[i]), vdsDataspace_para,
+                virtualfd, paraDatasetNames[i].c_str(),
+                GetDataTypeinC(paraDatasetTypes[i]), vdsDataspace_para,
                 H5P_DEFAULT, dcpl_para[i], H5P_DEFAULT);
             if (vdsdataset_para < 0)
                 throw sls::RuntimeError("Could not create virutal dataset "
@@ -788,9 +1286,9 @@ void HDF5File::LinkVirtualInMaster(std::string fname, std::string dsetname) {
         H5Dclose(vdset);
 
         //**paramter datasets**
-        for (unsigned int i = 0; i < parameterNames.size(); ++i) {
+        for (unsigned int i = 0; i < paraDatasetNames.size(); ++i) {
             hid_t vdset_para = H5Dopen2(
-                vfd, (std::string(parameterNames[i])).c_str(), H5P_DEFAULT);
+                vfd, (std::string(paraDatasetNames[i])).c_str(), H5P_DEFAULT);
             if (vdset_para < 0) {
                 H5Fclose(mfd);
                 mfd = 0;
@@ -798,10 +1296,10 @@ void HDF5File::LinkVirtualInMaster(std::string fname, std::string dsetname) {
                     "Could not open virtual parameter dataset to create link");
             }
             sprintf(linkname, "/entry/data/%s",
-                    (std::string(parameterNames[i])).c_str());
+                    (std::string(paraDatasetNames[i])).c_str());
 
             if (H5Lcreate_external(relative_virtualfname.c_str(),
-                                   parameterNames[i].c_str(), mfd, linkname,
+                                   paraDatasetNames[i].c_str(), mfd, linkname,
                                    H5P_DEFAULT, H5P_DEFAULT) < 0) {
                 H5Fclose(mfd);
                 mfd = 0;
@@ -830,6 +1328,8 @@ hid_t HDF5File::GetDataTypeinC(DataType dtype) {
         return H5T_STD_U32LE;
     else if (dtype == PredType::STD_U64LE)
         return H5T_STD_U64LE;
+    else if (dtype.getClass() == H5T_COMPOUND)
+        return H5Tcopy(dtype.getId());
     else {
         hid_t s = H5Tcopy(H5T_C_S1);
         H5Tset_size(s, MAX_NUM_PACKETS);
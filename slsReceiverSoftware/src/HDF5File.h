@@ -9,14 +9,19 @@
  *writes data to it
  */
 
+#include "Compressor.h"
 #include "File.h"
 
 #include "H5Cpp.h"
 #ifndef H5_NO_NAMESPACE
 using namespace H5;
 #endif
+#include <chrono>
+#include <memory>
 #include <mutex>
 
+class FileRotation;
+
 class HDF5File : private virtual slsDetectorDefs, public File {
 
   public:
@@ -38,11 +43,20 @@ class HDF5File : private virtual slsDetectorDefs, public File {
      * @param nx number of pixels in x direction
      * @param ny number of pixels in y direction
      * @param smode pointer to silent mode
+     * @param cframes pointer to number of images per chunk
+     * @param crows pointer to number of rows per chunk (0 for all)
+     * @param cheader pointer to receiver header as one compound dataset
+     * @param swmr pointer to single writer multiple reader mode
+     * @param flushf pointer to images between flushes in swmr mode (0 none)
+     * @param flusht pointer to ms between flushes in swmr mode (0 none)
+     * @param comp compressor of the chunks (nullptr for none)
      */
     HDF5File(int ind, uint32_t *maxf, int *nd, std::string *fname,
              std::string *fpath, uint64_t *findex, bool *owenable, int *dindex,
              int *nunits, uint64_t *nf, uint32_t *dr, uint32_t *portno,
-             uint32_t nx, uint32_t ny, bool *smode);
+             uint32_t nx, uint32_t ny, bool *smode, uint32_t *cframes,
+             uint32_t *crows, bool *cheader, bool *swmr, uint32_t *flushf,
+             uint32_t *flusht, Compressor *comp = nullptr);
     ~HDF5File();
     void SetNumberofPixels(uint32_t nx, uint32_t ny);
     void CreateFile();
@@ -53,16 +67,85 @@ class HDF5File : private virtual slsDetectorDefs, public File {
     void CreateMasterFile(bool masterFileWriteEnable,
                           MasterAttributes *attr) override;
     void EndofAcquisition(bool anyPacketsCaught, uint64_t numImagesCaught);
+    void FlushIfIdle() override;
+    /** write whole chunks with H5Dwrite_chunk, bypassing the conversion
+     * pipeline (default when the byte order is little endian), else through
+     * a hyperslab */
+    void SetDirectChunkWrite(bool enable);
+
+  protected:
+    /** handles of a data file */
+    struct DataFile {
+        std::string name;
+        H5File *fd{nullptr};
+        DataSpace *dataspace{nullptr};
+        DataSet *dataset{nullptr};
+        DataSpace *dataspace_para{nullptr};
+        std::vector<DataSet *> dataset_para;
+    };
 
-  private:
+    /** counts the file of the acquisition and sets its name */
+    void SetupNewFile();
+    /** name of a sub file of the acquisition */
+    std::string GetFileName(uint32_t subIndex) const;
+    /** number of images a sub file is created with */
+    uint64_t GetFramesToSave(uint32_t subIndex) const;
+    /** data and parameter dataset types of the acquisition */
+    void SetupDatasetTypes();
     void CloseFile(H5File *&fd, bool masterFile);
     void WriteDataFile(uint64_t currentFrameNumber, char *buffer);
+    /** compresses the chunk if enabled, then writes it with the hdf5 lock */
+    void WriteChunk(uint64_t chunkIndex, uint32_t tile, const char *buffer);
+    /** writes the chunk being filled, missing images with the fill value.
+     * Not to be called with the hdf5 lock
+     * @param keep keep filling it (partial chunk for swmr readers) */
+    void FlushChunk(bool keep = false);
+    void FlushHeaders(bool keep = false);
+    void FlushAtClose();
+    /** extends the datasets of a swmr file to the chunk of the image */
+    void ExtendToImage(uint64_t nDimx);
+    /** makes the images written so far visible to swmr readers */
+    void FlushForReaders();
+    /** flushes for swmr readers if images were written since the flush
+     * time */
+    void FlushOnTime();
     void WriteParameterDatasets(uint64_t currentFrameNumber,
                                 sls_receiver_header *rheader);
     void ExtendDataset();
+    /** sets up the chunks of the acquisition and creates the data file */
     void CreateDataFile();
+    /** chunk layout and buffers of the data files of the acquisition */
+    void SetupChunks();
+    /**
+     * Creates a data file with its datasets, takes the hdf5 lock. The chunk
+     * layout must be set up. Can be called from the background
+     * @param f data file, with its name set
+     * @param subIndex sub file index
+     * @param framestosave number of images to create the datasets with
+     * @param swmr swmr file, datasets extended as images arrive
+     */
+    void OpenDataFile(DataFile &f, uint32_t subIndex, uint64_t framestosave,
+                      bool swmr);
+    /** closes the data file and deletes its handles, takes the hdf5 lock */
+    void CloseDataFile(DataFile &f);
+    /** makes the data file the current one */
+    void UseDataFile(DataFile &f);
+    /** moves the handles of the current data file to f */
+    void ReleaseDataFile(DataFile &f);
+    /** creates the next sub file in the background if the acquisition has
+     * more images than fit in the current one */
+    void PrepareNextFile();
+    /** closes the current file in the background and continues with the
+     * next one, created inline if it could not be prepared */
+    void RotateFile();
+    /** closes the next file if it was prepared but not used, removed if
+     * it did not exist before */
+    void DiscardNextFile();
     void CreateMasterDataFile(MasterAttributes *attr);
-    void CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf);
+    /** @param unlimited map the whole (growing) data file of each port,
+     * created at the start for swmr readers */
+    void CreateVirtualDataFile(uint32_t maxFramesPerFile, uint64_t numf,
+                               bool unlimited = false);
     void LinkVirtualInMaster(std::string fname, std::string dsetname);
     hid_t GetDataTypeinC(DataType dtype);
 
@@ -85,8 +168,70 @@ class HDF5File : private virtual slsDetectorDefs, public File {
 
     std::vector<std::string> parameterNames;
     std::vector<DataType> parameterDataTypes;
+    /** offset of each parameter in a header record */
+    std::vector<size_t> parameterOffsets;
+    /** header record with a member per parameter */
+    CompType headerType;
+    /** receiver header as one compound dataset */
+    bool *compoundHeader;
+    /** names and types of the parameter datasets of the acquisition */
+    std::vector<std::string> paraDatasetNames;
+    std::vector<DataType> paraDatasetTypes;
+    bool writeCompoundHeader;
     DataSpace *dataspace_para;
     std::vector<DataSet *> dataset_para;
 
     uint64_t extNumImages;
+
+    /** number of images per chunk */
+    uint32_t *chunkFrames;
+    /** number of rows per chunk, 0 for all */
+    uint32_t *chunkRows;
+    bool directChunkWrite;
+    /** chunk dimensions of the current file */
+    hsize_t chunkDims[3];
+    uint32_t numTiles;
+    size_t rowSize;
+    size_t tileSize;
+    /** images of the chunk being filled, one block per tile */
+    std::vector<char> chunkBuffer;
+    /** images of the chunk being filled that were written to it */
+    std::vector<bool> chunkImages;
+    /** index of the chunk being filled, -1 for none */
+    int64_t bufferedChunk;
+    std::vector<char> fillPixel;
+    /** header records of the chunk being filled */
+    std::vector<char> headerBuffer;
+    std::vector<bool> headerImages;
+    /** index of the chunk of the header records, -1 for none */
+    int64_t bufferedHeaders;
+    /** one parameter of the header records, to write its dataset */
+    std::vector<char> parameterBuffer;
+
+    /** single writer multiple reader mode */
+    bool *swmrMode;
+    /** images and ms between flushes in swmr mode, 0 for none */
+    uint32_t *flushFrames;
+    uint32_t *flushTime;
+    /** current file is written in swmr mode */
+    bool swmrFile;
+    /** extent of the datasets of the swmr file */
+    uint64_t swmrExtent;
+    /** images in the swmr file, up to the last one written */
+    uint64_t swmrImages;
+    uint64_t framesSinceFlush;
+    std::chrono::steady_clock::time_point lastFlush;
+    /** virtual file created at the start of the acquisition */
+    bool liveVirtual;
+
+    Compressor *compressor;
+    /** chunks of the current file are compressed (bitshuffle filter) */
+    bool compressChunks;
+
+    /** creates the next sub file and closes the previous one */
+    std::unique_ptr<FileRotation> rotation;
+    /** next sub file, created in the background */
+    DataFile nextFile;
+    /** previous sub file, closed in the background */
+    DataFile oldFile;
 };
@@ -0,0 +1,622 @@
+/************************************************
+ * @file HDF5ProcessFile.cpp
+ * @short writes the HDF5 data file of a port in its
+ * own writer process, creates the master and virtual
+ * file in the receiver
+ ***********************************************/
+#include "HDF5ProcessFile.h"
+#include "receiver_defs.h"
+#include "sls/sls_detector_exceptions.h"
+
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <libgen.h> //dirname
+#include <linux/memfd.h>
+#include <memory>
+#include <semaphore.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace {
+enum WriterRequestType : uint32_t { CREATE, WRITE, CLOSE, QUIT };
+
+// time to wait for the writer process before checking it is still running
+constexpr long WRITER_POLL_NS = 100 * 1000 * 1000;
+
+struct WriterRequest {
+    uint32_t type;
+    char *buffer;
+    uint32_t size;
+    uint64_t frameNumber;
+    uint32_t numPackets;
+};
+
+struct WriterCompletion {
+    char *buffer;
+    int32_t status;
+    /** compressed by the writer process since the previous completion */
+    uint64_t rawBytes;
+    uint64_t packedBytes;
+    uint64_t compressionTime;
+};
+
+/** file parameters of the next file, by value */
+struct WriterParameters {
+    char fileNamePrefix[MAX_STR_LENGTH];
+    char filePath[MAX_STR_LENGTH];
+    uint64_t fileIndex;
+    uint32_t maxFramesPerFile;
+    int numDet[2];
+    bool overwrite;
+    int detIndex;
+    int numUnits;
+    uint64_t numImages;
+    uint32_t dynamicRange;
+    uint32_t port;
+    uint32_t nx;
+    uint32_t ny;
+    bool silent;
+    uint32_t chunkFrames;
+    uint32_t chunkRows;
+    bool compoundHeader;
+    bool swmr;
+    uint32_t flushFrames;
+    uint32_t flushTime;
+    bool directChunkWrite;
+    slsDetectorDefs::fileCompression compression;
+};
+
+void CopyString(char *dst, const std::string &src) {
+    if (src.size() >= MAX_STR_LENGTH) {
+        throw sls::RuntimeError("File name or path too long for the HDF5 "
+                                "writer process: " +
+                                src);
+    }
+    strcpy(dst, src.c_str());
+}
+} // namespace
+
+/** shared between the receiver and a writer process, requests and
+ * completions are single producer single consumer rings in sequence */
+struct Hdf5WriterQueue {
+    sem_t requestsQueued;
+    sem_t completionsQueued;
+    /** fifo memory as mapped by the receiver, images are requested with
+     * their address in it */
+    char *memory;
+    size_t memorySize;
+    WriterParameters parameters;
+    WriterRequest requests[HDF5_WRITER_QUEUE_DEPTH];
+    WriterCompletion completions[HDF5_WRITER_QUEUE_DEPTH];
+};
+
+namespace {
+/** absolute time ns from now, for sem_timedwait */
+timespec TimeFromNow(long ns) {
+    timespec ts{};
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ns / (1000 * 1000 * 1000);
+    ts.tv_nsec += ns % (1000 * 1000 * 1000);
+    if (ts.tv_nsec >= 1000 * 1000 * 1000) {
+        ++ts.tv_sec;
+        ts.tv_nsec -= 1000 * 1000 * 1000;
+    }
+    return ts;
+}
+
+/** @returns false if not posted within ns */
+bool WaitSemaphore(sem_t *s, long ns) {
+    timespec ts = TimeFromNow(ns);
+    while (sem_timedwait(s, &ts) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** file settings of the writer process, pointed to by its HDF5File */
+struct WriterSettings {
+    uint32_t maxFramesPerFile{0};
+    int numDet[2]{1, 1};
+    std::string fileNamePrefix;
+    std::string filePath;
+    uint64_t fileIndex{0};
+    bool overwrite{true};
+    int detIndex{0};
+    int numUnits{1};
+    uint64_t numImages{0};
+    uint32_t dynamicRange{16};
+    uint32_t port{0};
+    bool silent{false};
+    uint32_t chunkFrames{DEFAULT_CHUNKED_IMAGES};
+    uint32_t chunkRows{0};
+    bool compoundHeader{false};
+    bool swmr{false};
+    uint32_t flushFrames{0};
+    uint32_t flushTime{0};
+    slsDetectorDefs::fileCompression compression{
+        slsDetectorDefs::NO_COMPRESSION};
+
+    void Set(const WriterParameters &p) {
+        maxFramesPerFile = p.maxFramesPerFile;
+        numDet[0] = p.numDet[0];
+        numDet[1] = p.numDet[1];
+        fileNamePrefix = p.fileNamePrefix;
+        filePath = p.filePath;
+        fileIndex = p.fileIndex;
+        overwrite = p.overwrite;
+        detIndex = p.detIndex;
+        numUnits = p.numUnits;
+        numImages = p.numImages;
+        dynamicRange = p.dynamicRange;
+        port = p.port;
+        silent = p.silent;
+        chunkFrames = p.chunkFrames;
+        chunkRows = p.chunkRows;
+        compoundHeader = p.compoundHeader;
+        swmr = p.swmr;
+        flushFrames = p.flushFrames;
+        flushTime = p.flushTime;
+        compression = p.compression;
+    }
+};
+
+/** closes the sockets and files inherited from the receiver, but the two
+ * to keep */
+void CloseInheritedFiles(int keep1, int keep2) {
+    std::vector<int> fds;
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == nullptr) {
+        return;
+    }
+    while (dirent *entry = readdir(dir)) {
+        int fd = atoi(entry->d_name);
+        if (fd > 2 && fd != dirfd(dir) && fd != keep1 && fd != keep2) {
+            fds.push_back(fd);
+        }
+    }
+    closedir(dir);
+    for (int fd : fds) {
+        close(fd);
+    }
+}
+
+/** fd duplicated without close on exec, for the writer process */
+int DuplicateForWriter(int fd) { return fcntl(fd, F_DUPFD, 0); }
+
+/** writer executable next to the running one, else looked up in PATH */
+std::string WriterExecutable() {
+    char path[PATH_MAX]{};
+    if (readlink("/proc/self/exe", path, sizeof(path) - 1) > 0) {
+        std::string exe = std::string(dirname(path)) + "/" +
+                          HDF5_WRITER_EXECUTABLE;
+        if (access(exe.c_str(), X_OK) == 0) {
+            return exe;
+        }
+    }
+    return HDF5_WRITER_EXECUTABLE;
+}
+
+/** main loop of the writer process, one data file at a time */
+void RunWriter(int index, Hdf5WriterQueue *q, char *memory) {
+    WriterSettings s;
+    // blocks compressed by this process only, ports compress in parallel
+    Compressor compressor(&s.compression, nullptr);
+    std::unique_ptr<HDF5File> file;
+    for (uint64_t seq = 0;; ++seq) {
+        // idle, swmr readers still see the last images in time
+        while (!WaitSemaphore(&q->requestsQueued,
+                              WRITER_IDLE_CHECK_MS * 1000 * 1000)) {
+            if (file != nullptr) {
+                file->FlushIfIdle();
+            }
+        }
+        WriterRequest r = q->requests[seq % HDF5_WRITER_QUEUE_DEPTH];
+        int32_t status = 0;
+        bool quit = false;
+        try {
+            switch (r.type) {
+            case CREATE:
+                s.Set(q->parameters);
+                if (file == nullptr) {
+                    file.reset(new HDF5File(
+                        index, &s.maxFramesPerFile, s.numDet,
+                        &s.fileNamePrefix, &s.filePath, &s.fileIndex,
+                        &s.overwrite, &s.detIndex, &s.numUnits, &s.numImages,
+                        &s.dynamicRange, &s.port, q->parameters.nx,
+                        q->parameters.ny, &s.silent, &s.chunkFrames,
+                        &s.chunkRows, &s.compoundHeader, &s.swmr,
+                        &s.flushFrames, &s.flushTime, &compressor));
+                }
+                file->CloseAllFiles();
+                file->SetNumberofPixels(q->parameters.nx, q->parameters.ny);
+                file->SetDirectChunkWrite(q->parameters.directChunkWrite);
+                file->resetSubFileIndex();
+                file->CreateMasterFile(false, nullptr);
+                file->CreateFile();
+                break;
+            case WRITE:
+                // at another address in this process
+                if (r.buffer < q->memory ||
+                    r.buffer + r.size > q->memory + q->memorySize) {
+                    throw sls::RuntimeError("Image not in fifo memory");
+                }
+                file->WriteToFile(memory + (r.buffer - q->memory), r.size,
+                                  r.frameNumber, r.numPackets);
+                break;
+            case CLOSE:
+                if (file != nullptr) {
+                    file->CloseCurrentFile();
+                }
+                break;
+            default:
+                file.reset();
+                quit = true;
+                break;
+            }
+        } catch (const sls::RuntimeError &e) {
+            status = -1;
+        }
+        q->completions[seq % HDF5_WRITER_QUEUE_DEPTH] = {
+            r.buffer, status, compressor.GetRawBytes(),
+            compressor.GetPackedBytes(), compressor.GetCompressionTime()};
+        compressor.ResetStatistics();
+        sem_post(&q->completionsQueued);
+        if (quit) {
+            return;
+        }
+    }
+}
+} // namespace
+
+int HDF5ProcessFile::WriterMain(int argc, char *argv[]) {
+    if (argc != 5) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [index] [receiver pid] [queue fd] [fifo memory fd]\n"
+                  << "Started by the receiver to write HDF5 data files\n";
+        return EXIT_FAILURE;
+    }
+    int index = atoi(argv[1]);
+    pid_t parent = atoi(argv[2]);
+    int queueFd = atoi(argv[3]);
+    int memoryFd = atoi(argv[4]);
+
+    // exit with the receiver, not with its signals
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != parent) {
+        return EXIT_FAILURE;
+    }
+    signal(SIGINT, SIG_IGN);
+    signal(SIGTERM, SIG_IGN);
+    CloseInheritedFiles(queueFd, memoryFd);
+
+    void *q = mmap(nullptr, sizeof(Hdf5WriterQueue), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, queueFd, 0);
+    if (q == MAP_FAILED) {
+        std::cerr << "Could not map HDF5 writer queue\n";
+        return EXIT_FAILURE;
+    }
+    auto *queue = static_cast<Hdf5WriterQueue *>(q);
+    void *memory = mmap(nullptr, queue->memorySize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, memoryFd, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Could not map fifo memory\n";
+        return EXIT_FAILURE;
+    }
+    close(queueFd);
+    close(memoryFd);
+    RunWriter(index, queue, static_cast<char *>(memory));
+    return EXIT_SUCCESS;
+}
+
+HDF5ProcessFile::HDF5ProcessFile(int ind, uint32_t *maxf, int *nd,
+                                 std::string *fname, std::string *fpath,
+                                 uint64_t *findex, bool *owenable, int *dindex,
+                                 int *nunits, uint64_t *nf, uint32_t *dr,
+                                 uint32_t *portno, uint32_t nx, uint32_t ny,
+                                 bool *smode, uint32_t *cframes,
+                                 uint32_t *crows, bool *cheader, bool *swmr,
+                                 uint32_t *flushf, uint32_t *flusht,
+                                 Compressor *comp)
+    : HDF5File(ind, maxf, nd, fname, fpath, findex, owenable, dindex, nunits,
+               nf, dr, portno, nx, ny, smode, cframes, crows, cheader, swmr,
+               flushf, flusht, comp),
+      writerPid(-1), queue(nullptr), bufferMemory(nullptr),
+      bufferMemorySize(0), bufferFd(-1), writerMemory(nullptr),
+      requestSeq(0), completionSeq(0), controlSucceeded(false) {}
+
+HDF5ProcessFile::~HDF5ProcessFile() {
+    HDF5ProcessFile::CloseAllFiles();
+    StopWriter();
+}
+
+void HDF5ProcessFile::SetBufferMemory(char *memory, size_t size, int fd) {
+    bufferMemory = memory;
+    bufferMemorySize = size;
+    bufferFd = fd;
+    // freed, the writer process still maps the old memory
+    if (memory == nullptr) {
+        writerMemory = nullptr;
+    }
+}
+
+void HDF5ProcessFile::CreateFile() {
+    SetupNewFile();
+
+    // fifo memory reallocated since, the writer process cannot see it
+    if (writerPid < 0 || writerMemory == nullptr ||
+        writerMemory != bufferMemory) {
+        StartWriter();
+    }
+    WriterParameters &p = queue->parameters;
+    CopyString(p.fileNamePrefix, *fileNamePrefix);
+    CopyString(p.filePath, *filePath);
+    p.fileIndex = *fileIndex;
+    p.maxFramesPerFile = *maxFramesPerFile;
+    p.numDet[0] = numDetX;
+    p.numDet[1] = numDetY;
+    p.overwrite = *overWriteEnable;
+    p.detIndex = *detIndex;
+    p.numUnits = *numUnitsPerDetector;
+    p.numImages = *numImages;
+    p.dynamicRange = *dynamicRange;
+    p.port = *udpPortNumber;
+    p.nx = nPixelsX;
+    p.ny = nPixelsY;
+    p.silent = *silentMode;
+    p.chunkFrames = *chunkFrames;
+    p.chunkRows = *chunkRows;
+    p.compoundHeader = *compoundHeader;
+    p.swmr = *swmrMode;
+    p.flushFrames = *flushFrames;
+    p.flushTime = *flushTime;
+    p.directChunkWrite = directChunkWrite;
+    p.compression =
+        (compressor != nullptr) ? compressor->GetType() : NO_COMPRESSION;
+    if (!SendAndWait(CREATE)) {
+        throw sls::RuntimeError("Could not create HDF5 file " +
+                                currentFileName + " in writer process of "
+                                                  "object " +
+                                std::to_string(index));
+    }
+}
+
+void HDF5ProcessFile::CloseCurrentFile() {
+    if (writerPid >= 0) {
+        SendAndWait(CLOSE);
+    }
+}
+
+void HDF5ProcessFile::CloseAllFiles() {
+    CloseCurrentFile();
+    // master and virtual file
+    HDF5File::CloseAllFiles();
+}
+
+void HDF5ProcessFile::WriteToFile(char *buffer, int bufferSize,
+                                  uint64_t currentFrameNumber,
+                                  uint32_t numPacketsCaught) {
+    if (writerPid < 0) {
+        throw sls::RuntimeError("No HDF5 writer process in object " +
+                                std::to_string(index));
+    }
+    // the writer process creates the next file itself, only the names for
+    // the virtual file
+    if ((*maxFramesPerFile) && (numFramesInFile >= (*maxFramesPerFile))) {
+        ++subFileIndex;
+        SetupNewFile();
+    }
+    numFramesInFile++;
+    numActualPacketsInFile += numPacketsCaught;
+    Send(WRITE, buffer, bufferSize, currentFrameNumber, numPacketsCaught);
+}
+
+bool HDF5ProcessFile::HasPendingWrites() const {
+    return (!inFlight.empty() || !completed.empty());
+}
+
+void HDF5ProcessFile::GetCompletedWrites(std::vector<char *> &buffers,
+                                         bool wait) {
+    while (Reap(false))
+        ;
+    while (wait && !inFlight.empty()) {
+        Reap(true);
+    }
+    buffers.insert(buffers.end(), completed.begin(), completed.end());
+    completed.clear();
+}
+
+void HDF5ProcessFile::StartWriter() {
+    StopWriter();
+    if (bufferFd < 0) {
+        throw sls::RuntimeError("Fifo memory not shared with the HDF5 writer "
+                                "process of object " +
+                                std::to_string(index));
+    }
+    int queueFd = static_cast<int>(
+        syscall(SYS_memfd_create, "slsHdf5WriterQueue", MFD_CLOEXEC));
+    void *p = MAP_FAILED;
+    if (queueFd >= 0 && ftruncate(queueFd, sizeof(Hdf5WriterQueue)) == 0) {
+        p = mmap(nullptr, sizeof(Hdf5WriterQueue), PROT_READ | PROT_WRITE,
+                 MAP_SHARED, queueFd, 0);
+    }
+    if (p == MAP_FAILED) {
+        if (queueFd >= 0) {
+            close(queueFd);
+        }
+        throw sls::RuntimeError("Could not allocate HDF5 writer queue in "
+                                "object " +
+                                std::to_string(index));
+    }
+    queue = static_cast<Hdf5WriterQueue *>(p);
+    sem_init(&queue->requestsQueued, 1, 0);
+    sem_init(&queue->completionsQueued, 1, 0);
+    queue->memory = bufferMemory;
+    queue->memorySize = bufferMemorySize;
+    requestSeq = 0;
+    completionSeq = 0;
+
+    // a new executable, as a forked copy of this multithreaded process
+    // could deadlock in malloc or the hdf5 library. Only the duplicates
+    // without close on exec are inherited
+    int fds[2] = {DuplicateForWriter(queueFd), DuplicateForWriter(bufferFd)};
+    close(queueFd);
+    std::string exe = WriterExecutable();
+    std::vector<std::string> args{exe, std::to_string(index),
+                                  std::to_string(getpid()),
+                                  std::to_string(fds[0]),
+                                  std::to_string(fds[1])};
+    std::vector<char *> argv;
+    for (auto &it : args) {
+        argv.push_back(&it[0]);
+    }
+    argv.push_back(nullptr);
+    // with the default signal mask, not that of this thread
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t mask;
+    sigemptyset(&mask);
+    posix_spawnattr_setsigmask(&attr, &mask);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+    pid_t pid = -1;
+    int rc = ENOENT;
+    if (fds[0] >= 0 && fds[1] >= 0) {
+        rc = posix_spawnp(&pid, exe.c_str(), nullptr, &attr, argv.data(),
+                          environ);
+    }
+    posix_spawnattr_destroy(&attr);
+    for (int fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    if (rc != 0) {
+        sem_destroy(&queue->requestsQueued);
+        sem_destroy(&queue->completionsQueued);
+        munmap(queue, sizeof(Hdf5WriterQueue));
+        queue = nullptr;
+        throw sls::RuntimeError("Could not start HDF5 writer process " + exe +
+                                " of object " + std::to_string(index) +
+                                " (" + strerror(rc) + ")");
+    }
+    writerPid = pid;
+    writerMemory = bufferMemory;
+    LOG(logINFO) << index << ": HDF5 writer process " << writerPid
+                 << " started";
+}
+
+void HDF5ProcessFile::StopWriter() {
+    if (writerPid >= 0) {
+        try {
+            SendAndWait(QUIT);
+        } catch (const sls::RuntimeError &e) {
+            ; // already gone
+        }
+        if (writerPid >= 0) {
+            waitpid(writerPid, nullptr, 0);
+            writerPid = -1;
+            writerMemory = nullptr;
+        }
+    }
+    if (queue != nullptr) {
+        sem_destroy(&queue->requestsQueued);
+        sem_destroy(&queue->completionsQueued);
+        munmap(queue, sizeof(Hdf5WriterQueue));
+        queue = nullptr;
+    }
+}
+
+void HDF5ProcessFile::Send(uint32_t type, char *buffer, uint32_t size,
+                           uint64_t fnum, uint32_t nump) {
+    // queue full
+    while (writerPid >= 0 && inFlight.size() == HDF5_WRITER_QUEUE_DEPTH) {
+        Reap(true);
+    }
+    if (writerPid < 0) {
+        throw sls::RuntimeError("HDF5 writer process of object " +
+                                std::to_string(index) + " is not running");
+    }
+    queue->requests[requestSeq % HDF5_WRITER_QUEUE_DEPTH] = {type, buffer,
+                                                             size, fnum, nump};
+    ++requestSeq;
+    inFlight.push_back(buffer);
+    sem_post(&queue->requestsQueued);
+}
+
+bool HDF5ProcessFile::SendAndWait(uint32_t type) {
+    Send(type, nullptr, 0, 0, 0);
+    uint64_t seq = requestSeq;
+    controlSucceeded = false;
+    while (writerPid >= 0 && completionSeq != seq) {
+        Reap(true);
+    }
+    return controlSucceeded;
+}
+
+bool HDF5ProcessFile::Reap(bool wait) {
+    while (true) {
+        if (inFlight.empty()) {
+            return false;
+        }
+        if (sem_trywait(&queue->completionsQueued) == 0) {
+            break;
+        }
+        if (!wait) {
+            return false;
+        }
+        if (WaitSemaphore(&queue->completionsQueued, WRITER_POLL_NS)) {
+            break;
+        }
+        if (waitpid(writerPid, nullptr, WNOHANG) != 0) {
+            WriterExited();
+            return false;
+        }
+    }
+    const WriterCompletion &c =
+        queue->completions[completionSeq % HDF5_WRITER_QUEUE_DEPTH];
+    ++completionSeq;
+    inFlight.pop_front();
+    // for the summary of the receiver
+    if (compressor != nullptr) {
+        compressor->AddStatistics(c.rawBytes, c.packedBytes,
+                                  c.compressionTime);
+    }
+    if (c.buffer != nullptr) {
+        completed.push_back(c.buffer);
+        if (c.status != 0) {
+            LOG(logERROR) << "HDF5 writer process of object " << index
+                          << " could not write an image";
+        }
+    } else {
+        controlSucceeded = (c.status == 0);
+    }
+    return true;
+}
+
+void HDF5ProcessFile::WriterExited() {
+    LOG(logERROR) << "HDF5 writer process " << writerPid << " of object "
+                  << index << " exited, " << inFlight.size()
+                  << " requests not done";
+    for (auto *b : inFlight) {
+        if (b != nullptr) {
+            completed.push_back(b);
+        }
+    }
+    inFlight.clear();
+    writerPid = -1;
+    writerMemory = nullptr;
+}
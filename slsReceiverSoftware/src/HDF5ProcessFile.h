@@ -0,0 +1,105 @@
+#pragma once
+/************************************************
+ * @file HDF5ProcessFile.h
+ * @short writes the HDF5 data file of a port in its
+ * own writer process, creates the master and virtual
+ * file in the receiver
+ ***********************************************/
+/**
+ *@short HDF5 file written by a dedicated writer process, so that ports do
+ *not share the (not thread safe) hdf5 library of the receiver
+ */
+
+#include "HDF5File.h"
+
+#include <deque>
+#include <sys/types.h>
+#include <vector>
+
+struct Hdf5WriterQueue;
+
+class HDF5ProcessFile : private virtual slsDetectorDefs, public HDF5File {
+
+  public:
+    /**
+     * Constructor
+     * Same parameters as HDF5File. The writer process (HDF5_WRITER_EXECUTABLE)
+     * is started with the first file, after the fifo memory is set with
+     * SetBufferMemory. The fifo memory must be a shared memory file, as the
+     * writer process maps it to write the images straight from it. The
+     * writer process compresses with a compressor of its own, without
+     * thread pool, and reports its statistics to comp
+     */
+    HDF5ProcessFile(int ind, uint32_t *maxf, int *nd, std::string *fname,
+                    std::string *fpath, uint64_t *findex, bool *owenable,
+                    int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
+                    uint32_t *portno, uint32_t nx, uint32_t ny, bool *smode,
+                    uint32_t *cframes, uint32_t *crows, bool *cheader,
+                    bool *swmr, uint32_t *flushf, uint32_t *flusht,
+                    Compressor *comp = nullptr);
+
+    /**
+     * Destructor
+     * Closes the files and stops the writer process
+     */
+    ~HDF5ProcessFile();
+
+    void SetBufferMemory(char *memory, size_t size, int fd) override;
+    void CreateFile() override;
+    void CloseCurrentFile() override;
+    void CloseAllFiles() override;
+    /** queues the image to the writer process, buffer must stay valid till
+     * it is returned by GetCompletedWrites */
+    void WriteToFile(char *buffer, int bufferSize, uint64_t currentFrameNumber,
+                     uint32_t numPacketsCaught) override;
+    bool HasPendingWrites() const override;
+    void GetCompletedWrites(std::vector<char *> &buffers, bool wait) override;
+
+    /**
+     * Main of the writer process, which maps the queue and the fifo memory
+     * from the file descriptors it is started with
+     * @param argc argument count
+     * @param argv index, receiver pid, queue fd and fifo memory fd
+     * @returns exit status
+     */
+    static int WriterMain(int argc, char *argv[]);
+
+  private:
+    /** starts the writer process for the current fifo memory */
+    void StartWriter();
+    /** asks the writer process to exit and waits for it */
+    void StopWriter();
+    /** queues a request, waits for space in the queue */
+    void Send(uint32_t type, char *buffer, uint32_t size, uint64_t fnum,
+              uint32_t nump);
+    /** sends a request without image and waits for it to be done
+     * @returns true if the writer process succeeded */
+    bool SendAndWait(uint32_t type);
+    /**
+     * Collects one completed request
+     * @param wait wait for it
+     * @returns false if none (or the writer process is gone)
+     */
+    bool Reap(bool wait);
+    /** writer process gone, gives back the images in flight */
+    void WriterExited();
+
+    pid_t writerPid;
+    Hdf5WriterQueue *queue;
+    /** fifo memory shared with the writer process */
+    char *bufferMemory;
+    size_t bufferMemorySize;
+    /** memory file of the fifo memory */
+    int bufferFd;
+    /** fifo memory the writer process was started with */
+    char *writerMemory;
+    /** requests sent and completed */
+    uint64_t requestSeq;
+    uint64_t completionSeq;
+    /** image of each request in flight (nullptr if none), in order */
+    std::deque<char *> inFlight;
+    /** images written, to be returned by GetCompletedWrites */
+    std::vector<char *> completed;
+    /** status of the last request without image */
+    bool controlSucceeded;
+};
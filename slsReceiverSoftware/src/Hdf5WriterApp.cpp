@@ -0,0 +1,7 @@
+/* slsHdf5Writer, started by the receiver to write the HDF5 data files of a
+ * port (fh5process) */
+#include "HDF5ProcessFile.h"
+
+int main(int argc, char *argv[]) {
+    return HDF5ProcessFile::WriterMain(argc, argv);
+}
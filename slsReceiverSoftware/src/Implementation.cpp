@@ -2,13 +2,16 @@
 #include "DataProcessor.h"
 #include "DataStreamer.h"
 #include "Fifo.h"
+#include "FileWriter.h"
 #include "GeneralData.h"
 #include "Listener.h"
 #include "MasterAttributes.h"
 #include "sls/ToString.h"
 #include "sls/ZmqSocket.h" //just for the zmq port define
 #include "sls/file_utils.h"
+#include "sls/network_utils.h"
 
+#include <algorithm>
 #include <cerrno> //eperm
 #include <chrono>
 #include <cstdlib> //system
@@ -22,9 +25,25 @@
 
 /** cosntructor & destructor */
 
-Implementation::Implementation(const detectorType d) { setDetectorType(d); }
+Implementation::Implementation(const detectorType d)
+    : compressionPool(
+          sls::make_unique<CompressionPool>(DEFAULT_COMPRESSION_THREADS)) {
+    for (int t = 0; t < NUM_RX_THREAD_TYPES; ++t) {
+        for (int i = 0; i < MAX_NUMBER_OF_LISTENING_THREADS; ++i) {
+            threadAffinity[t][i] =
+                rxThreadAffinity(static_cast<rxThreadType>(t), i);
+        }
+    }
+    for (auto &it : threadAffinity[LISTENER_THREAD]) {
+        it.policy = RX_SCHED_FIFO;
+        it.priority = LISTENER_PRIORITY;
+    }
+    setDetectorType(d);
+}
 
 Implementation::~Implementation() {
+    // before the fifos, as zmq could still be sending images from them
+    dataStreamer.clear();
     delete generalData;
     generalData = nullptr;
 }
@@ -55,12 +74,26 @@ void Implementation::SetLocalNetworkParameters() {
     }
 }
 
-void Implementation::SetThreadPriorities() {
-    for (const auto &it : listener)
-        it->SetThreadPriority(LISTENER_PRIORITY);
+void Implementation::SetThreadAffinities() {
+    for (size_t i = 0; i < listener.size(); ++i)
+        listener[i]->SetThreadAffinity(threadAffinity[LISTENER_THREAD][i]);
+    for (size_t i = 0; i < dataProcessor.size(); ++i)
+        dataProcessor[i]->SetThreadAffinity(
+            threadAffinity[PROCESSOR_THREAD][i]);
+    for (size_t i = 0; i < dataStreamer.size(); ++i)
+        dataStreamer[i]->SetThreadAffinity(threadAffinity[STREAMER_THREAD][i]);
+    for (size_t i = 0; i < fileWriter.size(); ++i)
+        fileWriter[i]->SetThreadAffinity(threadAffinity[WRITER_THREAD][i]);
 }
 
 void Implementation::SetupFifoStructure() {
+    // zmq could still be sending images from the fifos, the streamer sockets
+    // drop them when closed
+    bool restartStreaming = !dataStreamer.empty();
+    if (restartStreaming) {
+        dataStreamer.clear();
+        dataStreamEnable = false;
+    }
     fifo.clear();
     for (int i = 0; i < numThreads; ++i) {
         uint32_t datasize = generalData->imageSize;
@@ -72,7 +105,9 @@ void Implementation::SetupFifoStructure() {
         // create fifo structure
         try {
             fifo.push_back(sls::make_unique<Fifo>(
-                i, datasize + (generalData->fifoBufferHeaderSize), fifoDepth));
+                i, datasize + (generalData->fifoBufferHeaderSize), fifoDepth,
+                fifoHugePages, fifoMemoryLock,
+                sls::InterfaceNameToNumaNode(eth[i]), hdf5WriterProcess));
         } catch (...) {
             fifo.clear();
             fifoDepth = 0;
@@ -80,11 +115,14 @@ void Implementation::SetupFifoStructure() {
                 "Could not allocate memory for fifo structure " +
                 std::to_string(i) + ". FifoDepth is now 0.");
         }
+        fifo[i]->SetZeroCopyStreaming(streamingZeroCopy);
         // set the listener & dataprocessor threads to point to the right fifo
         if (listener.size())
             listener[i]->SetFifo(fifo[i].get());
         if (dataProcessor.size())
             dataProcessor[i]->SetFifo(fifo[i].get());
+        if (fileWriter.size())
+            fileWriter[i]->SetFifo(fifo[i].get());
         if (dataStreamer.size())
             dataStreamer[i]->SetFifo(fifo[i].get());
 
@@ -96,6 +134,9 @@ void Implementation::SetupFifoStructure() {
                      << " MB";
     }
     LOG(logINFO) << numThreads << " Fifo structure(s) reconstructed";
+    if (restartStreaming) {
+        setDataStreamEnable(true);
+    }
 }
 
 /**************************************************
@@ -163,20 +204,31 @@ void Implementation::setDetectorType(const detectorType d) {
             listener.push_back(sls::make_unique<Listener>(
                 i, myDetectorType, fifo_ptr, &status, &udpPortNum[i], &eth[i],
                 &numberOfTotalFrames, &udpSocketBufferSize,
-                &actualUDPSocketBufferSize, &framesPerFile, &frameDiscardMode,
-                &activated, &deactivatedPaddingEnable, &silentMode));
+                &actualUDPSocketBufferSize, &udpBatchSize, &udpZeroCopy,
+                &udpCaptureBackend, &udpThreads, &frameWindowSize,
+                &frameTimeout, &framesPerFile, &frameDiscardMode, &activated,
+                &deactivatedPaddingEnable, &silentMode));
             dataProcessor.push_back(sls::make_unique<DataProcessor>(
-                i, myDetectorType, fifo_ptr, &fileFormatType, fileWriteEnable,
-                &masterFileWriteEnable, &dataStreamEnable, &streamingFrequency,
-                &streamingTimerInMs, &streamingStartFnum, &framePadding,
-                &activated, &deactivatedPaddingEnable, &silentMode,
-                &ctbDbitList, &ctbDbitOffset, &ctbAnalogDataBytes));
+                i, myDetectorType, fifo_ptr, &fileWriteEnable,
+                &dataStreamEnable, &streamingFrequency, &streamingTimerInMs,
+                &streamingStartFnum, &streamingBandwidth, &streamingType,
+                &streamingPreviewBinning, &streamingPreviewTimerInMs,
+                &framePadding, &activated, &deactivatedPaddingEnable,
+                &silentMode, &ctbDbitList, &ctbDbitOffset,
+                &ctbAnalogDataBytes));
+            fileWriter.push_back(sls::make_unique<FileWriter>(
+                i, fifo_ptr, &fileFormatType, &masterFileWriteEnable,
+                &dataStreamEnable, &silentMode, &fileDirectIO, &fileIoUring,
+                &hdf5ChunkFrames, &hdf5ChunkRows, &hdf5CompoundHeader,
+                &hdf5WriterProcess, &hdf5Swmr, &hdf5FlushFrames, &hdf5FlushTime,
+                &fileCompressionType, compressionPool.get()));
         } catch (...) {
             listener.clear();
             dataProcessor.clear();
-            throw sls::RuntimeError(
-                "Could not create listener/dataprocessor threads (index:" +
-                std::to_string(i) + ")");
+            fileWriter.clear();
+            throw sls::RuntimeError("Could not create listener/dataprocessor/"
+                                    "filewriter threads (index:" +
+                                    std::to_string(i) + ")");
         }
     }
 
@@ -185,7 +237,9 @@ void Implementation::setDetectorType(const detectorType d) {
         it->SetGeneralData(generalData);
     for (const auto &it : dataProcessor)
         it->SetGeneralData(generalData);
-    SetThreadPriorities();
+    for (const auto &it : fileWriter)
+        it->SetGeneralData(generalData);
+    SetThreadAffinities();
 
     LOG(logDEBUG) << " Detector type set to " << sls::ToString(d);
 }
@@ -230,9 +284,13 @@ void Implementation::setModulePositionId(const int id) {
     // update zmq port
     streamingPort =
         DEFAULT_ZMQ_RX_PORTNO + (modulePos * (myDetectorType == EIGER ? 2 : 1));
+    streamingPreviewPort = DEFAULT_ZMQ_RX_PREVIEW_PORTNO +
+                           (modulePos * (myDetectorType == EIGER ? 2 : 1));
+    streamingPushPort = DEFAULT_ZMQ_RX_PUSH_PORTNO +
+                        (modulePos * (myDetectorType == EIGER ? 2 : 1));
 
-    for (unsigned int i = 0; i < dataProcessor.size(); ++i) {
-        dataProcessor[i]->SetupFileWriter(
+    for (unsigned int i = 0; i < fileWriter.size(); ++i) {
+        fileWriter[i]->SetupFileWriter(
             fileWriteEnable, (int *)numDet, &framesPerFile, &fileName,
             &filePath, &fileIndex, &overwriteEnable, &modulePos, &numThreads,
             &numberOfTotalFrames, &dynamicRange, &udpPortNum[i], generalData);
@@ -273,6 +331,26 @@ void Implementation::setFifoDepth(const uint32_t i) {
     LOG(logINFO) << "Fifo Depth: " << i;
 }
 
+bool Implementation::getFifoHugePages() const { return fifoHugePages; }
+
+void Implementation::setFifoHugePages(const bool i) {
+    if (fifoHugePages != i) {
+        fifoHugePages = i;
+        SetupFifoStructure();
+    }
+    LOG(logINFO) << "Fifo Huge Pages: " << i;
+}
+
+bool Implementation::getFifoMemoryLock() const { return fifoMemoryLock; }
+
+void Implementation::setFifoMemoryLock(const bool i) {
+    if (fifoMemoryLock != i) {
+        fifoMemoryLock = i;
+        SetupFifoStructure();
+    }
+    LOG(logINFO) << "Fifo Memory Lock: " << i;
+}
+
 slsDetectorDefs::frameDiscardPolicy
 Implementation::getFrameDiscardPolicy() const {
     return frameDiscardMode;
@@ -319,6 +397,21 @@ std::array<pid_t, NUM_RX_THREAD_IDS> Implementation::getThreadIds() const {
     return retval;
 }
 
+slsDetectorDefs::rxThreadAffinity
+Implementation::getThreadAffinity(const rxThreadType t, const int index) const {
+    return threadAffinity[t][index];
+}
+
+void Implementation::setThreadAffinity(const rxThreadAffinity &a) {
+    threadAffinity[a.thread][a.index] = a;
+    // tcp thread is the calling thread
+    if (a.thread == TCP_THREAD) {
+        ThreadObject::SetThreadAffinity(pthread_self(), "Tcp", a);
+    } else {
+        SetThreadAffinities();
+    }
+}
+
 /**************************************************
  *                                                 *
  *   File Parameters                               *
@@ -335,12 +428,15 @@ void Implementation::setFileFormat(const fileFormat f) {
         fileFormatType = HDF5;
         break;
 #endif
+    case INDEXED:
+        fileFormatType = INDEXED;
+        break;
     default:
         fileFormatType = BINARY;
         break;
     }
 
-    for (const auto &it : dataProcessor)
+    for (const auto &it : fileWriter)
         it->SetFileFormat(f);
 
     LOG(logINFO) << "File Format: " << sls::ToString(fileFormatType);
@@ -375,8 +471,8 @@ bool Implementation::getFileWriteEnable() const { return fileWriteEnable; }
 void Implementation::setFileWriteEnable(const bool b) {
     if (fileWriteEnable != b) {
         fileWriteEnable = b;
-        for (unsigned int i = 0; i < dataProcessor.size(); ++i) {
-            dataProcessor[i]->SetupFileWriter(
+        for (unsigned int i = 0; i < fileWriter.size(); ++i) {
+            fileWriter[i]->SetupFileWriter(
                 fileWriteEnable, (int *)numDet, &framesPerFile, &fileName,
                 &filePath, &fileIndex, &overwriteEnable, &modulePos,
                 &numThreads, &numberOfTotalFrames, &dynamicRange,
@@ -405,6 +501,113 @@ void Implementation::setOverwriteEnable(const bool b) {
                  << (overwriteEnable ? "enabled" : "disabled");
 }
 
+bool Implementation::getFileDirectIO() const { return fileDirectIO; }
+
+void Implementation::setFileDirectIO(const bool b) {
+    fileDirectIO = b;
+    LOG(logINFO) << "File Direct IO: "
+                 << (fileDirectIO ? "enabled" : "disabled");
+}
+
+bool Implementation::getFileIoUring() const { return fileIoUring; }
+
+void Implementation::setFileIoUring(const bool b) {
+    fileIoUring = b;
+    LOG(logINFO) << "File io_uring: " << (fileIoUring ? "enabled" : "disabled");
+}
+
+int Implementation::getHdf5ChunkFrames() const { return hdf5ChunkFrames; }
+
+void Implementation::setHdf5ChunkFrames(const int value) {
+    hdf5ChunkFrames = value;
+    LOG(logINFO) << "HDF5 images per chunk: " << hdf5ChunkFrames;
+}
+
+uint32_t Implementation::getHdf5MaxChunkFrames() const {
+    uint64_t maxFrames =
+        HDF5_MAX_CHUNK_BYTES / std::max(generalData->imageSize, 1u);
+    if (framesPerFile != 0) {
+        maxFrames = std::min<uint64_t>(maxFrames, framesPerFile);
+    }
+    return (uint32_t)std::max<uint64_t>(maxFrames, 1);
+}
+
+int Implementation::getHdf5ChunkRows() const { return hdf5ChunkRows; }
+
+void Implementation::setHdf5ChunkRows(const int value) {
+    hdf5ChunkRows = value;
+    LOG(logINFO) << "HDF5 rows per chunk: " << hdf5ChunkRows;
+}
+
+bool Implementation::getHdf5CompoundHeader() const {
+    return hdf5CompoundHeader;
+}
+
+void Implementation::setHdf5CompoundHeader(const bool b) {
+    hdf5CompoundHeader = b;
+    LOG(logINFO) << "HDF5 compound header: "
+                 << (hdf5CompoundHeader ? "enabled" : "disabled");
+}
+
+bool Implementation::getHdf5WriterProcess() const {
+    return hdf5WriterProcess;
+}
+
+void Implementation::setHdf5WriterProcess(const bool b) {
+    if (hdf5WriterProcess != b) {
+        hdf5WriterProcess = b;
+        // writer processes write straight from the fifo
+        SetupFifoStructure();
+    }
+    LOG(logINFO) << "HDF5 writer process: "
+                 << (hdf5WriterProcess ? "enabled" : "disabled");
+}
+
+bool Implementation::getHdf5Swmr() const { return hdf5Swmr; }
+
+void Implementation::setHdf5Swmr(const bool b) {
+    hdf5Swmr = b;
+    LOG(logINFO) << "HDF5 SWMR: " << (hdf5Swmr ? "enabled" : "disabled");
+}
+
+int Implementation::getHdf5FlushFrames() const { return hdf5FlushFrames; }
+
+void Implementation::setHdf5FlushFrames(const int value) {
+    hdf5FlushFrames = value;
+    LOG(logINFO) << "HDF5 SWMR flush frames: " << hdf5FlushFrames;
+}
+
+int Implementation::getHdf5FlushTime() const { return hdf5FlushTime; }
+
+void Implementation::setHdf5FlushTime(const int value) {
+    hdf5FlushTime = value;
+    LOG(logINFO) << "HDF5 SWMR flush time: " << hdf5FlushTime << " ms";
+}
+
+slsDetectorDefs::fileCompression Implementation::getFileCompression() const {
+    return fileCompressionType;
+}
+
+void Implementation::setFileCompression(const fileCompression c) {
+#ifndef COMPRESSIONC
+    if (c != NO_COMPRESSION) {
+        throw sls::RuntimeError("Compression not compiled in receiver. Build "
+                                "with SLS_USE_COMPRESSION.");
+    }
+#endif
+    fileCompressionType = c;
+    LOG(logINFO) << "File compression: " << sls::ToString(fileCompressionType);
+}
+
+int Implementation::getCompressionThreads() const {
+    return compressionPool->GetNumberOfThreads();
+}
+
+void Implementation::setCompressionThreads(const int value) {
+    compressionPool->SetNumberOfThreads(value);
+    LOG(logINFO) << "Compression threads: " << value;
+}
+
 uint32_t Implementation::getFramesPerFile() const { return framesPerFile; }
 
 void Implementation::setFramesPerFile(const uint32_t i) {
@@ -533,23 +736,19 @@ void Implementation::setStoppedFlag(bool stopped) { stoppedFlag = stopped; }
 
 void Implementation::stopReceiver() {
     LOG(logINFO) << "Stopping Receiver";
+    auto stopStart = std::chrono::steady_clock::now();
 
     // set status to transmitting
     startReadout();
+    auto readoutEnd = std::chrono::steady_clock::now();
 
     // wait for the processes (Listener and DataProcessor) to be done
-    bool running = true;
-    while (running) {
-        running = false;
-        for (const auto &it : listener)
-            if (it->IsRunning())
-                running = true;
-
-        for (const auto &it : dataProcessor)
-            if (it->IsRunning())
-                running = true;
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+    for (const auto &it : listener)
+        it->WaitForStop();
+    for (const auto &it : dataProcessor)
+        it->WaitForStop();
+    for (const auto &it : fileWriter)
+        it->WaitForStop();
 
     // create virtual file
     if (fileWriteEnable && fileFormatType == HDF5) {
@@ -562,21 +761,27 @@ void Implementation::stopReceiver() {
         }
         // to create virtual file & set files/acquisition to 0 (only hdf5 at the
         // moment)
-        dataProcessor[0]->EndofAcquisition(anycaught, maxIndexCaught);
+        fileWriter[0]->EndofAcquisition(anycaught, maxIndexCaught);
     }
 
     // wait for the processes (dataStreamer) to be done
-    running = true;
-    while (running) {
-        running = false;
-        for (const auto &it : dataStreamer)
-            if (it->IsRunning())
-                running = true;
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+    for (const auto &it : dataStreamer)
+        it->WaitForStop();
 
     status = RUN_FINISHED;
     LOG(logINFO) << "Status: " << sls::ToString(status);
+    {
+        auto stopEnd = std::chrono::steady_clock::now();
+        using us = std::chrono::microseconds;
+        LOG(logINFO)
+            << "Stop latency: "
+            << std::chrono::duration_cast<us>(stopEnd - stopStart).count()
+            << " us (waiting for packets: "
+            << std::chrono::duration_cast<us>(readoutEnd - stopStart).count()
+            << " us, processing: "
+            << std::chrono::duration_cast<us>(stopEnd - readoutEnd).count()
+            << " us)";
+    }
 
     { // statistics
         std::vector<uint64_t> mp = getNumMissingPackets();
@@ -594,6 +799,45 @@ void Implementation::stopReceiver() {
                      << "\n\tComplete Frames\t\t: " << nf
                      << "\n\tLast Frame Caught\t: "
                      << listener[i]->GetLastFrameIndexCaught();
+            // to size fifos against disk jitter
+            if (fileWriteEnable) {
+                LOG(logINFO)
+                    << "File Writer of Port " << udpPortNum[i]
+                    << "\n\tImages Written\t\t: "
+                    << fileWriter[i]->GetNumImagesWritten()
+                    << "\n\tWrite Queue Max Level\t: "
+                    << fileWriter[i]->GetMaxQueueLevel()
+                    << "\n\tWrite Latency (avg/max)\t: "
+                    << fileWriter[i]->GetAverageWriteLatency() << " / "
+                    << fileWriter[i]->GetMaxWriteLatency() << " us";
+                uint64_t packed = fileWriter[i]->GetNumBytesPacked();
+                if (packed != 0) {
+                    LOG(logINFO)
+                        << "Compression of Port " << udpPortNum[i]
+                        << "\n\tCompression Ratio\t: "
+                        << (double)fileWriter[i]->GetNumBytesRaw() /
+                               (double)packed
+                        << "\n\tCompression Speed\t: "
+                        << fileWriter[i]->GetCompressionRate() << " MB/s";
+                }
+            }
+            // frames skipped by frequency, timer, bandwidth budget or busy
+            // pulling clients
+            if (dataStreamEnable && dataStreamer.size()) {
+                uint64_t streamed = dataStreamer[i]->GetNumFramesStreamed();
+                uint64_t total = dataProcessor[i]->GetNumFramesToStream();
+                LOG(logINFO)
+                    << "Streamer of Port " << udpPortNum[i]
+                    << "\n\tStreamed Frames\t\t: " << streamed << " ("
+                    << (total == 0 ? 100 : 100.00 * streamed / total) << " %)";
+            }
+            // images held by zmq are missing from the free fifo slots
+            if (dataStreamEnable && streamingZeroCopy) {
+                LOG(logINFO) << "Streamer of Port " << udpPortNum[i]
+                             << "\n\tZero Copy Max In Flight\t: "
+                             << fifo[i]->GetMaxLevelForFifoInFlight() << " / "
+                             << fifoDepth;
+            }
         }
         if (!activated) {
             LOG(logINFORED) << "Deactivated Receiver";
@@ -625,30 +869,32 @@ void Implementation::startReadout() {
     if (status == RUNNING) {
         // wait for incoming delayed packets
         int totalPacketsReceived = 0;
-        int previousValue = -1;
         for (const auto &it : listener)
             totalPacketsReceived += it->GetPacketsCaught();
 
-        // wait for all packets
+        // wait for all packets, or till no packets arrived for the quiet
+        // period
         const int numPacketsToReceive = numberOfTotalFrames *
                                         generalData->packetsPerFrame *
                                         listener.size();
-        if (totalPacketsReceived != numPacketsToReceive) {
-            while (totalPacketsReceived != previousValue) {
-                LOG(logDEBUG3)
-                    << "waiting for all packets, previousValue:"
-                    << previousValue
-                    << " totalPacketsReceived: " << totalPacketsReceived;
-                /* TODO! Need to find optimal time **/
-                std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                previousValue = totalPacketsReceived;
-                totalPacketsReceived = 0;
-                for (const auto &it : listener)
-                    totalPacketsReceived += it->GetPacketsCaught();
-
-                LOG(logDEBUG3) << "\tupdated:  totalPacketsReceived:"
-                               << totalPacketsReceived;
-            }
+        const std::chrono::nanoseconds quietPeriod =
+            std::chrono::milliseconds(RX_QUIET_PERIOD_MS);
+        while (totalPacketsReceived != numPacketsToReceive) {
+            int64_t lastPacketTime = 0;
+            for (const auto &it : listener)
+                lastPacketTime =
+                    std::max(lastPacketTime, it->GetLastPacketTime());
+            auto quietEnd = std::chrono::steady_clock::time_point(
+                                std::chrono::nanoseconds(lastPacketTime)) +
+                            quietPeriod;
+            if (std::chrono::steady_clock::now() >= quietEnd)
+                break;
+            LOG(logDEBUG3) << "waiting for all packets, totalPacketsReceived: "
+                           << totalPacketsReceived;
+            std::this_thread::sleep_until(quietEnd);
+            totalPacketsReceived = 0;
+            for (const auto &it : listener)
+                totalPacketsReceived += it->GetPacketsCaught();
         }
         status = TRANSMITTING;
         LOG(logINFO) << "Status: Transmitting";
@@ -666,15 +912,16 @@ void Implementation::shutDownUDPSockets() {
 void Implementation::closeFiles() {
     uint64_t maxIndexCaught = 0;
     bool anycaught = false;
-    for (const auto &it : dataProcessor) {
+    for (const auto &it : fileWriter)
         it->CloseFiles();
+    for (const auto &it : dataProcessor) {
         maxIndexCaught = std::max(maxIndexCaught, it->GetProcessedIndex());
         if (it->GetStartedFlag())
             anycaught = true;
     }
     // to create virtual file & set files/acquisition to 0 (only hdf5 at the
     // moment)
-    dataProcessor[0]->EndofAcquisition(anycaught, maxIndexCaught);
+    fileWriter[0]->EndofAcquisition(anycaught, maxIndexCaught);
 }
 
 void Implementation::restreamStop() {
@@ -688,6 +935,8 @@ void Implementation::ResetParametersforNewAcquisition() {
         it->ResetParametersforNewAcquisition();
     for (const auto &it : dataProcessor)
         it->ResetParametersforNewAcquisition();
+    for (const auto &it : fileWriter)
+        it->ResetParametersforNewAcquisition();
 
     if (dataStreamEnable) {
         std::ostringstream os;
@@ -753,6 +1002,10 @@ void Implementation::SetupWriter() {
     masterAttributes->burstMode = burstMode;
     masterAttributes->numUDPInterfaces = numUDPInterfaces;
     masterAttributes->dynamicRange = dynamicRange;
+    masterAttributes->fileFormat = fileFormatType;
+    // images of the indexed file are not compressed
+    masterAttributes->compression =
+        (fileFormatType == INDEXED ? NO_COMPRESSION : fileCompressionType);
     masterAttributes->tenGiga = tengigaEnable;
     masterAttributes->thresholdEnergyeV = thresholdEnergyeV;
     masterAttributes->subExptime = subExpTime;
@@ -787,8 +1040,8 @@ void Implementation::SetupWriter() {
     masterAttributes->additionalJsonHeader = additionalJsonHeader;
 
     try {
-        for (unsigned int i = 0; i < dataProcessor.size(); ++i) {
-            dataProcessor[i]->CreateNewFile(masterAttributes.get());
+        for (unsigned int i = 0; i < fileWriter.size(); ++i) {
+            fileWriter[i]->CreateNewFile(masterAttributes.get());
         }
     } catch (const sls::RuntimeError &e) {
         shutDownUDPSockets();
@@ -809,6 +1062,12 @@ void Implementation::StartRunning() {
         it->StartRunning();
         it->Continue();
     }
+    if (fileWriteEnable) {
+        for (const auto &it : fileWriter) {
+            it->StartRunning();
+            it->Continue();
+        }
+    }
     for (const auto &it : dataStreamer) {
         it->StartRunning();
         it->Continue();
@@ -838,6 +1097,7 @@ void Implementation::setNumberofUDPInterfaces(const int n) {
         // clear all threads and fifos
         listener.clear();
         dataProcessor.clear();
+        fileWriter.clear();
         dataStreamer.clear();
         fifo.clear();
 
@@ -857,25 +1117,38 @@ void Implementation::setNumberofUDPInterfaces(const int n) {
                 listener.push_back(sls::make_unique<Listener>(
                     i, myDetectorType, fifo_ptr, &status, &udpPortNum[i],
                     &eth[i], &numberOfTotalFrames, &udpSocketBufferSize,
-                    &actualUDPSocketBufferSize, &framesPerFile,
-                    &frameDiscardMode, &activated, &deactivatedPaddingEnable,
-                    &silentMode));
+                    &actualUDPSocketBufferSize, &udpBatchSize, &udpZeroCopy,
+                    &udpCaptureBackend, &udpThreads, &frameWindowSize,
+                    &frameTimeout, &framesPerFile, &frameDiscardMode,
+                    &activated, &deactivatedPaddingEnable, &silentMode));
                 listener[i]->SetGeneralData(generalData);
 
                 dataProcessor.push_back(sls::make_unique<DataProcessor>(
-                    i, myDetectorType, fifo_ptr, &fileFormatType,
-                    fileWriteEnable, &masterFileWriteEnable, &dataStreamEnable,
-                    &streamingFrequency, &streamingTimerInMs,
-                    &streamingStartFnum, &framePadding, &activated,
-                    &deactivatedPaddingEnable, &silentMode, &ctbDbitList,
-                    &ctbDbitOffset, &ctbAnalogDataBytes));
+                    i, myDetectorType, fifo_ptr, &fileWriteEnable,
+                    &dataStreamEnable, &streamingFrequency, &streamingTimerInMs,
+                    &streamingStartFnum, &streamingBandwidth, &streamingType,
+                    &streamingPreviewBinning, &streamingPreviewTimerInMs,
+                    &framePadding, &activated, &deactivatedPaddingEnable,
+                    &silentMode, &ctbDbitList, &ctbDbitOffset,
+                    &ctbAnalogDataBytes));
                 dataProcessor[i]->SetGeneralData(generalData);
+
+                fileWriter.push_back(sls::make_unique<FileWriter>(
+                    i, fifo_ptr, &fileFormatType, &masterFileWriteEnable,
+                    &dataStreamEnable, &silentMode, &fileDirectIO, &fileIoUring,
+                    &hdf5ChunkFrames, &hdf5ChunkRows, &hdf5CompoundHeader,
+                    &hdf5WriterProcess, &hdf5Swmr, &hdf5FlushFrames,
+                    &hdf5FlushTime, &fileCompressionType,
+                    compressionPool.get()));
+                fileWriter[i]->SetGeneralData(generalData);
             } catch (...) {
                 listener.clear();
                 dataProcessor.clear();
-                throw sls::RuntimeError(
-                    "Could not create listener/dataprocessor threads (index:" +
-                    std::to_string(i) + ")");
+                fileWriter.clear();
+                throw sls::RuntimeError("Could not create listener/"
+                                        "dataprocessor/filewriter threads "
+                                        "(index:" +
+                                        std::to_string(i) + ")");
             }
             // streamer threads
             if (dataStreamEnable) {
@@ -889,11 +1162,19 @@ void Implementation::setNumberofUDPInterfaces(const int n) {
                     }
                     dataStreamer.push_back(sls::make_unique<DataStreamer>(
                         i, fifo[i].get(), &dynamicRange, &roi, &fileIndex, fd,
-                        (int *)nd, &quadEnable, &numberOfTotalFrames));
+                        (int *)nd, &quadEnable, &numberOfTotalFrames,
+                        &streamingBandwidth, &streamingPreviewBinning,
+                        &streamingPreviewMode));
                     dataStreamer[i]->SetGeneralData(generalData);
+                    dataStreamer[i]->SetBinaryHeader(streamingBinaryHeader);
                     dataStreamer[i]->CreateZmqSockets(
                         &numThreads, streamingPort, streamingSrcIP,
-                        streamingHwm);
+                        streamingHwm, streamingType, streamingPushPort);
+                    if (streamingPreviewBinning != 0) {
+                        dataStreamer[i]->CreatePreviewSocket(
+                            streamingPreviewPort, streamingSrcIP,
+                            streamingHwm);
+                    }
                     dataStreamer[i]->SetAdditionalJsonHeader(
                         additionalJsonHeader);
 
@@ -909,7 +1190,7 @@ void Implementation::setNumberofUDPInterfaces(const int n) {
             }
         }
 
-        SetThreadPriorities();
+        SetThreadAffinities();
 
         // update (from 1 to 2 interface) & also for printout
         setDetectorSize(numDet);
@@ -938,15 +1219,27 @@ void Implementation::setNumberofUDPInterfaces(const int n) {
 std::string Implementation::getEthernetInterface() const { return eth[0]; }
 
 void Implementation::setEthernetInterface(const std::string &c) {
+    bool numaChanged = (sls::InterfaceNameToNumaNode(eth[0]) !=
+                        sls::InterfaceNameToNumaNode(c));
     eth[0] = c;
     LOG(logINFO) << "Ethernet Interface: " << eth[0];
+    // fifo memory follows the numa node of the interface
+    if (numaChanged && (int)fifo.size() > 0) {
+        SetupFifoStructure();
+    }
 }
 
 std::string Implementation::getEthernetInterface2() const { return eth[1]; }
 
 void Implementation::setEthernetInterface2(const std::string &c) {
+    bool numaChanged = (sls::InterfaceNameToNumaNode(eth[1]) !=
+                        sls::InterfaceNameToNumaNode(c));
     eth[1] = c;
     LOG(logINFO) << "Ethernet Interface 2: " << eth[1];
+    // fifo memory follows the numa node of the interface
+    if (numaChanged && (int)fifo.size() > 1) {
+        SetupFifoStructure();
+    }
 }
 
 uint32_t Implementation::getUDPPortNumber() const { return udpPortNum[0]; }
@@ -992,6 +1285,51 @@ int Implementation::getActualUDPSocketBufferSize() const {
     return actualUDPSocketBufferSize;
 }
 
+uint32_t Implementation::getUDPBatchSize() const { return udpBatchSize; }
+
+void Implementation::setUDPBatchSize(const uint32_t i) {
+    udpBatchSize = i;
+    LOG(logINFO) << "UDP Batch Size: " << udpBatchSize;
+}
+
+bool Implementation::getUDPZeroCopy() const { return udpZeroCopy; }
+
+void Implementation::setUDPZeroCopy(const bool b) {
+    udpZeroCopy = b;
+    LOG(logINFO) << "UDP Zero Copy: "
+                 << (udpZeroCopy ? "enabled" : "disabled");
+}
+
+slsDetectorDefs::udpBackend Implementation::getUDPBackend() const {
+    return udpCaptureBackend;
+}
+
+void Implementation::setUDPBackend(const udpBackend b) {
+    udpCaptureBackend = b;
+    LOG(logINFO) << "UDP Backend: " << sls::ToString(udpCaptureBackend);
+}
+
+uint32_t Implementation::getUDPThreads() const { return udpThreads; }
+
+void Implementation::setUDPThreads(const uint32_t i) {
+    udpThreads = i;
+    LOG(logINFO) << "UDP Threads per port: " << udpThreads;
+}
+
+uint32_t Implementation::getFrameWindow() const { return frameWindowSize; }
+
+void Implementation::setFrameWindow(const uint32_t i) {
+    frameWindowSize = i;
+    LOG(logINFO) << "Frame window: " << frameWindowSize;
+}
+
+int Implementation::getFrameTimeout() const { return frameTimeout; }
+
+void Implementation::setFrameTimeout(const int timeout_us) {
+    frameTimeout = timeout_us;
+    LOG(logINFO) << "Frame timeout: " << frameTimeout << "us";
+}
+
 /**************************************************
  *                                                 *
  *   ZMQ Streaming Parameters (ZMQ)                *
@@ -1018,11 +1356,19 @@ void Implementation::setDataStreamEnable(const bool enable) {
                     }
                     dataStreamer.push_back(sls::make_unique<DataStreamer>(
                         i, fifo[i].get(), &dynamicRange, &roi, &fileIndex, fd,
-                        (int *)nd, &quadEnable, &numberOfTotalFrames));
+                        (int *)nd, &quadEnable, &numberOfTotalFrames,
+                        &streamingBandwidth, &streamingPreviewBinning,
+                        &streamingPreviewMode));
                     dataStreamer[i]->SetGeneralData(generalData);
+                    dataStreamer[i]->SetBinaryHeader(streamingBinaryHeader);
                     dataStreamer[i]->CreateZmqSockets(
                         &numThreads, streamingPort, streamingSrcIP,
-                        streamingHwm);
+                        streamingHwm, streamingType, streamingPushPort);
+                    if (streamingPreviewBinning != 0) {
+                        dataStreamer[i]->CreatePreviewSocket(
+                            streamingPreviewPort, streamingSrcIP,
+                            streamingHwm);
+                    }
                     dataStreamer[i]->SetAdditionalJsonHeader(
                         additionalJsonHeader);
                 } catch (...) {
@@ -1032,7 +1378,7 @@ void Implementation::setDataStreamEnable(const bool enable) {
                         "Could not set data stream enable.");
                 }
             }
-            SetThreadPriorities();
+            SetThreadAffinities();
         }
     }
     LOG(logINFO) << "Data Send to Gui: " << dataStreamEnable;
@@ -1065,6 +1411,18 @@ void Implementation::setStreamingStartingFrameNumber(const uint32_t fnum) {
     LOG(logINFO) << "Streaming Start Frame num: " << streamingStartFnum;
 }
 
+uint32_t Implementation::getStreamingBandwidth() const {
+    return streamingBandwidth;
+}
+
+void Implementation::setStreamingBandwidth(const uint32_t mbps) {
+    streamingBandwidth = mbps;
+    LOG(logINFO) << "Streaming Bandwidth: "
+                 << (streamingBandwidth == 0
+                         ? std::string("unlimited")
+                         : std::to_string(streamingBandwidth) + " MB/s");
+}
+
 uint32_t Implementation::getStreamingPort() const { return streamingPort; }
 
 void Implementation::setStreamingPort(const uint32_t i) {
@@ -1089,6 +1447,102 @@ void Implementation::setStreamingHwm(const int i) {
                  << (i == -1 ? "Default (-1)" : std::to_string(streamingHwm));
 }
 
+bool Implementation::getStreamingZeroCopy() const {
+    return streamingZeroCopy;
+}
+
+void Implementation::setStreamingZeroCopy(const bool b) {
+    streamingZeroCopy = b;
+    for (const auto &it : fifo)
+        it->SetZeroCopyStreaming(streamingZeroCopy);
+    LOG(logINFO) << "Streaming Zero Copy: "
+                 << (streamingZeroCopy ? "enabled" : "disabled");
+}
+
+bool Implementation::getStreamingBinaryHeader() const {
+    return streamingBinaryHeader;
+}
+
+void Implementation::setStreamingBinaryHeader(const bool b) {
+    streamingBinaryHeader = b;
+    for (const auto &it : dataStreamer)
+        it->SetBinaryHeader(streamingBinaryHeader);
+    LOG(logINFO) << "Streaming Binary Header: "
+                 << (streamingBinaryHeader ? "enabled" : "disabled");
+}
+
+slsDetectorDefs::streamingSocketType
+Implementation::getStreamingSocketType() const {
+    return streamingType;
+}
+
+void Implementation::setStreamingSocketType(const streamingSocketType type) {
+    streamingType = type;
+    LOG(logINFO) << "Streaming Socket Type: " << sls::ToString(streamingType);
+}
+
+uint32_t Implementation::getStreamingPushPort() const {
+    return streamingPushPort;
+}
+
+void Implementation::setStreamingPushPort(const uint32_t i) {
+    streamingPushPort = i;
+    LOG(logINFO) << "Streaming Push Port: " << streamingPushPort;
+}
+
+uint32_t Implementation::getStreamingPreviewBinning() const {
+    return streamingPreviewBinning;
+}
+
+void Implementation::setStreamingPreviewBinning(const uint32_t factor) {
+    if (streamingPreviewBinning != factor) {
+        streamingPreviewBinning = factor;
+        UpdatePreviewSockets();
+    }
+    LOG(logINFO) << "Streaming Preview Binning: " << streamingPreviewBinning;
+}
+
+slsDetectorDefs::previewMode Implementation::getStreamingPreviewMode() const {
+    return streamingPreviewMode;
+}
+
+void Implementation::setStreamingPreviewMode(const previewMode mode) {
+    streamingPreviewMode = mode;
+    LOG(logINFO) << "Streaming Preview Mode: "
+                 << sls::ToString(streamingPreviewMode);
+}
+
+uint32_t Implementation::getStreamingPreviewTimer() const {
+    return streamingPreviewTimerInMs;
+}
+
+void Implementation::setStreamingPreviewTimer(const uint32_t time_in_ms) {
+    streamingPreviewTimerInMs = time_in_ms;
+    LOG(logINFO) << "Streaming Preview Timer: " << streamingPreviewTimerInMs;
+}
+
+uint32_t Implementation::getStreamingPreviewPort() const {
+    return streamingPreviewPort;
+}
+
+void Implementation::setStreamingPreviewPort(const uint32_t i) {
+    if (streamingPreviewPort != i) {
+        streamingPreviewPort = i;
+        UpdatePreviewSockets();
+    }
+    LOG(logINFO) << "Streaming Preview Port: " << streamingPreviewPort;
+}
+
+void Implementation::UpdatePreviewSockets() {
+    for (const auto &it : dataStreamer) {
+        it->ClosePreviewSocket();
+        if (streamingPreviewBinning != 0) {
+            it->CreatePreviewSocket(streamingPreviewPort, streamingSrcIP,
+                                    streamingHwm);
+        }
+    }
+}
+
 std::map<std::string, std::string>
 Implementation::getAdditionalJsonHeader() const {
     return additionalJsonHeader;
@@ -1331,7 +1785,7 @@ void Implementation::setNumberofAnalogSamples(const uint32_t i) {
             numberOfAnalogSamples, numberOfDigitalSamples, tengigaEnable,
             readoutType);
 
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1352,7 +1806,7 @@ void Implementation::setNumberofDigitalSamples(const uint32_t i) {
             numberOfAnalogSamples, numberOfDigitalSamples, tengigaEnable,
             readoutType);
 
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1374,7 +1828,7 @@ void Implementation::setCounterMask(const uint32_t i) {
         generalData->SetNumberofCounters(ncounters, dynamicRange,
                                          tengigaEnable);
         // to update npixelsx, npixelsy in file writer
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1399,7 +1853,7 @@ void Implementation::setDynamicRange(const uint32_t i) {
             }
 
             // to update npixelsx, npixelsy in file writer
-            for (const auto &it : dataProcessor)
+            for (const auto &it : fileWriter)
                 it->SetPixelDimension();
             fifoDepth = generalData->defaultFifoDepth;
             SetupFifoStructure();
@@ -1418,7 +1872,7 @@ void Implementation::setROI(slsDetectorDefs::ROI arg) {
         // only for gotthard
         generalData->SetROI(arg);
         framesPerFile = generalData->maxFramesPerFile;
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1548,7 +2002,7 @@ void Implementation::setReadoutMode(const readoutMode f) {
             tengigaEnable ? adcEnableMaskTenGiga : adcEnableMaskOneGiga,
             numberOfAnalogSamples, numberOfDigitalSamples, tengigaEnable,
             readoutType);
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1568,7 +2022,7 @@ void Implementation::setADCEnableMask(uint32_t mask) {
             numberOfAnalogSamples, numberOfDigitalSamples, tengigaEnable,
             readoutType);
 
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -1590,7 +2044,7 @@ void Implementation::setTenGigaADCEnableMask(uint32_t mask) {
             numberOfAnalogSamples, numberOfDigitalSamples, tengigaEnable,
             readoutType);
 
-        for (const auto &it : dataProcessor)
+        for (const auto &it : fileWriter)
             it->SetPixelDimension();
         SetupFifoStructure();
     }
@@ -6,6 +6,8 @@
 class GeneralData;
 class Listener;
 class DataProcessor;
+class FileWriter;
+class CompressionPool;
 class DataStreamer;
 class Fifo;
 class slsDetectorDefs;
@@ -40,12 +42,20 @@ class Implementation : private virtual slsDetectorDefs {
     void setSilentMode(const bool i);
     uint32_t getFifoDepth() const;
     void setFifoDepth(const uint32_t i);
+    bool getFifoHugePages() const;
+    void setFifoHugePages(const bool i);
+    bool getFifoMemoryLock() const;
+    void setFifoMemoryLock(const bool i);
     frameDiscardPolicy getFrameDiscardPolicy() const;
     void setFrameDiscardPolicy(const frameDiscardPolicy i);
     bool getFramePaddingEnable() const;
     void setFramePaddingEnable(const bool i);
     void setThreadIds(const pid_t parentTid, const pid_t tcpTid);
     std::array<pid_t, NUM_RX_THREAD_IDS> getThreadIds() const;
+    rxThreadAffinity getThreadAffinity(const rxThreadType t,
+                                       const int index) const;
+    /** also applied to threads created later */
+    void setThreadAffinity(const rxThreadAffinity &a);
 
     /**************************************************
      *                                                 *
@@ -67,6 +77,44 @@ class Implementation : private virtual slsDetectorDefs {
     void setMasterFileWriteEnable(const bool b);
     bool getOverwriteEnable() const;
     void setOverwriteEnable(const bool b);
+    bool getFileDirectIO() const;
+    /* binary files written with O_DIRECT through aligned staging buffers */
+    void setFileDirectIO(const bool b);
+    bool getFileIoUring() const;
+    /* binary files written asynchronously with io_uring from the fifo */
+    void setFileIoUring(const bool b);
+    int getHdf5ChunkFrames() const;
+    /* images per hdf5 chunk, gathered and written as whole chunks */
+    void setHdf5ChunkFrames(const int value);
+    /* most images per hdf5 chunk, within the hdf5 chunk limit for the current
+     * image size and not more than the frames per file */
+    uint32_t getHdf5MaxChunkFrames() const;
+    int getHdf5ChunkRows() const;
+    /* rows per hdf5 chunk (tiles), 0 for the whole image */
+    void setHdf5ChunkRows(const int value);
+    bool getHdf5CompoundHeader() const;
+    /* receiver header as one hdf5 compound dataset, not per parameter */
+    void setHdf5CompoundHeader(const bool b);
+    bool getHdf5WriterProcess() const;
+    /* hdf5 data file of each port written by a writer process, reallocates
+     * the fifo as shared memory */
+    void setHdf5WriterProcess(const bool b);
+    bool getHdf5Swmr() const;
+    /* hdf5 data files readable while written (single writer multiple
+     * reader) */
+    void setHdf5Swmr(const bool b);
+    int getHdf5FlushFrames() const;
+    /* images between flushes to swmr readers, 0 for none */
+    void setHdf5FlushFrames(const int value);
+    int getHdf5FlushTime() const;
+    /* ms between flushes to swmr readers, 0 for none */
+    void setHdf5FlushTime(const int value);
+    fileCompression getFileCompression() const;
+    /* bitshuffle compression of the images, only if compiled with it */
+    void setFileCompression(const fileCompression c);
+    int getCompressionThreads() const;
+    /* threads compressing the blocks of images for all ports */
+    void setCompressionThreads(const int value);
     uint32_t getFramesPerFile() const;
     /* 0 means infinite */
     void setFramesPerFile(const uint32_t i);
@@ -111,6 +159,27 @@ class Implementation : private virtual slsDetectorDefs {
     int getUDPSocketBufferSize() const;
     void setUDPSocketBufferSize(const int s);
     int getActualUDPSocketBufferSize() const;
+    uint32_t getUDPBatchSize() const;
+    /* 1 receives one packet per system call */
+    void setUDPBatchSize(const uint32_t i);
+    bool getUDPZeroCopy() const;
+    /* receives packet data directly into the fifo, ignores udp batch size */
+    void setUDPZeroCopy(const bool b);
+    udpBackend getUDPBackend() const;
+    /* packet ring falls back to udp socket without CAP_NET_RAW */
+    void setUDPBackend(const udpBackend b);
+    uint32_t getUDPThreads() const;
+    /* threads receiving from each udp port (SO_REUSEPORT), sharded by frame
+     * number, only with udp socket backend */
+    void setUDPThreads(const uint32_t i);
+    uint32_t getFrameWindow() const;
+    /* frames assembled at the same time by each listener, to reorder packets
+     * across frames. 1 closes a frame with the first packet of a later frame
+     */
+    void setFrameWindow(const uint32_t i);
+    int getFrameTimeout() const;
+    /* pushes a partial frame after timeout_us without packets, 0 disables */
+    void setFrameTimeout(const int timeout_us);
 
     /**************************************************
      *                                                 *
@@ -126,12 +195,35 @@ class Implementation : private virtual slsDetectorDefs {
     void setStreamingTimer(const uint32_t time_in_ms);
     uint32_t getStreamingStartingFrameNumber() const;
     void setStreamingStartingFrameNumber(const uint32_t fnum);
+    uint32_t getStreamingBandwidth() const;
+    /* budget in MB/s, images skipped to stay within it, 0 unlimited */
+    void setStreamingBandwidth(const uint32_t mbps);
     uint32_t getStreamingPort() const;
     void setStreamingPort(const uint32_t i);
     sls::IpAddr getStreamingSourceIP() const;
     void setStreamingSourceIP(const sls::IpAddr ip);
     int getStreamingHwm() const;
     void setStreamingHwm(const int i);
+    bool getStreamingZeroCopy() const;
+    /* images streamed without a copy, freed once sent by zmq */
+    void setStreamingZeroCopy(const bool b);
+    bool getStreamingBinaryHeader() const;
+    /* fixed layout binary instead of json zmq headers */
+    void setStreamingBinaryHeader(const bool b);
+    streamingSocketType getStreamingSocketType() const;
+    /* publish, push (load balanced over pulling clients) or both */
+    void setStreamingSocketType(const streamingSocketType type);
+    uint32_t getStreamingPushPort() const;
+    void setStreamingPushPort(const uint32_t i);
+    uint32_t getStreamingPreviewBinning() const;
+    /* binned preview stream on its own socket, 0 disables it */
+    void setStreamingPreviewBinning(const uint32_t factor);
+    previewMode getStreamingPreviewMode() const;
+    void setStreamingPreviewMode(const previewMode mode);
+    uint32_t getStreamingPreviewTimer() const;
+    void setStreamingPreviewTimer(const uint32_t time_in_ms);
+    uint32_t getStreamingPreviewPort() const;
+    void setStreamingPreviewPort(const uint32_t i);
     std::map<std::string, std::string> getAdditionalJsonHeader() const;
     void setAdditionalJsonHeader(const std::map<std::string, std::string> &c);
     std::string getAdditionalJsonParameter(const std::string &key) const;
@@ -257,13 +349,14 @@ class Implementation : private virtual slsDetectorDefs {
 
   private:
     void SetLocalNetworkParameters();
-    void SetThreadPriorities();
+    void SetThreadAffinities();
     void SetupFifoStructure();
 
     void ResetParametersforNewAcquisition();
     void CreateUDPSockets();
     void SetupWriter();
     void StartRunning();
+    void UpdatePreviewSockets();
 
     /**************************************************
      *                                                *
@@ -279,10 +372,15 @@ class Implementation : private virtual slsDetectorDefs {
     std::string detHostname;
     bool silentMode{false};
     uint32_t fifoDepth{0};
+    bool fifoHugePages{false};
+    bool fifoMemoryLock{false};
     frameDiscardPolicy frameDiscardMode{NO_DISCARD};
     bool framePadding{true};
     pid_t parentThreadId;
     pid_t tcpThreadId;
+    std::array<std::array<rxThreadAffinity, MAX_NUMBER_OF_LISTENING_THREADS>,
+               NUM_RX_THREAD_TYPES>
+        threadAffinity;
 
     // file parameters
     fileFormat fileFormatType{BINARY};
@@ -292,6 +390,16 @@ class Implementation : private virtual slsDetectorDefs {
     bool fileWriteEnable{true};
     bool masterFileWriteEnable{true};
     bool overwriteEnable{true};
+    bool fileDirectIO{false};
+    bool fileIoUring{false};
+    uint32_t hdf5ChunkFrames{DEFAULT_CHUNKED_IMAGES};
+    uint32_t hdf5ChunkRows{0};
+    bool hdf5CompoundHeader{false};
+    bool hdf5WriterProcess{false};
+    bool hdf5Swmr{false};
+    uint32_t hdf5FlushFrames{DEFAULT_SWMR_FLUSH_FRAMES};
+    uint32_t hdf5FlushTime{DEFAULT_SWMR_FLUSH_TIME_MS};
+    fileCompression fileCompressionType{NO_COMPRESSION};
     uint32_t framesPerFile{0};
 
     // acquisition
@@ -306,15 +414,30 @@ class Implementation : private virtual slsDetectorDefs {
         {DEFAULT_UDP_PORTNO, DEFAULT_UDP_PORTNO + 1}};
     int udpSocketBufferSize{0};
     int actualUDPSocketBufferSize{0};
+    uint32_t udpBatchSize{DEFAULT_UDP_BATCH_SIZE};
+    bool udpZeroCopy{false};
+    udpBackend udpCaptureBackend{UDP_SOCKET};
+    uint32_t udpThreads{1};
+    uint32_t frameWindowSize{1};
+    int frameTimeout{0};
 
     // zmq parameters
     bool dataStreamEnable{false};
     uint32_t streamingFrequency{1};
     uint32_t streamingTimerInMs{DEFAULT_STREAMING_TIMER_IN_MS};
     uint32_t streamingStartFnum{0};
+    uint32_t streamingBandwidth{0};
     uint32_t streamingPort{0};
     sls::IpAddr streamingSrcIP = sls::IpAddr{};
     int streamingHwm{-1};
+    bool streamingZeroCopy{false};
+    bool streamingBinaryHeader{false};
+    streamingSocketType streamingType{STREAM_PUB};
+    uint32_t streamingPushPort{DEFAULT_ZMQ_RX_PUSH_PORTNO};
+    uint32_t streamingPreviewBinning{0};
+    previewMode streamingPreviewMode{PREVIEW_BIN};
+    uint32_t streamingPreviewTimerInMs{DEFAULT_PREVIEW_TIMER_IN_MS};
+    uint32_t streamingPreviewPort{DEFAULT_ZMQ_RX_PREVIEW_PORTNO};
     std::map<std::string, std::string> additionalJsonHeader;
 
     // detector parameters
@@ -369,8 +492,11 @@ class Implementation : private virtual slsDetectorDefs {
 
     // class objects
     GeneralData *generalData;
+    // shared by the file writers, outlives them
+    std::unique_ptr<CompressionPool> compressionPool;
     std::vector<std::unique_ptr<Listener>> listener;
     std::vector<std::unique_ptr<DataProcessor>> dataProcessor;
+    std::vector<std::unique_ptr<FileWriter>> fileWriter;
     std::vector<std::unique_ptr<DataStreamer>> dataStreamer;
     std::vector<std::unique_ptr<Fifo>> fifo;
 };
@@ -0,0 +1,318 @@
+/************************************************
+ * @file IndexedFile.cpp
+ * @short writes the indexed binary file: a superblock,
+ * page aligned images, a table of the receiver headers
+ * and a directory of the frames, so that the file can
+ * be memory mapped and read at any frame
+ ***********************************************/
+
+#include "IndexedFile.h"
+#include "FileRotation.h"
+#include "MasterAttributes.h"
+#include "receiver_defs.h"
+#include "sls/container_utils.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+/** zeros to pad the images to the next page */
+const char zeroPage[INDEXED_FILE_PAGE_SIZE] = {};
+
+/** writes all of the buffers, returns false on error */
+bool WriteAll(int fd, struct iovec *iov, int iovcnt) {
+    while (iovcnt != 0) {
+        ssize_t rc = writev(fd, iov, iovcnt);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // skip what was written
+        size_t n = rc;
+        while (iovcnt != 0 && n >= iov->iov_len) {
+            n -= iov->iov_len;
+            ++iov;
+            --iovcnt;
+        }
+        if (iovcnt != 0) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+    return true;
+}
+
+bool WriteAll(int fd, const void *buf, size_t size) {
+    struct iovec iov = {const_cast<void *>(buf), size};
+    return WriteAll(fd, &iov, 1);
+}
+} // namespace
+
+IndexedFile::IndexedFile(int ind, uint32_t *maxf, int *nd, std::string *fname,
+                         std::string *fpath, uint64_t *findex, bool *owenable,
+                         int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
+                         uint32_t *portno, uint32_t nx, uint32_t ny,
+                         bool *smode)
+    : File(ind, INDEXED, maxf, nd, fname, fpath, findex, owenable, dindex,
+           nunits, nf, dr, portno, smode),
+      nPixelsX(nx), nPixelsY(ny) {
+#ifdef VERBOSE
+    PrintMembers();
+#endif
+}
+
+IndexedFile::~IndexedFile() { CloseAllFiles(); }
+
+void IndexedFile::PrintMembers(TLogLevel level) {
+    File::PrintMembers(level);
+    LOG(logINFO) << "Max Frames Per File: " << *maxFramesPerFile;
+    LOG(logINFO) << "Number of Frames in File: " << numFramesInFile;
+}
+
+void IndexedFile::SetNumberofPixels(uint32_t nx, uint32_t ny) {
+    nPixelsX = nx;
+    nPixelsY = ny;
+}
+
+uint32_t IndexedFile::GetMaxFramesPerFile() const {
+    if (*maxFramesPerFile == 0 || *maxFramesPerFile > INDEXED_FILE_MAX_FRAMES) {
+        return INDEXED_FILE_MAX_FRAMES;
+    }
+    return *maxFramesPerFile;
+}
+
+std::string IndexedFile::GetFileName(uint32_t subIndex) const {
+    std::ostringstream os;
+    os << *filePath << "/" << *fileNamePrefix << "_d"
+       << (*detIndex * (*numUnitsPerDetector) + index) << "_f" << subIndex
+       << '_' << *fileIndex << ".raw";
+    return os.str();
+}
+
+void IndexedFile::CreateFile() {
+    numFramesInFile = 0;
+    numActualPacketsInFile = 0;
+    currentFileName = GetFileName(subFileIndex);
+    currentFile.name = currentFileName;
+    OpenDataFile(currentFile);
+    if (!(*silentMode)) {
+        LOG(logINFO) << "[" << *udpPortNumber
+                     << "]: Indexed Binary File created: " << currentFileName;
+    }
+    PrepareNextFile();
+}
+
+void IndexedFile::OpenDataFile(DataFile &f) {
+    int flags = O_WRONLY | O_CREAT | (*overWriteEnable ? O_TRUNC : O_EXCL);
+    f.fd = open(f.name.c_str(), flags, 0664);
+    if (f.fd < 0) {
+        f.fd = -1;
+        throw sls::RuntimeError("Could not create file " + f.name + " (" +
+                                strerror(errno) + ")");
+    }
+    // superblock written at close, incomplete till then
+    if (!WriteAll(f.fd, zeroPage, sizeof(zeroPage))) {
+        close(f.fd);
+        f.fd = -1;
+        throw sls::RuntimeError("Could not write to file " + f.name);
+    }
+    f.offset = sizeof(zeroPage);
+    f.headers.clear();
+    f.directory.clear();
+}
+
+void IndexedFile::CloseDataFile(DataFile &f) {
+    if (f.fd < 0) {
+        return;
+    }
+    indexed_file_superblock sb{};
+    memcpy(sb.magic, INDEXED_FILE_MAGIC, sizeof(sb.magic));
+    sb.version = INDEXED_FILE_VERSION;
+    sb.pageSize = INDEXED_FILE_PAGE_SIZE;
+    sb.headerSize = sizeof(sls_detector_header) + sizeof(bitset_storage);
+    sb.dynamicRange = *dynamicRange;
+    sb.nPixelsX = nPixelsX;
+    sb.nPixelsY = nPixelsY;
+    sb.complete = 1;
+    sb.numFrames = f.directory.size();
+    sb.headerTableOffset = f.offset;
+    sb.directoryOffset = f.offset + f.headers.size();
+
+    // frames can be looked up by frame number
+    std::stable_sort(f.directory.begin(), f.directory.end(),
+                     [](const indexed_file_entry &a,
+                        const indexed_file_entry &b) {
+                         return a.frameNumber < b.frameNumber;
+                     });
+    bool ok =
+        WriteAll(f.fd, f.headers.data(), f.headers.size()) &&
+        WriteAll(f.fd, f.directory.data(),
+                 f.directory.size() * sizeof(indexed_file_entry)) &&
+        (pwrite(f.fd, &sb, sizeof(sb), 0) == (ssize_t)sizeof(sb));
+    if (close(f.fd) != 0) {
+        ok = false;
+    }
+    f.fd = -1;
+    if (!ok) {
+        LOG(logERROR) << index << " : Could not write the tables of file "
+                      << f.name;
+    }
+}
+
+void IndexedFile::PrepareNextFile() {
+    if (!FileRotation::HasNextFile(subFileIndex, GetMaxFramesPerFile(),
+                                   *numImages)) {
+        return;
+    }
+    if (rotation == nullptr) {
+        rotation =
+            sls::make_unique<FileRotation>(std::to_string(*udpPortNumber));
+    }
+    nextFile.name = GetFileName(subFileIndex + 1);
+    rotation->PrepareNext(nextFile.name, [this]() { OpenDataFile(nextFile); });
+}
+
+void IndexedFile::RotateFile() {
+    std::string fname;
+    if (rotation != nullptr) {
+        fname = rotation->TakeNext([this]() { return nextFile.fd >= 0; });
+    }
+    if (fname.empty()) {
+        CloseCurrentFile();
+        ++subFileIndex;
+        CreateFile();
+        return;
+    }
+
+    // the current file is closed in the background
+    std::swap(oldFile, currentFile);
+    std::swap(currentFile, nextFile);
+    rotation->Queue([this]() { CloseDataFile(oldFile); });
+
+    ++subFileIndex;
+    numFramesInFile = 0;
+    numActualPacketsInFile = 0;
+    currentFileName = currentFile.name;
+    if (!(*silentMode)) {
+        LOG(logINFO) << "[" << *udpPortNumber
+                     << "]: Indexed Binary File created: " << currentFileName;
+    }
+    PrepareNextFile();
+}
+
+void IndexedFile::DiscardNextFile() {
+    if (rotation == nullptr) {
+        return;
+    }
+    rotation->DiscardNext([this]() {
+        if (nextFile.fd < 0) {
+            return false;
+        }
+        close(nextFile.fd);
+        nextFile.fd = -1;
+        return true;
+    });
+}
+
+void IndexedFile::CloseCurrentFile() {
+    DiscardNextFile();
+    CloseDataFile(currentFile);
+}
+
+void IndexedFile::CloseAllFiles() { CloseCurrentFile(); }
+
+void IndexedFile::WriteToFile(char *buffer, int buffersize,
+                              uint64_t currentFrameNumber,
+                              uint32_t numPacketsCaught) {
+    if (numFramesInFile >= GetMaxFramesPerFile()) {
+        RotateFile();
+    }
+    if (currentFile.fd < 0) {
+        throw sls::RuntimeError(std::to_string(index) +
+                                " : No file open to write image number " +
+                                std::to_string(currentFrameNumber));
+    }
+    numFramesInFile++;
+    numActualPacketsInFile += numPacketsCaught;
+
+    // image from the next page, images can be of any size (modified by the
+    // call back)
+    auto *rheader = reinterpret_cast<sls_receiver_header *>(buffer);
+    size_t imageSize = buffersize - sizeof(sls_receiver_header);
+    size_t padding =
+        (INDEXED_FILE_PAGE_SIZE - imageSize % INDEXED_FILE_PAGE_SIZE) %
+        INDEXED_FILE_PAGE_SIZE;
+    struct iovec iov[2] = {
+        {buffer + sizeof(sls_receiver_header), imageSize},
+        {const_cast<char *>(zeroPage), padding}};
+    if (!WriteAll(currentFile.fd, iov, 2)) {
+        throw sls::RuntimeError(std::to_string(index) +
+                                " : Write to file failed for image number " +
+                                std::to_string(currentFrameNumber));
+    }
+
+    indexed_file_entry entry{};
+    entry.frameNumber = rheader->detHeader.frameNumber;
+    entry.record = currentFile.directory.size();
+    entry.offset = currentFile.offset;
+    entry.size = imageSize;
+    currentFile.directory.push_back(entry);
+    currentFile.offset += imageSize + padding;
+
+    // receiver header with a contiguous bitset
+    size_t hsize = sizeof(sls_detector_header) + sizeof(bitset_storage);
+    size_t pos = currentFile.headers.size();
+    currentFile.headers.resize(pos + hsize);
+    char *dst = &currentFile.headers[pos];
+    memcpy(dst, &rheader->detHeader, sizeof(sls_detector_header));
+    if (sizeof(sls_bitset) == sizeof(bitset_storage)) {
+        memcpy(dst + sizeof(sls_detector_header), &rheader->packetsMask,
+               sizeof(bitset_storage));
+    } else {
+        auto *storage =
+            reinterpret_cast<uint8_t *>(dst + sizeof(sls_detector_header));
+        memset(storage, 0, sizeof(bitset_storage));
+        for (int i = 0; i < MAX_NUM_PACKETS; ++i)
+            storage[i >> 3] |= (rheader->packetsMask[i] << (i & 7));
+    }
+}
+
+void IndexedFile::CreateMasterFile(bool masterFileWriteEnable,
+                                   MasterAttributes *attr) {
+    // beginning of every acquisition
+    numFramesInFile = 0;
+    numActualPacketsInFile = 0;
+
+    if (GetMaxFramesPerFile() != *maxFramesPerFile && !(*silentMode)) {
+        LOG(logWARNING) << "[" << *udpPortNumber
+                        << "]: Indexed binary files are split every "
+                        << INDEXED_FILE_MAX_FRAMES << " frames";
+    }
+
+    if (masterFileWriteEnable && master) {
+        std::ostringstream os;
+        os << *filePath << "/" << *fileNamePrefix << "_master"
+           << "_" << *fileIndex << ".raw";
+        masterFileName = os.str();
+        if (!(*silentMode)) {
+            LOG(logINFO) << "Master File: " << masterFileName;
+        }
+
+        // create master file
+        FILE *masterfd = fopen((const char *)masterFileName.c_str(),
+                               (*overWriteEnable) ? "w" : "wx");
+        if (masterfd == nullptr) {
+            throw sls::RuntimeError("Could not create binary master file " +
+                                    masterFileName);
+        }
+        attr->WriteMasterBinaryAttributes(masterfd);
+        fclose(masterfd);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+/************************************************
+ * @file IndexedFile.h
+ * @short writes the indexed binary file: a superblock,
+ * page aligned images, a table of the receiver headers
+ * and a directory of the frames, so that the file can
+ * be memory mapped and read at any frame
+ ***********************************************/
+/**
+ *@short indexed binary file, memory mappable with random access to the frames
+ */
+
+#include "File.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class FileRotation;
+
+class IndexedFile : private virtual slsDetectorDefs, public File {
+
+  public:
+    /**
+     * Constructor
+     * creates the File Writer
+     * @param ind self index
+     * @param maxf pointer to max frames per file
+     * @param nd pointer to number of detectors in each dimension
+     * @param fname pointer to file name prefix
+     * @param fpath pointer to file path
+     * @param findex pointer to file index
+     * @param owenable pointer to over write enable
+     * @param dindex pointer to detector index
+     * @param nunits pointer to number of theads/ units per detector
+     * @param nf pointer to number of images in acquisition
+     * @param dr pointer to dynamic range
+     * @param portno pointer to udp port number for logging
+     * @param nx number of pixels in x direction
+     * @param ny number of pixels in y direction
+     * @param smode pointer to silent mode
+     */
+    IndexedFile(int ind, uint32_t *maxf, int *nd, std::string *fname,
+                std::string *fpath, uint64_t *findex, bool *owenable,
+                int *dindex, int *nunits, uint64_t *nf, uint32_t *dr,
+                uint32_t *portno, uint32_t nx, uint32_t ny, bool *smode);
+    ~IndexedFile();
+
+    void PrintMembers(TLogLevel level = logDEBUG1) override;
+    void SetNumberofPixels(uint32_t nx, uint32_t ny) override;
+    void CreateFile() override;
+    void CreateMasterFile(bool masterFileWriteEnable,
+                          MasterAttributes *attr) override;
+    void CloseCurrentFile() override;
+    void CloseAllFiles() override;
+    void WriteToFile(char *buffer, int buffersize, uint64_t currentFrameNumber,
+                     uint32_t numPacketsCaught) override;
+
+  private:
+    /** a data file being written, its tables kept till it is closed */
+    struct DataFile {
+        std::string name;
+        int fd{-1};
+        /** end of the last image written */
+        uint64_t offset{0};
+        /** receiver headers in the order written */
+        std::vector<char> headers;
+        std::vector<indexed_file_entry> directory;
+    };
+
+    /** frames per sub file, at most INDEXED_FILE_MAX_FRAMES as the tables
+     * of a file are kept in memory */
+    uint32_t GetMaxFramesPerFile() const;
+    /** name of a sub file of the acquisition */
+    std::string GetFileName(uint32_t subIndex) const;
+    /** creates a data file and reserves its superblock */
+    void OpenDataFile(DataFile &f);
+    /** writes the header table, the directory and the superblock and
+     * closes the data file, errors are logged */
+    void CloseDataFile(DataFile &f);
+    /** creates the next sub file in the background if the acquisition has
+     * more images than fit in the current one */
+    void PrepareNextFile();
+    /** closes the current file in the background and continues with the
+     * next one, created inline if it could not be prepared */
+    void RotateFile();
+    /** closes the next file if it was prepared but not used, removed if
+     * it did not exist before */
+    void DiscardNextFile();
+
+    uint32_t nPixelsX;
+    uint32_t nPixelsY;
+    uint32_t numFramesInFile{0};
+    uint64_t numActualPacketsInFile{0};
+    DataFile currentFile;
+    /** creates the next sub file and closes the previous one */
+    std::unique_ptr<FileRotation> rotation;
+    /** next sub file, created in the background */
+    DataFile nextFile;
+    /** previous sub file, closed in the background */
+    DataFile oldFile;
+};
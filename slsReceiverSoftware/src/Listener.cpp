@@ -7,30 +7,53 @@
 
 #include "Listener.h"
 #include "Fifo.h"
+#include "FrameWindow.h"
 #include "GeneralData.h"
+#include "ListenerShard.h"
+#include "sls/ToString.h"
+#include "sls/UdpRxPacketRing.h"
 #include "sls/UdpRxSocket.h"
 #include "sls/container_utils.h" // For sls::make_unique<>
 #include "sls/network_utils.h"
 #include "sls/sls_detector_exceptions.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 
+namespace {
+int64_t SteadyClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
 const std::string Listener::TypeName = "Listener";
 
 Listener::Listener(int ind, detectorType dtype, Fifo *f,
                    std::atomic<runStatus> *s, uint32_t *portno, std::string *e,
-                   uint64_t *nf, int *us, int *as, uint32_t *fpf,
-                   frameDiscardPolicy *fdp, bool *act, bool *depaden, bool *sm)
+                   uint64_t *nf, int *us, int *as, uint32_t *ubs, bool *uzc,
+                   udpBackend *ub, uint32_t *uth, uint32_t *fw, int *ft,
+                   uint32_t *fpf, frameDiscardPolicy *fdp, bool *act,
+                   bool *depaden, bool *sm)
     : ThreadObject(ind, TypeName), fifo(f), myDetectorType(dtype), status(s),
       udpPortNumber(portno), eth(e), numImages(nf), udpSocketBufferSize(us),
-      actualUDPSocketBufferSize(as), framesPerFile(fpf), frameDiscardMode(fdp),
-      activated(act), deactivatedPaddingEnable(depaden), silentMode(sm) {
+      actualUDPSocketBufferSize(as), udpBatchSize(ubs), udpZeroCopy(uzc),
+      udpCaptureBackend(ub), udpThreads(uth), frameWindowSize(fw),
+      frameTimeout(ft), framesPerFile(fpf), frameDiscardMode(fdp),
+      activated(act), deactivatedPaddingEnable(depaden), silentMode(sm),
+      threadAffinity(LISTENER_THREAD, ind) {
     LOG(logDEBUG) << "Listener " << ind << " created";
 }
 
-Listener::~Listener() = default;
+Listener::~Listener() {
+    // shard threads use the sockets
+    ShutDownUDPSocket();
+    shards.clear();
+}
 
 uint64_t Listener::GetPacketsCaught() const { return numPacketsCaught; }
 
@@ -38,6 +61,8 @@ uint64_t Listener::GetLastFrameIndexCaught() const {
     return lastCaughtFrameIndex;
 }
 
+int64_t Listener::GetLastPacketTime() const { return lastPacketTime; }
+
 uint64_t Listener::GetNumMissingPacket(bool stoppedFlag,
                                        uint64_t numPackets) const {
     if (!stoppedFlag) {
@@ -60,6 +85,7 @@ void Listener::ResetParametersforNewAcquisition() {
     firstIndex = 0;
     currentFrameIndex = 0;
     lastCaughtFrameIndex = 0;
+    lastPacketTime = SteadyClockNs();
     carryOverFlag = false;
     uint32_t packetSize = generalData->packetSize;
     if (myDetectorType == GOTTHARD2 && index != 0) {
@@ -67,11 +93,17 @@ void Listener::ResetParametersforNewAcquisition() {
     }
     carryOverPacket = sls::make_unique<char[]>(packetSize);
     memset(carryOverPacket.get(), 0, packetSize);
-    listeningPacket = sls::make_unique<char[]>(packetSize);
+    listeningPacketSize = packetSize;
+    listeningPacket = sls::make_unique<char[]>((size_t)packetSize *
+                                               (size_t)(*udpBatchSize));
     memset(carryOverPacket.get(), 0, packetSize);
+    numBatchPackets = 0;
+    batchPacketIndex = 0;
 
     numPacketsStatistic = 0;
     numFramesStatistic = 0;
+    numFramesPushedStatistic = 0;
+    shardsStarted = false;
     // reset fifo statistic
     fifo->GetMaxLevelForFifoBound();
     fifo->GetMinLevelForFifoFree();
@@ -95,6 +127,7 @@ void Listener::SetGeneralData(GeneralData *g) { generalData = g; }
 
 void Listener::CreateUDPSockets() {
     if (!(*activated)) {
+        frameWindow.reset();
         return;
     }
 
@@ -113,29 +146,160 @@ void Listener::CreateUDPSockets() {
         packetSize = generalData->vetoPacketSize;
     }
 
+    udpBackend backend = *udpCaptureBackend;
+
+    // frame window and multiple udp threads only for standard headers,
+    // copying into the frame
+    uint32_t numThreads = *udpThreads;
+    uint32_t windowSize = *frameWindowSize;
+    if (numThreads > 1 && backend != UDP_SOCKET) {
+        LOG(logWARNING) << index
+                        << ": Multiple udp threads only with udp socket "
+                           "backend. Using 1 thread.";
+        numThreads = 1;
+    }
+    if (numThreads > 1) {
+        windowSize = std::max(windowSize, 2 * numThreads);
+    }
+    if (windowSize > 1 &&
+        (*udpZeroCopy || !generalData->standardheader ||
+         myDetectorType == CHIPTESTBOARD || myDetectorType == MOENCH ||
+         (myDetectorType == GOTTHARD2 && index != 0))) {
+        LOG(logWARNING) << index
+                        << ": Frame window and multiple udp threads only "
+                           "without zero copy and for standard headers. "
+                           "Using 1 frame and 1 thread.";
+        numThreads = 1;
+        windowSize = 1;
+    }
+    // processors need free buffers while the window holds its frames
+    if (windowSize > 1 &&
+        windowSize >= static_cast<uint32_t>(fifo->GetFifoDepth())) {
+        windowSize = std::max(fifo->GetFifoDepth() - 1, 1);
+        LOG(logWARNING) << index << ": Frame window limited to " << windowSize
+                        << " frames by fifo depth";
+    }
+
+    if (numThreads > 1) {
+        CreateShards(numThreads, packetSize);
+    } else {
+        shards.clear();
+        shardSockets.clear();
+        CreateSocket(backend, packetSize);
+    }
+    CreateFrameWindow(numThreads, windowSize, packetSize);
+
+    // receive returns without packets to push partial frames
+    udpSocket->setReceiveTimeout(*frameTimeout);
+    for (const auto &it : shardSockets) {
+        it->setReceiveTimeout(*frameTimeout);
+    }
+
+    udpSocketAlive = true;
+
+    // doubled due to kernel bookkeeping (could also be less due to permissions)
+    // or size of the packet ring
+    *actualUDPSocketBufferSize = udpSocket->getBufferSize();
+}
+
+void Listener::CreateSocket(udpBackend backend, uint32_t packetSize) {
+    if (backend == PACKET_RING) {
+        try {
+            udpSocket = sls::make_unique<sls::UdpRxPacketRing>(
+                *udpPortNumber, packetSize,
+                ((*eth).length() ? (*eth).c_str() : nullptr),
+                *udpSocketBufferSize);
+        } catch (const sls::RuntimeError &e) {
+            LOG(logWARNING) << index << ": " << e.what()
+                            << ". Falling back to udp socket";
+            backend = UDP_SOCKET;
+        }
+    }
+
     // InterfaceNameToIp(eth).str().c_str()
     try {
-        udpSocket = sls::make_unique<sls::UdpRxSocket>(
-            *udpPortNumber, packetSize,
-            ((*eth).length() ? sls::InterfaceNameToIp(*eth).str().c_str()
-                             : nullptr),
-            *udpSocketBufferSize);
-        LOG(logINFO) << index << ": UDP port opened at port " << *udpPortNumber;
+        if (backend == UDP_SOCKET) {
+            udpSocket = sls::make_unique<sls::UdpRxSocket>(
+                *udpPortNumber, packetSize,
+                ((*eth).length() ? sls::InterfaceNameToIp(*eth).str().c_str()
+                                 : nullptr),
+                *udpSocketBufferSize);
+        }
+        LOG(logINFO) << index << ": UDP port opened at port " << *udpPortNumber
+                     << " (" << sls::ToString(backend)
+                     << ", batch size: " << *udpBatchSize << ")";
     } catch (...) {
         throw sls::RuntimeError("Could not create UDP socket on port " +
                                 std::to_string(*udpPortNumber));
     }
+}
 
-    udpSocketAlive = true;
+void Listener::CreateShards(uint32_t numThreads, uint32_t packetSize) {
+    const char *ip = nullptr;
+    std::string ipString;
+    if ((*eth).length()) {
+        ipString = sls::InterfaceNameToIp(*eth).str();
+        ip = ipString.c_str();
+    }
+    // bound in order, the order of the reuse port group
+    shardSockets.clear();
+    try {
+        auto socket = sls::make_unique<sls::UdpRxSocket>(
+            *udpPortNumber, packetSize, ip, *udpSocketBufferSize, true);
+        for (uint32_t i = 1; i < numThreads; ++i) {
+            shardSockets.push_back(sls::make_unique<sls::UdpRxSocket>(
+                *udpPortNumber, packetSize, ip, *udpSocketBufferSize, true));
+        }
+        // frame number is the first (little endian) word of the packet
+        socket->ShardReusePortGroup(numThreads);
+        udpSocket = std::move(socket);
+    } catch (const sls::RuntimeError &e) {
+        shardSockets.clear();
+        LOG(logERROR) << index << ": " << e.what();
+        throw sls::RuntimeError("Could not create UDP sockets on port " +
+                                std::to_string(*udpPortNumber));
+    }
+    LOG(logINFO) << index << ": UDP port opened at port " << *udpPortNumber
+                 << " (" << sls::ToString(UDP_SOCKET)
+                 << ", batch size: " << *udpBatchSize
+                 << ", threads: " << numThreads << ")";
+
+    if (shards.size() != numThreads - 1) {
+        shards.clear();
+        for (uint32_t i = 1; i < numThreads; ++i) {
+            shards.push_back(sls::make_unique<ListenerShard>(index, i, this));
+        }
+        SetShardAffinities();
+    }
+}
 
-    // doubled due to kernel bookkeeping (could also be less due to permissions)
-    *actualUDPSocketBufferSize = udpSocket->getBufferSize();
+void Listener::CreateFrameWindow(uint32_t numThreads, uint32_t windowSize,
+                                 uint32_t packetSize) {
+    shardPackets.clear();
+    if (windowSize == 1) {
+        frameWindow.reset();
+        return;
+    }
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        shardPackets.push_back(sls::make_unique<char[]>(
+            (size_t)packetSize * (size_t)(*udpBatchSize)));
+    }
+    // frames of all threads are assembled at the same time
+    frameWindow = sls::make_unique<FrameWindow>(
+        fifo, windowSize, generalData->packetsPerFrame, generalData->dataSize,
+        generalData->imageSize, generalData->fifoBufferHeaderSize,
+        frameDiscardMode);
+    frameWindow->SetHardCodedPosition(row, column);
+    LOG(logINFO) << index << ": Frame window of " << windowSize << " frames";
 }
 
 void Listener::ShutDownUDPSocket() {
     if (udpSocket) {
         udpSocketAlive = false;
         udpSocket->Shutdown();
+        for (const auto &it : shardSockets) {
+            it->Shutdown();
+        }
         LOG(logINFO) << "Shut down of UDP port " << *udpPortNumber;
     }
 }
@@ -188,9 +352,156 @@ void Listener::CreateDummySocketForUDPSocketBufferSize(int s) {
 void Listener::SetHardCodedPosition(uint16_t r, uint16_t c) {
     row = r;
     column = c;
+    if (frameWindow) {
+        frameWindow->SetHardCodedPosition(r, c);
+    }
+}
+
+void Listener::SetThreadAffinity(const rxThreadAffinity &a) {
+    threadAffinity = a;
+    SetShardAffinities();
+}
+
+void Listener::SetShardAffinities() {
+    std::vector<int> cpus;
+    for (int i = 0; i < MAX_RX_CPUS; ++i) {
+        if (threadAffinity.hasCpu(i)) {
+            cpus.push_back(i);
+        }
+    }
+    size_t numThreads = shards.size() + 1;
+    for (size_t k = 0; k < numThreads; ++k) {
+        rxThreadAffinity a = threadAffinity;
+        // a cpu for each receiving thread
+        if (numThreads > 1 && cpus.size() >= numThreads) {
+            for (int i = 0; i < MAX_RX_CPUS / 64; ++i) {
+                a.cpuMask[i] = 0;
+            }
+            a.addCpu(cpus[k]);
+        }
+        if (k == 0) {
+            ThreadObject::SetThreadAffinity(a);
+        } else {
+            shards[k - 1]->SetThreadAffinity(a);
+        }
+    }
+}
+
+bool Listener::ReceiveShard(int shard) {
+    if (!udpSocketAlive) {
+        return false;
+    }
+    sls::UdpRxBase *socket =
+        (shard == 0 ? udpSocket.get() : shardSockets[shard - 1].get());
+    char *packets = shardPackets[shard].get();
+    int numPackets = 0;
+    if (*udpBatchSize == 1) {
+        numPackets = (socket->ReceiveDataOnly(packets) > 0 ? 1 : 0);
+    } else {
+        numPackets = socket->ReceiveBatch(packets, *udpBatchSize);
+    }
+    if (numPackets <= 0) {
+        // only a shut down socket ends the shard, retry on frame timeouts,
+        // interrupted (EINTR) or spurious (EAGAIN) wake ups
+        if (!udpSocketAlive) {
+            return false;
+        }
+        if (*frameTimeout > 0) {
+            FlushOnFrameTimeout();
+        }
+        return true;
+    }
+    lastPacketTime = SteadyClockNs();
+
+    uint32_t pperFrame = generalData->packetsPerFrame;
+    uint32_t hsize = generalData->headerSizeinPacket;
+    for (int i = 0; i < numPackets; ++i) {
+        char *packet = packets + (size_t)i * listeningPacketSize;
+        auto *header = (sls_detector_header *)(packet);
+        uint64_t fnum = header->frameNumber;
+        uint32_t pnum = header->packetNumber;
+
+        // Eiger Firmware in a weird state
+        if (myDetectorType == EIGER && fnum == 0) {
+            LOG(logERROR) << "[" << *udpPortNumber
+                          << "]: Got Frame Number "
+                             "Zero from Firmware. Discarding Packet";
+            continue;
+        }
+        if (pnum >= pperFrame) {
+            LOG(logERROR) << "Bad packet " << pnum << "(fnum: " << fnum
+                          << "), throwing away.";
+            continue;
+        }
+        // duplicate or frame already pushed
+        if (!frameWindow->AddPacket(fnum, pnum, header, packet + hsize)) {
+            continue;
+        }
+        numPacketsCaught++;
+        numPacketsStatistic++;
+        uint64_t last = lastCaughtFrameIndex;
+        while (fnum > last &&
+               !lastCaughtFrameIndex.compare_exchange_weak(last, fnum)) {
+        }
+    }
+    return true;
+}
+
+void Listener::FlushOnFrameTimeout() {
+    // other threads might still be receiving packets of these frames
+    if (SteadyClockNs() - lastPacketTime < (int64_t)(*frameTimeout) * 1000) {
+        return;
+    }
+    frameWindow->Flush();
+}
+
+void Listener::ThreadExecutionSharded() {
+    // other threads start with the first execution of this acquisition
+    if (!shardsStarted) {
+        shardsStarted = true;
+        for (const auto &it : shards) {
+            it->StartRunning();
+            it->Continue();
+        }
+    }
+
+    bool receiving = ReceiveShard(0);
+    if (!startedFlag && frameWindow->HasStarted()) {
+        RecordFirstIndex(frameWindow->GetFirstFrameNumber());
+    }
+    if (receiving) {
+        // Statistics
+        if (!(*silentMode)) {
+            uint64_t pushed = frameWindow->GetNumFramesPushed();
+            numFramesStatistic = pushed - numFramesPushedStatistic;
+            if (numFramesStatistic >=
+                (((*framesPerFile) == 0) ? STATISTIC_FRAMENUMBER_INFINITE
+                                         : (*framesPerFile))) {
+                numFramesPushedStatistic = pushed;
+                PrintFifoStatistics();
+            }
+        }
+        return;
+    }
+
+    // end of acquisition
+    for (const auto &it : shards) {
+        it->WaitForStop();
+    }
+    frameWindow->Flush();
+    currentFrameIndex = frameWindow->GetNextFrameNumber();
+    shardsStarted = false;
+
+    char *buffer = nullptr;
+    fifo->GetNewAddress(buffer);
+    StopListening(buffer);
 }
 
 void Listener::ThreadExecution() {
+    if (frameWindow) {
+        ThreadExecutionSharded();
+        return;
+    }
     char *buffer;
     int rc = 0;
 
@@ -200,8 +511,11 @@ void Listener::ThreadExecution() {
                       "pop 0x"
                    << std::hex << (void *)(buffer) << std::dec << ":" << buffer;
 
+    // packets left over from the last udp batch
+    bool batchPending = (batchPacketIndex < numBatchPackets);
+
     // udpsocket doesnt exist
-    if (*activated && !udpSocketAlive && !carryOverFlag) {
+    if (*activated && !udpSocketAlive && !carryOverFlag && !batchPending) {
         // LOG(logERROR) << "Listening_Thread " << index << ": UDP Socket not
         // created or shut down earlier";
         (*((uint32_t *)buffer)) = 0;
@@ -211,7 +525,7 @@ void Listener::ThreadExecution() {
 
     // get data
     if ((*status != TRANSMITTING && (!(*activated) || udpSocketAlive)) ||
-        carryOverFlag) {
+        carryOverFlag || batchPending) {
         rc = ListenToAnImage(buffer);
     }
 
@@ -222,14 +536,14 @@ void Listener::ThreadExecution() {
             (*((uint32_t *)buffer)) = 0;
             StopListening(buffer);
         } else
-            fifo->FreeAddress(buffer);
+            fifo->ReturnNewAddress(buffer);
         return;
     }
 
     // discarding image
     else if (rc < 0) {
         LOG(logDEBUG) << index << " discarding fnum:" << currentFrameIndex;
-        fifo->FreeAddress(buffer);
+        fifo->ReturnNewAddress(buffer);
         currentFrameIndex++;
         return;
     }
@@ -266,6 +580,7 @@ void Listener::StopListening(char *buf) {
 uint32_t Listener::ListenToAnImage(char *buf) {
 
     int rc = 0;
+    char *packet = nullptr;
     uint64_t fnum = 0;
     uint32_t pnum = 0;
     uint64_t bnum = 0;
@@ -288,6 +603,12 @@ uint32_t Listener::ListenToAnImage(char *buf) {
     sls_detector_header *old_header = nullptr;
     sls_receiver_header *new_header = nullptr;
     uint32_t corrected_dsize = dsize - ((pperFrame * dsize) - imageSize);
+    // scatter payload directly into its expected place in the fifo buffer
+    // (only for detectors without special packet layouts)
+    bool zeroCopy = (*udpZeroCopy) && standardheader &&
+                    myDetectorType != CHIPTESTBOARD && myDetectorType != MOENCH;
+    uint32_t expectedPnum = 0;
+    char *slot = nullptr;
 
     // reset to -1
     memset(buf, 0, fifohsize);
@@ -387,6 +708,7 @@ uint32_t Listener::ListenToAnImage(char *buf) {
         }
 
         carryOverFlag = false;
+        expectedPnum = pnum + 1;
         ++numpackets; // number of packets in this image (each time its copied
                       // to buf)
         new_header->packetsMask[(
@@ -421,11 +743,18 @@ uint32_t Listener::ListenToAnImage(char *buf) {
     // never entering this loop)
     while (numpackets < pperFrame) {
         // listen to new packet
-        rc = 0;
-        if (udpSocketAlive) {
-            rc = udpSocket->ReceiveDataOnly(&listeningPacket[0]);
+        slot = nullptr;
+        if (zeroCopy) {
+            // expected slot must not already hold a packet of this frame
+            if (expectedPnum < pperFrame &&
+                !new_header->packetsMask[expectedPnum]) {
+                slot = buf + fifohsize + (expectedPnum * dsize);
+            }
+            rc = ReceivePacketInPlace(packet, slot);
+        } else {
+            rc = ReceivePacket(packet);
         }
-        // end of acquisition
+        // end of acquisition or frame timeout
         if (rc <= 0) {
             if (numpackets == 0)
                 return 0; // empty image
@@ -457,7 +786,7 @@ uint32_t Listener::ListenToAnImage(char *buf) {
         // -------------------------- new header
         // ----------------------------------------------------------------------
         if (standardheader) {
-            old_header = (sls_detector_header *)(&listeningPacket[0]);
+            old_header = (sls_detector_header *)(packet);
             fnum = old_header->frameNumber;
             pnum = old_header->packetNumber;
         }
@@ -467,12 +796,12 @@ uint32_t Listener::ListenToAnImage(char *buf) {
             // set first packet to be odd or even (check required when switching
             // from roi to no roi)
             if (myDetectorType == GOTTHARD && !startedFlag) {
-                oddStartingPacket = generalData->SetOddStartingPacket(
-                    index, &listeningPacket[0]);
+                oddStartingPacket =
+                    generalData->SetOddStartingPacket(index, packet);
             }
 
-            generalData->GetHeaderInfo(index, &listeningPacket[0],
-                                       oddStartingPacket, fnum, pnum, bnum);
+            generalData->GetHeaderInfo(index, packet, oddStartingPacket, fnum,
+                                       pnum, bnum);
         }
         //------------------------------------------------------------------------------------------------------------
 
@@ -507,7 +836,13 @@ uint32_t Listener::ListenToAnImage(char *buf) {
         // detectors)
         if (fnum != currentFrameIndex) {
             carryOverFlag = true;
-            memcpy(carryOverPacket.get(), &listeningPacket[0], packetSize);
+            if (slot != nullptr) {
+                // payload was placed in this frame, reassemble packet
+                memcpy(carryOverPacket.get(), packet, hsize);
+                memcpy(carryOverPacket.get() + hsize, slot, dsize);
+            } else {
+                memcpy(carryOverPacket.get(), packet, packetSize);
+            }
 
             switch (*frameDiscardMode) {
             case DISCARD_EMPTY_FRAMES:
@@ -535,26 +870,33 @@ uint32_t Listener::ListenToAnImage(char *buf) {
         // bytes fnum, previous 1*2 bytes data  + 640*2 bytes data !!
         case GOTTHARD:
             if (!pnum)
-                memcpy(buf + fifohsize + (pnum * dsize),
-                       &listeningPacket[hsize + 4], dsize - 2);
+                memcpy(buf + fifohsize + (pnum * dsize), &packet[hsize + 4],
+                       dsize - 2);
             else
-                memcpy(buf + fifohsize + (pnum * dsize) - 2,
-                       &listeningPacket[hsize], dsize + 2);
+                memcpy(buf + fifohsize + (pnum * dsize) - 2, &packet[hsize],
+                       dsize + 2);
             break;
         case CHIPTESTBOARD:
         case MOENCH:
             if (pnum == (pperFrame - 1))
-                memcpy(buf + fifohsize + (pnum * dsize),
-                       &listeningPacket[hsize], corrected_dsize);
+                memcpy(buf + fifohsize + (pnum * dsize), &packet[hsize],
+                       corrected_dsize);
             else
-                memcpy(buf + fifohsize + (pnum * dsize),
-                       &listeningPacket[hsize], dsize);
+                memcpy(buf + fifohsize + (pnum * dsize), &packet[hsize],
+                       dsize);
             break;
         default:
-            memcpy(buf + fifohsize + (pnum * dsize), &listeningPacket[hsize],
-                   dsize);
+            if (slot == nullptr) {
+                memcpy(buf + fifohsize + (pnum * dsize), &packet[hsize],
+                       dsize);
+            }
+            // placed in the wrong slot
+            else if (pnum != expectedPnum) {
+                memcpy(buf + fifohsize + (pnum * dsize), slot, dsize);
+            }
             break;
         }
+        expectedPnum = pnum + 1;
         ++numpackets; // number of packets in this image (each time its copied
                       // to buf)
         new_header->packetsMask[(
@@ -589,6 +931,56 @@ uint32_t Listener::ListenToAnImage(char *buf) {
     return imageSize;
 }
 
+int Listener::ReceivePacket(char *&packet) {
+    // refill batch
+    if (batchPacketIndex >= numBatchPackets) {
+        numBatchPackets = 0;
+        batchPacketIndex = 0;
+        if (!udpSocketAlive) {
+            return 0;
+        }
+        // one recvfrom per packet
+        if (*udpBatchSize == 1) {
+            int rc = udpSocket->ReceiveDataOnly(&listeningPacket[0]);
+            if (rc <= 0) {
+                return rc;
+            }
+            numBatchPackets = 1;
+        } else {
+            int rc = udpSocket->ReceiveBatch(&listeningPacket[0],
+                                             *udpBatchSize);
+            if (rc <= 0) {
+                return rc;
+            }
+            numBatchPackets = rc;
+        }
+        lastPacketTime = SteadyClockNs();
+    }
+    packet = &listeningPacket[(size_t)batchPacketIndex * listeningPacketSize];
+    ++batchPacketIndex;
+    return listeningPacketSize;
+}
+
+int Listener::ReceivePacketInPlace(char *&packet, char *slot) {
+    numBatchPackets = 0;
+    batchPacketIndex = 0;
+    if (!udpSocketAlive) {
+        return 0;
+    }
+    packet = &listeningPacket[0];
+    int rc = 0;
+    if (slot == nullptr) {
+        rc = udpSocket->ReceiveDataOnly(packet);
+    } else {
+        rc = udpSocket->ReceiveScattered(
+            packet, generalData->headerSizeinPacket, slot);
+    }
+    if (rc > 0) {
+        lastPacketTime = SteadyClockNs();
+    }
+    return rc;
+}
+
 void Listener::PrintFifoStatistics() {
     LOG(logDEBUG1) << "numFramesStatistic:" << numFramesStatistic
                    << " numPacketsStatistic:" << numPacketsStatistic
@@ -608,5 +1000,7 @@ void Listener::PrintFifoStatistics() {
                << loss << " (" << lossPercent << "%)"
                << "  Used_Fifo_Max_Level:" << fifo->GetMaxLevelForFifoBound()
                << " \tFree_Slots_Min_Level:" << fifo->GetMinLevelForFifoFree()
-               << " \tCurrent_Frame#:" << currentFrameIndex;
+               << " \tCurrent_Frame#:"
+               << (frameWindow ? frameWindow->GetNextFrameNumber()
+                               : currentFrameIndex);
 }
@@ -10,12 +10,15 @@
  */
 
 #include "ThreadObject.h"
-#include "sls/UdpRxSocket.h"
+#include "sls/UdpRxBase.h"
 #include <atomic>
 #include <memory>
+#include <vector>
 
 class GeneralData;
 class Fifo;
+class FrameWindow;
+class ListenerShard;
 
 class Listener : private virtual slsDetectorDefs, public ThreadObject {
 
@@ -34,6 +37,12 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      * @param dr pointer to dynamic range
      * @param us pointer to udp socket buffer size
      * @param as pointer to actual udp socket buffer size
+     * @param ubs pointer to number of packets received per udp batch
+     * @param uzc pointer to udp zero copy enable
+     * @param ub pointer to udp capture backend
+     * @param uth pointer to number of threads receiving from the udp port
+     * @param fw pointer to number of frames assembled at the same time
+     * @param ft pointer to frame timeout in us, 0 disables
      * @param fpf pointer to frames per file
      * @param fdp frame discard policy
      * @param act pointer to activated
@@ -42,8 +51,9 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      */
     Listener(int ind, detectorType dtype, Fifo *f, std::atomic<runStatus> *s,
              uint32_t *portno, std::string *e, uint64_t *nf, int *us, int *as,
-             uint32_t *fpf, frameDiscardPolicy *fdp, bool *act, bool *depaden,
-             bool *sm);
+             uint32_t *ubs, bool *uzc, udpBackend *ub, uint32_t *uth,
+             uint32_t *fw, int *ft, uint32_t *fpf, frameDiscardPolicy *fdp,
+             bool *act, bool *depaden, bool *sm);
 
     /**
      * Destructor
@@ -63,6 +73,10 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      */
     uint64_t GetLastFrameIndexCaught() const;
 
+    /** Steady clock time in ns of the last packet received (or of the
+     * start of acquisition) */
+    int64_t GetLastPacketTime() const;
+
     /** Get  number of missing packets */
     uint64_t GetNumMissingPacket(bool stoppedFlag, uint64_t numPackets) const;
 
@@ -108,7 +122,26 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      */
     void SetHardCodedPosition(uint16_t r, uint16_t c);
 
+    /**
+     * Set cpu affinity and scheduling of the listener thread and its shard
+     * threads. If the affinity lists a cpu per receiving thread, each is
+     * pinned to its own cpu
+     */
+    void SetThreadAffinity(const rxThreadAffinity &a) override;
+
+    /**
+     * Receive a batch of packets from the socket of the shard into the
+     * frame window (frame window or multiple udp threads only)
+     * @param shard shard index, 0 for the listener thread
+     * @returns false once the udp socket is shut down
+     */
+    bool ReceiveShard(int shard);
+
   private:
+    /** Flushes the frame window if no packet arrived on any receiving thread
+     * for the frame timeout */
+    void FlushOnFrameTimeout();
+
     /**
      * Record First Acquisition Index
      * @param fnum frame index to record
@@ -122,6 +155,27 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      */
     void ThreadExecution() override;
 
+    /**
+     * Thread Execution with a frame window, starts the shard threads if any,
+     * receives packets like them and at the end of acquisition waits for
+     * them, flushes the frame window & pushes the dummy buffer
+     */
+    void ThreadExecutionSharded();
+
+    /** Creates the udp socket of the backend (one udp thread) */
+    void CreateSocket(udpBackend backend, uint32_t packetSize);
+
+    /** Creates the sockets & threads for the shards */
+    void CreateShards(uint32_t numThreads, uint32_t packetSize);
+
+    /** Creates the frame window and batch buffers of the receiving threads,
+     * none if window size is 1 */
+    void CreateFrameWindow(uint32_t numThreads, uint32_t windowSize,
+                           uint32_t packetSize);
+
+    /** Sets affinity of listener and shard threads from threadAffinity */
+    void SetShardAffinities();
+
     /**
      * Pushes non empty buffers into fifo/ frees empty buffer,
      * pushes dummy buffer into fifo
@@ -139,6 +193,24 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
      */
     uint32_t ListenToAnImage(char *buf);
 
+    /**
+     * Get the next packet from the udp batch buffer, refilling the batch
+     * from the udp socket once all its packets have been consumed
+     * @param packet pointer to the packet in the batch buffer
+     * @returns number of bytes of the packet or <= 0 at end of acquisition
+     */
+    int ReceivePacket(char *&packet);
+
+    /**
+     * Receive the next packet, with its header in the listening buffer and
+     * its data directly in the given slot of the fifo buffer
+     * @param packet pointer to the packet header in the listening buffer
+     * @param slot place for the packet data, if nullptr whole packet is
+     * received in the listening buffer
+     * @returns number of bytes of the packet or <= 0 at end of acquisition
+     */
+    int ReceivePacketInPlace(char *&packet, char *slot);
+
     /**
      * Print Fifo Statistics
      */
@@ -161,7 +233,7 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
     std::atomic<runStatus> *status;
 
     /** UDP Socket - Detector to Receiver */
-    std::unique_ptr<sls::UdpRxSocket> udpSocket{nullptr};
+    std::unique_ptr<sls::UdpRxBase> udpSocket{nullptr};
 
     /** UDP Port Number */
     uint32_t *udpPortNumber;
@@ -178,6 +250,25 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
     /** actual UDP Socket Buffer Size (double due to kernel bookkeeping) */
     int *actualUDPSocketBufferSize;
 
+    /** Number of packets received per udp batch (1 for one recvfrom per
+     * packet) */
+    uint32_t *udpBatchSize;
+
+    /** Receive packet data directly into the fifo buffer */
+    bool *udpZeroCopy;
+
+    /** udp capture backend */
+    udpBackend *udpCaptureBackend;
+
+    /** Number of threads receiving from the udp port */
+    uint32_t *udpThreads;
+
+    /** Number of frames assembled at the same time */
+    uint32_t *frameWindowSize;
+
+    /** Time without packets in us, after which partial frames are pushed */
+    int *frameTimeout;
+
     /** frames per file */
     uint32_t *framesPerFile;
 
@@ -228,16 +319,51 @@ class Listener : private virtual slsDetectorDefs, public ThreadObject {
     /** Carry over packet buffer */
     std::unique_ptr<char[]> carryOverPacket;
 
-    /** Listening buffer for one packet - might be removed when we can peek and
-     * eiger fnum is in header */
+    /** Listening buffer for a batch of packets - might be removed when we can
+     * peek and eiger fnum is in header */
     std::unique_ptr<char[]> listeningPacket;
 
+    /** size of each packet slot in the listening buffer */
+    uint32_t listeningPacketSize{0};
+
+    /** Number of packets in the listening buffer from the last batch */
+    uint32_t numBatchPackets{0};
+
+    /** Index of the next packet to be used in the listening buffer */
+    uint32_t batchPacketIndex{0};
+
     /** if the udp socket is connected */
     std::atomic<bool> udpSocketAlive{false};
 
+    /** Steady clock time in ns of the last packet of any receiving thread */
+    std::atomic<int64_t> lastPacketTime{0};
+
+    // multiple udp threads
+    /** Sockets of shards 1 onwards, bound to the same port as udpSocket */
+    std::vector<std::unique_ptr<sls::UdpRxBase>> shardSockets;
+
+    /** Batch buffer of each shard */
+    std::vector<std::unique_ptr<char[]>> shardPackets;
+
+    /** Threads of shards 1 onwards */
+    std::vector<std::unique_ptr<ListenerShard>> shards;
+
+    /** Frames being assembled by all shards, nullptr for a frame window of
+     * 1 frame */
+    std::unique_ptr<FrameWindow> frameWindow;
+
+    /** If shard threads have been started for this acquisition */
+    bool shardsStarted{false};
+
+    /** Frames pushed by the window at the last statistic */
+    uint64_t numFramesPushedStatistic{0};
+
+    /** cpu affinity and scheduling of the listener */
+    rxThreadAffinity threadAffinity{LISTENER_THREAD, 0};
+
     // for print progress during acquisition
     /** number of packets for statistic */
-    uint32_t numPacketsStatistic{0};
+    std::atomic<uint32_t> numPacketsStatistic{0};
 
     /** number of images for statistic */
     uint32_t numFramesStatistic{0};
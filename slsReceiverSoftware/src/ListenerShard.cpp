@@ -0,0 +1,24 @@
+/************************************************
+ * @file ListenerShard.cpp
+ * @short creates an additional thread receiving
+ * packets of the udp port of a listener, sharing
+ * its socket port and frame window
+ ***********************************************/
+
+#include "ListenerShard.h"
+#include "Listener.h"
+
+const std::string ListenerShard::TypeName = "ListenerShard";
+
+ListenerShard::ListenerShard(int ind, int sh, Listener *l)
+    : ThreadObject(ind, TypeName), shard(sh), listener(l) {
+    LOG(logDEBUG) << "Listener " << ind << " shard " << sh << " created";
+}
+
+ListenerShard::~ListenerShard() = default;
+
+void ListenerShard::ThreadExecution() {
+    if (!listener->ReceiveShard(shard)) {
+        StopRunning();
+    }
+}
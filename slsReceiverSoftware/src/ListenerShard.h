@@ -0,0 +1,43 @@
+#pragma once
+/************************************************
+ * @file ListenerShard.h
+ * @short creates an additional thread receiving
+ * packets of the udp port of a listener, sharing
+ * its socket port and frame window
+ ***********************************************/
+/**
+ *@short additional udp receiving thread of a listener
+ */
+
+#include "ThreadObject.h"
+
+class Listener;
+
+class ListenerShard : public ThreadObject {
+
+  public:
+    /**
+     * Constructor
+     * @param ind index of the listener
+     * @param sh shard index (> 0, shard 0 is the listener thread)
+     * @param l listener owning the socket and frame window
+     */
+    ListenerShard(int ind, int sh, Listener *l);
+
+    ~ListenerShard();
+
+  private:
+    /**
+     * Thread Execution for ListenerShard Class
+     * Receives packets into the frame window till the end of acquisition
+     */
+    void ThreadExecution() override;
+
+    /** type of thread */
+    static const std::string TypeName;
+
+    /** shard index */
+    const int shard;
+
+    Listener *listener;
+};
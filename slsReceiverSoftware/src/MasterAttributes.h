@@ -58,6 +58,9 @@ struct MasterAttributes {
     ns gateDelay3{0};
     uint32_t gates;
     std::map<std::string, std::string> additionalJsonHeader;
+    slsDetectorDefs::fileCompression compression{
+        slsDetectorDefs::NO_COMPRESSION};
+    slsDetectorDefs::fileFormat fileFormat{slsDetectorDefs::BINARY};
 
     MasterAttributes(){};
     virtual ~MasterAttributes(){};
@@ -96,6 +99,18 @@ struct MasterAttributes {
                 << sls::ToString(additionalJsonHeader) << '\n';
             message += oss.str();
         }
+        if (fileFormat == slsDetectorDefs::INDEXED) {
+            std::ostringstream oss;
+            oss << "File Format                : "
+                << sls::ToString(fileFormat) << '\n';
+            message += oss.str();
+        }
+        if (compression != slsDetectorDefs::NO_COMPRESSION) {
+            std::ostringstream oss;
+            oss << "File Compression           : "
+                << sls::ToString(compression) << '\n';
+            message += oss.str();
+        }
 
         // adding sls_receiver header format
         message += std::string("\n#Frame Header\n"
@@ -113,6 +128,9 @@ struct MasterAttributes {
                                "Detector Type              : 1 byte\n"
                                "Header Version             : 1 byte\n"
                                "Packets Caught Mask        : 64 bytes\n");
+        if (compression != slsDetectorDefs::NO_COMPRESSION) {
+            message += std::string("Compressed Image Size      : 8 bytes\n");
+        }
 
         // writing to file
         if (fwrite((void *)message.c_str(), 1, message.length(), fd) !=
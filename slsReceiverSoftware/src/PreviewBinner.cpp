@@ -0,0 +1,179 @@
+/************************************************
+ * @file PreviewBinner.cpp
+ * @short bins images for the preview stream,
+ * summing or max pooling blocks of pixels
+ ***********************************************/
+
+#include "PreviewBinner.h"
+
+#include <algorithm>
+
+namespace {
+
+// row kernels: branch free loops over contiguous pixels that do not alias,
+// vectorized by the compiler for each pixel size
+
+template <typename T, typename A>
+void SumRow(const T *__restrict in, A *__restrict values, uint32_t n,
+            T valueMask) {
+    for (uint32_t i = 0; i != n; ++i) {
+        values[i] += static_cast<A>(in[i] & valueMask);
+    }
+}
+
+template <typename T, typename A>
+void MaxRow(const T *__restrict in, A *__restrict values, uint32_t n,
+            T valueMask) {
+    for (uint32_t i = 0; i != n; ++i) {
+        A v = static_cast<A>(in[i] & valueMask);
+        values[i] = (v > values[i] ? v : values[i]);
+    }
+}
+
+template <typename T>
+void OrRow(const T *__restrict in, T *__restrict gain, uint32_t n,
+           T gainMask) {
+    for (uint32_t i = 0; i != n; ++i) {
+        gain[i] |= static_cast<T>(in[i] & gainMask);
+    }
+}
+
+} // namespace
+
+const char *PreviewBinner::Bin(const char *data, uint32_t size, uint32_t nx,
+                               uint32_t ny, uint32_t dr, uint32_t factor,
+                               previewMode mode, uint32_t gainMask) {
+    if (factor == 0 || nx == 0 || ny == 0 ||
+        (uint64_t)nx * ny * dr != (uint64_t)size * 8) {
+        return nullptr;
+    }
+    numPixelsX = (nx + factor - 1) / factor;
+    numPixelsY = (ny + factor - 1) / factor;
+    dynamicRange = GetBinnedDynamicRange(dr, mode);
+    binnedGainMask = 0;
+    output.resize(GetSize());
+
+    switch (dr) {
+    case 4:
+        unpacked.resize((size_t)nx * ny);
+        for (uint32_t i = 0; i != size; ++i) {
+            auto byte = static_cast<uint8_t>(data[i]);
+            unpacked[2 * i] = (byte >> 4);
+            unpacked[2 * i + 1] = (byte & 0xf);
+        }
+        if (mode == PREVIEW_MAX) {
+            BinImage<uint8_t, uint8_t, uint8_t>(unpacked.data(), nx, ny,
+                                                factor, mode, 0);
+        } else {
+            BinImage<uint8_t, uint32_t, uint32_t>(unpacked.data(), nx, ny,
+                                                  factor, mode, 0);
+        }
+        break;
+    case 8: {
+        auto in = reinterpret_cast<const uint8_t *>(data);
+        auto mask = static_cast<uint8_t>(gainMask);
+        if (mode == PREVIEW_MAX) {
+            BinImage<uint8_t, uint8_t, uint8_t>(in, nx, ny, factor, mode,
+                                                mask);
+        } else {
+            BinImage<uint8_t, uint32_t, uint32_t>(in, nx, ny, factor, mode,
+                                                  mask);
+        }
+    } break;
+    case 16: {
+        auto in = reinterpret_cast<const uint16_t *>(data);
+        auto mask = static_cast<uint16_t>(gainMask);
+        if (mode == PREVIEW_MAX) {
+            BinImage<uint16_t, uint16_t, uint16_t>(in, nx, ny, factor, mode,
+                                                   mask);
+        } else {
+            BinImage<uint16_t, uint32_t, uint32_t>(in, nx, ny, factor, mode,
+                                                   mask);
+        }
+    } break;
+    case 32: {
+        auto in = reinterpret_cast<const uint32_t *>(data);
+        if (mode == PREVIEW_MAX) {
+            BinImage<uint32_t, uint32_t, uint32_t>(in, nx, ny, factor, mode,
+                                                   gainMask);
+        } else {
+            // sums saturate
+            BinImage<uint32_t, uint64_t, uint32_t>(in, nx, ny, factor, mode,
+                                                   gainMask);
+        }
+    } break;
+    default:
+        return nullptr;
+    }
+    return output.data();
+}
+
+template <typename T, typename A, typename O>
+void PreviewBinner::BinImage(const T *in, uint32_t nx, uint32_t ny,
+                             uint32_t factor, previewMode mode, T gainMask) {
+    const auto valueMask = static_cast<T>(~gainMask);
+    // gain bits at the top of a binned pixel, the value below
+    const int gainShift = 8 * (sizeof(O) - sizeof(T));
+    const auto gainBits = static_cast<O>(static_cast<O>(gainMask) << gainShift);
+    const auto maxValue = static_cast<O>(~gainBits);
+    binnedGainMask = gainBits;
+
+    // rows of a block reduced into values (and gain bits) per column
+    std::vector<A> values(nx);
+    std::vector<T> gain(nx);
+    auto out = reinterpret_cast<O *>(output.data());
+
+    for (uint32_t oy = 0; oy != numPixelsY; ++oy) {
+        std::fill(values.begin(), values.end(), 0);
+        std::fill(gain.begin(), gain.end(), 0);
+        const uint32_t yEnd = std::min(ny, (oy + 1) * factor);
+        for (uint32_t y = oy * factor; y != yEnd; ++y) {
+            const T *row = in + (size_t)y * nx;
+            if (mode == PREVIEW_MAX) {
+                MaxRow(row, values.data(), nx, valueMask);
+            } else {
+                SumRow(row, values.data(), nx, valueMask);
+            }
+            if (gainMask != 0) {
+                OrRow(row, gain.data(), nx, gainMask);
+            }
+        }
+
+        // columns of a block
+        for (uint32_t ox = 0; ox != numPixelsX; ++ox) {
+            const uint32_t xEnd = std::min(nx, (ox + 1) * factor);
+            A v = 0;
+            T g = 0;
+            for (uint32_t x = ox * factor; x != xEnd; ++x) {
+                if (mode == PREVIEW_MAX) {
+                    v = std::max(v, values[x]);
+                } else {
+                    v += values[x];
+                }
+                g |= gain[x];
+            }
+            auto binned = static_cast<O>(std::min<A>(v, maxValue));
+            out[(size_t)oy * numPixelsX + ox] =
+                binned | static_cast<O>(static_cast<O>(g) << gainShift);
+        }
+    }
+}
+
+uint32_t PreviewBinner::GetNumPixelsX() const { return numPixelsX; }
+
+uint32_t PreviewBinner::GetNumPixelsY() const { return numPixelsY; }
+
+uint32_t PreviewBinner::GetDynamicRange() const { return dynamicRange; }
+
+uint32_t PreviewBinner::GetSize() const {
+    return numPixelsX * numPixelsY * (dynamicRange / 8);
+}
+
+uint32_t PreviewBinner::GetGainMask() const { return binnedGainMask; }
+
+uint32_t PreviewBinner::GetBinnedDynamicRange(uint32_t dr, previewMode mode) {
+    if (mode == PREVIEW_MAX) {
+        return std::max(dr, 8u);
+    }
+    return 32;
+}
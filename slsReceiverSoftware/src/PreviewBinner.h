@@ -0,0 +1,80 @@
+#pragma once
+/************************************************
+ * @file PreviewBinner.h
+ * @short bins images for the preview stream,
+ * summing or max pooling blocks of pixels
+ ***********************************************/
+/**
+ *@short bins images into blocks of pixels for the preview stream
+ */
+
+#include "sls/sls_detector_defs.h"
+
+#include <cstdint>
+#include <vector>
+
+class PreviewBinner : private virtual slsDetectorDefs {
+
+  public:
+    /**
+     * Bins an image into blocks of factor x factor pixels. The blocks at the
+     * right and bottom edges are smaller if the image size is not a multiple
+     * of the factor
+     * @param data image, nx x ny pixels row by row (4 bit: 2 pixels per byte,
+     * high nibble first)
+     * @param size size of image in bytes
+     * @param nx number of pixels in x
+     * @param ny number of pixels in y
+     * @param dr dynamic range of the image (4, 8, 16 or 32)
+     * @param factor binning factor
+     * @param mode PREVIEW_BIN sums a block, PREVIEW_MAX takes its maximum
+     * @param gainMask bits of a pixel not part of its value (jungfrau gain
+     * bits). They are or-ed over a block into the top bits of the binned pixel
+     * @returns binned image, valid till the next call, nullptr if size does
+     * not match the image
+     */
+    const char *Bin(const char *data, uint32_t size, uint32_t nx, uint32_t ny,
+                    uint32_t dr, uint32_t factor, previewMode mode,
+                    uint32_t gainMask = 0);
+
+    /** number of pixels in x of the binned image */
+    uint32_t GetNumPixelsX() const;
+
+    /** number of pixels in y of the binned image */
+    uint32_t GetNumPixelsY() const;
+
+    /** dynamic range of the binned image */
+    uint32_t GetDynamicRange() const;
+
+    /** size of the binned image in bytes */
+    uint32_t GetSize() const;
+
+    /** gain bits in a pixel of the binned image */
+    uint32_t GetGainMask() const;
+
+    /**
+     * Dynamic range of a binned image: 32 bit for sums, else that of the
+     * image (8 bit for 4 bit images)
+     */
+    static uint32_t GetBinnedDynamicRange(uint32_t dr, previewMode mode);
+
+  private:
+    /**
+     * Bins an image of T pixels into O pixels, reducing the rows of a block
+     * into A values before the columns
+     */
+    template <typename T, typename A, typename O>
+    void BinImage(const T *in, uint32_t nx, uint32_t ny, uint32_t factor,
+                  previewMode mode, T gainMask);
+
+    uint32_t numPixelsX{0};
+    uint32_t numPixelsY{0};
+    uint32_t dynamicRange{0};
+    uint32_t binnedGainMask{0};
+
+    /** 4 bit image unpacked to a byte per pixel */
+    std::vector<uint8_t> unpacked;
+
+    /** binned image */
+    std::vector<char> output;
+};
@@ -0,0 +1,65 @@
+/************************************************
+ * @file StreamBudget.cpp
+ * @short token bucket keeping the zmq stream within a bandwidth budget,
+ * backing off while the stream is congested
+ ***********************************************/
+
+#include "StreamBudget.h"
+
+#include <algorithm>
+
+namespace {
+/** burst allowed, as time at the current rate */
+constexpr double BURST_TIME_IN_S = 0.1;
+/** interval at which the rate is halved or recovered */
+constexpr auto ADAPT_INTERVAL = std::chrono::milliseconds(100);
+constexpr double MIN_RATE_FRACTION = 1.0 / 64;
+constexpr double RATE_FRACTION_STEP = 1.0 / 16;
+} // namespace
+
+void StreamBudget::Reset(uint32_t mbps, Clock::time_point now) {
+    bytesPerSecond = mbps * 1e6;
+    rateFraction = 1;
+    tokens = bytesPerSecond * BURST_TIME_IN_S;
+    congestedSinceAdapt = false;
+    lastRefill = now;
+    lastAdapt = now;
+}
+
+bool StreamBudget::Take(uint64_t size, bool congested, Clock::time_point now) {
+    if (bytesPerSecond == 0) {
+        return true;
+    }
+    Adapt(congested, now);
+
+    // refill, burst of at least one image
+    double rate = bytesPerSecond * rateFraction;
+    double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    lastRefill = now;
+    double capacity = std::max(rate * BURST_TIME_IN_S, (double)size);
+    tokens = std::min(capacity, tokens + rate * elapsed);
+
+    if (tokens < size) {
+        return false;
+    }
+    tokens -= size;
+    return true;
+}
+
+void StreamBudget::Adapt(bool congested, Clock::time_point now) {
+    congestedSinceAdapt = congestedSinceAdapt || congested;
+    if (now - lastAdapt < ADAPT_INTERVAL) {
+        return;
+    }
+    if (congestedSinceAdapt) {
+        rateFraction = std::max(MIN_RATE_FRACTION, rateFraction / 2);
+    } else {
+        rateFraction = std::min(1.0, rateFraction + RATE_FRACTION_STEP);
+    }
+    congestedSinceAdapt = false;
+    lastAdapt = now;
+}
+
+double StreamBudget::GetBudget() const { return bytesPerSecond; }
+
+double StreamBudget::GetRateFraction() const { return rateFraction; }
@@ -0,0 +1,68 @@
+#pragma once
+/************************************************
+ * @file StreamBudget.h
+ * @short token bucket keeping the zmq stream within a bandwidth budget,
+ * backing off while the stream is congested
+ ***********************************************/
+/**
+ *@short decides which images fit into the bandwidth budget of the stream
+ */
+
+#include <chrono>
+#include <cstdint>
+
+class StreamBudget {
+
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Sets the budget, refills the bucket and restores the full rate (start
+     * of an acquisition)
+     * @param mbps bandwidth budget in MB/s, 0 for unlimited
+     * @param now current time
+     */
+    void Reset(uint32_t mbps, Clock::time_point now = Clock::now());
+
+    /**
+     * Takes the tokens of an image if it fits into the budget. The bucket
+     * holds a burst of 100 ms of the rate, but at least one image.
+     * Congestion halves the rate (at most every 100 ms, down to 1/64 of the
+     * budget), which then recovers by 1/16 of the budget every 100 ms
+     * @param size image size in bytes
+     * @param congested true if the stream is falling behind
+     * @param now current time
+     * @returns true if the image is to be streamed, else skipped
+     */
+    bool Take(uint64_t size, bool congested,
+              Clock::time_point now = Clock::now());
+
+    /** bandwidth budget in bytes per second, 0 for unlimited */
+    double GetBudget() const;
+
+    /** fraction of the budget currently allowed (less than 1 if backed off) */
+    double GetRateFraction() const;
+
+  private:
+    /**
+     * Halves or recovers the rate once every adapt interval
+     * @param congested true if the stream is falling behind
+     * @param now current time
+     */
+    void Adapt(bool congested, Clock::time_point now);
+
+    /** budget in bytes per second, 0 for unlimited */
+    double bytesPerSecond{0};
+
+    /** fraction of the budget allowed */
+    double rateFraction{1};
+
+    /** bytes that can be streamed right away */
+    double tokens{0};
+
+    /** congested since the rate was last adapted */
+    bool congestedSinceAdapt{false};
+
+    Clock::time_point lastRefill;
+    Clock::time_point lastAdapt;
+};
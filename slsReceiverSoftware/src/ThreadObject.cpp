@@ -4,8 +4,11 @@
  ***********************************************/
 
 #include "ThreadObject.h"
+#include "sls/ToString.h"
 #include "sls/container_utils.h"
 #include <iostream>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <unistd.h>
 
@@ -34,7 +37,18 @@ bool ThreadObject::IsRunning() const { return runningFlag; }
 
 void ThreadObject::StartRunning() { runningFlag = true; }
 
-void ThreadObject::StopRunning() { runningFlag = false; }
+void ThreadObject::StopRunning() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        runningFlag = false;
+    }
+    stopCondition.notify_all();
+}
+
+void ThreadObject::WaitForStop() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    stopCondition.wait(lock, [this] { return !runningFlag; });
+}
 
 void ThreadObject::RunningThread() {
     threadId = syscall(SYS_gettid);
@@ -54,17 +68,38 @@ void ThreadObject::RunningThread() {
 
 void ThreadObject::Continue() { sem_post(&semaphore); }
 
-void ThreadObject::SetThreadPriority(int priority) {
-    struct sched_param param;
-    param.sched_priority = priority;
-    if (pthread_setschedparam(threadObject.native_handle(), SCHED_FIFO,
-                              &param) == EPERM) {
-        if (index == 0) {
-            LOG(logWARNING) << "Could not prioritize " << type
-                            << " thread. "
-                               "(No Root Privileges?)";
+void ThreadObject::SetThreadAffinity(const rxThreadAffinity &a) {
+    SetThreadAffinity(threadObject.native_handle(), type, a);
+}
+
+void ThreadObject::SetThreadAffinity(pthread_t thread, const std::string &type,
+                                     const rxThreadAffinity &a) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (a.anyCpu()) {
+        // cpus of the process, to respect an external taskset
+        sched_getaffinity(getpid(), sizeof(cpus), &cpus);
+    } else {
+        for (int i = 0; i < MAX_RX_CPUS && i < CPU_SETSIZE; ++i) {
+            if (a.hasCpu(i)) {
+                CPU_SET(i, &cpus);
+            }
         }
+    }
+    if (pthread_setaffinity_np(thread, sizeof(cpus), &cpus) != 0) {
+        LOG(logWARNING) << "Could not set cpu affinity of " << type
+                        << " thread " << a.index << " to "
+                        << sls::ToString(a);
+    }
+
+    struct sched_param param {};
+    param.sched_priority = a.priority;
+    int policy = (a.policy == RX_SCHED_FIFO ? SCHED_FIFO : SCHED_OTHER);
+    if (pthread_setschedparam(thread, policy, &param) != 0) {
+        LOG(logWARNING) << "Could not set scheduling of " << type << " thread "
+                        << a.index << ". (No Root Privileges?)";
     } else {
-        LOG(logINFO) << "Priorities set - " << type << ": " << priority;
+        LOG(logINFO) << "Thread affinity set - " << type << ": "
+                     << sls::ToString(a);
     }
 }
@@ -11,6 +11,8 @@
 #include "sls/sls_detector_defs.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <semaphore.h>
 #include <string>
 #include <thread>
@@ -22,6 +24,9 @@ class ThreadObject : private virtual slsDetectorDefs {
   private:
     std::atomic<bool> killThread{false};
     std::atomic<bool> runningFlag{false};
+    /** signalled by StopRunning */
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;
     std::thread threadObject;
     sem_t semaphore;
     const std::string type;
@@ -34,8 +39,14 @@ class ThreadObject : private virtual slsDetectorDefs {
     bool IsRunning() const;
     void StartRunning();
     void StopRunning();
+    /** Blocks until StopRunning is reached */
+    void WaitForStop();
     void Continue();
-    void SetThreadPriority(int priority);
+    virtual void SetThreadAffinity(const rxThreadAffinity &a);
+    /** Sets cpu affinity and scheduling policy of any thread, eg. the tcp
+     * thread */
+    static void SetThreadAffinity(pthread_t thread, const std::string &type,
+                                  const rxThreadAffinity &a);
 
   private:
     virtual void ThreadExecution() = 0;
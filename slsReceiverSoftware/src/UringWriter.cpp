@@ -0,0 +1,346 @@
+/************************************************
+ * @file UringWriter.cpp
+ * @short writes a file asynchronously with io_uring,
+ * straight from the (registered) fifo buffers
+ ***********************************************/
+
+#include "UringWriter.h"
+#include "sls/logger.h"
+#include "sls/sls_detector_exceptions.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+// maximum size of a registered buffer
+constexpr size_t MAX_FIXED_BUFFER_SIZE = 1024 * 1024 * 1024;
+
+int io_uring_setup(unsigned entries, io_uring_params *p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                   unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, unsigned opcode, const void *arg,
+                      unsigned nr_args) {
+    return static_cast<int>(
+        syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+/** false also before kernel 5.6, which has neither the probe nor the op */
+bool OpcodeSupported(int ringFd, unsigned opcode) {
+    constexpr unsigned numOps = 256;
+    std::vector<char> buffer(sizeof(io_uring_probe) +
+                             numOps * sizeof(io_uring_probe_op));
+    auto *probe = reinterpret_cast<io_uring_probe *>(buffer.data());
+    if (io_uring_register(ringFd, IORING_REGISTER_PROBE, probe, numOps) != 0) {
+        return false;
+    }
+    return (opcode <= probe->last_op && opcode < probe->ops_len &&
+            (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0);
+}
+
+unsigned *RingField(void *ring, uint32_t offset) {
+    return reinterpret_cast<unsigned *>(static_cast<char *>(ring) + offset);
+}
+} // namespace
+
+UringWriter::UringWriter(unsigned depth) : queueDepth(depth), slots(depth) {
+    io_uring_params p{};
+    ringFd = io_uring_setup(queueDepth, &p);
+    if (ringFd < 0) {
+        throw sls::RuntimeError(std::string("io_uring not available (") +
+                                strerror(errno) + ")");
+    }
+    // older kernels fail every write with EINVAL
+    if (!OpcodeSupported(ringFd, IORING_OP_WRITE)) {
+        close(ringFd);
+        throw sls::RuntimeError(
+            "io_uring write not supported by the kernel (needs 5.6)");
+    }
+    queueDepth = std::min(queueDepth, p.sq_entries);
+    sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        close(ringFd);
+        throw sls::RuntimeError("Could not map io_uring submission queue");
+    }
+    if (single) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    }
+    sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    void *s = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (cqRing == MAP_FAILED || s == MAP_FAILED) {
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        if (s != MAP_FAILED)
+            munmap(s, sqesSize);
+        munmap(sqRing, sqRingSize);
+        close(ringFd);
+        throw sls::RuntimeError("Could not map io_uring queues");
+    }
+    sqes = static_cast<io_uring_sqe *>(s);
+    sqTail = RingField(sqRing, p.sq_off.tail);
+    sqMask = RingField(sqRing, p.sq_off.ring_mask);
+    sqArray = RingField(sqRing, p.sq_off.array);
+    cqHead = RingField(cqRing, p.cq_off.head);
+    cqTail = RingField(cqRing, p.cq_off.tail);
+    cqMask = RingField(cqRing, p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(static_cast<char *>(cqRing) +
+                                            p.cq_off.cqes);
+}
+
+UringWriter::~UringWriter() {
+    Close();
+    munmap(sqes, sqesSize);
+    if (cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    munmap(sqRing, sqRingSize);
+    // also unregisters the buffers
+    close(ringFd);
+}
+
+bool UringWriter::RegisterBuffers(char *memory, size_t size) {
+    if (memory == registeredMemory && size == registeredSize) {
+        return (registeredMemory != nullptr);
+    }
+    // failed before (eg. RLIMIT_MEMLOCK), not retried for every file
+    if (memory == failedMemory && size == failedSize) {
+        return false;
+    }
+    if (fd >= 0) {
+        return false;
+    }
+    if (registeredMemory != nullptr) {
+        io_uring_register(ringFd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        registeredMemory = nullptr;
+        registeredSize = 0;
+    }
+    std::vector<iovec> iovs;
+    for (size_t i = 0; i < size; i += MAX_FIXED_BUFFER_SIZE) {
+        size_t len = std::min(MAX_FIXED_BUFFER_SIZE, size - i);
+        iovs.push_back({memory + i, len});
+    }
+    if (iovs.empty() || io_uring_register(ringFd, IORING_REGISTER_BUFFERS,
+                                          iovs.data(), iovs.size()) != 0) {
+        LOG(logWARNING) << "Could not register fifo memory for io_uring ("
+                        << strerror(errno)
+                        << "), writing without fixed buffers";
+        failedMemory = memory;
+        failedSize = size;
+        return false;
+    }
+    registeredMemory = memory;
+    registeredSize = size;
+    return true;
+}
+
+void UringWriter::Open(const std::string &fname, bool overwrite) {
+    Close();
+    int flags = O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_EXCL);
+    fd = open(fname.c_str(), flags, 0664);
+    if (fd < 0) {
+        throw sls::RuntimeError("Could not create file " + fname + " (" +
+                                strerror(errno) + ")");
+    }
+    fileName = fname;
+    offset = 0;
+    preallocated = 0;
+    writeError = false;
+}
+
+void UringWriter::Preallocate(size_t size) {
+    if (fd < 0 || size <= preallocated) {
+        return;
+    }
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, size) == 0) {
+        preallocated = size;
+    } else {
+        LOG(logDEBUG1) << "Could not preallocate " << fileName << " ("
+                       << strerror(errno) << ")";
+    }
+}
+
+void UringWriter::Close() {
+    if (fd < 0) {
+        return;
+    }
+    GetCompleted(completed, true);
+    // release the preallocated space not written
+    if (preallocated > offset) {
+        fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset,
+                  preallocated - offset);
+    }
+    if (close(fd) != 0) {
+        writeError = true;
+    }
+    fd = -1;
+    if (writeError) {
+        LOG(logERROR) << "Could not write all data to file " << fileName;
+    }
+}
+
+bool UringWriter::IsOpen() const { return (fd >= 0); }
+
+bool UringWriter::HasPending() const {
+    return (headSeq != nextSeq || !completed.empty());
+}
+
+void UringWriter::Write(char *buf, size_t size) {
+    if (writeError) {
+        throw sls::RuntimeError("Could not write to file " + fileName);
+    }
+    if (fd < 0) {
+        throw sls::RuntimeError("No file open to write to");
+    }
+    // wait for the oldest write to free a slot
+    while (nextSeq - headSeq == queueDepth) {
+        Enter(1);
+        Reap();
+    }
+
+    Slot &slot = slots[nextSeq % queueDepth];
+    slot.buffer = buf;
+    slot.size = size;
+    slot.offset = offset;
+    slot.written = 0;
+    slot.done = false;
+    Queue(nextSeq, buf, size, offset);
+    ++nextSeq;
+    offset += size;
+    if (toSubmit >= URING_SUBMIT_BATCH) {
+        Enter(0);
+    }
+}
+
+void UringWriter::Queue(uint64_t seq, char *buf, size_t size,
+                        uint64_t fileOffset) {
+    unsigned tail = *sqTail;
+    unsigned index = tail & *sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE;
+    if (registeredMemory != nullptr && buf >= registeredMemory &&
+        buf + size <= registeredMemory + registeredSize) {
+        size_t start = buf - registeredMemory;
+        // within one fixed buffer
+        if (start / MAX_FIXED_BUFFER_SIZE ==
+            (start + size - 1) / MAX_FIXED_BUFFER_SIZE) {
+            sqe->opcode = IORING_OP_WRITE_FIXED;
+            sqe->buf_index = start / MAX_FIXED_BUFFER_SIZE;
+        }
+    }
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = size;
+    sqe->off = fileOffset;
+    sqe->user_data = seq;
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++toSubmit;
+}
+
+void UringWriter::GetCompleted(std::vector<char *> &buffers, bool wait) {
+    if (toSubmit != 0) {
+        Enter(0);
+    }
+    Reap();
+    while (wait && headSeq != nextSeq) {
+        Enter(1);
+        Reap();
+    }
+    if (&buffers != &completed) {
+        buffers.insert(buffers.end(), completed.begin(), completed.end());
+        completed.clear();
+    }
+}
+
+void UringWriter::Enter(unsigned minComplete) {
+    unsigned flags = (minComplete != 0) ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        int rc = io_uring_enter(ringFd, toSubmit, minComplete, flags);
+        if (rc >= 0) {
+            toSubmit -= std::min(toSubmit, static_cast<unsigned>(rc));
+            if (toSubmit == 0 || minComplete != 0) {
+                return;
+            }
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        // completion queue full, make space
+        if (errno == EAGAIN || errno == EBUSY) {
+            Reap();
+            continue;
+        }
+        LOG(logERROR) << "io_uring submission failed for " << fileName
+                      << " (" << strerror(errno) << ")";
+        writeError = true;
+        // writes not submitted are never completed, take them back
+        unsigned tail = *sqTail;
+        for (unsigned i = tail - toSubmit; i != tail; ++i) {
+            uint64_t seq = sqes[sqArray[i & *sqMask]].user_data;
+            slots[seq % queueDepth].done = true;
+        }
+        __atomic_store_n(sqTail, tail - toSubmit, __ATOMIC_RELEASE);
+        toSubmit = 0;
+        return;
+    }
+}
+
+void UringWriter::Reap() {
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes[head & *cqMask];
+        uint64_t seq = cqe.user_data;
+        Slot &slot = slots[seq % queueDepth];
+        if (cqe.res <= 0) {
+            writeError = true;
+            slot.done = true;
+            continue;
+        }
+        slot.written += cqe.res;
+        // short write (eg. interrupted), write the rest
+        if (slot.written < slot.size && !writeError) {
+            Queue(seq, slot.buffer + slot.written, slot.size - slot.written,
+                  slot.offset + slot.written);
+            continue;
+        }
+        if (slot.written < slot.size) {
+            writeError = true;
+        }
+        slot.done = true;
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+    // release in order
+    while (headSeq != nextSeq && slots[headSeq % queueDepth].done) {
+        completed.push_back(slots[headSeq % queueDepth].buffer);
+        ++headSeq;
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+/************************************************
+ * @file UringWriter.h
+ * @short writes a file asynchronously with io_uring,
+ * straight from the (registered) fifo buffers
+ ***********************************************/
+/**
+ *@short asynchronous io_uring file writer
+ */
+
+#include "receiver_defs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+class UringWriter {
+
+  public:
+    /**
+     * Constructor
+     * Sets up the io_uring, throws if the kernel does not support it or
+     * its write operation
+     * @param depth maximum number of writes in flight
+     */
+    explicit UringWriter(unsigned depth = URING_QUEUE_DEPTH);
+
+    /**
+     * Destructor
+     * Closes the file and the io_uring
+     */
+    ~UringWriter();
+
+    UringWriter(const UringWriter &) = delete;
+    UringWriter &operator=(const UringWriter &) = delete;
+
+    /**
+     * Registers memory (eg. of the fifo) as fixed buffers, so that writes
+     * from it are not mapped for every write. Only when no file is open
+     * @param memory start of memory
+     * @param size size of memory
+     * @returns true if registered
+     */
+    bool RegisterBuffers(char *memory, size_t size);
+
+    /**
+     * Creates the file
+     * @param fname file name
+     * @param overwrite overwrite an existing file
+     */
+    void Open(const std::string &fname, bool overwrite);
+
+    /**
+     * Preallocates disk space for the file, without changing its size
+     * @param size expected size of the file
+     */
+    void Preallocate(size_t size);
+
+    /**
+     * Waits for all writes, releases unused preallocated space and closes
+     * the file. The written buffers are then in the completed list
+     */
+    void Close();
+
+    /** true if a file is open */
+    bool IsOpen() const;
+
+    /**
+     * Queues writing buf to the end of the file. buf must stay valid till
+     * it is returned by GetCompleted. Submits in batches, waits if the
+     * queue is full. Throws (before queuing) if a previous write failed
+     * @param buf data
+     * @param size size of data in bytes
+     */
+    void Write(char *buf, size_t size);
+
+    /**
+     * Submits queued writes and moves the buffers of completed writes, in
+     * the order they were queued
+     * @param buffers completed buffers are appended to it
+     * @param wait wait for all writes in flight
+     */
+    void GetCompleted(std::vector<char *> &buffers, bool wait);
+
+    /** true if writes are in flight or completed but not yet collected */
+    bool HasPending() const;
+
+  private:
+    /**
+     * Queues a write to the submission queue, to be submitted with Enter
+     * @param seq sequence number of the write
+     * @param buf data
+     * @param size size of data in bytes
+     * @param fileOffset offset in file
+     */
+    void Queue(uint64_t seq, char *buf, size_t size, uint64_t fileOffset);
+
+    /** Submits queued writes and waits for min completions */
+    void Enter(unsigned minComplete);
+
+    /** Reaps the completion queue, queues the rest of short writes */
+    void Reap();
+
+    /** in flight write */
+    struct Slot {
+        char *buffer{nullptr};
+        size_t size{0};
+        uint64_t offset{0};
+        size_t written{0};
+        bool done{false};
+    };
+
+    unsigned queueDepth;
+    int ringFd{-1};
+
+    // mapped rings
+    void *sqRing{nullptr};
+    size_t sqRingSize{0};
+    void *cqRing{nullptr};
+    size_t cqRingSize{0};
+    io_uring_sqe *sqes{nullptr};
+    size_t sqesSize{0};
+    unsigned *sqTail{nullptr};
+    unsigned *sqMask{nullptr};
+    unsigned *sqArray{nullptr};
+    unsigned *cqHead{nullptr};
+    unsigned *cqTail{nullptr};
+    unsigned *cqMask{nullptr};
+    io_uring_cqe *cqes{nullptr};
+
+    /** writes in flight, indexed by sequence number modulo depth */
+    std::vector<Slot> slots;
+
+    /** sequence number of the oldest write not yet completed */
+    uint64_t headSeq{0};
+
+    /** sequence number of the next write */
+    uint64_t nextSeq{0};
+
+    /** writes queued but not yet submitted */
+    unsigned toSubmit{0};
+
+    /** buffers of completed writes, in order */
+    std::vector<char *> completed;
+
+    /** registered fixed buffers */
+    char *registeredMemory{nullptr};
+    size_t registeredSize{0};
+
+    /** memory that could not be registered */
+    char *failedMemory{nullptr};
+    size_t failedSize{0};
+
+    int fd{-1};
+    std::string fileName;
+    uint64_t offset{0};
+    size_t preallocated{0};
+    bool writeError{false};
+};
@@ -12,6 +12,19 @@
 
 #define MAX_SOCKET_INPUT_PACKET_QUEUE (250000)
 
+// time without packets after which readout stops waiting for packets
+#define RX_QUIET_PERIOD_MS (5)
+
+// packets received per recvmmsg call (max is the kernel's UIO_MAXIOV)
+#define DEFAULT_UDP_BATCH_SIZE (32)
+#define MAX_UDP_BATCH_SIZE     (1024)
+
+// threads receiving packets of one udp port (SO_REUSEPORT)
+#define MAX_UDP_THREADS_PER_PORT (16)
+
+// frames assembled at the same time by a listener
+#define MAX_FRAME_WINDOW (1024)
+
 // files
 #define MAX_FRAMES_PER_FILE           20000
 #define SHORT_MAX_FRAMES_PER_FILE     100000
@@ -26,15 +39,86 @@
 
 // binary
 #define FILE_BUFFER_SIZE (16 * 1024 * 1024) // 16mb
+// io_uring: writes in flight and writes submitted at once
+#define URING_QUEUE_DEPTH  (64)
+#define URING_SUBMIT_BATCH (8)
+
+// compression
+// threads compressing for all ports, besides the file writer threads
+#define DEFAULT_COMPRESSION_THREADS (4)
+#define MAX_COMPRESSION_THREADS     (64)
+#define COMPRESSION_ZSTD_LEVEL      (3)
+// compressed binary file: frame records (receiver header, packed size as
+// uint64, packed image), the offsets of the records as uint64 and a trailer
+#define COMPRESSED_FILE_MAGIC   "SLSBSHUF"
+#define COMPRESSED_FILE_VERSION (1)
+struct compressed_file_trailer {
+    char magic[8];
+    uint32_t version;
+    uint32_t compression;
+    uint32_t elementSize;
+    uint32_t reserved;
+    uint64_t numFrames;
+    uint64_t indexOffset;
+};
+
+// indexed binary file: superblock (padded to a page), images each starting
+// on a page, receiver headers (contiguous bitset) in the order written and
+// a directory of the frames sorted by frame number
+#define INDEXED_FILE_MAGIC     "SLSINDEX"
+#define INDEXED_FILE_VERSION   (1)
+#define INDEXED_FILE_PAGE_SIZE (4096)
+// tables are kept in memory till the file is closed (~200 bytes per frame),
+// sub files hold at most this many frames, also with rx_framesperfile 0
+#define INDEXED_FILE_MAX_FRAMES (100000)
+struct indexed_file_superblock {
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    /** size of an entry of the header table */
+    uint32_t headerSize;
+    uint32_t dynamicRange;
+    uint32_t nPixelsX;
+    uint32_t nPixelsY;
+    /** 1 once the file is closed and its tables written */
+    uint32_t complete;
+    uint32_t reserved;
+    uint64_t numFrames;
+    uint64_t headerTableOffset;
+    uint64_t directoryOffset;
+};
+struct indexed_file_entry {
+    uint64_t frameNumber;
+    /** index in the header table */
+    uint64_t record;
+    /** offset and size of the image */
+    uint64_t offset;
+    uint64_t size;
+};
 
 // fifo
 #define FIFO_HEADER_NUMBYTES   (8)
 #define FIFO_DATASIZE_NUMBYTES (4)
 #define FIFO_PADDING_NUMBYTES                                                  \
     (4) // for 8 byte alignment due to sls_receiver_header structure
+// ms to wait for zmq to free the images streamed without a copy
+#define FIFO_IN_FLIGHT_TIMEOUT_MS (5000)
 
 // hdf5
-#define MAX_CHUNKED_IMAGES (1)
+#define DEFAULT_CHUNKED_IMAGES (1)
+// hdf5 limit of the bytes of a chunk
+#define HDF5_MAX_CHUNK_BYTES (0xFFFFFFFFULL)
+// registered id of the bitshuffle filter
+#define BITSHUFFLE_FILTER_ID (32008)
+// requests queued to a writer process
+#define HDF5_WRITER_QUEUE_DEPTH (1024)
+// writer process executable, next to the receiver executable or in PATH
+#define HDF5_WRITER_EXECUTABLE "slsHdf5Writer"
+// swmr flush to readers every so many images or ms
+#define DEFAULT_SWMR_FLUSH_FRAMES (100)
+#define DEFAULT_SWMR_FLUSH_TIME_MS (1000)
+// writers check the swmr flush time while idle for so many ms
+#define WRITER_IDLE_CHECK_MS (100)
 
 // parameters to calculate fifo depth
 #define SAMPLE_TIME_IN_NS          (100000000) // 100ms
@@ -44,6 +128,17 @@
 #define GOTTHARD_PACKET_SIZE (1286)
 
 #define DUMMY_PACKET_VALUE (0xFFFFFFFF)
+// image not to be streamed, only passed on to be freed
+#define DISCARD_PACKET_VALUE (0xFFFFFFFE)
+// in the fifo header padding of an image passed to the file writer: image
+// not to be streamed, only freed once written
+#define NOT_STREAMED_VALUE (0xFFFFFFFF)
+// in the fifo header padding of an image passed to the streamer: frame index
+// and whether it is also binned into the preview stream, or only binned into
+// the preview stream (flags exclusive, never NOT_STREAMED_VALUE)
+#define STREAM_INDEX_MASK   (0x3FFFFFFF)
+#define PREVIEW_STREAM_FLAG (0x40000000)
+#define PREVIEW_ONLY_FLAG   (0x80000000)
 
 #define LISTENER_PRIORITY  (90)
 #define PROCESSOR_PRIORITY (70)
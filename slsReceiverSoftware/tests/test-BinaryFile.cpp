@@ -0,0 +1,132 @@
+#include "BinaryFile.h"
+#include "catch.hpp"
+#include "test-File-global.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using rx_header_t = slsDetectorDefs::sls_receiver_header;
+
+TEST_CASE("Binary sub files rotate to files opened in the background",
+          "[receiver]") {
+    for (bool directIO : {false, true}) {
+        FileSettings s("sls_rotation", 10);
+        s.maxFramesPerFile = 3;
+        bool ioUring = false;
+        std::vector<std::string> fnames;
+        for (uint32_t i = 0; i != 4; ++i) {
+            fnames.push_back(s.DataFileName(i));
+        }
+
+        // acquisition stopped after 7 images, in the third file
+        constexpr uint32_t written = 7;
+        constexpr size_t size = sizeof(rx_header_t) + 100;
+        {
+            BinaryFile file(0, &s.maxFramesPerFile, s.numDet, &s.fileName,
+                            &s.filePath, &s.fileIndex, &s.overwrite,
+                            &s.detIndex, &s.numUnits, &s.numImages,
+                            &s.dynamicRange, &s.port, &s.silent, &directIO,
+                            &ioUring);
+            file.resetSubFileIndex();
+            file.CreateFile();
+            std::vector<char> buffer(size);
+            for (uint32_t i = 0; i != written; ++i) {
+                memset(buffer.data(), static_cast<char>('a' + i), size);
+                file.WriteToFile(buffer.data(), size, i, 1);
+                CHECK(file.GetCurrentFileName() ==
+                      fnames[i / s.maxFramesPerFile]);
+            }
+            file.CloseCurrentFile();
+        }
+
+        for (uint32_t k = 0; k != 3; ++k) {
+            auto data = ReadFile(fnames[k]);
+            uint32_t first = k * s.maxFramesPerFile;
+            uint32_t n = std::min(s.maxFramesPerFile, written - first);
+            REQUIRE(data.size() == n * size);
+            for (uint32_t i = 0; i != n; ++i) {
+                CHECK(data[i * size] == static_cast<char>('a' + first + i));
+                CHECK(data[i * size + size - 1] ==
+                      static_cast<char>('a' + first + i));
+            }
+            remove(fnames[k].c_str());
+        }
+        // prepared for the rest of the acquisition, removed unused
+        CHECK_FALSE(FileExists(fnames[3]));
+        remove(fnames[3].c_str());
+    }
+}
+
+TEST_CASE("Binary sub file prepared over an existing file is not removed",
+          "[receiver]") {
+    FileSettings s("sls_rotation_existing", 10);
+    s.maxFramesPerFile = 3;
+    bool directIO = false;
+    bool ioUring = false;
+    std::string fname0 = s.DataFileName(0);
+    std::string fname1 = s.DataFileName(1);
+    std::ofstream(fname1) << "from an earlier acquisition";
+
+    // stopped in the first file, the second one is already prepared
+    {
+        BinaryFile file(0, &s.maxFramesPerFile, s.numDet, &s.fileName,
+                        &s.filePath, &s.fileIndex, &s.overwrite, &s.detIndex,
+                        &s.numUnits, &s.numImages, &s.dynamicRange, &s.port,
+                        &s.silent, &directIO, &ioUring);
+        file.resetSubFileIndex();
+        file.CreateFile();
+        std::vector<char> buffer(sizeof(rx_header_t) + 100);
+        file.WriteToFile(buffer.data(), buffer.size(), 0, 1);
+        file.CloseCurrentFile();
+    }
+    CHECK(FileExists(fname1));
+    remove(fname0.c_str());
+    remove(fname1.c_str());
+}
+
+TEST_CASE("Binary file holds the receiver header followed by the data",
+          "[receiver]") {
+    FileSettings s("sls_layout", 10);
+    bool directIO = false;
+    bool ioUring = false;
+    std::string fname = s.DataFileName(0);
+
+    constexpr size_t dataSize = 100;
+    std::vector<char> buffer(sizeof(rx_header_t) + dataSize);
+    auto header = reinterpret_cast<rx_header_t *>(buffer.data());
+    *header = rx_header_t{};
+    header->detHeader.frameNumber = 7;
+    header->packetsMask.set();
+    for (size_t i = 0; i != dataSize; ++i) {
+        buffer[sizeof(rx_header_t) + i] = static_cast<char>(i);
+    }
+    {
+        BinaryFile file(0, &s.maxFramesPerFile, s.numDet, &s.fileName,
+                        &s.filePath, &s.fileIndex, &s.overwrite, &s.detIndex,
+                        &s.numUnits, &s.numImages, &s.dynamicRange, &s.port,
+                        &s.silent, &directIO, &ioUring);
+        file.resetSubFileIndex();
+        file.CreateFile();
+        file.WriteToFile(buffer.data(), buffer.size(), 7, 1);
+        file.CloseCurrentFile();
+    }
+
+    auto data = ReadFile(fname);
+    REQUIRE(data.size() == buffer.size());
+    rx_header_t written{};
+    memcpy(&written, data.data(), sizeof(rx_header_t));
+    CHECK(written.detHeader.frameNumber == 7);
+    // the bitmask is stored as bits, one per packet
+    for (size_t i = 0; i != MAX_NUM_PACKETS / 8; ++i) {
+        CHECK(static_cast<unsigned char>(
+                  data[sizeof(slsDetectorDefs::sls_detector_header) + i]) ==
+              0xFF);
+    }
+    for (size_t i = 0; i != dataSize; ++i) {
+        CHECK(data[sizeof(rx_header_t) + i] == static_cast<char>(i));
+    }
+    remove(fname.c_str());
+}
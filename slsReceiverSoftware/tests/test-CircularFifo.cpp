@@ -1,5 +1,10 @@
 #include "catch.hpp"
 #include "sls/CircularFifo.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <semaphore.h>
+#include <thread>
 #include <vector>
 
 using sls::CircularFifo;
@@ -48,4 +53,178 @@ TEST_CASE("Push pop") {
 
     CHECK(fifo.isEmpty() == true);
     CHECK(fifo.isFull() == false);
-}
\ No newline at end of file
+}
+TEST_CASE("Batched push pop") {
+    CircularFifo<int> fifo(4);
+    std::vector<int> vec{1, 2, 3, 4, 5, 6};
+    std::vector<int *> items;
+    for (auto &i : vec)
+        items.push_back(&i);
+
+    // only as many as fit
+    CHECK(fifo.push(items.data(), items.size()) == 4);
+    CHECK(fifo.isFull() == true);
+    CHECK(fifo.push(items.data() + 4, 2) == 0);
+
+    std::vector<int *> out(6, nullptr);
+    CHECK(fifo.pop(out.data(), 3) == 3);
+    CHECK(*out[0] == 1);
+    CHECK(*out[2] == 3);
+    CHECK(fifo.getDataValue() == 1);
+
+    // wraps around
+    CHECK(fifo.push(items.data() + 4, 2) == 2);
+    CHECK(fifo.pop(out.data(), out.size()) == 3);
+    CHECK(*out[0] == 4);
+    CHECK(*out[1] == 5);
+    CHECK(*out[2] == 6);
+    CHECK(fifo.pop(out.data(), out.size(), true) == 0);
+}
+
+TEST_CASE("Blocking push pop between two threads") {
+    constexpr size_t n_items = 100000;
+    CircularFifo<size_t> fifo(8);
+    std::vector<size_t> vec(n_items);
+    std::thread producer([&] {
+        for (size_t i = 0; i != n_items; ++i) {
+            vec[i] = i;
+            size_t *p = &vec[i];
+            fifo.push(p);
+        }
+    });
+    bool in_order = true;
+    for (size_t i = 0; i != n_items; ++i) {
+        size_t *p = nullptr;
+        if (!fifo.pop(p) || *p != i)
+            in_order = false;
+    }
+    producer.join();
+    CHECK(in_order);
+    CHECK(fifo.isEmpty() == true);
+}
+
+TEST_CASE("Pop with a timeout") {
+    using ms = std::chrono::milliseconds;
+    CircularFifo<int> fifo(2);
+    int *p = nullptr;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(fifo.pop(p, ms(20)) == false);
+    CHECK(std::chrono::steady_clock::now() - start >= ms(20));
+
+    int value = 7;
+    std::thread producer([&] {
+        std::this_thread::sleep_for(ms(10));
+        int *v = &value;
+        fifo.push(v);
+    });
+    CHECK(fifo.pop(p, ms(5000)) == true);
+    CHECK(p == &value);
+    producer.join();
+}
+
+TEST_CASE("Several producers push into a multi producer fifo") {
+    constexpr size_t n_producers = 4;
+    constexpr size_t n_items = 20000;
+    CircularFifo<size_t> fifo(8, true);
+    std::vector<size_t> vec(n_producers * n_items);
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t != n_producers; ++t) {
+        producers.emplace_back([&, t] {
+            for (size_t i = t * n_items; i != (t + 1) * n_items; ++i) {
+                vec[i] = i;
+                size_t *p = &vec[i];
+                fifo.push(p);
+            }
+        });
+    }
+    // each item exactly once
+    std::vector<int> count(vec.size(), 0);
+    for (size_t i = 0; i != vec.size(); ++i) {
+        size_t *p = nullptr;
+        fifo.pop(p);
+        ++count[p - vec.data()];
+    }
+    for (auto &t : producers)
+        t.join();
+    CHECK(std::all_of(count.begin(), count.end(),
+                      [](int c) { return c == 1; }));
+    CHECK(fifo.isEmpty() == true);
+}
+
+namespace {
+
+/** The former semaphore based fifo, as reference for the benchmark */
+template <typename Element> class SemaphoreFifo {
+    size_t tail{0};
+    size_t head{0};
+    size_t capacity;
+    std::vector<Element *> data;
+    sem_t data_mutex;
+    sem_t free_mutex;
+
+  public:
+    explicit SemaphoreFifo(size_t size) : capacity(size + 1), data(capacity) {
+        sem_init(&data_mutex, 0, 0);
+        sem_init(&free_mutex, 0, size);
+    }
+    ~SemaphoreFifo() {
+        sem_destroy(&data_mutex);
+        sem_destroy(&free_mutex);
+    }
+    bool push(Element *&item) {
+        sem_wait(&free_mutex);
+        data[tail] = item;
+        tail = (tail + 1) % capacity;
+        sem_post(&data_mutex);
+        return true;
+    }
+    bool pop(Element *&item) {
+        sem_wait(&data_mutex);
+        item = data[head];
+        head = (head + 1) % capacity;
+        sem_post(&free_mutex);
+        return true;
+    }
+};
+
+/** Ping pong of pointers through a free and a bound fifo like the listener
+ * and the processor, returns ns per item */
+template <typename Fifo> double PingPong(size_t depth, size_t n_items) {
+    Fifo fifoFree(depth);
+    Fifo fifoBound(depth);
+    std::vector<char> memory(depth);
+    for (size_t i = 0; i != depth; ++i) {
+        char *p = &memory[i];
+        fifoFree.push(p);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::thread processor([&] {
+        for (size_t i = 0; i != n_items; ++i) {
+            char *p = nullptr;
+            fifoBound.pop(p);
+            fifoFree.push(p);
+        }
+    });
+    for (size_t i = 0; i != n_items; ++i) {
+        char *p = nullptr;
+        fifoFree.pop(p);
+        fifoBound.push(p);
+    }
+    processor.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           n_items;
+}
+
+} // namespace
+
+TEST_CASE("Benchmark against semaphore fifo", "[.benchmark]") {
+    constexpr size_t n_items = 2000000;
+    for (size_t depth : {2, 100, 2500}) {
+        double lockfree = PingPong<CircularFifo<char>>(depth, n_items);
+        double semaphore = PingPong<SemaphoreFifo<char>>(depth, n_items);
+        std::cout << "depth " << depth << ": lock-free " << lockfree
+                  << " ns/item, semaphore " << semaphore << " ns/item\n";
+        CHECK(lockfree > 0);
+    }
+}
@@ -0,0 +1,194 @@
+#include "BinaryFile.h"
+#include "Compressor.h"
+#include "catch.hpp"
+#include "receiver_defs.h"
+#include "sls/sls_detector_exceptions.h"
+#include "test-File-global.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using defs = slsDetectorDefs;
+
+namespace {
+// pixels of a detector: small values around a pedestal
+std::vector<char> Image(size_t numElements, size_t elemSize, uint32_t seed) {
+    std::vector<char> image(numElements * elemSize);
+    uint32_t x = seed;
+    for (size_t i = 0; i != numElements; ++i) {
+        x = x * 1664525 + 1013904223;
+        uint32_t value = 1000 + ((x >> 16) & 0x0f);
+        memcpy(&image[i * elemSize], &value, elemSize);
+    }
+    return image;
+}
+
+int Bit(const std::vector<char> &data, size_t byte, size_t bit) {
+    return (static_cast<uint8_t>(data[byte]) >> bit) & 1;
+}
+} // namespace
+
+TEST_CASE("Bitshuffle transposes the bits of the elements", "[receiver]") {
+    for (size_t elemSize : {1, 2, 4}) {
+        size_t n = 64;
+        auto in = Image(n, elemSize, 7);
+        std::vector<char> out(in.size());
+        Compressor::BitShuffle(in.data(), out.data(), n, elemSize);
+        // bit k of byte j of all elements, one after the other
+        size_t rowBytes = n / 8;
+        bool same = true;
+        for (size_t j = 0; j != elemSize; ++j) {
+            for (size_t k = 0; k != 8; ++k) {
+                for (size_t e = 0; e != n; ++e) {
+                    size_t row = (j * 8 + k) * rowBytes;
+                    if (Bit(out, row + e / 8, e % 8) !=
+                        Bit(in, e * elemSize + j, k)) {
+                        same = false;
+                    }
+                }
+            }
+        }
+        CHECK(same);
+        std::vector<char> back(in.size());
+        Compressor::BitUnshuffle(out.data(), back.data(), n, elemSize);
+        CHECK(back == in);
+    }
+}
+
+TEST_CASE("Compression pool runs every task and passes on failures",
+          "[receiver]") {
+    CompressionPool pool(3);
+    std::vector<std::atomic<int>> runs(100);
+    for (auto &r : runs) {
+        r = 0;
+    }
+    pool.Run(runs.size(), [&runs](size_t i) { ++runs[i]; });
+    bool once = true;
+    for (auto &r : runs) {
+        once = once && (r == 1);
+    }
+    CHECK(once);
+
+    REQUIRE_THROWS_AS(pool.Run(10,
+                               [](size_t i) {
+                                   if (i == 5) {
+                                       throw sls::RuntimeError("task failed");
+                                   }
+                               }),
+                      sls::RuntimeError);
+
+    // restarted with the next task
+    pool.SetNumberOfThreads(0);
+    CHECK(pool.GetNumberOfThreads() == 0);
+    std::atomic<int> count{0};
+    pool.Run(10, [&count](size_t) { ++count; });
+    CHECK(count == 10);
+}
+
+#ifdef COMPRESSIONC
+TEST_CASE("Compressed images decompress to the original", "[receiver]") {
+    CompressionPool pool(2);
+    for (auto type : {defs::BITSHUFFLE_LZ4, defs::BITSHUFFLE_ZSTD}) {
+        for (size_t elemSize : {1, 2, 4}) {
+            // several blocks, a partial block and elements left over
+            size_t n = 3 * Compressor::BlockSize(elemSize) + 203;
+            auto image = Image(n, elemSize, 11);
+            Compressor serial(&type, nullptr);
+            Compressor parallel(&type, &pool);
+            size_t serialSize = 0;
+            const char *packed =
+                serial.Compress(image.data(), image.size(), elemSize,
+                                serialSize);
+            std::vector<char> expected(packed, packed + serialSize);
+            size_t packedSize = 0;
+            packed = parallel.Compress(image.data(), image.size(), elemSize,
+                                       packedSize);
+            CHECK(std::vector<char>(packed, packed + packedSize) == expected);
+            CHECK(packedSize < image.size() * 3 / 4);
+
+            // header of the hdf5 bitshuffle filter, big endian
+            CHECK(static_cast<uint8_t>(packed[7]) == (image.size() & 0xff));
+            CHECK(static_cast<uint8_t>(packed[6]) ==
+                  ((image.size() >> 8) & 0xff));
+            size_t blockBytes = (static_cast<uint8_t>(packed[10]) << 8) |
+                                static_cast<uint8_t>(packed[11]);
+            CHECK(blockBytes == Compressor::BlockSize(elemSize) * elemSize);
+
+            CHECK(Compressor::Decompress(packed, packedSize, elemSize, type) ==
+                  image);
+            CHECK(parallel.GetRawBytes() == image.size());
+            CHECK(parallel.GetPackedBytes() == packedSize);
+            parallel.ResetStatistics();
+            CHECK(parallel.GetRawBytes() == 0);
+        }
+    }
+}
+
+TEST_CASE("Compressed binary file has an index of its frame records",
+          "[receiver]") {
+    using rx_header_t = slsDetectorDefs::sls_receiver_header;
+    FileSettings s("sls_compressed", 5);
+    bool directIO = false;
+    bool ioUring = false;
+    auto type = defs::BITSHUFFLE_LZ4;
+    Compressor compressor(&type, nullptr);
+    std::vector<std::vector<char>> images;
+    {
+        BinaryFile file(0, &s.maxFramesPerFile, s.numDet, &s.fileName,
+                        &s.filePath, &s.fileIndex, &s.overwrite, &s.detIndex,
+                        &s.numUnits, &s.numImages, &s.dynamicRange, &s.port,
+                        &s.silent, &directIO, &ioUring, &compressor);
+        file.resetSubFileIndex();
+        file.CreateFile();
+        for (uint32_t i = 0; i != s.numImages; ++i) {
+            auto image = Image(1024 * 4 + i, 2, i);
+            std::vector<char> buffer(sizeof(rx_header_t) + image.size());
+            auto *h = reinterpret_cast<rx_header_t *>(buffer.data());
+            *h = rx_header_t{};
+            h->detHeader.frameNumber = 100 + i;
+            memcpy(&buffer[sizeof(rx_header_t)], image.data(), image.size());
+            file.WriteToFile(buffer.data(), buffer.size(), i, 1);
+            images.push_back(image);
+        }
+        file.CloseCurrentFile();
+    }
+    std::string fname = s.DataFileName(0);
+    auto data = ReadFile(fname);
+    remove(fname.c_str());
+
+    compressed_file_trailer trailer{};
+    REQUIRE(data.size() > sizeof(trailer));
+    memcpy(&trailer, &data[data.size() - sizeof(trailer)], sizeof(trailer));
+    CHECK(std::string(trailer.magic, sizeof(trailer.magic)) ==
+          COMPRESSED_FILE_MAGIC);
+    CHECK(trailer.version == COMPRESSED_FILE_VERSION);
+    CHECK(trailer.compression == defs::BITSHUFFLE_LZ4);
+    CHECK(trailer.elementSize == 2);
+    REQUIRE(trailer.numFrames == s.numImages);
+    REQUIRE(trailer.indexOffset + s.numImages * sizeof(uint64_t) +
+                sizeof(trailer) ==
+            data.size());
+
+    std::vector<uint64_t> offsets(s.numImages);
+    memcpy(offsets.data(), &data[trailer.indexOffset],
+           s.numImages * sizeof(uint64_t));
+    CHECK(offsets[0] == 0);
+    for (uint32_t i = 0; i != s.numImages; ++i) {
+        const char *record = &data[offsets[i]];
+        rx_header_t h;
+        memcpy(&h, record, sizeof(h));
+        CHECK(h.detHeader.frameNumber == 100 + i);
+        uint64_t packedSize = 0;
+        memcpy(&packedSize, record + sizeof(h), sizeof(packedSize));
+        uint64_t end = (i + 1 < s.numImages) ? offsets[i + 1]
+                                             : trailer.indexOffset;
+        CHECK(offsets[i] + sizeof(h) + sizeof(packedSize) + packedSize == end);
+        CHECK(Compressor::Decompress(record + sizeof(h) + sizeof(packedSize),
+                                     packedSize, 2, defs::BITSHUFFLE_LZ4) ==
+              images[i]);
+    }
+}
+#endif
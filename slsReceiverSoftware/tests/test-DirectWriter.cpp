@@ -0,0 +1,52 @@
+#include "DirectWriter.h"
+#include "catch.hpp"
+#include "sls/sls_detector_exceptions.h"
+#include "test-File-global.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+std::string TempFileName() {
+    return "/tmp/sls_direct_writer_" + std::to_string(getpid()) + ".raw";
+}
+} // namespace
+
+TEST_CASE("Direct writer output is identical to what was written",
+          "[receiver]") {
+    auto fname = TempFileName();
+    // frames crossing the staging buffer boundaries, partial last block
+    DirectWriter w(8192);
+    std::vector<char> expected;
+    w.Open(fname, true);
+    REQUIRE(w.IsOpen());
+    for (int i = 0; i != 7; ++i) {
+        std::vector<char> frame(3000 + i, static_cast<char>('a' + i));
+        CHECK(w.Write(frame.data(), frame.size()) == frame.size());
+        expected.insert(expected.end(), frame.begin(), frame.end());
+    }
+    w.Close();
+    CHECK_FALSE(w.IsOpen());
+    CHECK(ReadFile(fname) == expected);
+
+    // reopen for the next file
+    w.Open(fname, true);
+    CHECK(w.Write(expected.data(), 100) == 100);
+    w.Close();
+    CHECK(ReadFile(fname) == std::vector<char>(expected.begin(),
+                                               expected.begin() + 100));
+    remove(fname.c_str());
+}
+
+TEST_CASE("Direct writer does not overwrite unless enabled", "[receiver]") {
+    auto fname = TempFileName();
+    DirectWriter w(4096);
+    w.Open(fname, true);
+    w.Close();
+    REQUIRE_THROWS_AS(w.Open(fname, false), sls::RuntimeError);
+    CHECK_FALSE(w.IsOpen());
+    CHECK(w.Write("abc", 3) == 0);
+    remove(fname.c_str());
+}
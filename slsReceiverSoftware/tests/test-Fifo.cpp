@@ -0,0 +1,78 @@
+#include "Fifo.h"
+#include "catch.hpp"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Fifo addresses in flight are only lent with zero copy streaming",
+          "[receiver]") {
+    Fifo fifo(0, 64, 4);
+    CHECK(fifo.SetAddressInFlight() == false);
+
+    fifo.SetZeroCopyStreaming(true);
+    // half of the fifo
+    CHECK(fifo.SetAddressInFlight() == true);
+    CHECK(fifo.SetAddressInFlight() == true);
+    CHECK(fifo.SetAddressInFlight() == false);
+    CHECK(fifo.GetMaxLevelForFifoInFlight() == 2);
+    CHECK(fifo.GetMaxLevelForFifoInFlight() == 0);
+
+    std::vector<char *> lent(2);
+    fifo.GetNewAddress(lent[0]);
+    fifo.GetNewAddress(lent[1]);
+
+    // freed by zmq from its own thread
+    std::thread t([&]() {
+        for (auto *b : lent)
+            fifo.FreeAddressInFlight(b);
+    });
+    // leaves the addresses in flight to zmq
+    fifo.SetZeroCopyStreaming(false);
+    CHECK(fifo.SetAddressInFlight() == false);
+    t.join();
+
+    std::set<char *> addresses;
+    for (int i = 0; i != 4; ++i) {
+        char *b = nullptr;
+        fifo.GetNewAddress(b);
+        addresses.insert(b);
+    }
+    CHECK(addresses.size() == 4);
+}
+
+TEST_CASE("Fifo backlog of the streamer", "[receiver]") {
+    Fifo fifo(0, 64, 4);
+    CHECK(fifo.GetNumToStream() == 0);
+    char *b = nullptr;
+    fifo.GetNewAddress(b);
+    fifo.PushAddressToStream(b);
+    fifo.SetZeroCopyStreaming(true);
+    CHECK(fifo.SetAddressInFlight() == true);
+    CHECK(fifo.GetNumToStream() == 2);
+
+    CHECK(fifo.GetStreamCongested() == false);
+    fifo.SetStreamCongested();
+    CHECK(fifo.GetStreamCongested() == true);
+    CHECK(fifo.GetStreamCongested() == false);
+
+    fifo.PopAddressToStream(b);
+    fifo.FreeAddressInFlight(b);
+    CHECK(fifo.GetNumToStream() == 0);
+}
+
+TEST_CASE("Fifo destroyed with addresses in flight leaks their memory",
+          "[receiver]") {
+    char *b = nullptr;
+    void *hint = nullptr;
+    {
+        Fifo fifo(0, 64, 4);
+        fifo.SetZeroCopyStreaming(true);
+        REQUIRE(fifo.SetAddressInFlight() == true);
+        fifo.GetNewAddress(b);
+        hint = fifo.GetInFlightHint();
+    }
+    // still sent and freed by zmq after the timeout
+    b[0] = 1;
+    Fifo::FreeAddressInFlight(b, hint);
+}
@@ -0,0 +1,22 @@
+#include "test-File-global.h"
+
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+FileSettings::FileSettings(const std::string &name, uint64_t nf)
+    : fileName(name + "_" + std::to_string(getpid())), numImages(nf) {}
+
+std::string FileSettings::DataFileName(uint32_t subIndex) const {
+    return filePath + "/" + fileName + "_d0_f" + std::to_string(subIndex) +
+           "_" + std::to_string(fileIndex) + ".raw";
+}
+
+std::vector<char> ReadFile(const std::string &fname) {
+    std::ifstream ifs(fname, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(ifs), {});
+}
+
+bool FileExists(const std::string &fname) {
+    return (access(fname.c_str(), F_OK) == 0);
+}
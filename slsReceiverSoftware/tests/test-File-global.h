@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** file settings of one port, pointed to by its file */
+struct FileSettings {
+    uint32_t maxFramesPerFile{0};
+    int numDet[2]{1, 1};
+    std::string fileName;
+    std::string filePath{"/tmp"};
+    uint64_t fileIndex{0};
+    bool overwrite{true};
+    int detIndex{0};
+    int numUnits{1};
+    uint64_t numImages;
+    uint32_t dynamicRange{16};
+    uint32_t port{50001};
+    bool silent{true};
+
+    /** file name prefix name_[pid], in /tmp */
+    FileSettings(const std::string &name, uint64_t nf);
+
+    /** binary data file of a sub file of the first port */
+    std::string DataFileName(uint32_t subIndex) const;
+};
+
+std::vector<char> ReadFile(const std::string &fname);
+
+bool FileExists(const std::string &fname);
@@ -0,0 +1,81 @@
+#include "Fifo.h"
+#include "FileWriter.h"
+#include "catch.hpp"
+#include "receiver_defs.h"
+
+#include <cstring>
+
+using rx_header_t = slsDetectorDefs::sls_receiver_header;
+
+namespace {
+constexpr uint32_t isize = 16;
+constexpr uint32_t hsize = FIFO_HEADER_NUMBYTES + sizeof(rx_header_t);
+
+void PushToWrite(Fifo &fifo, uint32_t size, uint64_t fnum, uint32_t index) {
+    char *buffer = nullptr;
+    fifo.GetNewAddress(buffer);
+    memset(buffer, 0, hsize);
+    *reinterpret_cast<uint32_t *>(buffer) = size;
+    *reinterpret_cast<uint32_t *>(buffer + FIFO_DATASIZE_NUMBYTES) = index;
+    auto *h = reinterpret_cast<rx_header_t *>(buffer + FIFO_HEADER_NUMBYTES);
+    h->detHeader.frameNumber = fnum;
+    fifo.PushAddressToWrite(buffer);
+}
+
+uint64_t PopStreamed(Fifo &fifo, uint32_t &size) {
+    char *buffer = nullptr;
+    fifo.PopAddressToStream(buffer);
+    size = *reinterpret_cast<uint32_t *>(buffer);
+    auto *h = reinterpret_cast<rx_header_t *>(buffer + FIFO_HEADER_NUMBYTES);
+    uint64_t fnum = h->detHeader.frameNumber;
+    fifo.FreeAddress(buffer);
+    return fnum;
+}
+} // namespace
+
+TEST_CASE("File writer streams only images marked to stream once written",
+          "[receiver]") {
+    Fifo fifo(0, hsize + isize, 8);
+    slsDetectorDefs::fileFormat format = slsDetectorDefs::BINARY;
+    bool masterFileWriteEnable = false;
+    bool dataStreamEnable = true;
+    bool silentMode = true;
+    bool directIO = false;
+    bool ioUring = false;
+    uint32_t chunkFrames = 1;
+    uint32_t chunkRows = 0;
+    bool compoundHeader = false;
+    bool writerProcess = false;
+    bool swmr = false;
+    uint32_t flushFrames = 0;
+    uint32_t flushTime = 0;
+    slsDetectorDefs::fileCompression compression =
+        slsDetectorDefs::NO_COMPRESSION;
+    FileWriter writer(0, &fifo, &format, &masterFileWriteEnable,
+                      &dataStreamEnable, &silentMode, &directIO, &ioUring,
+                      &chunkFrames, &chunkRows, &compoundHeader,
+                      &writerProcess, &swmr, &flushFrames, &flushTime,
+                      &compression, nullptr);
+    writer.ResetParametersforNewAcquisition();
+
+    PushToWrite(fifo, isize, 10, NOT_STREAMED_VALUE);
+    PushToWrite(fifo, isize, 11, 1);
+    PushToWrite(fifo, DISCARD_PACKET_VALUE, 12, 0);
+    PushToWrite(fifo, isize, 13, NOT_STREAMED_VALUE);
+    PushToWrite(fifo, DUMMY_PACKET_VALUE, 0, 0);
+    CHECK(writer.GetMaxQueueLevel() == 4);
+
+    writer.StartRunning();
+    writer.Continue();
+    writer.WaitForStop();
+
+    uint32_t size = 0;
+    CHECK(PopStreamed(fifo, size) == 11);
+    CHECK(size == isize);
+    PopStreamed(fifo, size);
+    CHECK(size == DISCARD_PACKET_VALUE);
+    PopStreamed(fifo, size);
+    CHECK(size == DUMMY_PACKET_VALUE);
+    // no file to write to
+    CHECK(writer.GetNumImagesWritten() == 0);
+}
@@ -0,0 +1,159 @@
+#include "Fifo.h"
+#include "FrameWindow.h"
+#include "catch.hpp"
+#include "receiver_defs.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using header_t = slsDetectorDefs::sls_detector_header;
+using rx_header_t = slsDetectorDefs::sls_receiver_header;
+
+namespace {
+constexpr uint32_t ppf = 4;
+constexpr uint32_t dsize = sizeof(int);
+constexpr uint32_t isize = ppf * dsize;
+constexpr uint32_t hsize = FIFO_HEADER_NUMBYTES + sizeof(rx_header_t);
+
+struct Frame {
+    uint32_t size;
+    uint64_t fnum;
+    uint32_t npackets;
+    int data[ppf];
+};
+
+Frame Pop(Fifo &fifo) {
+    char *buffer = nullptr;
+    fifo.PopAddress(buffer);
+    Frame f{};
+    f.size = *reinterpret_cast<uint32_t *>(buffer);
+    auto *h = reinterpret_cast<rx_header_t *>(buffer + FIFO_HEADER_NUMBYTES);
+    f.fnum = h->detHeader.frameNumber;
+    f.npackets = h->detHeader.packetNumber;
+    memcpy(f.data, buffer + hsize, isize);
+    fifo.FreeAddress(buffer);
+    return f;
+}
+
+bool Add(FrameWindow &w, uint64_t fnum, uint32_t pnum) {
+    header_t h{};
+    h.frameNumber = fnum;
+    h.packetNumber = pnum;
+    int data = static_cast<int>(fnum * ppf + pnum);
+    return w.AddPacket(fnum, pnum, &h, reinterpret_cast<char *>(&data));
+}
+} // namespace
+
+TEST_CASE("Frames are pushed in order once complete", "[receiver]") {
+    Fifo fifo(0, hsize + isize, 8);
+    slsDetectorDefs::frameDiscardPolicy policy = slsDetectorDefs::NO_DISCARD;
+    FrameWindow w(&fifo, 2, ppf, dsize, isize, hsize, &policy);
+    REQUIRE(Add(w, 10, 1));
+    for (uint32_t i = 0; i != ppf; ++i) {
+        REQUIRE(Add(w, 11, ppf - 1 - i));
+    }
+    for (uint32_t i = 2; i != ppf; ++i) {
+        REQUIRE(Add(w, 10, i));
+    }
+    REQUIRE(w.GetNumFramesPushed() == 0);
+    REQUIRE(Add(w, 10, 0));
+    REQUIRE(w.GetNumFramesPushed() == 2);
+    REQUIRE(w.GetFirstFrameNumber() == 10);
+    REQUIRE(w.GetNextFrameNumber() == 12);
+    for (uint64_t fnum = 10; fnum != 12; ++fnum) {
+        auto f = Pop(fifo);
+        CHECK(f.size == isize);
+        CHECK(f.fnum == fnum);
+        CHECK(f.npackets == ppf);
+        for (uint32_t i = 0; i != ppf; ++i) {
+            CHECK(f.data[i] == static_cast<int>(fnum * ppf + i));
+        }
+    }
+}
+
+TEST_CASE("Window slides over partial and missing frames", "[receiver]") {
+    Fifo fifo(0, hsize + isize, 8);
+    slsDetectorDefs::frameDiscardPolicy policy = slsDetectorDefs::NO_DISCARD;
+    FrameWindow w(&fifo, 2, ppf, dsize, isize, hsize, &policy);
+    w.SetHardCodedPosition(1, 2);
+    REQUIRE(Add(w, 0, 1));
+    REQUIRE_FALSE(Add(w, 0, 1)); // duplicate
+    REQUIRE(Add(w, 3, 0));       // pushes 0 (partial) and 1 (empty)
+    REQUIRE_FALSE(Add(w, 0, 2)); // too late
+    REQUIRE(w.GetNumFramesPushed() == 2);
+    w.Flush();
+    REQUIRE(w.GetNumFramesPushed() == 4);
+
+    uint32_t npackets[] = {1, 0, 0, 1};
+    for (uint64_t fnum = 0; fnum != 4; ++fnum) {
+        auto f = Pop(fifo);
+        CHECK(f.size == isize);
+        CHECK(f.fnum == fnum);
+        CHECK(f.npackets == npackets[fnum]);
+    }
+}
+
+TEST_CASE("Frame window discards partial frames", "[receiver]") {
+    Fifo fifo(0, hsize + isize, 8);
+    slsDetectorDefs::frameDiscardPolicy policy =
+        slsDetectorDefs::DISCARD_PARTIAL_FRAMES;
+    FrameWindow w(&fifo, 2, ppf, dsize, isize, hsize, &policy);
+    REQUIRE(Add(w, 0, 0));
+    for (uint32_t i = 0; i != ppf; ++i) {
+        REQUIRE(Add(w, 2, i));
+    }
+    w.Flush();
+    // partial frame 0 only to be freed, empty frame 1 never taken a buffer
+    CHECK(Pop(fifo).size == DISCARD_PACKET_VALUE);
+    auto f = Pop(fifo);
+    CHECK(f.size == isize);
+    CHECK(f.fnum == 2);
+    CHECK(w.GetNumFramesPushed() == 3);
+}
+
+TEST_CASE("Packets of frames from several threads", "[receiver]") {
+    constexpr int numThreads = 4;
+    constexpr uint64_t numFrames = 200;
+    Fifo fifo(0, hsize + isize, 16);
+    slsDetectorDefs::frameDiscardPolicy policy = slsDetectorDefs::NO_DISCARD;
+    FrameWindow w(&fifo, 2 * numThreads, ppf, dsize, isize, hsize, &policy);
+
+    std::atomic<uint64_t> numAdded{0};
+    std::vector<std::thread> threads;
+    for (int k = 0; k != numThreads; ++k) {
+        threads.emplace_back([&, k]() {
+            for (uint64_t fnum = k; fnum < numFrames; fnum += numThreads) {
+                for (uint32_t i = 0; i != ppf; ++i) {
+                    if (Add(w, fnum, i)) {
+                        ++numAdded;
+                    }
+                }
+            }
+        });
+    }
+    std::vector<Frame> frames;
+    std::thread consumer([&]() {
+        while (frames.empty() || frames.back().fnum != numFrames - 1) {
+            frames.push_back(Pop(fifo));
+        }
+    });
+    for (auto &t : threads) {
+        t.join();
+    }
+    w.Flush();
+    consumer.join();
+
+    uint64_t numPackets = 0;
+    uint64_t fnum = w.GetFirstFrameNumber();
+    for (const auto &f : frames) {
+        CHECK(f.fnum == fnum++);
+        numPackets += f.npackets;
+        for (uint32_t i = 0; i != f.npackets && f.npackets == ppf; ++i) {
+            CHECK(f.data[i] == static_cast<int>(f.fnum * ppf + i));
+        }
+    }
+    CHECK(numPackets == numAdded);
+    CHECK(w.GetNumFramesPushed() == frames.size());
+}
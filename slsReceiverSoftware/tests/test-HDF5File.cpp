@@ -0,0 +1,673 @@
+#include "HDF5File.h"
+#include "HDF5ProcessFile.h"
+#include "MasterAttributes.h"
+#include "catch.hpp"
+#include "receiver_defs.h"
+#include "test-File-global.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <linux/memfd.h>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using rx_header_t = slsDetectorDefs::sls_receiver_header;
+
+namespace {
+/** hdf5 file settings of one port, pointed to by its file */
+struct Hdf5Settings : FileSettings {
+    uint32_t chunkFrames;
+    uint32_t chunkRows;
+    bool compoundHeader;
+    bool swmr{false};
+    uint32_t flushFrames{0};
+    uint32_t flushTime{0};
+
+    Hdf5Settings(const std::string &name, uint64_t nf, uint32_t cframes,
+                 uint32_t crows, bool cheader)
+        : FileSettings(name, nf), chunkFrames(cframes), chunkRows(crows),
+          compoundHeader(cheader) {}
+};
+
+/** one port writing 16 bit images of nx * ny pixels */
+struct Hdf5Writer : Hdf5Settings {
+    uint32_t nx;
+    uint32_t ny;
+    HDF5File file;
+    std::vector<char> buffer;
+
+    Hdf5Writer(const std::string &name, uint32_t x, uint32_t y, uint64_t nf,
+               uint32_t cframes, uint32_t crows, bool cheader = false,
+               Compressor *comp = nullptr)
+        : Hdf5Settings(name, nf, cframes, crows, cheader), nx(x), ny(y),
+          file(0, &maxFramesPerFile, numDet, &fileName, &filePath, &fileIndex,
+               &overwrite, &detIndex, &numUnits, &numImages, &dynamicRange,
+               &port, x, y, &silent, &chunkFrames, &chunkRows,
+               &compoundHeader, &swmr, &flushFrames, &flushTime, comp),
+          buffer(sizeof(rx_header_t) + x * y * sizeof(uint16_t)) {
+        file.CreateMasterFile(false, nullptr);
+        file.CreateFile();
+    }
+
+    ~Hdf5Writer() {
+        file.CloseAllFiles();
+        remove(file.GetCurrentFileName().c_str());
+    }
+
+    void Write(uint64_t fnum, bool fill = true) {
+        auto *h = reinterpret_cast<rx_header_t *>(buffer.data());
+        h->detHeader.frameNumber = fnum;
+        h->detHeader.bunchId = fnum * 10;
+        h->detHeader.row = static_cast<uint16_t>(fnum);
+        h->packetsMask.set(fnum % MAX_NUM_PACKETS);
+        auto *image = reinterpret_cast<uint16_t *>(buffer.data() +
+                                                   sizeof(rx_header_t));
+        for (uint32_t i = 0; fill && i != nx * ny; ++i) {
+            image[i] = static_cast<uint16_t>(fnum * 1000 + i);
+        }
+        file.WriteToFile(buffer.data(), buffer.size(), fnum, 1);
+    }
+
+    std::vector<uint16_t> Read(hsize_t chunk[3]) {
+        std::string fname = file.GetCurrentFileName();
+        file.CloseCurrentFile();
+        H5File fd(fname.c_str(), H5F_ACC_RDONLY);
+        DataSet ds = fd.openDataSet("/data_f000000000000");
+        ds.getCreatePlist().getChunk(3, chunk);
+        hsize_t dims[3];
+        ds.getSpace().getSimpleExtentDims(dims);
+        std::vector<uint16_t> data(dims[0] * dims[1] * dims[2]);
+        ds.read(data.data(), PredType::NATIVE_UINT16);
+        return data;
+    }
+
+    template <typename T>
+    std::vector<T> ReadParameter(const DataType &type, const char *name) {
+        std::string fname = file.GetCurrentFileName();
+        file.CloseCurrentFile();
+        H5File fd(fname.c_str(), H5F_ACC_RDONLY);
+        DataSet ds = fd.openDataSet(name);
+        hsize_t dims[1];
+        ds.getSpace().getSimpleExtentDims(dims);
+        std::vector<T> data(dims[0]);
+        ds.read(data.data(), type);
+        return data;
+    }
+};
+
+std::vector<uint16_t> Expected(uint32_t nx, uint32_t ny, uint64_t nf,
+                               uint64_t missing) {
+    std::vector<uint16_t> data;
+    for (uint64_t f = 0; f != nf; ++f) {
+        for (uint32_t i = 0; i != nx * ny; ++i) {
+            data.push_back((f == missing)
+                               ? static_cast<uint16_t>(-1)
+                               : static_cast<uint16_t>(f * 1000 + i));
+        }
+    }
+    return data;
+}
+
+std::unique_ptr<HDF5File> MakeFile(int index, Hdf5Settings &s, uint32_t nx,
+                                   uint32_t ny, bool process) {
+    if (process) {
+        return std::unique_ptr<HDF5File>(new HDF5ProcessFile(
+            index, &s.maxFramesPerFile, s.numDet, &s.fileName, &s.filePath,
+            &s.fileIndex, &s.overwrite, &s.detIndex, &s.numUnits,
+            &s.numImages, &s.dynamicRange, &s.port, nx, ny, &s.silent,
+            &s.chunkFrames, &s.chunkRows, &s.compoundHeader, &s.swmr,
+            &s.flushFrames, &s.flushTime));
+    }
+    return std::unique_ptr<HDF5File>(new HDF5File(
+        index, &s.maxFramesPerFile, s.numDet, &s.fileName, &s.filePath,
+        &s.fileIndex, &s.overwrite, &s.detIndex, &s.numUnits, &s.numImages,
+        &s.dynamicRange, &s.port, nx, ny, &s.silent, &s.chunkFrames,
+        &s.chunkRows, &s.compoundHeader, &s.swmr, &s.flushFrames,
+        &s.flushTime));
+}
+
+/** file and dataset a swmr reader is asked to read */
+struct SwmrRequest {
+    char fileName[256];
+    char datasetName[64];
+};
+
+/** what a swmr reader sees: images in the dataset, how many from the first
+ * have the written values */
+struct SwmrView {
+    uint64_t extent;
+    uint64_t written;
+};
+
+/**
+ * Reader process, forked before any file is opened as a reader and the
+ * writer cannot share the hdf5 library. Answers requests till the pipe is
+ * closed
+ */
+pid_t StartSwmrReader(int &requests, int &views) {
+    int req[2], view[2];
+    if (pipe(req) != 0 || pipe(view) != 0) {
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid != 0) {
+        close(req[0]);
+        close(view[1]);
+        requests = req[1];
+        views = view[0];
+        return pid;
+    }
+    close(req[1]);
+    close(view[0]);
+    SwmrRequest r;
+    while (read(req[0], &r, sizeof(r)) == sizeof(r)) {
+        SwmrView v{0, 0};
+        try {
+            H5File fd(r.fileName, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ);
+            DataSet ds = fd.openDataSet(r.datasetName);
+            hsize_t dims[3];
+            ds.getSpace().getSimpleExtentDims(dims);
+            std::vector<uint16_t> data(dims[0] * dims[1] * dims[2]);
+            ds.read(data.data(), PredType::NATIVE_UINT16);
+            v.extent = dims[0];
+            size_t pixels = dims[1] * dims[2];
+            while (v.written != dims[0] &&
+                   data[v.written * pixels + pixels - 1] ==
+                       static_cast<uint16_t>(v.written * 1000 + pixels - 1)) {
+                ++v.written;
+            }
+        } catch (const Exception &e) {
+            v.extent = -1;
+        }
+        if (write(view[1], &v, sizeof(v)) != sizeof(v)) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+SwmrView ReadSwmr(int requests, int views, const std::string &fname,
+                  const char *dsetname) {
+    SwmrRequest r{};
+    strncpy(r.fileName, fname.c_str(), sizeof(r.fileName) - 1);
+    strncpy(r.datasetName, dsetname, sizeof(r.datasetName) - 1);
+    SwmrView v{0, 0};
+    if (write(requests, &r, sizeof(r)) != sizeof(r) ||
+        read(views, &v, sizeof(v)) != sizeof(v)) {
+        v.extent = -1;
+    }
+    return v;
+}
+
+/** images in a memory file shared with the writer processes, as the fifo */
+char *MapShared(size_t size, int &fd) {
+    fd = static_cast<int>(syscall(SYS_memfd_create, "sls_hdf5", MFD_CLOEXEC));
+    void *p = MAP_FAILED;
+    if (fd >= 0 && ftruncate(fd, size) == 0) {
+        p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    return (p == MAP_FAILED) ? nullptr : static_cast<char *>(p);
+}
+} // namespace
+
+TEST_CASE("HDF5 images gathered in tiled chunks", "[receiver]") {
+    constexpr uint32_t nx = 7;
+    constexpr uint32_t ny = 5;
+    constexpr uint64_t nf = 10;
+    constexpr uint64_t missing = 6;
+    for (bool direct : {true, false}) {
+        Hdf5Writer w("sls_hdf5_chunk", nx, ny, nf, 4, 3);
+        w.file.SetDirectChunkWrite(direct);
+        for (uint64_t f = 0; f != nf; ++f) {
+            if (f != missing) {
+                w.Write(f);
+            }
+        }
+        hsize_t chunk[3];
+        CHECK(w.Read(chunk) == Expected(nx, ny, nf, missing));
+        CHECK(chunk[0] == 4);
+        CHECK(chunk[1] == 3);
+        CHECK(chunk[2] == nx);
+    }
+}
+
+TEST_CASE("HDF5 image per chunk written directly", "[receiver]") {
+    constexpr uint32_t nx = 8;
+    constexpr uint32_t ny = 4;
+    constexpr uint64_t nf = 3;
+    Hdf5Writer w("sls_hdf5_image", nx, ny, nf, 1, 0);
+    for (uint64_t f = 0; f != nf; ++f) {
+        w.Write(f);
+    }
+    hsize_t chunk[3];
+    CHECK(w.Read(chunk) == Expected(nx, ny, nf, nf));
+    CHECK(chunk[0] == 1);
+    CHECK(chunk[1] == ny);
+}
+
+#ifdef COMPRESSIONC
+TEST_CASE("HDF5 chunks compressed for the bitshuffle filter", "[receiver]") {
+    constexpr uint32_t nx = 64;
+    constexpr uint32_t ny = 32;
+    constexpr uint64_t nf = 5;
+    // last chunk with the fill value for the image after the last
+    auto expected = Expected(nx, ny, nf + 1, nf);
+    for (auto type :
+         {slsDetectorDefs::BITSHUFFLE_LZ4, slsDetectorDefs::BITSHUFFLE_ZSTD}) {
+        Compressor compressor(&type, nullptr);
+        Hdf5Writer w("sls_hdf5_compressed", nx, ny, nf, 2, 0, false,
+                     &compressor);
+        for (uint64_t f = 0; f != nf; ++f) {
+            w.Write(f);
+        }
+        std::string fname = w.file.GetCurrentFileName();
+        w.file.CloseCurrentFile();
+
+        H5File fd(fname.c_str(), H5F_ACC_RDONLY);
+        DataSet ds = fd.openDataSet("/data_f000000000000");
+        // filter plugin not needed to write, only to read through hdf5
+        DSetCreatPropList plist = ds.getCreatePlist();
+        REQUIRE(plist.getNfilters() == 1);
+        unsigned int flags = 0;
+        size_t nelmts = 8;
+        unsigned int cd[8]{};
+        CHECK(H5Pget_filter2(plist.getId(), 0, &flags, &nelmts, cd, 0, nullptr,
+                             nullptr) == BITSHUFFLE_FILTER_ID);
+        CHECK((flags & H5Z_FLAG_OPTIONAL) != 0);
+        CHECK(cd[2] == sizeof(uint16_t));
+        CHECK(cd[4] ==
+              ((type == slsDetectorDefs::BITSHUFFLE_LZ4) ? 2u : 3u));
+
+        size_t chunkPixels = 2 * nx * ny;
+        for (hsize_t c = 0; c != 3; ++c) {
+            hsize_t offset[3] = {2 * c, 0, 0};
+            hsize_t size = 0;
+            REQUIRE(H5Dget_chunk_storage_size(ds.getId(), offset, &size) >= 0);
+            std::vector<char> packed(size);
+            uint32_t mask = 1;
+            REQUIRE(H5Dread_chunk(ds.getId(), H5P_DEFAULT, offset, &mask,
+                                  packed.data()) >= 0);
+            CHECK(mask == 0);
+            CHECK(size < chunkPixels * sizeof(uint16_t));
+            auto raw = Compressor::Decompress(packed.data(), packed.size(),
+                                              sizeof(uint16_t), type);
+            REQUIRE(raw.size() == chunkPixels * sizeof(uint16_t));
+            CHECK(memcmp(raw.data(), &expected[c * chunkPixels],
+                         raw.size()) == 0);
+        }
+    }
+}
+#endif
+
+TEST_CASE("HDF5 receiver header written per chunk", "[receiver]") {
+    constexpr uint64_t nf = 6;
+    constexpr uint64_t missing = 4;
+    for (bool compound : {true, false}) {
+        Hdf5Writer w("sls_hdf5_header", 4, 2, nf, 4, 0, compound);
+        for (uint64_t f = 0; f != nf; ++f) {
+            if (f != missing) {
+                w.Write(f);
+            }
+        }
+        std::vector<uint64_t> bunchIds;
+        std::vector<uint16_t> rows;
+        if (compound) {
+            // read back only some members
+            struct Members {
+                uint64_t bunchId;
+                uint16_t row;
+            };
+            CompType type(sizeof(Members));
+            type.insertMember("bunch id", HOFFSET(Members, bunchId),
+                              PredType::NATIVE_UINT64);
+            type.insertMember("row", HOFFSET(Members, row),
+                              PredType::NATIVE_UINT16);
+            for (const auto &m : w.ReadParameter<Members>(type, "header")) {
+                bunchIds.push_back(m.bunchId);
+                rows.push_back(m.row);
+            }
+        } else {
+            bunchIds = w.ReadParameter<uint64_t>(PredType::NATIVE_UINT64,
+                                                 "bunch id");
+            rows = w.ReadParameter<uint16_t>(PredType::NATIVE_UINT16, "row");
+        }
+        REQUIRE(bunchIds.size() == nf);
+        for (uint64_t f = 0; f != nf; ++f) {
+            CHECK(bunchIds[f] == ((f == missing) ? 0 : f * 10));
+            CHECK(rows[f] == ((f == missing) ? 0 : f));
+        }
+    }
+}
+
+TEST_CASE("HDF5 data files written by a writer process", "[receiver]") {
+    constexpr uint32_t nx = 6;
+    constexpr uint32_t ny = 4;
+    constexpr uint64_t nf = 10;
+    constexpr size_t size = sizeof(rx_header_t) + nx * ny * sizeof(uint16_t);
+    int fd = -1;
+    char *memory = MapShared(nf * size, fd);
+    REQUIRE(memory != nullptr);
+    Hdf5Settings s("sls_hdf5_process", nf, 1, 0, false);
+    s.maxFramesPerFile = 4;
+    std::vector<std::string> fnames;
+    std::vector<char *> done;
+    {
+        auto file = MakeFile(0, s, nx, ny, true);
+        file->SetBufferMemory(memory, nf * size, fd);
+        file->CreateMasterFile(false, nullptr);
+        file->CreateFile();
+        for (uint64_t f = 0; f != nf; ++f) {
+            char *buffer = memory + f * size;
+            reinterpret_cast<rx_header_t *>(buffer)->detHeader.frameNumber = f;
+            auto *image =
+                reinterpret_cast<uint16_t *>(buffer + sizeof(rx_header_t));
+            for (uint32_t i = 0; i != nx * ny; ++i) {
+                image[i] = static_cast<uint16_t>(f * 1000 + i);
+            }
+            file->WriteToFile(buffer, size, f, 1);
+            // next file created by the writer process
+            if (fnames.empty() || fnames.back() != file->GetCurrentFileName()) {
+                fnames.push_back(file->GetCurrentFileName());
+            }
+        }
+        CHECK(file->HasPendingWrites());
+        file->CloseCurrentFile();
+        file->GetCompletedWrites(done, false);
+        CHECK_FALSE(file->HasPendingWrites());
+    }
+    REQUIRE(done.size() == nf);
+    for (uint64_t f = 0; f != nf; ++f) {
+        CHECK(done[f] == memory + f * size);
+    }
+    munmap(memory, nf * size);
+    close(fd);
+
+    REQUIRE(fnames.size() == 3);
+    auto expected = Expected(nx, ny, nf, nf);
+    for (size_t k = 0; k != fnames.size(); ++k) {
+        H5File fd(fnames[k].c_str(), H5F_ACC_RDONLY);
+        char dsetname[32];
+        snprintf(dsetname, sizeof(dsetname), "/data_f%012zu", k);
+        DataSet ds = fd.openDataSet(dsetname);
+        hsize_t dims[3];
+        ds.getSpace().getSimpleExtentDims(dims);
+        std::vector<uint16_t> data(dims[0] * dims[1] * dims[2]);
+        ds.read(data.data(), PredType::NATIVE_UINT16);
+        size_t first = k * s.maxFramesPerFile * nx * ny;
+        size_t n = std::min<size_t>(expected.size() - first,
+                                    s.maxFramesPerFile * nx * ny);
+        REQUIRE(data.size() >= n);
+        CHECK(std::equal(data.begin(), data.begin() + n,
+                         expected.begin() + first));
+        fd.close();
+        remove(fnames[k].c_str());
+    }
+}
+
+TEST_CASE("HDF5 sub files rotate to files created in the background",
+          "[receiver]") {
+    constexpr uint32_t nx = 6;
+    constexpr uint32_t ny = 4;
+    constexpr uint64_t nf = 10;
+    // acquisition stopped after 7 images, in the third file
+    constexpr uint64_t written = 7;
+    Hdf5Settings s("sls_hdf5_rotation", nf, 2, 0, false);
+    s.maxFramesPerFile = 3;
+    std::vector<std::string> fnames;
+    {
+        auto file = MakeFile(0, s, nx, ny, false);
+        file->CreateMasterFile(false, nullptr);
+        file->CreateFile();
+        std::vector<char> buffer(sizeof(rx_header_t) +
+                                 nx * ny * sizeof(uint16_t));
+        for (uint64_t f = 0; f != written; ++f) {
+            reinterpret_cast<rx_header_t *>(buffer.data())
+                ->detHeader.frameNumber = f;
+            auto *image = reinterpret_cast<uint16_t *>(buffer.data() +
+                                                       sizeof(rx_header_t));
+            for (uint32_t i = 0; i != nx * ny; ++i) {
+                image[i] = static_cast<uint16_t>(f * 1000 + i);
+            }
+            file->WriteToFile(buffer.data(), buffer.size(), f, 1);
+            if (fnames.empty() || fnames.back() != file->GetCurrentFileName()) {
+                fnames.push_back(file->GetCurrentFileName());
+            }
+        }
+        file->CloseCurrentFile();
+    }
+
+    REQUIRE(fnames.size() == 3);
+    auto expected = Expected(nx, ny, written, nf);
+    for (size_t k = 0; k != fnames.size(); ++k) {
+        H5File fd(fnames[k].c_str(), H5F_ACC_RDONLY);
+        char dsetname[32];
+        snprintf(dsetname, sizeof(dsetname), "/data_f%012zu", k);
+        DataSet ds = fd.openDataSet(dsetname);
+        hsize_t dims[3];
+        ds.getSpace().getSimpleExtentDims(dims);
+        CHECK(dims[0] == s.maxFramesPerFile);
+        std::vector<uint16_t> data(dims[0] * dims[1] * dims[2]);
+        ds.read(data.data(), PredType::NATIVE_UINT16);
+        size_t first = k * s.maxFramesPerFile * nx * ny;
+        size_t n = std::min<size_t>(expected.size() - first,
+                                    s.maxFramesPerFile * nx * ny);
+        CHECK(std::equal(data.begin(), data.begin() + n,
+                         expected.begin() + first));
+        fd.close();
+        remove(fnames[k].c_str());
+    }
+    // prepared for the rest of the acquisition, removed unused
+    std::string next = fnames[2];
+    next.replace(next.find("_f2_"), 4, "_f3_");
+    CHECK(access(next.c_str(), F_OK) != 0);
+    remove(next.c_str());
+}
+
+TEST_CASE("HDF5 write rate of chunk layouts", "[.benchmark]") {
+    // jungfrau sized images
+    constexpr uint32_t nx = 1024;
+    constexpr uint32_t ny = 512;
+    constexpr uint64_t nf = 200;
+    struct Layout {
+        const char *name;
+        uint32_t frames;
+        uint32_t rows;
+        bool direct;
+        bool compound;
+    };
+    for (const auto &l :
+         {Layout{"1 image, hyperslab", 1, 0, false, false},
+          Layout{"1 image, direct", 1, 0, true, false},
+          Layout{"1 image, direct, compound header", 1, 0, true, true},
+          Layout{"16 images, direct", 16, 0, true, false},
+          Layout{"16 images, direct, compound header", 16, 0, true, true},
+          Layout{"16 images x 128 rows, direct", 16, 128, true, false},
+          Layout{"16 images, hyperslab", 16, 0, false, false}}) {
+        // best of a few runs, as page cache writeback adds noise
+        double best = 0;
+        for (int run = 0; run != 3; ++run) {
+            Hdf5Writer w("sls_hdf5_bench", nx, ny, nf, l.frames, l.rows,
+                         l.compound);
+            w.file.SetDirectChunkWrite(l.direct);
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t f = 0; f != nf; ++f) {
+                w.Write(f, false);
+            }
+            w.file.CloseCurrentFile();
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            best = std::max(best, nf / elapsed.count());
+        }
+        WARN(l.name << ": " << best << " frames/s");
+    }
+}
+
+TEST_CASE("HDF5 write rate of receiver headers", "[.benchmark]") {
+    // tiny images, mostly header overhead
+    constexpr uint64_t nf = 20000;
+    struct Layout {
+        const char *name;
+        uint32_t frames;
+        bool compound;
+    };
+    for (const auto &l : {Layout{"dataset per parameter, 1 image", 1, false},
+                          Layout{"dataset per parameter, 16 images", 16, false},
+                          Layout{"compound, 1 image", 1, true},
+                          Layout{"compound, 16 images", 16, true}}) {
+        Hdf5Writer w("sls_hdf5_bench_header", 4, 4, nf, l.frames, 0,
+                     l.compound);
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t f = 0; f != nf; ++f) {
+            w.Write(f, false);
+        }
+        w.file.CloseCurrentFile();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        WARN(l.name << ": " << nf / elapsed.count() << " frames/s");
+    }
+}
+
+TEST_CASE("HDF5 write rate of two ports", "[.benchmark]") {
+    constexpr uint32_t nx = 1024;
+    constexpr uint32_t ny = 512;
+    constexpr uint64_t nf = 200;
+    constexpr size_t size = sizeof(rx_header_t) + nx * ny * sizeof(uint16_t);
+    // the same image over and over, it is not modified
+    int fd = -1;
+    char *memory = MapShared(size, fd);
+    REQUIRE(memory != nullptr);
+    for (bool process : {false, true}) {
+        // files (and writer processes) created one after the other
+        Hdf5Settings s("sls_hdf5_bench_ports", nf, 1, 0, false);
+        std::unique_ptr<HDF5File> files[2];
+        for (int i = 0; i != 2; ++i) {
+            files[i] = MakeFile(i, s, nx, ny, process);
+            files[i]->SetBufferMemory(memory, size, fd);
+            files[i]->CreateMasterFile(false, nullptr);
+            files[i]->CreateFile();
+        }
+        auto write = [&](HDF5File *file) {
+            std::vector<char *> done;
+            for (uint64_t f = 0; f != nf; ++f) {
+                file->WriteToFile(memory, size, f, 1);
+                file->GetCompletedWrites(done, false);
+            }
+            file->CloseCurrentFile();
+        };
+        auto start = std::chrono::steady_clock::now();
+        std::thread port0(write, files[0].get());
+        std::thread port1(write, files[1].get());
+        port0.join();
+        port1.join();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        WARN((process ? "writer processes" : "receiver threads")
+             << ": " << 2 * nf / elapsed.count() << " frames/s");
+        for (auto &file : files) {
+            remove(file->GetCurrentFileName().c_str());
+        }
+    }
+    munmap(memory, size);
+    close(fd);
+}
+
+TEST_CASE("HDF5 swmr readers see images as they are written", "[receiver]") {
+    int requests = -1, views = -1;
+    pid_t reader = StartSwmrReader(requests, views);
+    REQUIRE(reader > 0);
+
+    SECTION("data file extent and images after each flush") {
+        Hdf5Writer w("sls_hdf5_swmr", 6, 4, 10, 2, 0);
+        // recreated in swmr mode
+        w.file.CloseAllFiles();
+        remove(w.file.GetCurrentFileName().c_str());
+        w.swmr = true;
+        w.flushFrames = 3;
+        w.file.CreateMasterFile(false, nullptr);
+        w.file.CreateFile();
+        std::string fname = w.file.GetCurrentFileName();
+        const char *dsetname = "/data_f000000000000";
+
+        auto v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.extent == 0);
+        for (uint64_t f = 0; f != 3; ++f) {
+            w.Write(f);
+        }
+        // by whole chunks, the rest has the fill value
+        v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.extent == 4);
+        CHECK(v.written == 3);
+        for (uint64_t f = 3; f != 6; ++f) {
+            w.Write(f);
+        }
+        v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.extent == 6);
+        CHECK(v.written == 6);
+        for (uint64_t f = 6; f != 9; ++f) {
+            w.Write(f);
+        }
+        // exact extent once closed
+        w.file.CloseCurrentFile();
+        v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.extent == 9);
+        CHECK(v.written == 9);
+    }
+
+    SECTION("last images flushed on time while idle") {
+        Hdf5Writer w("sls_hdf5_swmr_idle", 6, 4, 10, 2, 0);
+        w.file.CloseAllFiles();
+        remove(w.file.GetCurrentFileName().c_str());
+        w.swmr = true;
+        w.flushFrames = 0;
+        w.flushTime = 50;
+        w.file.CreateMasterFile(false, nullptr);
+        w.file.CreateFile();
+        std::string fname = w.file.GetCurrentFileName();
+        const char *dsetname = "/data_f000000000000";
+
+        for (uint64_t f = 0; f != 3; ++f) {
+            w.Write(f);
+        }
+        w.file.FlushIfIdle();
+        auto v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.written == 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        w.file.FlushIfIdle();
+        v = ReadSwmr(requests, views, fname, dsetname);
+        CHECK(v.extent == 4);
+        CHECK(v.written == 3);
+    }
+
+    SECTION("virtual file grows with the data file") {
+        Hdf5Writer w("sls_hdf5_swmr_virtual", 6, 4, 10, 2, 0);
+        w.file.CloseAllFiles();
+        remove(w.file.GetCurrentFileName().c_str());
+        w.swmr = true;
+        w.flushFrames = 2;
+        JungfrauMasterAttributes attr;
+        w.file.CreateMasterFile(true, &attr);
+        w.file.CreateFile();
+        std::string vname = w.filePath + "/" + w.fileName + "_virtual_0.h5";
+        for (uint64_t f = 0; f != 4; ++f) {
+            w.Write(f);
+        }
+        auto v = ReadSwmr(requests, views, vname, "/data");
+        CHECK(v.extent == 4);
+        CHECK(v.written == 4);
+        w.file.CloseAllFiles();
+        w.file.EndofAcquisition(true, 4);
+        remove(vname.c_str());
+        remove((w.filePath + "/" + w.fileName + "_master_0.h5").c_str());
+    }
+    close(requests);
+    close(views);
+    waitpid(reader, nullptr, 0);
+}
@@ -0,0 +1,107 @@
+#include "FileRotation.h"
+#include "IndexedFile.h"
+#include "catch.hpp"
+#include "receiver_defs.h"
+#include "test-File-global.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using rx_header_t = slsDetectorDefs::sls_receiver_header;
+
+TEST_CASE("Indexed file has page aligned images, headers and a directory",
+          "[receiver]") {
+    FileSettings s("sls_indexed", 6);
+    s.maxFramesPerFile = 4;
+    constexpr uint32_t nx = 40;
+    constexpr uint32_t ny = 30;
+    constexpr size_t imageSize = nx * ny * sizeof(uint16_t);
+
+    // frames out of order, the third one cut short by a call back
+    std::vector<uint64_t> fnums{101, 100, 102, 104, 103, 105};
+    {
+        IndexedFile file(0, &s.maxFramesPerFile, s.numDet, &s.fileName,
+                         &s.filePath, &s.fileIndex, &s.overwrite, &s.detIndex,
+                         &s.numUnits, &s.numImages, &s.dynamicRange, &s.port,
+                         nx, ny, &s.silent);
+        file.resetSubFileIndex();
+        file.CreateFile();
+        for (size_t i = 0; i != fnums.size(); ++i) {
+            size_t size = (i == 2) ? 1000 : imageSize;
+            std::vector<char> buffer(sizeof(rx_header_t) + size);
+            auto *h = reinterpret_cast<rx_header_t *>(buffer.data());
+            *h = rx_header_t{};
+            h->detHeader.frameNumber = fnums[i];
+            h->detHeader.row = static_cast<uint16_t>(i);
+            h->packetsMask.set(i);
+            memset(&buffer[sizeof(rx_header_t)], static_cast<char>('a' + i),
+                   size);
+            file.WriteToFile(buffer.data(), buffer.size(), i, 1);
+        }
+        file.CloseCurrentFile();
+    }
+
+    for (uint32_t k = 0; k != 2; ++k) {
+        std::string fname = s.DataFileName(k);
+        auto data = ReadFile(fname);
+        remove(fname.c_str());
+        indexed_file_superblock sb{};
+        REQUIRE(data.size() >= INDEXED_FILE_PAGE_SIZE);
+        memcpy(&sb, data.data(), sizeof(sb));
+        CHECK(std::string(sb.magic, sizeof(sb.magic)) == INDEXED_FILE_MAGIC);
+        CHECK(sb.version == INDEXED_FILE_VERSION);
+        CHECK(sb.complete == 1);
+        CHECK(sb.nPixelsX == nx);
+        CHECK(sb.nPixelsY == ny);
+        CHECK(sb.dynamicRange == 16);
+        size_t hsize = sb.headerSize;
+        CHECK(hsize == sizeof(slsDetectorDefs::sls_detector_header) +
+                           sizeof(slsDetectorDefs::bitset_storage));
+        uint64_t first = k * s.maxFramesPerFile;
+        uint64_t n = (k == 0) ? 4 : 2;
+        REQUIRE(sb.numFrames == n);
+        CHECK(sb.headerTableOffset % INDEXED_FILE_PAGE_SIZE == 0);
+        CHECK(sb.directoryOffset == sb.headerTableOffset + n * hsize);
+        REQUIRE(data.size() ==
+                sb.directoryOffset + n * sizeof(indexed_file_entry));
+
+        std::vector<indexed_file_entry> dir(n);
+        memcpy(dir.data(), &data[sb.directoryOffset],
+               n * sizeof(indexed_file_entry));
+        for (uint64_t j = 0; j != n; ++j) {
+            // sorted by frame number
+            if (j != 0) {
+                CHECK(dir[j].frameNumber > dir[j - 1].frameNumber);
+            }
+            uint64_t i = first + dir[j].record;
+            CHECK(dir[j].frameNumber == fnums[i]);
+            CHECK(dir[j].offset % INDEXED_FILE_PAGE_SIZE == 0);
+            CHECK(dir[j].size == ((i == 2) ? 1000 : imageSize));
+            CHECK(data[dir[j].offset] == static_cast<char>('a' + i));
+            CHECK(data[dir[j].offset + dir[j].size - 1] ==
+                  static_cast<char>('a' + i));
+
+            slsDetectorDefs::sls_detector_header h;
+            memcpy(&h, &data[sb.headerTableOffset + dir[j].record * hsize],
+                   sizeof(h));
+            CHECK(h.frameNumber == fnums[i]);
+            CHECK(h.row == i);
+            uint8_t mask = data[sb.headerTableOffset + dir[j].record * hsize +
+                                sizeof(h) + i / 8];
+            CHECK(mask == (1 << (i % 8)));
+        }
+    }
+    // only the files of the images
+    CHECK_FALSE(FileExists(s.DataFileName(2)));
+}
+
+TEST_CASE("Next sub file for frame counts beyond 32 bit", "[receiver]") {
+    CHECK_FALSE(FileRotation::HasNextFile(0, 0, 1000));
+    CHECK(FileRotation::HasNextFile(0, 10, 11));
+    CHECK_FALSE(FileRotation::HasNextFile(0, 10, 10));
+    // 2^32 frames do not wrap around to 0
+    CHECK(FileRotation::HasNextFile(65535, 65536, 5000000000ULL));
+    CHECK_FALSE(FileRotation::HasNextFile(65535, 65536, 4294967296ULL));
+}
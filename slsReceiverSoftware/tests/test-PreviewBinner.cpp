@@ -0,0 +1,112 @@
+#include "PreviewBinner.h"
+#include "catch.hpp"
+
+#include <cstring>
+#include <vector>
+
+using defs = slsDetectorDefs;
+
+namespace {
+template <typename T>
+std::vector<T> Binned(PreviewBinner &binner, const char *binned) {
+    std::vector<T> pixels(binner.GetNumPixelsX() * binner.GetNumPixelsY());
+    REQUIRE(binner.GetSize() == pixels.size() * sizeof(T));
+    memcpy(pixels.data(), binned, binner.GetSize());
+    return pixels;
+}
+} // namespace
+
+TEST_CASE("Preview binning sums blocks of 16 bit pixels", "[receiver]") {
+    // 4 x 2 pixels: 1 2 3 4
+    //               5 6 7 8
+    std::vector<uint16_t> image{1, 2, 3, 4, 5, 6, 7, 8};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 16, 4, 2,
+                             16, 2, defs::PREVIEW_BIN);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetNumPixelsX() == 2);
+    CHECK(binner.GetNumPixelsY() == 1);
+    CHECK(binner.GetDynamicRange() == 32);
+    CHECK(Binned<uint32_t>(binner, binned) ==
+          std::vector<uint32_t>{1 + 2 + 5 + 6, 3 + 4 + 7 + 8});
+}
+
+TEST_CASE("Preview max pooling keeps the dynamic range", "[receiver]") {
+    std::vector<uint16_t> image{1, 9, 3, 4, 5, 6, 7, 65535};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 16, 4, 2,
+                             16, 2, defs::PREVIEW_MAX);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetDynamicRange() == 16);
+    CHECK(Binned<uint16_t>(binner, binned) ==
+          std::vector<uint16_t>{9, 65535});
+}
+
+TEST_CASE("Preview blocks at the edges are smaller", "[receiver]") {
+    // 3 x 3 pixels binned by 2
+    std::vector<uint8_t> image{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 9, 3, 3, 8,
+                             2, defs::PREVIEW_BIN);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetNumPixelsX() == 2);
+    CHECK(binner.GetNumPixelsY() == 2);
+    CHECK(Binned<uint32_t>(binner, binned) ==
+          std::vector<uint32_t>{1 + 2 + 4 + 5, 3 + 6, 7 + 8, 9});
+}
+
+TEST_CASE("Preview of 4 bit images", "[receiver]") {
+    // 4 x 2 pixels, high nibble first: 1 2 3 4
+    //                                  5 6 7 15
+    std::vector<uint8_t> image{0x12, 0x34, 0x56, 0x7f};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 4, 4, 2, 4,
+                             2, defs::PREVIEW_BIN);
+    REQUIRE(binned != nullptr);
+    CHECK(Binned<uint32_t>(binner, binned) ==
+          std::vector<uint32_t>{1 + 2 + 5 + 6, 3 + 4 + 7 + 15});
+
+    binned = binner.Bin(reinterpret_cast<char *>(image.data()), 4, 4, 2, 4, 2,
+                        defs::PREVIEW_MAX);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetDynamicRange() == 8);
+    CHECK(Binned<uint8_t>(binner, binned) == std::vector<uint8_t>{6, 15});
+}
+
+TEST_CASE("Preview sums of 32 bit pixels saturate", "[receiver]") {
+    std::vector<uint32_t> image{0xFFFFFFF0, 0x20, 1, 2};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 16, 2, 2,
+                             32, 2, defs::PREVIEW_BIN);
+    REQUIRE(binned != nullptr);
+    CHECK(Binned<uint32_t>(binner, binned) ==
+          std::vector<uint32_t>{0xFFFFFFFF});
+}
+
+TEST_CASE("Preview carries the jungfrau gain bits", "[receiver]") {
+    // adc values with gain bits (g1 in the second, g2 in the last pixel)
+    std::vector<uint16_t> image{100, 0x4000 | 50, 200, 0xC000 | 10};
+    PreviewBinner binner;
+    auto binned = binner.Bin(reinterpret_cast<char *>(image.data()), 8, 2, 2,
+                             16, 2, defs::PREVIEW_BIN, 0xC000);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetGainMask() == 0xC0000000);
+    CHECK(Binned<uint32_t>(binner, binned) ==
+          std::vector<uint32_t>{0xC0000000 | (100 + 50 + 200 + 10)});
+
+    binned = binner.Bin(reinterpret_cast<char *>(image.data()), 8, 2, 2, 16, 2,
+                        defs::PREVIEW_MAX, 0xC000);
+    REQUIRE(binned != nullptr);
+    CHECK(binner.GetGainMask() == 0xC000);
+    CHECK(Binned<uint16_t>(binner, binned) ==
+          std::vector<uint16_t>{0xC000 | 200});
+}
+
+TEST_CASE("Preview of an image of another size fails", "[receiver]") {
+    std::vector<uint16_t> image(8);
+    PreviewBinner binner;
+    CHECK(binner.Bin(reinterpret_cast<char *>(image.data()), 14, 4, 2, 16, 2,
+                     defs::PREVIEW_BIN) == nullptr);
+    CHECK(binner.Bin(reinterpret_cast<char *>(image.data()), 16, 4, 2, 12, 2,
+                     defs::PREVIEW_BIN) == nullptr);
+}
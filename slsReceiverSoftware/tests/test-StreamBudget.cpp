@@ -0,0 +1,62 @@
+#include "StreamBudget.h"
+#include "catch.hpp"
+
+using ms = std::chrono::milliseconds;
+
+namespace {
+/** number of images of size streamed in steps of dt over duration */
+int Streamed(StreamBudget &budget, StreamBudget::Clock::time_point &now,
+             uint32_t size, ms dt, ms duration, bool congested = false) {
+    int n = 0;
+    for (auto end = now + duration; now < end; now += dt) {
+        if (budget.Take(size, congested, now)) {
+            ++n;
+        }
+    }
+    return n;
+}
+} // namespace
+
+TEST_CASE("No budget streams every image", "[receiver]") {
+    StreamBudget budget;
+    auto now = StreamBudget::Clock::now();
+    budget.Reset(0, now);
+    CHECK(Streamed(budget, now, 1000000, ms(1), ms(1000), true) == 1000);
+    CHECK(budget.GetRateFraction() == 1);
+}
+
+TEST_CASE("Budget limits the streamed bytes per second", "[receiver]") {
+    // 10 MB/s of 1 MB images offered at 1 kHz: 1 MB burst + 10 per second
+    StreamBudget budget;
+    auto now = StreamBudget::Clock::now();
+    budget.Reset(10, now);
+    CHECK(budget.GetBudget() == 10e6);
+    int n = Streamed(budget, now, 1000000, ms(1), ms(1000));
+    CHECK((n == 10 || n == 11));
+    n = Streamed(budget, now, 1000000, ms(1), ms(1000));
+    CHECK((n == 10 || n == 11));
+}
+
+TEST_CASE("Images larger than the burst still get streamed", "[receiver]") {
+    // 100 ms burst is 0.1 MB, one 1 MB image per second
+    StreamBudget budget;
+    auto now = StreamBudget::Clock::now();
+    budget.Reset(1, now);
+    int n = Streamed(budget, now, 1000000, ms(10), ms(10000));
+    CHECK((n == 9 || n == 10));
+}
+
+TEST_CASE("Congestion backs off and recovers", "[receiver]") {
+    StreamBudget budget;
+    auto now = StreamBudget::Clock::now();
+    budget.Reset(100, now);
+    Streamed(budget, now, 1000, ms(1), ms(201), true);
+    CHECK(budget.GetRateFraction() == 0.25);
+    Streamed(budget, now, 1000, ms(1), ms(2000), true);
+    CHECK(budget.GetRateFraction() == 1.0 / 64);
+    Streamed(budget, now, 1000, ms(1), ms(2000));
+    CHECK(budget.GetRateFraction() == 1);
+
+    budget.Reset(100, now);
+    CHECK(budget.GetRateFraction() == 1);
+}
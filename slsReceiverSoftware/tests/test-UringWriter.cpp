@@ -0,0 +1,78 @@
+#include "UringWriter.h"
+#include "catch.hpp"
+#include "sls/sls_detector_exceptions.h"
+#include "test-File-global.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+std::string TempFileName() {
+    return "/tmp/sls_uring_writer_" + std::to_string(getpid()) + ".raw";
+}
+
+std::unique_ptr<UringWriter> MakeWriter(unsigned depth) {
+    try {
+        return std::unique_ptr<UringWriter>(new UringWriter(depth));
+    } catch (const sls::RuntimeError &e) {
+        WARN(e.what());
+        return nullptr;
+    }
+}
+} // namespace
+
+TEST_CASE("io_uring writer releases buffers in order once written",
+          "[receiver]") {
+    auto w = MakeWriter(4);
+    if (w == nullptr) {
+        return;
+    }
+    auto fname = TempFileName();
+    // more frames than the queue depth, from registered memory
+    constexpr size_t nframes = 10;
+    constexpr size_t fsize = 3000;
+    std::vector<char> memory(nframes * fsize);
+    for (size_t i = 0; i != nframes; ++i) {
+        std::fill_n(memory.begin() + i * fsize, fsize,
+                    static_cast<char>('a' + i));
+    }
+    w->RegisterBuffers(memory.data(), memory.size());
+    w->Open(fname, true);
+    w->Preallocate(memory.size() * 2);
+    std::vector<char *> done;
+    for (size_t i = 0; i != nframes; ++i) {
+        w->Write(memory.data() + i * fsize, fsize);
+        w->GetCompleted(done, false);
+    }
+    CHECK(w->HasPending() == (done.size() != nframes));
+    w->Close();
+    CHECK_FALSE(w->IsOpen());
+    w->GetCompleted(done, false);
+    CHECK_FALSE(w->HasPending());
+    REQUIRE(done.size() == nframes);
+    for (size_t i = 0; i != nframes; ++i) {
+        CHECK(done[i] == memory.data() + i * fsize);
+    }
+    CHECK(ReadFile(fname) == memory);
+    remove(fname.c_str());
+}
+
+TEST_CASE("io_uring writer does not overwrite unless enabled", "[receiver]") {
+    auto w = MakeWriter(4);
+    if (w == nullptr) {
+        return;
+    }
+    auto fname = TempFileName();
+    w->Open(fname, true);
+    w->Close();
+    REQUIRE_THROWS_AS(w->Open(fname, false), sls::RuntimeError);
+    CHECK_FALSE(w->IsOpen());
+    char data[] = "abc";
+    REQUIRE_THROWS_AS(w->Write(data, 3), sls::RuntimeError);
+    CHECK_FALSE(w->HasPending());
+    remove(fname.c_str());
+}
@@ -0,0 +1,103 @@
+#pragma once
+/************************************************
+ * @file FrameReorderer.h
+ * @short puts results of frames processed out of order back into frame order
+ ***********************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace sls {
+
+/**
+ * Collects results of frames processed out of order, eg. by a pool of workers
+ * pulling the frames pushed by the receivers (rx_zmqsocket push) and sending
+ * their results to one collector, and hands them out in frame order. Results
+ * are keyed by the frame index of the zmq header. Frames that never arrive
+ * (not streamed, lost or not taken by any worker) are skipped once more than
+ * window results are pending, or when flushing at the end of an acquisition.
+ */
+template <typename T> class FrameReorderer {
+  public:
+    /**
+     * @param window number of results to hold back waiting for a missing
+     * frame before skipping it
+     * @param firstIndex frame index of the first result
+     */
+    explicit FrameReorderer(size_t window = 1000, uint64_t firstIndex = 0)
+        : window(window), nextIndex(firstIndex) {}
+
+    /**
+     * Adds the result of a frame
+     * @returns false if the frame was already handed out or skipped, or is
+     * already pending
+     */
+    bool Push(uint64_t frameIndex, T result) {
+        if (frameIndex < nextIndex) {
+            return false;
+        }
+        return pending.emplace(frameIndex, std::move(result)).second;
+    }
+
+    /**
+     * Takes the next result in frame order
+     * @param frameIndex frame index of the result
+     * @param result result
+     * @returns false if the next frame is still missing
+     */
+    bool Pop(uint64_t &frameIndex, T &result) {
+        if (pending.empty() ||
+            (pending.begin()->first != nextIndex && pending.size() <= window)) {
+            return false;
+        }
+        return Take(frameIndex, result);
+    }
+
+    /**
+     * Takes the next pending result, skipping missing frames (at the end of
+     * an acquisition)
+     * @returns false if no result is pending
+     */
+    bool Flush(uint64_t &frameIndex, T &result) {
+        if (pending.empty()) {
+            return false;
+        }
+        return Take(frameIndex, result);
+    }
+
+    /** Drops pending results to start again from firstIndex */
+    void Reset(uint64_t firstIndex = 0) {
+        pending.clear();
+        nextIndex = firstIndex;
+        numSkipped = 0;
+    }
+
+    /** frame index of the next result in order */
+    uint64_t GetNextIndex() const { return nextIndex; }
+
+    /** number of results held back */
+    size_t GetNumPending() const { return pending.size(); }
+
+    /** number of missing frames skipped */
+    uint64_t GetNumSkipped() const { return numSkipped; }
+
+  private:
+    bool Take(uint64_t &frameIndex, T &result) {
+        auto it = pending.begin();
+        numSkipped += it->first - nextIndex;
+        frameIndex = it->first;
+        result = std::move(it->second);
+        nextIndex = frameIndex + 1;
+        pending.erase(it);
+        return true;
+    }
+
+    std::map<uint64_t, T> pending;
+    size_t window;
+    uint64_t nextIndex;
+    uint64_t numSkipped{0};
+};
+
+} // namespace sls
@@ -30,6 +30,12 @@ std::string ToString(const defs::speedLevel s);
 std::string ToString(const defs::timingMode s);
 std::string ToString(const defs::frameDiscardPolicy s);
 std::string ToString(const defs::fileFormat s);
+std::string ToString(const defs::udpBackend s);
+std::string ToString(const defs::fileCompression s);
+std::string ToString(const defs::previewMode s);
+std::string ToString(const defs::streamingSocketType s);
+std::string ToString(const defs::rxThreadType s);
+std::string ToString(const defs::rxSchedPolicy s);
 std::string ToString(const defs::externalSignalFlag s);
 std::string ToString(const defs::readoutMode s);
 std::string ToString(const defs::dacIndex s);
@@ -50,6 +56,9 @@ std::ostream &operator<<(std::ostream &os,
 std::string ToString(const slsDetectorDefs::scanParameters &r);
 std::ostream &operator<<(std::ostream &os,
                          const slsDetectorDefs::scanParameters &r);
+std::string ToString(const slsDetectorDefs::rxThreadAffinity &r);
+std::ostream &operator<<(std::ostream &os,
+                         const slsDetectorDefs::rxThreadAffinity &r);
 const std::string &ToString(const std::string &s);
 /** Convert std::chrono::duration with specified output unit */
 template <typename T, typename Rep = double>
@@ -279,6 +288,13 @@ template <> defs::speedLevel StringTo(const std::string &s);
 template <> defs::timingMode StringTo(const std::string &s);
 template <> defs::frameDiscardPolicy StringTo(const std::string &s);
 template <> defs::fileFormat StringTo(const std::string &s);
+template <> defs::udpBackend StringTo(const std::string &s);
+
+template <> defs::fileCompression StringTo(const std::string &s);
+template <> defs::previewMode StringTo(const std::string &s);
+template <> defs::streamingSocketType StringTo(const std::string &s);
+template <> defs::rxThreadType StringTo(const std::string &s);
+template <> defs::rxSchedPolicy StringTo(const std::string &s);
 template <> defs::externalSignalFlag StringTo(const std::string &s);
 template <> defs::readoutMode StringTo(const std::string &s);
 template <> defs::dacIndex StringTo(const std::string &s);
@@ -0,0 +1,38 @@
+#pragma once
+/*
+Interface of the udp packet receivers used in the receiver listener loop.
+Implemented by UdpRxSocket (bound udp socket) and UdpRxPacketRing (AF_PACKET
+memory mapped ring)
+*/
+
+#include <sys/types.h> //ssize_t
+
+namespace sls {
+
+class UdpRxBase {
+  public:
+    virtual ~UdpRxBase() = default;
+    virtual ssize_t getPacketSize() const noexcept = 0;
+    virtual int getBufferSize() const = 0;
+    virtual void Shutdown() = 0;
+
+    // The receive functions return <= 0 if no packet arrives within
+    // timeout_us microseconds. 0 waits for a packet (default)
+    virtual void setReceiveTimeout(int timeout_us) = 0;
+
+    // Receives one packet to dst. Drops the eiger header packets (40 bytes)
+    // and bad packets (8 bytes). Returns the packet size, <= 0 on shutdown
+    virtual ssize_t ReceiveDataOnly(char *dst) noexcept = 0;
+
+    // Receives up to max_packets packets, blocking only until the first
+    // packet arrives. Packets are placed packet size apart starting at dst.
+    // Returns number of packets received, 0 on shutdown and -1 on error
+    virtual int ReceiveBatch(char *dst, int max_packets) = 0;
+
+    // Receives one packet, the first header_size bytes into header and the
+    // rest into data. Returns the packet size, <= 0 on shutdown
+    virtual ssize_t ReceiveScattered(char *header, size_t header_size,
+                                     char *data) noexcept = 0;
+};
+
+} // namespace sls
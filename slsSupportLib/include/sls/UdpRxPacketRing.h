@@ -0,0 +1,62 @@
+#pragma once
+/*
+Receives the udp packets of one port from an AF_PACKET TPACKET_V3 memory
+mapped ring (PACKET_RX_RING). Whole blocks of packets are handed over by the
+kernel, so there is no system call per packet. Requires CAP_NET_RAW, throws
+otherwise. Only IPv4 without fragmentation is supported.
+*/
+
+#include "sls/UdpRxBase.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sls {
+
+class UdpRxPacketRing : public UdpRxBase {
+    const ssize_t packet_size_;
+    const uint16_t port_;
+    int sockfd_{-1};
+    int sinkfd_{-1};
+    int eventfd_{-1};
+    char *ring_{nullptr};
+    size_t block_size_{0};
+    size_t num_blocks_{0};
+    std::atomic<bool> shutdown_{false};
+    int timeout_us_{0};
+
+    // position in the ring
+    size_t block_index_{0};
+    uint32_t packets_left_{0};
+    char *next_packet_{nullptr};
+
+  public:
+    // ifname is the interface name, nullptr or empty listens to all.
+    // ring_size is the minimum size of the ring in bytes
+    UdpRxPacketRing(int port, ssize_t packet_size,
+                    const char *ifname = nullptr, int ring_size = 0);
+    ~UdpRxPacketRing() override;
+    UdpRxPacketRing(const UdpRxPacketRing &) = delete;
+    UdpRxPacketRing &operator=(const UdpRxPacketRing &) = delete;
+
+    ssize_t getPacketSize() const noexcept override;
+    // size of the ring in bytes
+    int getBufferSize() const override;
+    void Shutdown() override;
+    // partial blocks are handed over only after 8 ms
+    void setReceiveTimeout(int timeout_us) override;
+    ssize_t ReceiveDataOnly(char *dst) noexcept override;
+    int ReceiveBatch(char *dst, int max_packets) override;
+    ssize_t ReceiveScattered(char *header, size_t header_size,
+                             char *data) noexcept override;
+
+  private:
+    // Points payload to the udp payload of the next packet for this port,
+    // waiting for the kernel if blocking. Returns payload size, 0 if not
+    // blocking and no packet is ready and -1 on shutdown or timeout
+    ssize_t NextPayload(const char *&payload, bool blocking) noexcept;
+    void ReleaseBlock() noexcept;
+    void Close() noexcept;
+};
+
+} // namespace sls
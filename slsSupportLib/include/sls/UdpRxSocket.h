@@ -5,26 +5,53 @@ UDP socket class to receive data. The intended use is in the
 receiver listener loop. Should be used RAII style...
 */
 
-#include <sys/types.h> //ssize_t
+#include "sls/UdpRxBase.h"
+#include <sys/socket.h> //mmsghdr
+#include <sys/types.h>  //ssize_t
+#include <sys/uio.h>    //iovec
+#include <vector>
+
 namespace sls {
 
-class UdpRxSocket {
+class UdpRxSocket : public UdpRxBase {
     const ssize_t packet_size_;
     int sockfd_{-1};
+    std::vector<mmsghdr> msgs_;
+    std::vector<iovec> iovs_;
 
   public:
+    // reuse_port allows several sockets to bind the same port (SO_REUSEPORT)
     UdpRxSocket(int port, ssize_t packet_size, const char *hostname = nullptr,
-                int kernel_buffer_size = 0);
-    ~UdpRxSocket();
+                int kernel_buffer_size = 0, bool reuse_port = false);
+    ~UdpRxSocket() override;
     bool ReceivePacket(char *dst) noexcept;
-    int getBufferSize() const;
+    int getBufferSize() const override;
     void setBufferSize(int size);
-    ssize_t getPacketSize() const noexcept;
-    void Shutdown();
+    void setReceiveTimeout(int timeout_us) override;
+
+    // Distributes the packets of the reuse port group of this socket over
+    // its num_sockets sockets (in order of binding) by the byte at
+    // byte_offset of the payload, eg. low byte of the frame number. Instead
+    // of the kernel hash, which puts all packets of one sender on one socket
+    void ShardReusePortGroup(int num_sockets, int byte_offset = 0);
+    ssize_t getPacketSize() const noexcept override;
+    void Shutdown() override;
 
     // Only for backwards compatibility, this drops the EIGER small pkt, may be
     // removed
-    ssize_t ReceiveDataOnly(char *dst) noexcept;
+    ssize_t ReceiveDataOnly(char *dst) noexcept override;
+
+    // Receives up to max_packets packets with one recvmmsg call, blocking
+    // only until the first packet arrives. Packets are placed packet_size
+    // apart starting at dst. Drops the same small packets as ReceiveDataOnly.
+    // Returns number of packets received, 0 on shutdown and -1 on error
+    int ReceiveBatch(char *dst, int max_packets) override;
+
+    // Receives one packet with recvmsg, scattering the first header_size
+    // bytes into header and the rest directly into data. Drops the same
+    // small packets as ReceiveDataOnly. Returns the packet size
+    ssize_t ReceiveScattered(char *header, size_t header_size,
+                             char *data) noexcept override;
 };
 
 } // namespace sls
@@ -12,6 +12,21 @@
 
 #define MAX_STR_LENGTH 1000
 
+/** longest wait of a push server for a client to take a message */
+#define ZMQ_PUSH_SEND_TIMEOUT_MS 1000
+
+/** a push server publishes the end of acquisition on its port plus this
+ * offset (clear of the stream, preview and push port ranges) */
+#define ZMQ_PUSH_END_PORT_OFFSET 3000
+
+/** a pulling client still takes the frames arriving for so long after the
+ * end of acquisition, which comes on the other socket */
+#define ZMQ_PULL_END_DRAIN_MS 100
+
+/** SendHeader of a push server without a client that can take the frame,
+ * nothing sent */
+#define ZMQ_SEND_SKIPPED (-1)
+
 // #define ZMQ_DETAIL
 #define ROIVERBOSITY
 
@@ -68,6 +83,54 @@ struct zmqHeader {
     std::map<std::string, std::string> addJsonHeader;
 };
 
+/** first 4 bytes of a binary header ("SZBH"), a json header starts with '{' */
+#define ZMQ_BINARY_HEADER_MAGIC (0x48425a53)
+/** layout version of the binary header */
+#define ZMQ_BINARY_HEADER_VERSION (1)
+
+/**
+ * binary zmq header, fixed layout of zmqHeader (little endian). It is
+ * followed by the file name (fnameLength bytes) and numAddJsonHeader key
+ * value pairs of the additional json header, each key and value as a uint16
+ * length and its characters. headerSize is the size of this structure, later
+ * versions only append members.
+ */
+struct __attribute__((packed)) zmqBinaryHeader {
+    uint32_t magic;
+    uint16_t binaryVersion;
+    uint16_t headerSize;
+    uint32_t jsonversion;
+    uint32_t dynamicRange;
+    uint64_t fileIndex;
+    uint32_t ndetx;
+    uint32_t ndety;
+    uint32_t npixelsx;
+    uint32_t npixelsy;
+    uint32_t imageSize;
+    uint64_t acqIndex;
+    uint64_t frameIndex;
+    double progress;
+    uint64_t frameNumber;
+    uint32_t expLength;
+    uint32_t packetNumber;
+    uint64_t bunchId;
+    uint64_t timestamp;
+    uint16_t modId;
+    uint16_t row;
+    uint16_t column;
+    uint16_t reserved;
+    uint32_t debug;
+    uint16_t roundRNumber;
+    uint8_t detType;
+    uint8_t version;
+    int32_t flippedDataX;
+    uint32_t quad;
+    uint8_t data;
+    uint8_t completeImage;
+    uint16_t fnameLength;
+    uint16_t numAddJsonHeader;
+};
+
 class ZmqSocket {
 
   public:
@@ -82,16 +145,35 @@ class ZmqSocket {
      * Creates socket, context and connects to server
      * @param hostname_or_ip hostname or ip of server
      * @param portnumber port number
+     * @param pull true to pull from a push server (frames shared among the
+     * clients), false to subscribe to a publishing server (every frame). A
+     * pulling client also subscribes to the end of acquisition on
+     * portnumber + ZMQ_PUSH_END_PORT_OFFSET
      */
-    ZmqSocket(const char *const hostname_or_ip, const uint32_t portnumber);
+    ZmqSocket(const char *const hostname_or_ip, const uint32_t portnumber,
+              bool pull = false);
 
     /**
      * Constructor for a server
      * Creates socket, context and connects to server
      * @param portnumber port number
      * @param ethip is the ip of the ethernet interface to stream zmq from
+     * @param push true to push each frame to one of the connected clients
+     * (load balanced) and publish the end of acquisition to all of them on
+     * portnumber + ZMQ_PUSH_END_PORT_OFFSET, false to publish every frame to
+     * every client
      */
-    ZmqSocket(const uint32_t portnumber, const char *ethip);
+    ZmqSocket(const uint32_t portnumber, const char *ethip, bool push = false);
+
+    /** Returns true if a push server or pull client */
+    bool IsLoadBalanced() const { return loadBalanced; }
+
+    /**
+     * Returns true if a message can be sent without waiting. A push server
+     * waits when no client is connected or all of them are full (high water
+     * mark), a publisher never waits
+     */
+    bool CanSend();
 
     /** Returns high water mark for outbound messages */
     int GetSendHighWaterMark();
@@ -99,6 +181,12 @@ class ZmqSocket {
     /** Sets high water mark for outbound messages. Default 1000 (zmqlib) */
     void SetSendHighWaterMark(int limit);
 
+    /**
+     * Sets how long messages still queued are kept on close, 0 drops them
+     * (zero copy ones are released), -1 waits until sent. Default -1 (zmqlib)
+     */
+    void SetLinger(int value);
+
     /** Returns high water mark for inbound messages */
     int GetReceiveHighWaterMark();
 
@@ -129,12 +217,22 @@ class ZmqSocket {
     void Disconnect() { sockfd.Disconnect(); }
 
     /**
-     * Send Message Header
+     * Send headers in the binary format instead of json. Receiving detects
+     * the format of each header
+     * @param enable true for binary, false for json (default)
+     */
+    void SetBinaryHeader(bool enable) { binaryHeader = enable; }
+
+    /**
+     * Send Message Header. A push server pushes a header with data to one
+     * client, without waiting, and publishes the end of acquisition header to
+     * every client
      * @param index self index for debugging
      * @param header zmq header (from json)
-     * @returns 0 if error, else 1
+     * @returns 0 if error, ZMQ_SEND_SKIPPED if no client of a push server
+     * can take it (the data is not to be sent either), else 1
      */
-    int SendHeader(int index, zmqHeader header);
+    int SendHeader(int index, const zmqHeader &header);
 
     /**
      * Send Message Body
@@ -144,6 +242,19 @@ class ZmqSocket {
      */
     int SendData(char *buf, int length);
 
+    /**
+     * Send Message Body without copying it. buf has to stay valid until zmq
+     * calls release, possibly from its io thread, once the message is sent
+     * to all subscribers or dropped
+     * @param buf message
+     * @param length length of message
+     * @param release called with buf and hint when zmq is done with buf
+     * @param hint passed on to release
+     * @returns 0 if error (release has been called), else 1
+     */
+    int SendDataZeroCopy(char *buf, int length,
+                         void (*release)(void *, void *), void *hint);
+
     /**
      * Receive Header
      * @param index self index for debugging
@@ -169,6 +280,18 @@ class ZmqSocket {
     void PrintError();
 
   private:
+    /**
+     * Waits for a message of a pulling client, a frame or the end of
+     * acquisition. The end is returned once no frame arrived for
+     * ZMQ_PULL_END_DRAIN_MS, so that it follows the frames pushed before it
+     * @param index self index for debugging
+     * @param zHeader end of acquisition header
+     * @param version version that has to match
+     * @returns 1 if a frame is ready to be read, 0 at the end of acquisition,
+     * -1 if error
+     */
+    int PollPullClient(const int index, zmqHeader &zHeader, uint32_t version);
+
     /**
      * Receive Message
      * @param index self index for debugging
@@ -189,6 +312,30 @@ class ZmqSocket {
     int ParseHeader(const int index, int length, char *buff, zmqHeader &zHeader,
                     uint32_t version);
 
+    /**
+     * Writes the json header into header_buffer
+     * @returns length of header
+     */
+    int EncodeJsonHeader(const zmqHeader &header);
+
+    /**
+     * Writes the binary header into header_buffer
+     * @returns length of header, -1 if it does not fit
+     */
+    int EncodeBinaryHeader(const zmqHeader &header);
+
+    /**
+     * Parse Binary Header
+     * @param index self index for debugging
+     * @param length length of message
+     * @param buff message
+     * @param zHeader filled out zmqHeader structure
+     * @param version json version that has to match
+     * @returns true if successful else false
+     */
+    int DecodeBinaryHeader(const int index, int length, const char *buff,
+                           zmqHeader &zHeader, uint32_t version);
+
     /**
      * Class to close socket descriptors automatically
      * upon encountering exceptions in the ZmqSocket constructor
@@ -211,6 +358,10 @@ class ZmqSocket {
         void *contextDescriptor;
         /** Socket Descriptor */
         void *socketDescriptor;
+        /** End of acquisition address (push server or pull client) */
+        std::string controlAddress;
+        /** End of acquisition socket (push server or pull client) */
+        void *controlDescriptor{nullptr};
     };
 
     /** Port Number */
@@ -219,6 +370,16 @@ class ZmqSocket {
     /** Socket descriptor */
     mySocketDescriptors sockfd;
 
+    /** push server or pull client */
+    bool loadBalanced{false};
+
+    /** a pulling client received the end of acquisition, to be returned
+     * after the frames still arriving */
+    bool endPending{false};
+
+    /** send binary instead of json headers */
+    bool binaryHeader{false};
+
     std::unique_ptr<char[]> header_buffer =
         sls::make_unique<char[]>(MAX_STR_LENGTH);
 };
@@ -31,10 +31,12 @@
 #define MAX_RX_DBIT 64
 
 /** default ports */
-#define DEFAULT_PORTNO        1952
-#define DEFAULT_UDP_PORTNO    50001
-#define DEFAULT_ZMQ_CL_PORTNO 30001
-#define DEFAULT_ZMQ_RX_PORTNO 30001
+#define DEFAULT_PORTNO                1952
+#define DEFAULT_UDP_PORTNO            50001
+#define DEFAULT_ZMQ_CL_PORTNO         30001
+#define DEFAULT_ZMQ_RX_PORTNO         30001
+#define DEFAULT_ZMQ_RX_PREVIEW_PORTNO 31001
+#define DEFAULT_ZMQ_RX_PUSH_PORTNO    32001
 
 #define SLS_DETECTOR_HEADER_VERSION      0x2
 #define SLS_DETECTOR_JSON_HEADER_VERSION 0x4
@@ -65,9 +67,14 @@
 #define MAX_PATTERN_LENGTH 0x2000
 
 #define DEFAULT_STREAMING_TIMER_IN_MS 500
+#define DEFAULT_PREVIEW_TIMER_IN_MS   200
+/** largest binning factor of the receiver preview stream */
+#define MAX_PREVIEW_BINNING 64
 
 #define NUM_RX_THREAD_IDS 8
 
+#define MAX_RX_CPUS 256
+
 #ifdef __cplusplus
 class slsDetectorDefs {
   public:
@@ -153,7 +160,36 @@ class slsDetectorDefs {
         NUM_DISCARD_POLICIES
     };
 
-    enum fileFormat { BINARY, HDF5, NUM_FILE_FORMATS };
+    enum fileFormat { BINARY, HDF5, INDEXED, NUM_FILE_FORMATS };
+
+    enum udpBackend { UDP_SOCKET, PACKET_RING, NUM_UDP_BACKENDS };
+
+    enum fileCompression {
+        NO_COMPRESSION,
+        BITSHUFFLE_LZ4,
+        BITSHUFFLE_ZSTD,
+        NUM_FILE_COMPRESSIONS
+    };
+
+    enum previewMode { PREVIEW_BIN, PREVIEW_MAX, NUM_PREVIEW_MODES };
+
+    enum streamingSocketType {
+        STREAM_PUB,
+        STREAM_PUSH,
+        STREAM_PUB_PUSH,
+        NUM_STREAMING_SOCKET_TYPES
+    };
+
+    enum rxThreadType {
+        LISTENER_THREAD,
+        PROCESSOR_THREAD,
+        STREAMER_THREAD,
+        TCP_THREAD,
+        WRITER_THREAD,
+        NUM_RX_THREAD_TYPES
+    };
+
+    enum rxSchedPolicy { RX_SCHED_OTHER, RX_SCHED_FIFO, NUM_RX_SCHED_POLICIES };
 
     /**
         @short structure for a region of interest
@@ -425,6 +461,41 @@ typedef struct {
         }
     } __attribute__((packed));
 
+    /** cpu affinity and scheduling of a receiver thread */
+    struct rxThreadAffinity {
+        rxThreadType thread{LISTENER_THREAD};
+        /** udp interface index, 0 for the tcp thread */
+        int index{0};
+        /** bit i set to run on cpu i, none set to run on any cpu */
+        uint64_t cpuMask[MAX_RX_CPUS / 64]{};
+        rxSchedPolicy policy{RX_SCHED_OTHER};
+        /** 1-99 for fifo, 0 for other */
+        int priority{0};
+
+        rxThreadAffinity() = default;
+        rxThreadAffinity(rxThreadType t, int i) : thread(t), index(i) {}
+        bool hasCpu(int cpu) const {
+            return ((cpuMask[cpu / 64] >> (cpu % 64)) & 1U) != 0U;
+        }
+        void addCpu(int cpu) { cpuMask[cpu / 64] |= (1ULL << (cpu % 64)); }
+        bool anyCpu() const {
+            for (int i = 0; i < MAX_RX_CPUS / 64; ++i) {
+                if (cpuMask[i] != 0U)
+                    return false;
+            }
+            return true;
+        }
+        bool operator==(const rxThreadAffinity &other) const {
+            for (int i = 0; i < MAX_RX_CPUS / 64; ++i) {
+                if (cpuMask[i] != other.cpuMask[i])
+                    return false;
+            }
+            return ((thread == other.thread) && (index == other.index) &&
+                    (policy == other.policy) &&
+                    (priority == other.priority));
+        }
+    } __attribute__((packed));
+
     /**
      * structure to udpate receiver
      */
@@ -320,6 +320,64 @@ enum detFuncs {
     F_RECEIVER_SET_THRESHOLD,
     F_GET_RECEIVER_STREAMING_HWM,
     F_SET_RECEIVER_STREAMING_HWM,
+    F_GET_RECEIVER_UDP_BATCH_SIZE,
+    F_SET_RECEIVER_UDP_BATCH_SIZE,
+    F_GET_RECEIVER_UDP_ZERO_COPY,
+    F_SET_RECEIVER_UDP_ZERO_COPY,
+    F_GET_RECEIVER_UDP_BACKEND,
+    F_SET_RECEIVER_UDP_BACKEND,
+    F_GET_RECEIVER_FIFO_HUGEPAGES,
+    F_SET_RECEIVER_FIFO_HUGEPAGES,
+    F_GET_RECEIVER_FIFO_MLOCK,
+    F_SET_RECEIVER_FIFO_MLOCK,
+    F_GET_RECEIVER_THREAD_AFFINITY,
+    F_SET_RECEIVER_THREAD_AFFINITY,
+    F_GET_RECEIVER_UDP_THREADS,
+    F_SET_RECEIVER_UDP_THREADS,
+    F_GET_RECEIVER_FRAME_WINDOW,
+    F_SET_RECEIVER_FRAME_WINDOW,
+    F_GET_RECEIVER_FRAME_TIMEOUT,
+    F_SET_RECEIVER_FRAME_TIMEOUT,
+    F_GET_RECEIVER_FILE_DIRECT_IO,
+    F_SET_RECEIVER_FILE_DIRECT_IO,
+    F_GET_RECEIVER_FILE_IO_URING,
+    F_SET_RECEIVER_FILE_IO_URING,
+    F_GET_RECEIVER_HDF5_CHUNK_FRAMES,
+    F_SET_RECEIVER_HDF5_CHUNK_FRAMES,
+    F_GET_RECEIVER_HDF5_CHUNK_ROWS,
+    F_SET_RECEIVER_HDF5_CHUNK_ROWS,
+    F_GET_RECEIVER_HDF5_COMPOUND_HEADER,
+    F_SET_RECEIVER_HDF5_COMPOUND_HEADER,
+    F_GET_RECEIVER_HDF5_WRITER_PROCESS,
+    F_SET_RECEIVER_HDF5_WRITER_PROCESS,
+    F_GET_RECEIVER_HDF5_SWMR,
+    F_SET_RECEIVER_HDF5_SWMR,
+    F_GET_RECEIVER_HDF5_FLUSH_FRAMES,
+    F_SET_RECEIVER_HDF5_FLUSH_FRAMES,
+    F_GET_RECEIVER_HDF5_FLUSH_TIME,
+    F_SET_RECEIVER_HDF5_FLUSH_TIME,
+    F_GET_RECEIVER_FILE_COMPRESSION,
+    F_SET_RECEIVER_FILE_COMPRESSION,
+    F_GET_RECEIVER_COMPRESSION_THREADS,
+    F_SET_RECEIVER_COMPRESSION_THREADS,
+    F_GET_RECEIVER_STREAMING_ZERO_COPY,
+    F_SET_RECEIVER_STREAMING_ZERO_COPY,
+    F_GET_RECEIVER_STREAMING_BINARY_HEADER,
+    F_SET_RECEIVER_STREAMING_BINARY_HEADER,
+    F_GET_RECEIVER_STREAMING_PREVIEW_BINNING,
+    F_SET_RECEIVER_STREAMING_PREVIEW_BINNING,
+    F_GET_RECEIVER_STREAMING_PREVIEW_MODE,
+    F_SET_RECEIVER_STREAMING_PREVIEW_MODE,
+    F_GET_RECEIVER_STREAMING_PREVIEW_TIMER,
+    F_SET_RECEIVER_STREAMING_PREVIEW_TIMER,
+    F_GET_RECEIVER_STREAMING_PREVIEW_PORT,
+    F_SET_RECEIVER_STREAMING_PREVIEW_PORT,
+    F_GET_RECEIVER_STREAMING_SOCKET_TYPE,
+    F_SET_RECEIVER_STREAMING_SOCKET_TYPE,
+    F_GET_RECEIVER_STREAMING_PUSH_PORT,
+    F_SET_RECEIVER_STREAMING_PUSH_PORT,
+    F_GET_RECEIVER_STREAMING_BANDWIDTH,
+    F_SET_RECEIVER_STREAMING_BANDWIDTH,
 
     NUM_REC_FUNCTIONS
 };
@@ -641,6 +699,64 @@ const char* getFunctionNameFromEnum(enum detFuncs func) {
     case F_RECEIVER_SET_THRESHOLD:          return "F_RECEIVER_SET_THRESHOLD";
     case F_GET_RECEIVER_STREAMING_HWM:      return "F_GET_RECEIVER_STREAMING_HWM";
     case F_SET_RECEIVER_STREAMING_HWM:      return "F_SET_RECEIVER_STREAMING_HWM";
+    case F_GET_RECEIVER_UDP_BATCH_SIZE:     return "F_GET_RECEIVER_UDP_BATCH_SIZE";
+    case F_SET_RECEIVER_UDP_BATCH_SIZE:     return "F_SET_RECEIVER_UDP_BATCH_SIZE";
+    case F_GET_RECEIVER_UDP_ZERO_COPY:      return "F_GET_RECEIVER_UDP_ZERO_COPY";
+    case F_SET_RECEIVER_UDP_ZERO_COPY:      return "F_SET_RECEIVER_UDP_ZERO_COPY";
+    case F_GET_RECEIVER_UDP_BACKEND:        return "F_GET_RECEIVER_UDP_BACKEND";
+    case F_SET_RECEIVER_UDP_BACKEND:        return "F_SET_RECEIVER_UDP_BACKEND";
+    case F_GET_RECEIVER_FIFO_HUGEPAGES:     return "F_GET_RECEIVER_FIFO_HUGEPAGES";
+    case F_SET_RECEIVER_FIFO_HUGEPAGES:     return "F_SET_RECEIVER_FIFO_HUGEPAGES";
+    case F_GET_RECEIVER_FIFO_MLOCK:         return "F_GET_RECEIVER_FIFO_MLOCK";
+    case F_SET_RECEIVER_FIFO_MLOCK:         return "F_SET_RECEIVER_FIFO_MLOCK";
+    case F_GET_RECEIVER_THREAD_AFFINITY:    return "F_GET_RECEIVER_THREAD_AFFINITY";
+    case F_SET_RECEIVER_THREAD_AFFINITY:    return "F_SET_RECEIVER_THREAD_AFFINITY";
+    case F_GET_RECEIVER_UDP_THREADS:        return "F_GET_RECEIVER_UDP_THREADS";
+    case F_SET_RECEIVER_UDP_THREADS:        return "F_SET_RECEIVER_UDP_THREADS";
+    case F_GET_RECEIVER_FRAME_WINDOW:       return "F_GET_RECEIVER_FRAME_WINDOW";
+    case F_SET_RECEIVER_FRAME_WINDOW:       return "F_SET_RECEIVER_FRAME_WINDOW";
+    case F_GET_RECEIVER_FRAME_TIMEOUT:      return "F_GET_RECEIVER_FRAME_TIMEOUT";
+    case F_SET_RECEIVER_FRAME_TIMEOUT:      return "F_SET_RECEIVER_FRAME_TIMEOUT";
+    case F_GET_RECEIVER_FILE_DIRECT_IO:     return "F_GET_RECEIVER_FILE_DIRECT_IO";
+    case F_SET_RECEIVER_FILE_DIRECT_IO:     return "F_SET_RECEIVER_FILE_DIRECT_IO";
+    case F_GET_RECEIVER_FILE_IO_URING:      return "F_GET_RECEIVER_FILE_IO_URING";
+    case F_SET_RECEIVER_FILE_IO_URING:      return "F_SET_RECEIVER_FILE_IO_URING";
+    case F_GET_RECEIVER_HDF5_CHUNK_FRAMES:  return "F_GET_RECEIVER_HDF5_CHUNK_FRAMES";
+    case F_SET_RECEIVER_HDF5_CHUNK_FRAMES:  return "F_SET_RECEIVER_HDF5_CHUNK_FRAMES";
+    case F_GET_RECEIVER_HDF5_CHUNK_ROWS:    return "F_GET_RECEIVER_HDF5_CHUNK_ROWS";
+    case F_SET_RECEIVER_HDF5_CHUNK_ROWS:    return "F_SET_RECEIVER_HDF5_CHUNK_ROWS";
+    case F_GET_RECEIVER_HDF5_COMPOUND_HEADER: return "F_GET_RECEIVER_HDF5_COMPOUND_HEADER";
+    case F_SET_RECEIVER_HDF5_COMPOUND_HEADER: return "F_SET_RECEIVER_HDF5_COMPOUND_HEADER";
+    case F_GET_RECEIVER_HDF5_WRITER_PROCESS: return "F_GET_RECEIVER_HDF5_WRITER_PROCESS";
+    case F_SET_RECEIVER_HDF5_WRITER_PROCESS: return "F_SET_RECEIVER_HDF5_WRITER_PROCESS";
+    case F_GET_RECEIVER_HDF5_SWMR:          return "F_GET_RECEIVER_HDF5_SWMR";
+    case F_SET_RECEIVER_HDF5_SWMR:          return "F_SET_RECEIVER_HDF5_SWMR";
+    case F_GET_RECEIVER_HDF5_FLUSH_FRAMES:  return "F_GET_RECEIVER_HDF5_FLUSH_FRAMES";
+    case F_SET_RECEIVER_HDF5_FLUSH_FRAMES:  return "F_SET_RECEIVER_HDF5_FLUSH_FRAMES";
+    case F_GET_RECEIVER_HDF5_FLUSH_TIME:    return "F_GET_RECEIVER_HDF5_FLUSH_TIME";
+    case F_SET_RECEIVER_HDF5_FLUSH_TIME:    return "F_SET_RECEIVER_HDF5_FLUSH_TIME";
+    case F_GET_RECEIVER_FILE_COMPRESSION:   return "F_GET_RECEIVER_FILE_COMPRESSION";
+    case F_SET_RECEIVER_FILE_COMPRESSION:   return "F_SET_RECEIVER_FILE_COMPRESSION";
+    case F_GET_RECEIVER_COMPRESSION_THREADS: return "F_GET_RECEIVER_COMPRESSION_THREADS";
+    case F_SET_RECEIVER_COMPRESSION_THREADS: return "F_SET_RECEIVER_COMPRESSION_THREADS";
+    case F_GET_RECEIVER_STREAMING_ZERO_COPY: return "F_GET_RECEIVER_STREAMING_ZERO_COPY";
+    case F_SET_RECEIVER_STREAMING_ZERO_COPY: return "F_SET_RECEIVER_STREAMING_ZERO_COPY";
+    case F_GET_RECEIVER_STREAMING_BINARY_HEADER: return "F_GET_RECEIVER_STREAMING_BINARY_HEADER";
+    case F_SET_RECEIVER_STREAMING_BINARY_HEADER: return "F_SET_RECEIVER_STREAMING_BINARY_HEADER";
+    case F_GET_RECEIVER_STREAMING_PREVIEW_BINNING: return "F_GET_RECEIVER_STREAMING_PREVIEW_BINNING";
+    case F_SET_RECEIVER_STREAMING_PREVIEW_BINNING: return "F_SET_RECEIVER_STREAMING_PREVIEW_BINNING";
+    case F_GET_RECEIVER_STREAMING_PREVIEW_MODE: return "F_GET_RECEIVER_STREAMING_PREVIEW_MODE";
+    case F_SET_RECEIVER_STREAMING_PREVIEW_MODE: return "F_SET_RECEIVER_STREAMING_PREVIEW_MODE";
+    case F_GET_RECEIVER_STREAMING_PREVIEW_TIMER: return "F_GET_RECEIVER_STREAMING_PREVIEW_TIMER";
+    case F_SET_RECEIVER_STREAMING_PREVIEW_TIMER: return "F_SET_RECEIVER_STREAMING_PREVIEW_TIMER";
+    case F_GET_RECEIVER_STREAMING_PREVIEW_PORT: return "F_GET_RECEIVER_STREAMING_PREVIEW_PORT";
+    case F_SET_RECEIVER_STREAMING_PREVIEW_PORT: return "F_SET_RECEIVER_STREAMING_PREVIEW_PORT";
+    case F_GET_RECEIVER_STREAMING_SOCKET_TYPE: return "F_GET_RECEIVER_STREAMING_SOCKET_TYPE";
+    case F_SET_RECEIVER_STREAMING_SOCKET_TYPE: return "F_SET_RECEIVER_STREAMING_SOCKET_TYPE";
+    case F_GET_RECEIVER_STREAMING_PUSH_PORT: return "F_GET_RECEIVER_STREAMING_PUSH_PORT";
+    case F_SET_RECEIVER_STREAMING_PUSH_PORT: return "F_SET_RECEIVER_STREAMING_PUSH_PORT";
+    case F_GET_RECEIVER_STREAMING_BANDWIDTH: return "F_GET_RECEIVER_STREAMING_BANDWIDTH";
+    case F_SET_RECEIVER_STREAMING_BANDWIDTH: return "F_SET_RECEIVER_STREAMING_BANDWIDTH";
 
 
     case NUM_REC_FUNCTIONS: 				return "NUM_REC_FUNCTIONS";
@@ -150,6 +150,36 @@ std::ostream &operator<<(std::ostream &os,
     return os << ToString(r);
 }
 
+std::string ToString(const slsDetectorDefs::rxThreadAffinity &r) {
+    std::ostringstream oss;
+    oss << '[' << ToString(r.thread) << ' ' << r.index << ", cpus ";
+    if (r.anyCpu()) {
+        oss << "all";
+    } else {
+        // ranges of consecutive cpus, eg. 0-3,8
+        bool first = true;
+        for (int i = 0; i < MAX_RX_CPUS; ++i) {
+            if (!r.hasCpu(i))
+                continue;
+            int last = i;
+            while (last + 1 < MAX_RX_CPUS && r.hasCpu(last + 1))
+                ++last;
+            oss << (first ? "" : ",") << i;
+            if (last != i)
+                oss << '-' << last;
+            first = false;
+            i = last;
+        }
+    }
+    oss << ", " << ToString(r.policy) << ' ' << r.priority << ']';
+    return oss.str();
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const slsDetectorDefs::rxThreadAffinity &r) {
+    return os << ToString(r);
+}
+
 std::string ToString(const defs::runStatus s) {
     switch (s) {
     case defs::ERROR:
@@ -292,6 +322,84 @@ std::string ToString(const defs::fileFormat s) {
         return std::string("hdf5");
     case defs::BINARY:
         return std::string("binary");
+    case defs::INDEXED:
+        return std::string("indexed");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::udpBackend s) {
+    switch (s) {
+    case defs::UDP_SOCKET:
+        return std::string("socket");
+    case defs::PACKET_RING:
+        return std::string("ring");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::fileCompression s) {
+    switch (s) {
+    case defs::NO_COMPRESSION:
+        return std::string("none");
+    case defs::BITSHUFFLE_LZ4:
+        return std::string("bslz4");
+    case defs::BITSHUFFLE_ZSTD:
+        return std::string("bszstd");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::previewMode s) {
+    switch (s) {
+    case defs::PREVIEW_BIN:
+        return std::string("bin");
+    case defs::PREVIEW_MAX:
+        return std::string("max");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::streamingSocketType s) {
+    switch (s) {
+    case defs::STREAM_PUB:
+        return std::string("pub");
+    case defs::STREAM_PUSH:
+        return std::string("push");
+    case defs::STREAM_PUB_PUSH:
+        return std::string("pubpush");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::rxThreadType s) {
+    switch (s) {
+    case defs::LISTENER_THREAD:
+        return std::string("listener");
+    case defs::PROCESSOR_THREAD:
+        return std::string("processor");
+    case defs::STREAMER_THREAD:
+        return std::string("streamer");
+    case defs::TCP_THREAD:
+        return std::string("tcp");
+    case defs::WRITER_THREAD:
+        return std::string("writer");
+    default:
+        return std::string("Unknown");
+    }
+}
+
+std::string ToString(const defs::rxSchedPolicy s) {
+    switch (s) {
+    case defs::RX_SCHED_OTHER:
+        return std::string("other");
+    case defs::RX_SCHED_FIFO:
+        return std::string("fifo");
     default:
         return std::string("Unknown");
     }
@@ -662,9 +770,69 @@ template <> defs::fileFormat StringTo(const std::string &s) {
         return defs::HDF5;
     if (s == "binary")
         return defs::BINARY;
+    if (s == "indexed")
+        return defs::INDEXED;
     throw sls::RuntimeError("Unknown file format " + s);
 }
 
+template <> defs::udpBackend StringTo(const std::string &s) {
+    if (s == "socket")
+        return defs::UDP_SOCKET;
+    if (s == "ring")
+        return defs::PACKET_RING;
+    throw sls::RuntimeError("Unknown udp backend " + s);
+}
+
+template <> defs::fileCompression StringTo(const std::string &s) {
+    if (s == "none")
+        return defs::NO_COMPRESSION;
+    if (s == "bslz4")
+        return defs::BITSHUFFLE_LZ4;
+    if (s == "bszstd")
+        return defs::BITSHUFFLE_ZSTD;
+    throw sls::RuntimeError("Unknown file compression " + s);
+}
+
+template <> defs::previewMode StringTo(const std::string &s) {
+    if (s == "bin")
+        return defs::PREVIEW_BIN;
+    if (s == "max")
+        return defs::PREVIEW_MAX;
+    throw sls::RuntimeError("Unknown preview mode " + s);
+}
+
+template <> defs::streamingSocketType StringTo(const std::string &s) {
+    if (s == "pub")
+        return defs::STREAM_PUB;
+    if (s == "push")
+        return defs::STREAM_PUSH;
+    if (s == "pubpush")
+        return defs::STREAM_PUB_PUSH;
+    throw sls::RuntimeError("Unknown streaming socket type " + s);
+}
+
+template <> defs::rxThreadType StringTo(const std::string &s) {
+    if (s == "listener")
+        return defs::LISTENER_THREAD;
+    if (s == "processor")
+        return defs::PROCESSOR_THREAD;
+    if (s == "streamer")
+        return defs::STREAMER_THREAD;
+    if (s == "tcp")
+        return defs::TCP_THREAD;
+    if (s == "writer")
+        return defs::WRITER_THREAD;
+    throw sls::RuntimeError("Unknown receiver thread type " + s);
+}
+
+template <> defs::rxSchedPolicy StringTo(const std::string &s) {
+    if (s == "other")
+        return defs::RX_SCHED_OTHER;
+    if (s == "fifo")
+        return defs::RX_SCHED_FIFO;
+    throw sls::RuntimeError("Unknown scheduling policy " + s);
+}
+
 template <> defs::externalSignalFlag StringTo(const std::string &s) {
     if (s == "trigger_in_rising_edge")
         return defs::TRIGGER_IN_RISING_EDGE;
@@ -0,0 +1,323 @@
+#include "sls/UdpRxPacketRing.h"
+#include "sls/logger.h"
+#include "sls/sls_detector_exceptions.h"
+#include <algorithm>
+#include <errno.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace sls {
+
+namespace {
+
+constexpr size_t ring_block_size = 1 << 22; // 4 MB, power of 2 of page size
+constexpr size_t ring_frame_size = 1 << 11; // only for validation in V3
+constexpr size_t ring_min_blocks = 16;
+constexpr unsigned ring_block_timeout_ms = 8; // hand over partial blocks
+constexpr ssize_t eiger_header_packet = 40;
+
+// Returns udp payload size of the packet if it is ipv4 udp to port, else -1
+ssize_t UdpPayload(const tpacket3_hdr *hdr, uint16_t port,
+                   const char *&payload) noexcept {
+    auto base = reinterpret_cast<const char *>(hdr);
+    auto ll = reinterpret_cast<const sockaddr_ll *>(
+        base + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+    // own packets seen on loopback
+    if (ll->sll_pkttype == PACKET_OUTGOING) {
+        return -1;
+    }
+    auto ip = reinterpret_cast<const uint8_t *>(base + hdr->tp_net);
+    size_t caplen = hdr->tp_snaplen - (hdr->tp_net - hdr->tp_mac);
+    if (caplen < 20 || (ip[0] >> 4) != 4 || ip[9] != IPPROTO_UDP) {
+        return -1;
+    }
+    // more fragments flag or fragment offset
+    if ((ip[6] & 0x3f) || ip[7]) {
+        return -1;
+    }
+    size_t ihl = (ip[0] & 0x0f) * 4;
+    if (caplen < ihl + 8) {
+        return -1;
+    }
+    auto udp = ip + ihl;
+    if (((udp[2] << 8) | udp[3]) != port) {
+        return -1;
+    }
+    size_t len = (udp[4] << 8) | udp[5];
+    if (len < 8 || caplen < ihl + len) {
+        return -1;
+    }
+    payload = reinterpret_cast<const char *>(udp + 8);
+    return len - 8;
+}
+
+} // namespace
+
+UdpRxPacketRing::UdpRxPacketRing(int port, ssize_t packet_size,
+                                 const char *ifname, int ring_size)
+    : packet_size_(packet_size), port_(static_cast<uint16_t>(port)) {
+    try {
+        sockfd_ = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_IP));
+        if (sockfd_ == -1) {
+            if (errno == EPERM) {
+                throw RuntimeError(
+                    "Failed to create packet socket (requires CAP_NET_RAW)");
+            }
+            throw RuntimeError("Failed to create packet socket: " +
+                               std::string(strerror(errno)));
+        }
+
+        // kernel filter for "udp dst port", ethernet and ipv4 only
+        struct sock_filter code[] = {
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, 0, 8),
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 23),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 6),
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 20),
+            BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x1fff, 4, 0),
+            BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 14),
+            BPF_STMT(BPF_LD | BPF_H | BPF_IND, 16),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, port_, 0, 1),
+            BPF_STMT(BPF_RET | BPF_K, 0x40000),
+            BPF_STMT(BPF_RET | BPF_K, 0),
+        };
+        struct sock_fprog filter {};
+        filter.len = sizeof(code) / sizeof(code[0]);
+        filter.filter = code;
+        if (setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_FILTER, &filter,
+                       sizeof(filter)) == -1) {
+            throw RuntimeError("Failed to attach filter to packet socket");
+        }
+
+        int version = TPACKET_V3;
+        if (setsockopt(sockfd_, SOL_PACKET, PACKET_VERSION, &version,
+                       sizeof(version)) == -1) {
+            throw RuntimeError("Failed to set TPACKET_V3 on packet socket");
+        }
+
+        block_size_ = ring_block_size;
+        num_blocks_ = std::max(ring_min_blocks,
+                               (static_cast<size_t>(std::max(ring_size, 0)) +
+                                block_size_ - 1) /
+                                   block_size_);
+        struct tpacket_req3 req {};
+        req.tp_block_size = block_size_;
+        req.tp_block_nr = num_blocks_;
+        req.tp_frame_size = ring_frame_size;
+        req.tp_frame_nr = (block_size_ / ring_frame_size) * num_blocks_;
+        req.tp_retire_blk_tov = ring_block_timeout_ms;
+        if (setsockopt(sockfd_, SOL_PACKET, PACKET_RX_RING, &req,
+                       sizeof(req)) == -1) {
+            throw RuntimeError("Failed to create packet ring of " +
+                               std::to_string(block_size_ * num_blocks_) +
+                               " bytes");
+        }
+        void *ring = mmap(nullptr, block_size_ * num_blocks_,
+                          PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          sockfd_, 0);
+        if (ring == MAP_FAILED) {
+            throw RuntimeError("Failed to map packet ring");
+        }
+        ring_ = static_cast<char *>(ring);
+
+        struct sockaddr_ll addr {};
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_IP);
+        if (ifname != nullptr && strlen(ifname)) {
+            addr.sll_ifindex = if_nametoindex(ifname);
+            if (addr.sll_ifindex == 0) {
+                throw RuntimeError("Unknown interface " + std::string(ifname));
+            }
+        }
+        if (bind(sockfd_, reinterpret_cast<sockaddr *>(&addr),
+                 sizeof(addr)) == -1) {
+            throw RuntimeError("Failed to bind packet socket");
+        }
+
+        eventfd_ = eventfd(0, EFD_NONBLOCK);
+        if (eventfd_ == -1) {
+            throw RuntimeError("Failed to create eventfd for packet ring");
+        }
+    } catch (...) {
+        Close();
+        throw;
+    }
+
+    // udp socket bound to the port that drops everything in the kernel, so
+    // that the stack does not answer with icmp port unreachable
+    sinkfd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sinkfd_ != -1) {
+        struct sock_filter drop[] = {BPF_STMT(BPF_RET | BPF_K, 0)};
+        struct sock_fprog filter {};
+        filter.len = 1;
+        filter.filter = drop;
+        struct sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port_);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(sinkfd_, SOL_SOCKET, SO_ATTACH_FILTER, &filter,
+                       sizeof(filter)) == -1 ||
+            bind(sinkfd_, reinterpret_cast<sockaddr *>(&addr),
+                 sizeof(addr)) == -1) {
+            LOG(logWARNING) << "Could not bind udp port " << port_
+                            << " next to packet ring";
+            close(sinkfd_);
+            sinkfd_ = -1;
+        }
+    }
+}
+
+UdpRxPacketRing::~UdpRxPacketRing() { Close(); }
+
+void UdpRxPacketRing::Close() noexcept {
+    if (ring_ != nullptr) {
+        munmap(ring_, block_size_ * num_blocks_);
+        ring_ = nullptr;
+    }
+    for (int *fd : {&sockfd_, &sinkfd_, &eventfd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+ssize_t UdpRxPacketRing::getPacketSize() const noexcept {
+    return packet_size_;
+}
+
+int UdpRxPacketRing::getBufferSize() const {
+    return static_cast<int>(block_size_ * num_blocks_);
+}
+
+void UdpRxPacketRing::Shutdown() {
+    if (!shutdown_.exchange(true)) {
+        // wake up a waiting receive, ring is released in the destructor
+        uint64_t one = 1;
+        if (write(eventfd_, &one, sizeof(one)) != sizeof(one)) {
+            LOG(logWARNING) << "Could not wake up packet ring";
+        }
+        if (sinkfd_ >= 0) {
+            close(sinkfd_);
+            sinkfd_ = -1;
+        }
+    }
+}
+
+void UdpRxPacketRing::setReceiveTimeout(int timeout_us) {
+    timeout_us_ = timeout_us;
+}
+
+ssize_t UdpRxPacketRing::NextPayload(const char *&payload,
+                                     bool blocking) noexcept {
+    while (!shutdown_) {
+        // current block done, hand it back and wait for the next one
+        if (packets_left_ == 0) {
+            if (next_packet_ != nullptr) {
+                ReleaseBlock();
+            }
+            auto desc = reinterpret_cast<tpacket_block_desc *>(
+                ring_ + block_index_ * block_size_);
+            if (!(__atomic_load_n(&desc->hdr.bh1.block_status,
+                                  __ATOMIC_ACQUIRE) &
+                  TP_STATUS_USER)) {
+                if (!blocking) {
+                    return 0;
+                }
+                struct pollfd fds[2] = {{sockfd_, POLLIN | POLLERR, 0},
+                                        {eventfd_, POLLIN, 0}};
+                timespec timeout{timeout_us_ / 1000000,
+                                 (timeout_us_ % 1000000) * 1000L};
+                int rc = ppoll(fds, 2, (timeout_us_ > 0 ? &timeout : nullptr),
+                               nullptr);
+                if ((rc == -1 && errno != EINTR) || rc == 0) {
+                    return -1;
+                }
+                continue;
+            }
+            packets_left_ = desc->hdr.bh1.num_pkts;
+            next_packet_ = reinterpret_cast<char *>(desc) +
+                           desc->hdr.bh1.offset_to_first_pkt;
+            continue;
+        }
+
+        auto hdr = reinterpret_cast<tpacket3_hdr *>(next_packet_);
+        next_packet_ += hdr->tp_next_offset;
+        --packets_left_;
+        ssize_t r = UdpPayload(hdr, port_, payload);
+        if (r < 0) {
+            continue;
+        }
+        if (r == eiger_header_packet) {
+            LOG(logWARNING) << "Got header pkg";
+            continue;
+        }
+        // temporary workaround for Eiger firmware (stop sends bad packets
+        // of size 8 bytes)
+        if (r == 8) {
+            LOG(logWARNING) << "Ignoring bad packet of size 8 bytes";
+            continue;
+        }
+        return std::min(r, packet_size_);
+    }
+    return -1;
+}
+
+void UdpRxPacketRing::ReleaseBlock() noexcept {
+    auto desc = reinterpret_cast<tpacket_block_desc *>(
+        ring_ + block_index_ * block_size_);
+    __atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL,
+                     __ATOMIC_RELEASE);
+    block_index_ = (block_index_ + 1) % num_blocks_;
+    next_packet_ = nullptr;
+}
+
+ssize_t UdpRxPacketRing::ReceiveDataOnly(char *dst) noexcept {
+    const char *payload = nullptr;
+    auto r = NextPayload(payload, true);
+    if (r > 0) {
+        memcpy(dst, payload, r);
+    }
+    return r;
+}
+
+int UdpRxPacketRing::ReceiveBatch(char *dst, int max_packets) {
+    if (max_packets <= 0) {
+        return -1;
+    }
+    // block for the first packet, then take whatever is already in the ring
+    int count = 0;
+    while (count < max_packets) {
+        const char *payload = nullptr;
+        auto r = NextPayload(payload, count == 0);
+        if (r <= 0) {
+            break;
+        }
+        memcpy(dst + count * packet_size_, payload, r);
+        ++count;
+    }
+    return count;
+}
+
+ssize_t UdpRxPacketRing::ReceiveScattered(char *header, size_t header_size,
+                                          char *data) noexcept {
+    const char *payload = nullptr;
+    auto r = NextPayload(payload, true);
+    if (r > 0) {
+        size_t n = std::min(static_cast<size_t>(r), header_size);
+        memcpy(header, payload, n);
+        memcpy(data, payload + n, r - n);
+    }
+    return r;
+}
+
+} // namespace sls
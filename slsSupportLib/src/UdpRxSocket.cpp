@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <errno.h>
 #include <iostream>
+#include <linux/filter.h>
+#include <memory>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <string.h>
@@ -13,8 +15,27 @@
 
 namespace sls {
 
+namespace {
+// Closes the socket when the constructor throws, as the destructor does not
+// run then. A leaked socket bound with SO_REUSEPORT would take its share of
+// the packets of the port
+class SocketGuard {
+    int *fd_;
+
+  public:
+    explicit SocketGuard(int &fd) : fd_(&fd) {}
+    ~SocketGuard() {
+        if (fd_ != nullptr && *fd_ >= 0) {
+            close(*fd_);
+            *fd_ = -1;
+        }
+    }
+    void release() { fd_ = nullptr; }
+};
+} // namespace
+
 UdpRxSocket::UdpRxSocket(int port, ssize_t packet_size, const char *hostname,
-                         int kernel_buffer_size)
+                         int kernel_buffer_size, bool reuse_port)
     : packet_size_(packet_size) {
     struct addrinfo hints;
     memset(&hints, 0, sizeof(hints));
@@ -29,14 +50,24 @@ UdpRxSocket::UdpRxSocket(int port, ssize_t packet_size, const char *hostname,
         throw RuntimeError("Failed at getaddrinfo with " +
                            std::string(hostname));
     }
+    std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> info(res,
+                                                            freeaddrinfo);
     sockfd_ = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
     if (sockfd_ == -1) {
         throw RuntimeError("Failed to create UDP RX socket");
     }
+    SocketGuard guard(sockfd_);
+    if (reuse_port) {
+        int one = 1;
+        if (setsockopt(sockfd_, SOL_SOCKET, SO_REUSEPORT, &one,
+                       sizeof(one)) == -1) {
+            throw RuntimeError("Could not set SO_REUSEPORT on UDP RX socket");
+        }
+    }
     if (bind(sockfd_, res->ai_addr, res->ai_addrlen) == -1) {
         throw RuntimeError("Failed to bind UDP RX socket");
     }
-    freeaddrinfo(res);
+    info.reset();
 
     // If we get a specified buffer size that is larger than the set one
     // we set it. Otherwise we leave it there since it could have been
@@ -52,6 +83,7 @@ UdpRxSocket::UdpRxSocket(int port, ssize_t packet_size, const char *hostname,
             }
         }
     }
+    guard.release();
 }
 
 UdpRxSocket::~UdpRxSocket() { Shutdown(); }
@@ -79,6 +111,83 @@ ssize_t UdpRxSocket::ReceiveDataOnly(char *dst) noexcept {
     return r;
 }
 
+int UdpRxSocket::ReceiveBatch(char *dst, int max_packets) {
+    if (max_packets <= 0) {
+        return -1;
+    }
+    if (static_cast<int>(msgs_.size()) < max_packets) {
+        msgs_.resize(max_packets);
+        iovs_.resize(max_packets);
+    }
+    for (int i = 0; i < max_packets; ++i) {
+        iovs_[i].iov_base = dst + i * packet_size_;
+        iovs_[i].iov_len = packet_size_;
+        memset(&msgs_[i], 0, sizeof(mmsghdr));
+        msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+    // compact, dropping eiger header packets and bad packets of size 8 bytes.
+    // A zero length packet means the socket was shut down
+    constexpr unsigned eiger_header_packet = 40;
+    int count = 0;
+    bool shutdown = false;
+    while (count == 0 && !shutdown) {
+        // block for the first packet, then take whatever is already queued
+        int n = recvmmsg(sockfd_, msgs_.data(), max_packets, MSG_WAITFORONE,
+                         nullptr);
+        if (n <= 0) {
+            return n;
+        }
+        for (int i = 0; i < n; ++i) {
+            auto len = msgs_[i].msg_len;
+            if (len == 0) {
+                shutdown = true;
+                break;
+            }
+            if (len == eiger_header_packet) {
+                LOG(logWARNING) << "Got header pkg";
+                continue;
+            }
+            if (len == 8) {
+                LOG(logWARNING) << "Ignoring bad packet of size 8 bytes";
+                continue;
+            }
+            if (count != i) {
+                memcpy(dst + count * packet_size_, dst + i * packet_size_,
+                       len);
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+ssize_t UdpRxSocket::ReceiveScattered(char *header, size_t header_size,
+                                      char *data) noexcept {
+    iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = header_size;
+    iov[1].iov_base = data;
+    iov[1].iov_len = packet_size_ - header_size;
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    constexpr ssize_t eiger_header_packet = 40;
+    ssize_t r = 0;
+    while (true) {
+        r = recvmsg(sockfd_, &msg, 0);
+        if (r == eiger_header_packet) {
+            LOG(logWARNING) << "Got header pkg";
+        } else if (r == 8) {
+            LOG(logWARNING) << "Ignoring bad packet of size 8 bytes";
+        } else {
+            break;
+        }
+    }
+    return r;
+}
+
 int UdpRxSocket::getBufferSize() const {
     int ret = 0;
     socklen_t optlen = sizeof(ret);
@@ -92,6 +201,35 @@ void UdpRxSocket::setBufferSize(int size) {
         throw RuntimeError("Could not set socket buffer size");
 }
 
+void UdpRxSocket::setReceiveTimeout(int timeout_us) {
+    timeval tv{};
+    tv.tv_sec = timeout_us / 1000000;
+    tv.tv_usec = timeout_us % 1000000;
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)))
+        throw RuntimeError("Could not set socket receive timeout");
+}
+
+void UdpRxSocket::ShardReusePortGroup(int num_sockets, int byte_offset) {
+    if (num_sockets <= 0) {
+        throw RuntimeError("Invalid number of sockets to shard udp port");
+    }
+    // socket index = payload byte % num_sockets
+    sock_filter code[] = {
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, static_cast<uint32_t>(byte_offset)},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(num_sockets)},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    sock_fprog prog{};
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog,
+                   sizeof(prog)) == -1) {
+        throw RuntimeError("Could not attach reuse port program to UDP RX "
+                           "socket: " +
+                           std::string(strerror(errno)));
+    }
+}
+
 void UdpRxSocket::Shutdown() {
     shutdown(sockfd_, SHUT_RDWR);
     if (sockfd_ >= 0) {
@@ -7,13 +7,12 @@
 #include <sstream>
 #include <string.h>
 #include <thread>
-#include <vector>
 #include <zmq.h>
 
 using namespace rapidjson;
 ZmqSocket::ZmqSocket(const char *const hostname_or_ip,
-                     const uint32_t portnumber)
-    : portno(portnumber), sockfd(false) {
+                     const uint32_t portnumber, bool pull)
+    : portno(portnumber), sockfd(false), loadBalanced(pull) {
     // Extra check that throws if conversion fails, could be removed
     auto ipstr = sls::HostnameToIp(hostname_or_ip).str();
     std::ostringstream oss;
@@ -26,8 +25,9 @@ ZmqSocket::ZmqSocket(const char *const hostname_or_ip,
     if (sockfd.contextDescriptor == nullptr)
         throw sls::ZmqSocketError("Could not create contextDescriptor");
 
-    // create publisher
-    sockfd.socketDescriptor = zmq_socket(sockfd.contextDescriptor, ZMQ_SUB);
+    // create subscriber (or puller)
+    sockfd.socketDescriptor =
+        zmq_socket(sockfd.contextDescriptor, pull ? ZMQ_PULL : ZMQ_SUB);
     if (sockfd.socketDescriptor == nullptr) {
         PrintError();
         throw sls::ZmqSocketError("Could not create socket");
@@ -35,7 +35,8 @@ ZmqSocket::ZmqSocket(const char *const hostname_or_ip,
 
     // Socket Options provided above
     // an empty string implies receiving any messages
-    if (zmq_setsockopt(sockfd.socketDescriptor, ZMQ_SUBSCRIBE, "", 0)) {
+    if (!pull &&
+        zmq_setsockopt(sockfd.socketDescriptor, ZMQ_SUBSCRIBE, "", 0)) {
         PrintError();
         throw sls::ZmqSocketError("Could set socket opt");
     }
@@ -48,25 +49,62 @@ ZmqSocket::ZmqSocket(const char *const hostname_or_ip,
         PrintError();
         throw sls::ZmqSocketError("Could not set ZMQ_LINGER");
     }
+    // end of acquisition of a push server, published to every client
+    if (pull) {
+        std::ostringstream control;
+        control << "tcp://" << ipstr << ":"
+                << portno + ZMQ_PUSH_END_PORT_OFFSET;
+        sockfd.controlAddress = control.str();
+        sockfd.controlDescriptor =
+            zmq_socket(sockfd.contextDescriptor, ZMQ_SUB);
+        if (sockfd.controlDescriptor == nullptr ||
+            zmq_setsockopt(sockfd.controlDescriptor, ZMQ_SUBSCRIBE, "", 0) ||
+            zmq_setsockopt(sockfd.controlDescriptor, ZMQ_LINGER, &value,
+                           sizeof(value))) {
+            PrintError();
+            throw sls::ZmqSocketError(
+                "Could not create end of acquisition socket");
+        }
+    }
     LOG(logDEBUG) << "Default receive high water mark:"
                   << GetReceiveHighWaterMark();
 }
 
-ZmqSocket::ZmqSocket(const uint32_t portnumber, const char *ethip)
-    : portno(portnumber), sockfd(true) {
+ZmqSocket::ZmqSocket(const uint32_t portnumber, const char *ethip, bool push)
+    : portno(portnumber), sockfd(true), loadBalanced(push) {
     // create context
     sockfd.contextDescriptor = zmq_ctx_new();
     if (sockfd.contextDescriptor == nullptr)
         throw sls::ZmqSocketError("Could not create contextDescriptor");
 
-    // create publisher
-    sockfd.socketDescriptor = zmq_socket(sockfd.contextDescriptor, ZMQ_PUB);
+    // create publisher (or pusher)
+    sockfd.socketDescriptor =
+        zmq_socket(sockfd.contextDescriptor, push ? ZMQ_PUSH : ZMQ_PUB);
     if (sockfd.socketDescriptor == nullptr) {
         PrintError();
         throw sls::ZmqSocketError("Could not create socket");
     }
     LOG(logDEBUG) << "Default send high water mark:" << GetSendHighWaterMark();
 
+    if (push) {
+        // no connected client or all of them full must not block
+        const int timeout = ZMQ_PUSH_SEND_TIMEOUT_MS;
+        if (zmq_setsockopt(sockfd.socketDescriptor, ZMQ_SNDTIMEO, &timeout,
+                           sizeof(timeout))) {
+            PrintError();
+            throw sls::ZmqSocketError("Could not set ZMQ_SNDTIMEO");
+        }
+        // a pushed message reaches one client, the end of acquisition is
+        // published to all of them
+        sockfd.controlDescriptor =
+            zmq_socket(sockfd.contextDescriptor, ZMQ_PUB);
+        if (sockfd.controlDescriptor == nullptr) {
+            PrintError();
+            throw sls::ZmqSocketError(
+                "Could not create end of acquisition socket");
+        }
+    }
+
     // construct address, can be refactored with libfmt
     std::ostringstream oss;
     oss << "tcp://" << ethip << ":" << portno;
@@ -78,6 +116,18 @@ ZmqSocket::ZmqSocket(const uint32_t portnumber, const char *ethip)
         PrintError();
         throw sls::ZmqSocketError("Could not bind socket");
     }
+    if (push) {
+        std::ostringstream control;
+        control << "tcp://" << ethip << ":"
+                << portno + ZMQ_PUSH_END_PORT_OFFSET;
+        sockfd.controlAddress = control.str();
+        if (zmq_bind(sockfd.controlDescriptor,
+                     sockfd.controlAddress.c_str())) {
+            PrintError();
+            throw sls::ZmqSocketError(
+                "Could not bind end of acquisition socket");
+        }
+    }
     // sleep to allow a slow-joiner
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
 };
@@ -101,6 +151,17 @@ void ZmqSocket::SetSendHighWaterMark(int limit) {
     }
 }
 
+void ZmqSocket::SetLinger(int value) {
+    if (zmq_setsockopt(sockfd.socketDescriptor, ZMQ_LINGER, &value,
+                       sizeof(value)) ||
+        (sockfd.controlDescriptor != nullptr &&
+         zmq_setsockopt(sockfd.controlDescriptor, ZMQ_LINGER, &value,
+                        sizeof(value)))) {
+        PrintError();
+        throw sls::ZmqSocketError("Could not set ZMQ_LINGER");
+    }
+}
+
 int ZmqSocket::GetReceiveHighWaterMark() {
     int value = 0;
     size_t value_size = sizeof(value);
@@ -120,15 +181,31 @@ void ZmqSocket::SetReceiveHighWaterMark(int limit) {
     }
 }
 
+bool ZmqSocket::CanSend() {
+    int events = 0;
+    size_t events_size = sizeof(events);
+    if (zmq_getsockopt(sockfd.socketDescriptor, ZMQ_EVENTS, &events,
+                       &events_size)) {
+        PrintError();
+        return false;
+    }
+    return (events & ZMQ_POLLOUT) != 0;
+}
+
 int ZmqSocket::Connect() {
     if (zmq_connect(sockfd.socketDescriptor, sockfd.serverAddress.c_str())) {
         PrintError();
         return 1;
     }
+    if (sockfd.controlDescriptor != nullptr &&
+        zmq_connect(sockfd.controlDescriptor, sockfd.controlAddress.c_str())) {
+        PrintError();
+        return 1;
+    }
     return 0;
 }
 
-int ZmqSocket::SendHeader(int index, zmqHeader header) {
+int ZmqSocket::EncodeJsonHeader(const zmqHeader &header) {
 
     /** Json Header Format */
     const char jsonHeaderFormat[] = "{"
@@ -197,15 +274,134 @@ int ZmqSocket::SendHeader(int index, zmqHeader header) {
     }
 
     strcat(header_buffer.get(), "}\n");
-    int length = strlen(header_buffer.get());
+    return strlen(header_buffer.get());
+}
+
+namespace {
+
+/** appends a uint16 length and the characters, false if it does not fit */
+bool AppendBinaryString(char *buffer, int &length, const std::string &str) {
+    if (str.size() > UINT16_MAX ||
+        length + sizeof(uint16_t) + str.size() > MAX_STR_LENGTH) {
+        return false;
+    }
+    uint16_t size = str.size();
+    memcpy(buffer + length, &size, sizeof(size));
+    length += sizeof(size);
+    memcpy(buffer + length, str.data(), size);
+    length += size;
+    return true;
+}
+
+/** reads a uint16 length and the characters, false if beyond length */
+bool ReadBinaryString(const char *buffer, int length, int &offset,
+                      std::string &str) {
+    uint16_t size = 0;
+    if (offset + (int)sizeof(size) > length) {
+        return false;
+    }
+    memcpy(&size, buffer + offset, sizeof(size));
+    offset += sizeof(size);
+    if (offset + size > length) {
+        return false;
+    }
+    str.assign(buffer + offset, size);
+    offset += size;
+    return true;
+}
+
+} // namespace
+
+int ZmqSocket::EncodeBinaryHeader(const zmqHeader &header) {
+    zmqBinaryHeader b{};
+    b.magic = ZMQ_BINARY_HEADER_MAGIC;
+    b.binaryVersion = ZMQ_BINARY_HEADER_VERSION;
+    b.headerSize = sizeof(zmqBinaryHeader);
+    b.jsonversion = header.jsonversion;
+    b.dynamicRange = header.dynamicRange;
+    b.fileIndex = header.fileIndex;
+    b.ndetx = header.ndetx;
+    b.ndety = header.ndety;
+    b.npixelsx = header.npixelsx;
+    b.npixelsy = header.npixelsy;
+    b.imageSize = header.imageSize;
+    b.acqIndex = header.acqIndex;
+    b.frameIndex = header.frameIndex;
+    b.progress = header.progress;
+    b.frameNumber = header.frameNumber;
+    b.expLength = header.expLength;
+    b.packetNumber = header.packetNumber;
+    b.bunchId = header.bunchId;
+    b.timestamp = header.timestamp;
+    b.modId = header.modId;
+    b.row = header.row;
+    b.column = header.column;
+    b.reserved = header.reserved;
+    b.debug = header.debug;
+    b.roundRNumber = header.roundRNumber;
+    b.detType = header.detType;
+    b.version = header.version;
+    b.flippedDataX = header.flippedDataX;
+    b.quad = header.quad;
+    b.data = header.data ? 1 : 0;
+    b.completeImage = header.completeImage ? 1 : 0;
+    if (header.fname.size() > UINT16_MAX ||
+        header.addJsonHeader.size() > UINT16_MAX) {
+        return -1;
+    }
+    b.fnameLength = header.fname.size();
+    b.numAddJsonHeader = header.addJsonHeader.size();
+
+    char *buffer = header_buffer.get();
+    int length = sizeof(zmqBinaryHeader);
+    if (length + header.fname.size() > MAX_STR_LENGTH) {
+        return -1;
+    }
+    memcpy(buffer, &b, sizeof(b));
+    memcpy(buffer + length, header.fname.data(), header.fname.size());
+    length += header.fname.size();
+    for (const auto &it : header.addJsonHeader) {
+        if (!AppendBinaryString(buffer, length, it.first) ||
+            !AppendBinaryString(buffer, length, it.second)) {
+            return -1;
+        }
+    }
+    return length;
+}
+
+int ZmqSocket::SendHeader(int index, const zmqHeader &header) {
+    int length = binaryHeader ? EncodeBinaryHeader(header)
+                              : EncodeJsonHeader(header);
+    if (length < 0) {
+        LOG(logERROR) << index << " Binary header exceeds " << MAX_STR_LENGTH
+                      << " bytes (file name or additional json header)";
+        return 0;
+    }
 
 #ifdef VERBOSE
     // if(!index)
     cprintf(BLUE, "%d : Streamer: buf: %s\n", index, buf);
 #endif
 
+    // end of acquisition of a push server to every client
+    if (loadBalanced && sockfd.server && !header.data) {
+        if (zmq_send(sockfd.controlDescriptor, header_buffer.get(), length,
+                     0) < 0) {
+            PrintError();
+            return 0;
+        }
+        return 1;
+    }
+    // a push server skips a frame no client can take
+    int flags = header.data ? ZMQ_SNDMORE : 0;
+    if (loadBalanced && sockfd.server) {
+        flags |= ZMQ_DONTWAIT;
+    }
     if (zmq_send(sockfd.socketDescriptor, header_buffer.get(), length,
-                 header.data ? ZMQ_SNDMORE : 0) < 0) {
+                 flags) < 0) {
+        if (loadBalanced && sockfd.server && zmq_errno() == EAGAIN) {
+            return ZMQ_SEND_SKIPPED;
+        }
         PrintError();
         return 0;
     }
@@ -223,8 +419,29 @@ int ZmqSocket::SendData(char *buf, int length) {
     return 1;
 }
 
+int ZmqSocket::SendDataZeroCopy(char *buf, int length,
+                                void (*release)(void *, void *), void *hint) {
+    zmq_msg_t message;
+    if (zmq_msg_init_data(&message, buf, length, release, hint)) {
+        PrintError();
+        // zmq did not take over buf
+        release(buf, hint);
+        return 0;
+    }
+    if (zmq_msg_send(&message, sockfd.socketDescriptor, 0) < 0) {
+        PrintError();
+        // still owned here, closing releases buf
+        zmq_msg_close(&message);
+        return 0;
+    }
+    return 1;
+}
+
 int ZmqSocket::ReceiveHeader(const int index, zmqHeader &zHeader,
                              uint32_t version) {
+    if (loadBalanced && PollPullClient(index, zHeader, version) != 1) {
+        return 0;
+    }
     const int bytes_received = zmq_recv(sockfd.socketDescriptor,
                                         header_buffer.get(), MAX_STR_LENGTH, 0);
     if (bytes_received > 0) {
@@ -254,8 +471,44 @@ int ZmqSocket::ReceiveHeader(const int index, zmqHeader &zHeader,
     return 0;
 };
 
+int ZmqSocket::PollPullClient(const int index, zmqHeader &zHeader,
+                              uint32_t version) {
+    zmq_pollitem_t items[] = {{sockfd.socketDescriptor, 0, ZMQ_POLLIN, 0},
+                              {sockfd.controlDescriptor, 0, ZMQ_POLLIN, 0}};
+    while (true) {
+        // frames first, the end once they stopped arriving
+        int ret = zmq_poll(items, 2, endPending ? ZMQ_PULL_END_DRAIN_MS : -1);
+        if (ret < 0) {
+            PrintError();
+            return -1;
+        }
+        if (items[0].revents & ZMQ_POLLIN) {
+            return 1;
+        }
+        if (ret == 0) {
+            endPending = false;
+            zHeader.data = false;
+            return 0;
+        }
+        int length = zmq_recv(sockfd.controlDescriptor, header_buffer.get(),
+                              MAX_STR_LENGTH, 0);
+        if (length > 0 && ParseHeader(index, length, header_buffer.get(),
+                                      zHeader, version)) {
+            endPending = !zHeader.data;
+        }
+    }
+}
+
 int ZmqSocket::ParseHeader(const int index, int length, char *buff,
                            zmqHeader &zHeader, uint32_t version) {
+    uint32_t magic = 0;
+    if (length >= (int)sizeof(magic)) {
+        memcpy(&magic, buff, sizeof(magic));
+        if (magic == ZMQ_BINARY_HEADER_MAGIC) {
+            return DecodeBinaryHeader(index, length, buff, zHeader, version);
+        }
+    }
+
     Document document;
     if (document.Parse(buff, length).HasParseError()) {
         LOG(logERROR) << index << " Could not parse. len:" << length
@@ -320,6 +573,84 @@ int ZmqSocket::ParseHeader(const int index, int length, char *buff,
     return 1;
 }
 
+int ZmqSocket::DecodeBinaryHeader(const int index, int length,
+                                  const char *buff, zmqHeader &zHeader,
+                                  uint32_t version) {
+    zmqBinaryHeader b{};
+    // zmq_recv truncates to the buffer, but returns the message size
+    if (length > MAX_STR_LENGTH || length < (int)sizeof(b)) {
+        LOG(logERROR) << index << " Invalid binary header length " << length;
+        return 0;
+    }
+    memcpy(&b, buff, sizeof(b));
+    // later versions append members, skip them
+    if (b.headerSize < sizeof(b) || b.headerSize > length) {
+        LOG(logERROR) << index << " Invalid binary header size "
+                      << b.headerSize;
+        return 0;
+    }
+
+    // version check
+    zHeader.jsonversion = b.jsonversion;
+    if (zHeader.jsonversion != version) {
+        LOG(logERROR) << "version mismatch. required " << version << ", got "
+                      << zHeader.jsonversion;
+        return 0;
+    }
+
+    int offset = b.headerSize;
+    if (offset + b.fnameLength > length) {
+        LOG(logERROR) << index << " Invalid binary header file name length "
+                      << b.fnameLength;
+        return 0;
+    }
+    zHeader.fname.assign(buff + offset, b.fnameLength);
+    offset += b.fnameLength;
+
+    zHeader.addJsonHeader.clear();
+    for (int i = 0; i != b.numAddJsonHeader; ++i) {
+        std::string key, value;
+        if (!ReadBinaryString(buff, length, offset, key) ||
+            !ReadBinaryString(buff, length, offset, value)) {
+            LOG(logERROR) << index
+                          << " Invalid binary header additional json header";
+            return 0;
+        }
+        zHeader.addJsonHeader[key] = value;
+    }
+
+    zHeader.data = (b.data != 0);
+    zHeader.dynamicRange = b.dynamicRange;
+    zHeader.fileIndex = b.fileIndex;
+    zHeader.ndetx = b.ndetx;
+    zHeader.ndety = b.ndety;
+    zHeader.npixelsx = b.npixelsx;
+    zHeader.npixelsy = b.npixelsy;
+    zHeader.imageSize = b.imageSize;
+    zHeader.acqIndex = b.acqIndex;
+    zHeader.frameIndex = b.frameIndex;
+    zHeader.progress = b.progress;
+
+    zHeader.frameNumber = b.frameNumber;
+    zHeader.expLength = b.expLength;
+    zHeader.packetNumber = b.packetNumber;
+    zHeader.bunchId = b.bunchId;
+    zHeader.timestamp = b.timestamp;
+    zHeader.modId = b.modId;
+    zHeader.row = b.row;
+    zHeader.column = b.column;
+    zHeader.reserved = b.reserved;
+    zHeader.debug = b.debug;
+    zHeader.roundRNumber = b.roundRNumber;
+    zHeader.detType = b.detType;
+    zHeader.version = b.version;
+
+    zHeader.flippedDataX = b.flippedDataX;
+    zHeader.quad = b.quad;
+    zHeader.completeImage = (b.completeImage != 0);
+    return 1;
+}
+
 int ZmqSocket::ReceiveData(const int index, char *buf, const int size) {
     zmq_msg_t message;
     zmq_msg_init(&message);
@@ -425,8 +756,19 @@ void ZmqSocket::mySocketDescriptors::Disconnect() {
         zmq_unbind(socketDescriptor, serverAddress.c_str());
     else
         zmq_disconnect(socketDescriptor, serverAddress.c_str());
+    if (controlDescriptor != nullptr) {
+        if (server)
+            zmq_unbind(controlDescriptor, controlAddress.c_str());
+        else
+            zmq_disconnect(controlDescriptor, controlAddress.c_str());
+    }
 };
 void ZmqSocket::mySocketDescriptors::Close() {
+    if (controlDescriptor != nullptr) {
+        zmq_close(controlDescriptor);
+        controlDescriptor = nullptr;
+    }
+
     if (socketDescriptor != nullptr) {
         zmq_close(socketDescriptor);
         socketDescriptor = nullptr;
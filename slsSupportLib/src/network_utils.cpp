@@ -6,6 +6,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <ifaddrs.h>
 #include <iomanip>
 #include <net/if.h>
@@ -177,4 +178,16 @@ MacAddr InterfaceNameToMac(const std::string &inf) {
     return MacAddr(mac);
 }
 
+int InterfaceNameToNumaNode(const std::string &ifn) {
+    if (ifn.empty() || ifn.find('/') != std::string::npos) {
+        return -1;
+    }
+    std::ifstream ifs("/sys/class/net/" + ifn + "/device/numa_node");
+    int node = -1;
+    if (!(ifs >> node)) {
+        return -1;
+    }
+    return node;
+}
+
 } // namespace sls
@@ -0,0 +1,65 @@
+#include "catch.hpp"
+#include "sls/FrameReorderer.h"
+
+#include <string>
+#include <vector>
+
+using sls::FrameReorderer;
+
+TEST_CASE("Results are handed out in frame order") {
+    FrameReorderer<int> r;
+    REQUIRE(r.Push(2, 20));
+    REQUIRE(r.Push(0, 0));
+    REQUIRE(r.Push(1, 10));
+
+    std::vector<uint64_t> indices;
+    uint64_t index = 0;
+    int result = 0;
+    while (r.Pop(index, result)) {
+        REQUIRE(result == static_cast<int>(index) * 10);
+        indices.push_back(index);
+    }
+    REQUIRE(indices == std::vector<uint64_t>{0, 1, 2});
+    REQUIRE(r.GetNextIndex() == 3);
+    REQUIRE(r.GetNumPending() == 0);
+}
+
+TEST_CASE("A missing frame holds back the results after it") {
+    FrameReorderer<std::string> r(2);
+    r.Push(1, "b");
+    r.Push(2, "c");
+    uint64_t index = 0;
+    std::string result;
+    REQUIRE_FALSE(r.Pop(index, result));
+    REQUIRE(r.GetNumPending() == 2);
+
+    // window exceeded, frame 0 skipped
+    r.Push(3, "d");
+    REQUIRE(r.Pop(index, result));
+    REQUIRE(index == 1);
+    REQUIRE(result == "b");
+    REQUIRE(r.GetNumSkipped() == 1);
+
+    // too late
+    REQUIRE_FALSE(r.Push(0, "a"));
+}
+
+TEST_CASE("Flushing skips missing frames") {
+    FrameReorderer<int> r(100, 10);
+    r.Push(12, 12);
+    r.Push(15, 15);
+    REQUIRE_FALSE(r.Push(15, 0));
+    uint64_t index = 0;
+    int result = 0;
+    REQUIRE_FALSE(r.Pop(index, result));
+    REQUIRE(r.Flush(index, result));
+    REQUIRE(index == 12);
+    REQUIRE(r.Flush(index, result));
+    REQUIRE(result == 15);
+    REQUIRE_FALSE(r.Flush(index, result));
+    REQUIRE(r.GetNumSkipped() == 4);
+
+    r.Reset();
+    REQUIRE(r.GetNextIndex() == 0);
+    REQUIRE(r.GetNumSkipped() == 0);
+}
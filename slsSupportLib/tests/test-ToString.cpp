@@ -298,4 +298,67 @@ TEST_CASE("Streaming of slsDetectorDefs::scanParameters") {
         REQUIRE(oss.str() == "[enabled\ndac vth2\nstart 500\nstop 1500\nstep "
                              "500\nsettleTime 0.5s\n]");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("udp backend to and from string") {
+    REQUIRE(ToString(defs::UDP_SOCKET) == "socket");
+    REQUIRE(ToString(defs::PACKET_RING) == "ring");
+    REQUIRE(StringTo<defs::udpBackend>("socket") == defs::UDP_SOCKET);
+    REQUIRE(StringTo<defs::udpBackend>("ring") == defs::PACKET_RING);
+    REQUIRE_THROWS(StringTo<defs::udpBackend>("mmap"));
+}
+
+TEST_CASE("file compression to and from string") {
+    REQUIRE(ToString(defs::NO_COMPRESSION) == "none");
+    REQUIRE(ToString(defs::BITSHUFFLE_LZ4) == "bslz4");
+    REQUIRE(ToString(defs::BITSHUFFLE_ZSTD) == "bszstd");
+    REQUIRE(StringTo<defs::fileCompression>("none") == defs::NO_COMPRESSION);
+    REQUIRE(StringTo<defs::fileCompression>("bslz4") == defs::BITSHUFFLE_LZ4);
+    REQUIRE(StringTo<defs::fileCompression>("bszstd") ==
+            defs::BITSHUFFLE_ZSTD);
+    REQUIRE_THROWS(StringTo<defs::fileCompression>("gzip"));
+}
+
+TEST_CASE("preview mode to and from string") {
+    REQUIRE(ToString(defs::PREVIEW_BIN) == "bin");
+    REQUIRE(ToString(defs::PREVIEW_MAX) == "max");
+    REQUIRE(StringTo<defs::previewMode>("bin") == defs::PREVIEW_BIN);
+    REQUIRE(StringTo<defs::previewMode>("max") == defs::PREVIEW_MAX);
+    REQUIRE_THROWS(StringTo<defs::previewMode>("mean"));
+}
+
+TEST_CASE("streaming socket type to and from string") {
+    REQUIRE(ToString(defs::STREAM_PUB) == "pub");
+    REQUIRE(ToString(defs::STREAM_PUSH) == "push");
+    REQUIRE(ToString(defs::STREAM_PUB_PUSH) == "pubpush");
+    REQUIRE(StringTo<defs::streamingSocketType>("push") == defs::STREAM_PUSH);
+    REQUIRE(StringTo<defs::streamingSocketType>("pubpush") ==
+            defs::STREAM_PUB_PUSH);
+    REQUIRE_THROWS(StringTo<defs::streamingSocketType>("pull"));
+}
+
+TEST_CASE("file format to and from string") {
+    REQUIRE(ToString(defs::BINARY) == "binary");
+    REQUIRE(ToString(defs::HDF5) == "hdf5");
+    REQUIRE(ToString(defs::INDEXED) == "indexed");
+    REQUIRE(StringTo<defs::fileFormat>("indexed") == defs::INDEXED);
+    REQUIRE_THROWS(StringTo<defs::fileFormat>("tiff"));
+}
+
+TEST_CASE("Streaming of receiver thread affinity") {
+    defs::rxThreadAffinity t(defs::LISTENER_THREAD, 1);
+    REQUIRE(ToString(t) == "[listener 1, cpus all, other 0]");
+    t.addCpu(0);
+    t.addCpu(1);
+    t.addCpu(2);
+    t.addCpu(8);
+    t.addCpu(100);
+    t.policy = defs::RX_SCHED_FIFO;
+    t.priority = 10;
+    REQUIRE(ToString(t) == "[listener 1, cpus 0-2,8,100, fifo 10]");
+    REQUIRE(StringTo<defs::rxThreadType>("tcp") == defs::TCP_THREAD);
+    REQUIRE(StringTo<defs::rxThreadType>("writer") == defs::WRITER_THREAD);
+    REQUIRE(ToString(defs::WRITER_THREAD) == "writer");
+    REQUIRE(StringTo<defs::rxSchedPolicy>("fifo") == defs::RX_SCHED_FIFO);
+    REQUIRE_THROWS(StringTo<defs::rxSchedPolicy>("rr"));
+}
@@ -0,0 +1,129 @@
+#include "catch.hpp"
+#include "sls/UdpRxPacketRing.h"
+#include "sls/sls_detector_exceptions.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+constexpr int ring_port = 50011;
+
+// ipv4 loopback, the packet ring does not see ipv6
+int open_ipv4_socket(int port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd == -1) {
+        throw sls::RuntimeError("Failed to create UDP TX socket");
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))) {
+        throw sls::RuntimeError("Failed to connect socket");
+    }
+    return fd;
+}
+
+// nullptr without CAP_NET_RAW
+std::unique_ptr<sls::UdpRxPacketRing> make_ring(ssize_t packet_size) {
+    try {
+        return std::unique_ptr<sls::UdpRxPacketRing>(
+            new sls::UdpRxPacketRing(ring_port, packet_size, "lo"));
+    } catch (const sls::RuntimeError &e) {
+        WARN(e.what());
+        return nullptr;
+    }
+}
+
+TEST_CASE("Receive packets of one port from the packet ring") {
+    auto ring = make_ring(sizeof(int));
+    if (!ring) {
+        return;
+    }
+    CHECK(ring->getBufferSize() > 0);
+    auto fd = open_ipv4_socket(ring_port);
+    auto other = open_ipv4_socket(ring_port + 1);
+    for (int i = 0; i != 3; ++i) {
+        write(other, &i, sizeof(i));
+        write(fd, &i, sizeof(i));
+    }
+    int received = -1;
+    CHECK(ring->ReceiveDataOnly(reinterpret_cast<char *>(&received)) ==
+          sizeof(int));
+    CHECK(received == 0);
+
+    // rest of the packets in one or more blocks
+    std::vector<int> batch(4, -1);
+    int n = 0;
+    while (n < 2) {
+        n += ring->ReceiveBatch(reinterpret_cast<char *>(&batch[n]),
+                                batch.size() - n);
+    }
+    CHECK(n == 2);
+    CHECK(batch[0] == 1);
+    CHECK(batch[1] == 2);
+    CHECK(batch[2] == -1);
+    close(fd);
+    close(other);
+}
+
+TEST_CASE("Receive header and data of a packet from the packet ring") {
+    int to_send[] = {1, 2, 3};
+    auto ring = make_ring(sizeof(to_send));
+    if (!ring) {
+        return;
+    }
+    auto fd = open_ipv4_socket(ring_port);
+    write(fd, &to_send, sizeof(to_send));
+    int header = -1;
+    int data[] = {-1, -1};
+    CHECK(ring->ReceiveScattered(reinterpret_cast<char *>(&header),
+                                 sizeof(header),
+                                 reinterpret_cast<char *>(data)) ==
+          sizeof(to_send));
+    CHECK(header == 1);
+    CHECK(data[0] == 2);
+    CHECK(data[1] == 3);
+    close(fd);
+}
+
+TEST_CASE("Shutdown packet ring without hanging when waiting for data") {
+    auto ring = make_ring(8000);
+    if (!ring) {
+        return;
+    }
+    std::vector<char> buff(8000);
+    std::future<ssize_t> ret =
+        std::async(&sls::UdpRxPacketRing::ReceiveDataOnly, ring.get(),
+                   buff.data());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring->Shutdown();
+    CHECK(ret.get() <= 0);
+}
+
+TEST_CASE("Packet ring returns after timeout without packets") {
+    auto ring = make_ring(sizeof(int));
+    if (!ring) {
+        return;
+    }
+    ring->setReceiveTimeout(1000);
+    int received = -1;
+    CHECK(ring->ReceiveDataOnly(reinterpret_cast<char *>(&received)) < 0);
+    CHECK(ring->ReceiveBatch(reinterpret_cast<char *>(&received), 1) <= 0);
+    auto fd = open_ipv4_socket(ring_port);
+    int to_send = 5;
+    write(fd, &to_send, sizeof(to_send));
+    // partial blocks are handed over after the block timeout
+    int rc = -1;
+    for (int i = 0; i != 100 && rc < 0; ++i) {
+        rc = ring->ReceiveDataOnly(reinterpret_cast<char *>(&received));
+    }
+    CHECK(rc == sizeof(int));
+    CHECK(received == to_send);
+    close(fd);
+}
@@ -106,3 +106,96 @@ TEST_CASE("Receive an int to an external buffer") {
     CHECK(s.ReceivePacket(reinterpret_cast<char *>(&received)));
     CHECK(received == to_send);
 }
+
+TEST_CASE("Receive a batch of packets") {
+    constexpr int n_packets = 3;
+    std::vector<int> received(n_packets * 2, -1);
+    sls::UdpRxSocket s(default_port, sizeof(int));
+    auto fd = open_socket(default_port);
+    for (int i = 0; i != n_packets; ++i) {
+        write(fd, &i, sizeof(i));
+    }
+    // let all packets arrive to get them in one batch
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(s.ReceiveBatch(reinterpret_cast<char *>(received.data()),
+                         received.size()) == n_packets);
+    for (int i = 0; i != n_packets; ++i) {
+        CHECK(received[i] == i);
+    }
+    CHECK(received[n_packets] == -1);
+    close(fd);
+}
+
+TEST_CASE("Shutdown socket without hanging when waiting for a batch") {
+    constexpr ssize_t packet_size = 8000;
+    sls::UdpRxSocket s{default_port, packet_size};
+    std::vector<char> buff(packet_size * 4);
+    std::future<int> ret = std::async(&sls::UdpRxSocket::ReceiveBatch, &s,
+                                      buff.data(), 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    s.Shutdown();
+    CHECK(ret.get() <= 0); // since we didn't get any packet
+}
+
+TEST_CASE("Receive header and data of a packet to separate buffers") {
+    int to_send[] = {1, 2, 3};
+    int header = -1;
+    int data[] = {-1, -1};
+    sls::UdpRxSocket s(default_port, sizeof(to_send));
+    auto fd = open_socket(default_port);
+    write(fd, &to_send, sizeof(to_send));
+    CHECK(s.ReceiveScattered(reinterpret_cast<char *>(&header), sizeof(header),
+                             reinterpret_cast<char *>(data)) ==
+          sizeof(to_send));
+    CHECK(header == 1);
+    CHECK(data[0] == 2);
+    CHECK(data[1] == 3);
+    close(fd);
+}
+
+TEST_CASE("Shard packets of one port over sockets by first byte") {
+    sls::UdpRxSocket s0(default_port, sizeof(int), nullptr, 0, true);
+    sls::UdpRxSocket s1(default_port, sizeof(int), nullptr, 0, true);
+    s0.ShardReusePortGroup(2);
+    auto fd = open_socket(default_port);
+    for (int i = 0; i != 4; ++i) {
+        write(fd, &i, sizeof(i));
+    }
+    int received = -1;
+    CHECK(s0.ReceivePacket(reinterpret_cast<char *>(&received)));
+    CHECK(received == 0);
+    CHECK(s1.ReceivePacket(reinterpret_cast<char *>(&received)));
+    CHECK(received == 1);
+    CHECK(s0.ReceivePacket(reinterpret_cast<char *>(&received)));
+    CHECK(received == 2);
+    CHECK(s1.ReceivePacket(reinterpret_cast<char *>(&received)));
+    CHECK(received == 3);
+    close(fd);
+}
+
+TEST_CASE("Receive returns after timeout without packets") {
+    sls::UdpRxSocket s(default_port, sizeof(int));
+    s.setReceiveTimeout(1000);
+    int received = -1;
+    CHECK(s.ReceiveDataOnly(reinterpret_cast<char *>(&received)) < 0);
+    CHECK(s.ReceiveBatch(reinterpret_cast<char *>(&received), 1) < 0);
+    auto fd = open_socket(default_port);
+    int to_send = 5;
+    write(fd, &to_send, sizeof(to_send));
+    CHECK(s.ReceiveDataOnly(reinterpret_cast<char *>(&received)) ==
+          sizeof(int));
+    CHECK(received == to_send);
+    close(fd);
+}
+
+TEST_CASE("Failing to bind does not leak the socket") {
+    sls::UdpRxSocket s(default_port, sizeof(int));
+    // lowest free descriptor, reused by the next socket if none is leaked
+    int free_fd = dup(0);
+    close(free_fd);
+    REQUIRE_THROWS(sls::UdpRxSocket(default_port, sizeof(int), nullptr, 0,
+                                    true));
+    int fd = dup(0);
+    close(fd);
+    CHECK(fd == free_fd);
+}
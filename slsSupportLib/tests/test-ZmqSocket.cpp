@@ -1,5 +1,12 @@
 #include "catch.hpp"
 #include "sls/ZmqSocket.h"
+#include "sls/container_utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
 
 TEST_CASE("Throws when cannot create socket") {
     REQUIRE_THROWS(ZmqSocket("sdiasodjajpvv", 5076001));
@@ -111,4 +118,217 @@ TEST_CASE("Send header and data") {
     for (size_t i = 0; i != data.size(); ++i) {
         REQUIRE(data[i] == received_data[i]);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Send binary header on localhost") {
+    constexpr int port = 50001;
+    ZmqSocket sub("localhost", port);
+    sub.Connect();
+
+    ZmqSocket pub(port, "*");
+    pub.SetBinaryHeader(true);
+
+    zmqHeader header;
+    header.data = false; // if true we wait for the data
+    header.jsonversion = 0;
+    header.dynamicRange = 16;
+    header.fileIndex = 7;
+    header.ndetx = 2;
+    header.ndety = 4;
+    header.npixelsx = 1024;
+    header.npixelsy = 512;
+    header.imageSize = 1048576;
+    header.frameNumber = 123456789012;
+    header.progress = 42.5;
+    header.row = 3;
+    header.flippedDataX = 1;
+    header.completeImage = true;
+    header.fname = "run_d0";
+    header.addJsonHeader["key1"] = "value1";
+    header.addJsonHeader["emptyvalue"] = "";
+
+    REQUIRE(pub.SendHeader(0, header) == 1);
+
+    zmqHeader received_header;
+    sub.ReceiveHeader(0, received_header, 0);
+
+    REQUIRE(received_header.data == false);
+    REQUIRE(received_header.fname == "run_d0");
+    REQUIRE(received_header.dynamicRange == 16);
+    REQUIRE(received_header.fileIndex == 7);
+    REQUIRE(received_header.ndetx == 2);
+    REQUIRE(received_header.ndety == 4);
+    REQUIRE(received_header.npixelsx == 1024);
+    REQUIRE(received_header.npixelsy == 512);
+    REQUIRE(received_header.imageSize == 1048576);
+    REQUIRE(received_header.frameNumber == 123456789012);
+    REQUIRE(received_header.progress == 42.5);
+    REQUIRE(received_header.row == 3);
+    REQUIRE(received_header.flippedDataX == 1);
+    REQUIRE(received_header.completeImage == true);
+    REQUIRE(received_header.addJsonHeader == header.addJsonHeader);
+}
+
+TEST_CASE("Binary header that does not fit is not sent") {
+    constexpr int port = 50001;
+    ZmqSocket pub(port, "*");
+    pub.SetBinaryHeader(true);
+
+    zmqHeader header;
+    header.data = false;
+    header.fname = std::string(MAX_STR_LENGTH, 'a');
+    REQUIRE(pub.SendHeader(0, header) == 0);
+}
+
+TEST_CASE("A publisher can always send") {
+    constexpr int port = 50001;
+    ZmqSocket pub(port, "*");
+    REQUIRE_FALSE(pub.IsLoadBalanced());
+    REQUIRE(pub.CanSend());
+}
+
+TEST_CASE("Push header to a pulling client") {
+    constexpr int port = 50001;
+    ZmqSocket pull("localhost", port, true);
+    pull.Connect();
+    ZmqSocket push(port, "*", true);
+    REQUIRE(pull.IsLoadBalanced());
+    REQUIRE(push.IsLoadBalanced());
+
+    std::vector<int> data{0, 1, 2, 3};
+    const int nbytes = data.size() * sizeof(decltype(data)::value_type);
+    zmqHeader header;
+    header.frameIndex = 5;
+    header.fname = "pushed";
+    header.imageSize = nbytes;
+    REQUIRE(push.SendHeader(0, header) == 1);
+    REQUIRE(push.SendData((char *)data.data(), nbytes) == 1);
+
+    zmqHeader received_header;
+    REQUIRE(pull.ReceiveHeader(0, received_header, 0) == 1);
+    REQUIRE(received_header.frameIndex == 5);
+    REQUIRE(received_header.fname == "pushed");
+    std::vector<int> received_data(data.size());
+    REQUIRE(pull.ReceiveData(0, (char *)received_data.data(), nbytes) ==
+            nbytes);
+    REQUIRE(received_data == data);
+}
+
+TEST_CASE("Frames are shared among pulling clients, the end goes to all") {
+    constexpr int port = 50001;
+    ZmqSocket push(port, "*", true);
+    ZmqSocket pull1("localhost", port, true);
+    ZmqSocket pull2("localhost", port, true);
+    pull1.Connect();
+    pull2.Connect();
+    // both connected and subscribed to the end
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::vector<int> data{0, 1, 2, 3};
+    const int nbytes = data.size() * sizeof(decltype(data)::value_type);
+    zmqHeader header;
+    header.imageSize = nbytes;
+    for (int i = 0; i != 2; ++i) {
+        header.frameIndex = i;
+        REQUIRE(push.CanSend());
+        REQUIRE(push.SendHeader(0, header) == 1);
+        REQUIRE(push.SendData((char *)data.data(), nbytes) == 1);
+    }
+    zmqHeader end;
+    end.data = false;
+    REQUIRE(push.SendHeader(0, end) == 1);
+
+    std::set<uint64_t> frames;
+    for (auto *pull : {&pull1, &pull2}) {
+        zmqHeader received_header;
+        REQUIRE(pull->ReceiveHeader(0, received_header, 0) == 1);
+        frames.insert(received_header.frameIndex);
+        std::vector<int> received_data(data.size());
+        pull->ReceiveData(0, (char *)received_data.data(), nbytes);
+        REQUIRE(received_data == data);
+        // after its last frame
+        REQUIRE(pull->ReceiveHeader(0, received_header, 0) == 0);
+        REQUIRE_FALSE(received_header.data);
+    }
+    REQUIRE(frames.size() == 2);
+}
+
+TEST_CASE("A pulling client reconnects to a restarted push server") {
+    constexpr int port = 50001;
+    ZmqSocket pull("localhost", port, true);
+    pull.Connect();
+    { ZmqSocket restarted(port, "*", true); }
+    ZmqSocket push(port, "*", true);
+
+    zmqHeader received_header;
+    std::thread t([&]() { pull.ReceiveHeader(0, received_header, 0); });
+    for (int i = 0; i != 300 && !push.CanSend(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(push.CanSend());
+    zmqHeader header;
+    header.fname = "restarted";
+    REQUIRE(push.SendHeader(0, header) == 1);
+    REQUIRE(push.SendData(nullptr, 0) == 1);
+    t.join();
+    REQUIRE(received_header.fname == "restarted");
+}
+
+TEST_CASE("A push server without clients cannot send") {
+    constexpr int port = 50001;
+    ZmqSocket push(port, "*", true);
+    REQUIRE_FALSE(push.CanSend());
+    zmqHeader header;
+    REQUIRE(push.SendHeader(0, header) == ZMQ_SEND_SKIPPED);
+    std::vector<int> data{0, 1, 2, 3};
+    REQUIRE(push.SendData((char *)data.data(), sizeof(int) * 4) == 0);
+    // nobody to end the acquisition for
+    header.data = false;
+    REQUIRE(push.SendHeader(0, header) == 1);
+}
+
+TEST_CASE("A push server skips frames a full client cannot take") {
+    constexpr int port = 50001;
+    ZmqSocket pull("localhost", port, true);
+    pull.SetReceiveHighWaterMark(1);
+    pull.Connect();
+    ZmqSocket push(port, "*", true);
+    push.SetLinger(0);
+    for (int i = 0; i != 300 && !push.CanSend(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // the client never reads, the frames pile up till it is full (default
+    // high water mark of 1000 of the server)
+    std::vector<char> data(64 * 1024);
+    zmqHeader header;
+    int ret = 1;
+    for (int i = 0; i != 5000 && ret == 1; ++i) {
+        ret = push.SendHeader(0, header);
+        if (ret == 1) {
+            REQUIRE(push.SendData(data.data(), (int)data.size()) == 1);
+        }
+    }
+    REQUIRE(ret == ZMQ_SEND_SKIPPED);
+}
+
+TEST_CASE("Closing without linger releases queued zero copy data") {
+    constexpr int port = 50001;
+    ZmqSocket sub("localhost", port);
+    sub.Connect();
+    auto pub = sls::make_unique<ZmqSocket>(port, "*");
+    // subscription reaches the publisher, the client never reads
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // larger than the socket buffers, so it stays queued
+    std::vector<char> data(64 * 1024 * 1024);
+    std::atomic<bool> released{false};
+    auto release = [](void *, void *hint) {
+        static_cast<std::atomic<bool> *>(hint)->store(true);
+    };
+    REQUIRE(pub->SendDataZeroCopy(data.data(), (int)data.size(), release,
+                                  &released) == 1);
+    pub->SetLinger(0);
+    pub.reset();
+    REQUIRE(released);
+}
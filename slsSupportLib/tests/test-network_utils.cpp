@@ -112,4 +112,10 @@ TEST_CASE("Copy construct a MacAddr") {
     CHECK(addr == addr2);
 }
 
+TEST_CASE("NUMA node of an interface without device is unknown") {
+    CHECK(InterfaceNameToNumaNode("lo") == -1);
+    CHECK(InterfaceNameToNumaNode("") == -1);
+    CHECK(InterfaceNameToNumaNode("../lo") == -1);
+}
+
 // TODO!(Erik) Look up a real hostname and verify the IP